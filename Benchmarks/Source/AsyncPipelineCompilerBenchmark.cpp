@@ -0,0 +1,305 @@
+#include "Benchmark.hpp"
+#include "Core/Events.hpp"
+#include "Render/AsyncPipelineCompiler.hpp"
+
+namespace
+{
+    constexpr std::string_view kFirstCode = "first";
+    constexpr std::string_view kSecondCode = "second";
+    constexpr std::string_view kThirdCode = "third";
+    // Bound while a pipeline compiles, never created by the cache
+    constexpr auto kFallback = static_cast<FS::ShaderHandle>(1u << 20);
+
+    FS::Span<const char> ToCode(const std::string_view code)
+    {
+        return {code.data(), code.size()};
+    }
+
+    // Stands in for the pipeline cache, every pipeline takes the set latency and empty bytecode fails. Tracks the
+    // bytecode behind each live shader, so leaks, double releases and the pipeline a shader ends up with show
+    class FakePipelineCache final : public FS::IPipelineCache
+    {
+    public:
+        explicit FakePipelineCache(const std::chrono::microseconds latency) : m_latency(latency) {}
+
+        FS::ShaderHandle Acquire(const FS::GraphicsShaderCreateInfo& create_info,
+                                 const std::string_view debug_name) override
+        {
+            return Create(create_info.VertexCode);
+        }
+
+        FS::ShaderHandle Acquire(const FS::ComputeShaderCreateInfo& create_info,
+                                 const std::string_view debug_name) override
+        {
+            return Create(create_info.ComputeCode);
+        }
+
+        void Release(const FS::ShaderHandle shader) override
+        {
+            std::lock_guard lock(m_mutex);
+            if (m_live.erase(shader) == 0)
+            {
+                ++m_errors;
+            }
+        }
+
+        FS::PipelineReload PrepareReload(const FS::ShaderHandle shader, const FS::GraphicsShaderCreateInfo& create_info,
+                                         const std::string_view debug_name) override
+        {
+            return {.Shader = shader, .Replacement = Create(create_info.VertexCode)};
+        }
+
+        FS::PipelineReload PrepareReload(const FS::ShaderHandle shader, const FS::ComputeShaderCreateInfo& create_info,
+                                         const std::string_view debug_name) override
+        {
+            return {.Shader = shader, .Replacement = Create(create_info.ComputeCode)};
+        }
+
+        void CommitReload(const FS::PipelineReload& reload) override
+        {
+            if (reload.Replacement == FS::ShaderHandle::eNull)
+            {
+                return;
+            }
+            std::lock_guard lock(m_mutex);
+            const auto replacement = m_live.find(reload.Replacement);
+            if (replacement == m_live.end() || !m_live.contains(reload.Shader))
+            {
+                ++m_errors;
+                return;
+            }
+            m_live[reload.Shader] = replacement->second;
+            m_live.erase(replacement);
+            ++m_commits;
+        }
+
+        void CancelReload(const FS::PipelineReload& reload) override
+        {
+            if (reload.Replacement != FS::ShaderHandle::eNull)
+            {
+                Release(reload.Replacement);
+            }
+            ++m_cancels;
+        }
+
+        [[nodiscard]] std::string_view GetCode(const FS::ShaderHandle shader) const
+        {
+            std::lock_guard lock(m_mutex);
+            const auto it = m_live.find(shader);
+            return it == m_live.end() ? std::string_view() : it->second;
+        }
+
+        [[nodiscard]] u32 GetLiveCount() const
+        {
+            std::lock_guard lock(m_mutex);
+            return static_cast<u32>(m_live.size());
+        }
+
+        [[nodiscard]] u32 GetErrors() const { return m_errors; }
+        [[nodiscard]] u32 GetCommits() const { return m_commits; }
+        [[nodiscard]] u32 GetCancels() const { return m_cancels; }
+
+    private:
+        FS::ShaderHandle Create(const FS::Span<const char> code)
+        {
+            std::this_thread::sleep_for(m_latency);
+            if (code.empty())
+            {
+                return FS::ShaderHandle::eNull;
+            }
+            const auto shader = static_cast<FS::ShaderHandle>(m_next_shader.fetch_add(1));
+            std::lock_guard lock(m_mutex);
+            m_live.emplace(shader, std::string_view(code.data(), code.size()));
+            return shader;
+        }
+
+        std::chrono::microseconds m_latency;
+        std::atomic<u32> m_next_shader = 1;
+        mutable std::mutex m_mutex;
+        std::unordered_map<FS::ShaderHandle, std::string_view> m_live;
+        std::atomic<u32> m_errors = 0;
+        std::atomic<u32> m_commits = 0;
+        std::atomic<u32> m_cancels = 0;
+    };
+
+    u32 g_failures = 0;
+
+    void Check(const bool passed, const std::string_view what)
+    {
+        if (!passed)
+        {
+            std::print("FAILED {}\n", what);
+            ++g_failures;
+        }
+    }
+
+    // Update until every compile in flight has shown up
+    void Drain(FS::AsyncPipelineCompiler& compiler)
+    {
+        while (compiler.GetPendingCount() > 0)
+        {
+            compiler.Update();
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+
+    void CheckPendingToReady()
+    {
+        FakePipelineCache cache(std::chrono::milliseconds(20));
+        FS::Events events;
+        u32 compiled = 0;
+        events.Subscribe<FS::PipelineCompiledEvent>([&compiled](const FS::PipelineCompiledEvent& event)
+        {
+            compiled += event.Success && !event.Reloaded;
+        });
+        FS::AsyncPipelineCompiler compiler;
+        compiler.Init(cache, events);
+
+        const auto pipeline = compiler.CreateShaderAsync({.ComputeCode = ToCode(kFirstCode)}, "Pending", kFallback);
+        Check(compiler.GetState(pipeline) == FS::PipelineState::ePending, "pending after the request");
+        Check(compiler.GetShader(pipeline) == kFallback, "pending pipeline resolves to its fallback");
+        Drain(compiler);
+        Check(compiler.GetState(pipeline) == FS::PipelineState::eReady, "ready once compiled");
+        Check(cache.GetCode(compiler.GetShader(pipeline)) == kFirstCode, "ready pipeline resolves to its shader");
+        Check(compiled == 1, "one compiled event");
+
+        compiler.Shutdown();
+        Check(cache.GetLiveCount() == 0 && cache.GetErrors() == 0, "pending to ready releases every shader once");
+    }
+
+    void CheckFallbacks()
+    {
+        FakePipelineCache cache(std::chrono::milliseconds(5));
+        FS::Events events;
+        u32 failed = 0;
+        events.Subscribe<FS::PipelineCompiledEvent>([&failed](const FS::PipelineCompiledEvent& event)
+        {
+            failed += !event.Success;
+        });
+        FS::AsyncPipelineCompiler compiler;
+        compiler.Init(cache, events);
+
+        const auto with_fallback = compiler.CreateShaderAsync(FS::ComputeShaderCreateInfo{}, "Failing", kFallback);
+        const auto without_fallback = compiler.CreateShaderAsync(FS::ComputeShaderCreateInfo{}, "Skipped");
+        Check(compiler.GetShader(without_fallback) == FS::ShaderHandle::eNull, "pending without fallback is skipped");
+        Drain(compiler);
+        Check(compiler.GetState(with_fallback) == FS::PipelineState::eFailed, "failed compile");
+        Check(compiler.GetShader(with_fallback) == kFallback, "failed pipeline resolves to its fallback");
+        Check(compiler.GetShader(without_fallback) == FS::ShaderHandle::eNull, "failed without fallback is skipped");
+        Check(failed == 2, "two failed events");
+
+        // A failed pipeline compiles again from the reload
+        compiler.Reload(with_fallback, FS::ComputeShaderCreateInfo{.ComputeCode = ToCode(kSecondCode)}, "Fixed");
+        Check(compiler.GetShader(with_fallback) == kFallback, "reloading failed pipeline keeps its fallback");
+        Drain(compiler);
+        Check(cache.GetCode(compiler.GetShader(with_fallback)) == kSecondCode, "failed pipeline ready after reload");
+
+        compiler.Shutdown();
+        Check(cache.GetLiveCount() == 0 && cache.GetErrors() == 0, "fallbacks release every shader once");
+    }
+
+    void CheckReloadSupersededByReload()
+    {
+        FakePipelineCache cache(std::chrono::milliseconds(20));
+        FS::Events events;
+        FS::AsyncPipelineCompiler compiler;
+        compiler.Init(cache, events);
+
+        const auto pipeline = compiler.CreateShaderAsync({.ComputeCode = ToCode(kFirstCode)}, "Reloaded");
+        Drain(compiler);
+        const auto shader = compiler.GetShader(pipeline);
+
+        // Both reloads are in flight at once, only the later one may be swapped in whichever finishes first
+        compiler.Reload(pipeline, FS::ComputeShaderCreateInfo{.ComputeCode = ToCode(kSecondCode)}, "Reloaded");
+        compiler.Reload(pipeline, FS::ComputeShaderCreateInfo{.ComputeCode = ToCode(kThirdCode)}, "Reloaded");
+        Check(compiler.GetShader(pipeline) == shader, "previous pipeline bound while reloading");
+        Drain(compiler);
+        Check(compiler.GetShader(pipeline) == shader, "reload keeps the shader handle");
+        Check(cache.GetCode(shader) == kThirdCode, "latest reload swapped in");
+        Check(cache.GetCommits() == 1 && cache.GetCancels() == 1, "superseded reload cancelled");
+
+        // A reload of a pending pipeline drops the compile it replaces
+        const auto pending = compiler.CreateShaderAsync({.ComputeCode = ToCode(kFirstCode)}, "Pending");
+        compiler.Reload(pending, FS::ComputeShaderCreateInfo{.ComputeCode = ToCode(kSecondCode)}, "Pending");
+        Drain(compiler);
+        Check(cache.GetCode(compiler.GetShader(pending)) == kSecondCode, "reload of pending pipeline compiled");
+        Check(cache.GetLiveCount() == 2, "dropped compile released");
+
+        compiler.Shutdown();
+        Check(cache.GetLiveCount() == 0 && cache.GetErrors() == 0, "reloads release every shader once");
+    }
+
+    void CheckDestroyDuringCompile()
+    {
+        FakePipelineCache cache(std::chrono::milliseconds(20));
+        FS::Events events;
+        u32 events_received = 0;
+        events.Subscribe<FS::PipelineCompiledEvent>([&events_received](const FS::PipelineCompiledEvent&)
+        {
+            ++events_received;
+        });
+        FS::AsyncPipelineCompiler compiler;
+        compiler.Init(cache, events);
+
+        const auto pipeline = compiler.CreateShaderAsync({.ComputeCode = ToCode(kFirstCode)}, "Destroyed", kFallback);
+        compiler.Destroy(pipeline);
+        Check(compiler.GetShader(pipeline) == FS::ShaderHandle::eNull, "destroyed pipeline resolves to nothing");
+
+        // Same for a reload in flight, and the freed slot is reused meanwhile
+        const auto reloaded = compiler.CreateShaderAsync({.ComputeCode = ToCode(kFirstCode)}, "Reloaded");
+        Drain(compiler);
+        compiler.Reload(reloaded, FS::ComputeShaderCreateInfo{.ComputeCode = ToCode(kSecondCode)}, "Reloaded");
+        compiler.Destroy(reloaded);
+        const auto reused = compiler.CreateShaderAsync({.ComputeCode = ToCode(kThirdCode)}, "Reused");
+        Drain(compiler);
+        Check(cache.GetCode(compiler.GetShader(reused)) == kThirdCode, "reused slot gets its own pipeline");
+        Check(cache.GetCommits() == 0, "reload of destroyed pipeline not swapped in");
+        Check(cache.GetLiveCount() == 1, "compiles of destroyed pipelines released");
+        Check(events_received == 2, "no events for destroyed pipelines");
+
+        compiler.Shutdown();
+        Check(cache.GetLiveCount() == 0 && cache.GetErrors() == 0, "destroy releases every shader once");
+    }
+
+    // Requests never wait for the compile, the workers overlap the latency of the cache
+    void RunBenchmark(const u32 pipeline_count, const u32 worker_count, const std::chrono::microseconds latency)
+    {
+        FakePipelineCache cache(latency);
+        FS::Events events;
+        FS::AsyncPipelineCompiler compiler;
+        compiler.Init(cache, events, worker_count);
+
+        FS::Vec<FS::PipelineHandle> pipelines(pipeline_count);
+        const auto request = FS::Benchmark::Measure(1, [&]
+        {
+            for (auto& pipeline : pipelines)
+            {
+                pipeline = compiler.CreateShaderAsync({.ComputeCode = ToCode(kFirstCode)}, "Benchmark", kFallback);
+            }
+        });
+        const auto ready = FS::Benchmark::Measure(1, [&] { Drain(compiler); });
+        FS::Benchmark::Report(std::format("{} pipelines {} workers request", pipeline_count, worker_count), request);
+        FS::Benchmark::Report(std::format("{} pipelines {} workers ready", pipeline_count, worker_count), ready);
+        std::print("{:<40} {:.1f} ms serial latency\n", "", pipeline_count * latency.count() / 1000.0);
+
+        for (const auto pipeline : pipelines)
+        {
+            compiler.Destroy(pipeline);
+        }
+        compiler.Shutdown();
+        Check(cache.GetLiveCount() == 0 && cache.GetErrors() == 0, "benchmark releases every shader once");
+    }
+}
+
+int main()
+{
+    CheckPendingToReady();
+    CheckFallbacks();
+    CheckReloadSupersededByReload();
+    CheckDestroyDuringCompile();
+
+    RunBenchmark(64, 2, std::chrono::microseconds(2000));
+    RunBenchmark(64, 8, std::chrono::microseconds(2000));
+    RunBenchmark(1024, 4, std::chrono::microseconds(100));
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include "Asset/Mesh.hpp"
+#include "chrono"
+#include "numbers"
+
+namespace FS::Benchmark
+{
+    struct Result
+    {
+        f64 MinMs = std::numeric_limits<f64>::max();
+        f64 MeanMs = 0.0;
+    };
+
+    template <typename Func>
+    Result Measure(const u32 iterations, Func&& func)
+    {
+        Result result;
+        for (u32 i = 0; i < iterations; ++i)
+        {
+            const auto start = std::chrono::high_resolution_clock::now();
+            func();
+            const auto end = std::chrono::high_resolution_clock::now();
+            const auto ms = std::chrono::duration<f64, std::milli>(end - start).count();
+            result.MinMs = std::min(result.MinMs, ms);
+            result.MeanMs += ms / iterations;
+        }
+        return result;
+    }
+
+    inline void Report(const std::string_view name, const Result& result)
+    {
+        std::print("{:<40} min {:>10.3f} ms  mean {:>10.3f} ms\n", name, result.MinMs, result.MeanMs);
+    }
+
+    template <typename T>
+    void DoNotOptimize(const T& value)
+    {
+        static const void* volatile sink;
+        sink = &value;
+    }
+
+    /// <summary>
+    /// UV sphere with bumps along both angles, bump_frequency sets how many. Rings and segments are split into
+    /// quads, the seam duplicates its vertices like an imported mesh.
+    /// </summary>
+    inline Mesh GenerateSphere(const u32 rings, const u32 segments, const glm::vec2 bump_frequency = glm::vec2(12, 9))
+    {
+        Mesh mesh;
+        for (u32 ring = 0; ring <= rings; ++ring)
+        {
+            for (u32 segment = 0; segment <= segments; ++segment)
+            {
+                const f32 u = static_cast<f32>(segment) / static_cast<f32>(segments);
+                const f32 v = static_cast<f32>(ring) / static_cast<f32>(rings);
+                const f32 theta = u * 2.0f * std::numbers::pi_v<f32>;
+                const f32 phi = v * std::numbers::pi_v<f32>;
+                const glm::vec3 direction(std::sin(phi) * std::cos(theta), std::cos(phi),
+                                          std::sin(phi) * std::sin(theta));
+                const f32 radius =
+                    1.0f + 0.02f * std::sin(theta * bump_frequency.x) * std::sin(phi * bump_frequency.y);
+                mesh.Vertices.push_back({
+                    .Position = direction * radius,
+                    .UVx = u,
+                    .Normal = direction,
+                    .UVy = v,
+                    .Tangent = glm::vec4(-std::sin(theta), 0.0f, std::cos(theta), 1.0f),
+                });
+            }
+        }
+        for (u32 ring = 0; ring < rings; ++ring)
+        {
+            for (u32 segment = 0; segment < segments; ++segment)
+            {
+                const u32 i0 = ring * (segments + 1) + segment;
+                const u32 i1 = i0 + segments + 1;
+                mesh.Indices.insert(mesh.Indices.end(), {i0, i0 + 1, i1, i0 + 1, i1 + 1, i1});
+            }
+        }
+        return mesh;
+    }
+}
@@ -0,0 +1,88 @@
+#include "Benchmark.hpp"
+#include "Asset/BlockCompression.hpp"
+#include "Core/JobSystem.hpp"
+
+namespace
+{
+    // Smooth gradients with some noise, closer to real textures than pure noise
+    FS::Image GenerateImage(const u32 size)
+    {
+        std::mt19937 engine(42);
+        std::uniform_int_distribution noise(-12, 12);
+        auto image = FS::Image::Create(size, size, FS::Format::eR8G8B8A8_UNORM);
+        for (u32 y = 0; y < size; ++y)
+        {
+            u8* row = image.Row(y);
+            for (u32 x = 0; x < size; ++x)
+            {
+                const f32 u = static_cast<f32>(x) / static_cast<f32>(size);
+                const f32 v = static_cast<f32>(y) / static_cast<f32>(size);
+                const auto channel = [&](const f32 value)
+                {
+                    return static_cast<u8>(std::clamp(static_cast<i32>(value * 255.0f) + noise(engine), 0, 255));
+                };
+                row[x * 4 + 0] = channel(u);
+                row[x * 4 + 1] = channel(0.5f + 0.5f * std::sin(u * 20.0f) * std::cos(v * 13.0f));
+                row[x * 4 + 2] = channel(v);
+                row[x * 4 + 3] = channel(1.0f - u * v);
+            }
+        }
+        return image;
+    }
+
+    // The same pattern spread over several stops, converted up front so the conversion isn't measured
+    FS::Image GenerateHdrImage(const FS::Image& image)
+    {
+        auto hdr = FS::ConvertImage(image, FS::Format::eR32G32B32A32_FLOAT);
+        for (u32 y = 0; y < hdr.Height; ++y)
+        {
+            auto* row = reinterpret_cast<f32*>(hdr.Row(y));
+            for (u32 x = 0; x < hdr.Width * 4; ++x)
+            {
+                row[x] = std::exp2(row[x] * 12.0f - 4.0f);
+            }
+        }
+        return hdr;
+    }
+
+    void RunBenchmark(const FS::Image& image, const FS::Format format, const std::string_view format_name,
+                      const FS::CompressionQuality quality, FS::JobSystem* jobs, const u32 iterations)
+    {
+        const auto result = FS::Benchmark::Measure(iterations, [&]
+        {
+            const auto compressed = FS::CompressImage(image, format, {.Quality = quality}, jobs);
+            FS::Benchmark::DoNotOptimize(compressed);
+        });
+        const auto name = std::format("{} {} {}", format_name,
+                                      quality == FS::CompressionQuality::eFast ? "fast" : "quality",
+                                      jobs ? "threaded" : "single");
+        FS::Benchmark::Report(name, result);
+        const f64 megapixels = static_cast<f64>(image.Width) * image.Height / 1'000'000.0;
+        std::print("{:<40} {:>10.1f} MPix/s\n", "", megapixels / (result.MinMs / 1000.0));
+    }
+}
+
+int main()
+{
+    FS::JobSystem jobs;
+    jobs.Init();
+    const auto image = GenerateImage(2048);
+    const auto hdr_image = GenerateHdrImage(image);
+    const std::array formats = {
+        std::tuple{FS::Format::eBC1_UNORM, "BC1", &image},
+        std::tuple{FS::Format::eBC3_UNORM, "BC3", &image},
+        std::tuple{FS::Format::eBC4_UNORM, "BC4", &image},
+        std::tuple{FS::Format::eBC5_UNORM, "BC5", &image},
+        std::tuple{FS::Format::eBC7_UNORM, "BC7", &image},
+        std::tuple{FS::Format::eBC6H_UF16, "BC6H", &hdr_image},
+    };
+    for (const auto& [format, name, source] : formats)
+    {
+        for (const auto quality : {FS::CompressionQuality::eFast, FS::CompressionQuality::eQuality})
+        {
+            RunBenchmark(*source, format, name, quality, nullptr, 1);
+            RunBenchmark(*source, format, name, quality, &jobs, 5);
+        }
+    }
+    jobs.Shutdown();
+}
@@ -0,0 +1,83 @@
+#include "Benchmark.hpp"
+#include "Asset/MeshCodec.hpp"
+#include "Asset/MeshOptimizer.hpp"
+#include "Asset/VertexPacking.hpp"
+#include "lz4hc.h"
+
+namespace
+{
+    u64 CompressLz(const FS::Span<const u8> data)
+    {
+        FS::Vec<char> compressed(LZ4_compressBound(static_cast<int>(data.size())));
+        return LZ4_compress_HC(reinterpret_cast<const char*>(data.data()), compressed.data(),
+                               static_cast<int>(data.size()), static_cast<int>(compressed.size()), LZ4HC_CLEVEL_MAX);
+    }
+
+    // The codec is meant to run before a general purpose compressor, what counts is how much smaller the pair
+    // gets than that compressor alone
+    void ReportCompression(const FS::Span<const u8> raw, const FS::Span<const u8> encoded)
+    {
+        const u64 lz_size = CompressLz(raw);
+        const u64 codec_lz_size = CompressLz(encoded);
+        std::print("{:<40} LZ4HC {:.2f}x, codec + LZ4HC {:.2f}x, {:.2f}x smaller than LZ4HC alone\n", "",
+                   static_cast<f64>(raw.size()) / lz_size, static_cast<f64>(raw.size()) / codec_lz_size,
+                   static_cast<f64>(lz_size) / codec_lz_size);
+    }
+
+    void ReportDecode(const std::string_view name, const u64 raw_size, const u64 encoded_size,
+                      const FS::Benchmark::Result& result)
+    {
+        FS::Benchmark::Report(name, result);
+        std::print("{:<40} {:>10.2f} GB/s, {} -> {} bytes ({:.2f}x)\n", "", raw_size / (result.MinMs * 1'000'000.0),
+                   raw_size, encoded_size, static_cast<f64>(raw_size) / encoded_size);
+    }
+
+    void RunVertices(const std::string_view name, const FS::Span<const u8> vertices, const u32 stride,
+                     const FS::Span<const u32> indices = {})
+    {
+        const auto encoded = FS::EncodeVertexBuffer(vertices, stride, indices);
+        FS::Vec<u8> decoded(vertices.size());
+        ReportDecode(name, vertices.size(), encoded.size(), FS::Benchmark::Measure(10, [&]
+        {
+            (void)FS::DecodeVertexBuffer(encoded, stride, decoded, indices);
+            FS::Benchmark::DoNotOptimize(decoded);
+        }));
+        ReportCompression(vertices, encoded);
+        if (!std::ranges::equal(vertices, decoded))
+        {
+            std::print("{} round trip mismatch\n", name);
+        }
+    }
+}
+
+int main()
+{
+    auto mesh = FS::Benchmark::GenerateSphere(300, 600);
+    FS::OptimizeMesh(mesh);
+
+    const auto encoded_indices = FS::EncodeIndexBuffer(mesh.Indices);
+    FS::Vec<u32> indices(mesh.Indices.size());
+    ReportDecode("decode indices", mesh.Indices.size() * sizeof(u32), encoded_indices.size(),
+                 FS::Benchmark::Measure(10, [&]
+    {
+        (void)FS::DecodeIndexBuffer(encoded_indices, indices);
+        FS::Benchmark::DoNotOptimize(indices);
+    }));
+    std::print("{:.2f} bytes per triangle\n", static_cast<f64>(encoded_indices.size()) / mesh.TriangleCount());
+    ReportCompression(FS::Span<const u8>(reinterpret_cast<const u8*>(mesh.Indices.data()),
+                                         mesh.Indices.size() * sizeof(u32)),
+                      encoded_indices);
+
+    const auto quantization = FS::ComputeVertexQuantization(mesh.Vertices);
+    FS::Vec<FS::PackedVertex> packed(mesh.Vertices.size());
+    FS::PackVertices(mesh.Vertices, quantization, packed);
+    const auto as_bytes = [](const auto& vertices)
+    {
+        return FS::Span<const u8>(reinterpret_cast<const u8*>(vertices.data()),
+                                  vertices.size() * sizeof(vertices.front()));
+    };
+    RunVertices("decode full vertices", as_bytes(mesh.Vertices), sizeof(FS::Vertex));
+    RunVertices("decode packed vertices", as_bytes(packed), sizeof(FS::PackedVertex));
+    RunVertices("decode full vertices, triangles", as_bytes(mesh.Vertices), sizeof(FS::Vertex), mesh.Indices);
+    RunVertices("decode packed vertices, triangles", as_bytes(packed), sizeof(FS::PackedVertex), mesh.Indices);
+}
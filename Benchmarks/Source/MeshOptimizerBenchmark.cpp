@@ -0,0 +1,93 @@
+#include "Benchmark.hpp"
+#include "Asset/MeshOptimizer.hpp"
+
+namespace
+{
+    // A wavy grid with every triangle owning its vertices and the triangles shuffled, like the output of an
+    // importer before any optimization
+    FS::Mesh GenerateMesh(const u32 size)
+    {
+        const auto grid_vertex = [&](const u32 x, const u32 y)
+        {
+            const f32 u = static_cast<f32>(x) / static_cast<f32>(size);
+            const f32 v = static_cast<f32>(y) / static_cast<f32>(size);
+            return FS::Vertex{
+                .Position = glm::vec3(u, 0.1f * std::sin(u * 30.0f) * std::cos(v * 20.0f), v),
+                .UVx = u,
+                .Normal = glm::vec3(0.0f, 1.0f, 0.0f),
+                .UVy = v,
+                .Tangent = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f),
+            };
+        };
+
+        FS::Vec<FS::Array<glm::uvec2, 3>> triangles;
+        triangles.reserve(static_cast<u64>(size) * size * 2);
+        for (u32 y = 0; y < size; ++y)
+        {
+            for (u32 x = 0; x < size; ++x)
+            {
+                triangles.push_back({glm::uvec2(x, y), glm::uvec2(x, y + 1), glm::uvec2(x + 1, y)});
+                triangles.push_back({glm::uvec2(x + 1, y), glm::uvec2(x, y + 1), glm::uvec2(x + 1, y + 1)});
+            }
+        }
+        std::ranges::shuffle(triangles, std::mt19937(42));
+
+        FS::Mesh mesh;
+        for (const auto& triangle : triangles)
+        {
+            for (const auto& corner : triangle)
+            {
+                mesh.Indices.push_back(static_cast<u32>(mesh.Vertices.size()));
+                mesh.Vertices.push_back(grid_vertex(corner.x, corner.y));
+            }
+        }
+        return mesh;
+    }
+
+    void ReportStatistics(const std::string_view name, const FS::Mesh& mesh)
+    {
+        const auto vertex_count = static_cast<u32>(mesh.Vertices.size());
+        const auto cache = FS::AnalyzeVertexCache(mesh.Indices, vertex_count);
+        const auto fetch = FS::AnalyzeVertexFetch(mesh.Indices, vertex_count, sizeof(FS::Vertex));
+        std::print("{:<40} ACMR {:>6.3f}  ATVR {:>6.3f}  overfetch {:>6.3f}\n", name, cache.ACMR, cache.ATVR,
+                   fetch.Overfetch);
+    }
+
+    template <typename Func>
+    FS::Mesh RunPass(const std::string_view name, const FS::Mesh& input, const u32 iterations, Func&& func)
+    {
+        FS::Mesh output;
+        const auto result = FS::Benchmark::Measure(iterations, [&]
+        {
+            output = input;
+            func(output);
+            FS::Benchmark::DoNotOptimize(output);
+        });
+        FS::Benchmark::Report(name, result);
+        ReportStatistics(name, output);
+        return output;
+    }
+}
+
+int main()
+{
+    const auto mesh = GenerateMesh(500);
+    std::print("{} triangles\n", mesh.TriangleCount());
+
+    // Welded so the shuffled order is the baseline the cache passes are measured against
+    auto welded = mesh;
+    FS::DeduplicateVertices(welded);
+    ReportStatistics("unoptimized", welded);
+
+    RunPass("deduplicate", mesh, 5, [](FS::Mesh& output) { FS::DeduplicateVertices(output); });
+    const auto cache_optimized = RunPass("vertex cache", welded, 5, [](FS::Mesh& output)
+    {
+        FS::OptimizeVertexCache(output.Indices, static_cast<u32>(output.Vertices.size()));
+    });
+    RunPass("overdraw", cache_optimized, 5, [](FS::Mesh& output)
+    {
+        FS::OptimizeOverdraw(output.Indices, output.Vertices, 1.05f);
+    });
+    RunPass("vertex fetch", cache_optimized, 5, [](FS::Mesh& output) { FS::OptimizeVertexFetch(output); });
+    RunPass("all passes", mesh, 5, [](FS::Mesh& output) { FS::OptimizeMesh(output); });
+}
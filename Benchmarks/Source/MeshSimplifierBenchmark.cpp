@@ -0,0 +1,40 @@
+#include "Benchmark.hpp"
+#include "Asset/MeshSimplifier.hpp"
+#include "Core/JobSystem.hpp"
+
+int main()
+{
+    FS::JobSystem jobs;
+    jobs.Init();
+    const auto mesh = FS::Benchmark::GenerateSphere(300, 600);
+
+    FS::LodChain chain;
+    FS::Benchmark::Report("lod chain", FS::Benchmark::Measure(3, [&]
+    {
+        chain = FS::GenerateLods(mesh);
+        FS::Benchmark::DoNotOptimize(chain);
+    }));
+    for (u64 lod = 0; lod < chain.Lods.size(); ++lod)
+    {
+        u32 index_count = 0;
+        for (const auto& submesh : chain.Lods[lod].Submeshes)
+        {
+            index_count += submesh.IndexCount;
+        }
+        std::print("LOD {}: {:>8} triangles, error {:.5f}\n", lod, index_count / 3, chain.Lods[lod].Error);
+    }
+
+    const FS::Vec<FS::Mesh> meshes(8, mesh);
+    FS::Benchmark::Report("lod chain x8 parallel", FS::Benchmark::Measure(1, [&]
+    {
+        const auto chains = FS::GenerateLods(meshes, jobs);
+        FS::Benchmark::DoNotOptimize(chains);
+    }));
+
+    const f32 projection_scale = FS::GetLodProjectionScale(glm::radians(60.0f), 1080.0f);
+    for (const f32 distance : {1.0f, 5.0f, 20.0f, 100.0f})
+    {
+        std::print("distance {:>5.0f}: LOD {}\n", distance, FS::SelectLod(chain.Lods, distance, projection_scale));
+    }
+    jobs.Shutdown();
+}
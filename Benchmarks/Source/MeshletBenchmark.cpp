@@ -0,0 +1,47 @@
+#include "Benchmark.hpp"
+#include "Asset/MeshOptimizer.hpp"
+#include "Asset/Meshlet.hpp"
+#include "Render/MeshletCulling.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+namespace
+{
+    void RunCulling(const std::string_view name, const FS::MeshletMesh& meshlets, const glm::vec3 camera_position,
+                    const glm::vec3 target)
+    {
+        const glm::mat4 projection = glm::perspectiveRH_ZO(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+        const glm::mat4 view = glm::lookAtRH(camera_position, target, glm::vec3(0.0f, 1.0f, 0.0f));
+        const auto frustum = FS::Frustum::FromMatrix(projection * view);
+
+        FS::MeshletCullStatistics statistics;
+        const auto result = FS::Benchmark::Measure(100, [&]
+        {
+            statistics = FS::CullMeshlets(meshlets.Bounds, frustum, camera_position);
+            FS::Benchmark::DoNotOptimize(statistics);
+        });
+        FS::Benchmark::Report(name, result);
+        const auto percent = [&](const u32 count) { return 100.0 * count / statistics.MeshletCount; };
+        std::print("{:<40} frustum {:>5.1f}%  cone {:>5.1f}%  visible {:>5.1f}%\n", "",
+                   percent(statistics.FrustumCulled), percent(statistics.ConeCulled),
+                   percent(statistics.VisibleCount()));
+    }
+}
+
+int main()
+{
+    // Bumpier, about half of the sphere faces away from any camera outside
+    auto mesh = FS::Benchmark::GenerateSphere(700, 700, glm::vec2(40.0f, 30.0f));
+    FS::OptimizeMesh(mesh);
+
+    FS::MeshletMesh meshlets;
+    const auto result = FS::Benchmark::Measure(3, [&] { meshlets = FS::BuildMeshlets(mesh); });
+    FS::Benchmark::Report("build meshlets", result);
+    const f64 meshlet_count = static_cast<f64>(meshlets.Meshlets.size());
+    std::print("{} triangles, {} meshlets, {:.1f} vertices and {:.1f} triangles per meshlet\n",
+               mesh.TriangleCount(), meshlets.Meshlets.size(),
+               static_cast<f64>(meshlets.VertexIndices.size()) / meshlet_count,
+               static_cast<f64>(meshlets.Triangles.size()) / meshlet_count);
+
+    RunCulling("cull whole sphere", meshlets, glm::vec3(0.0f, 0.5f, 4.0f), glm::vec3(0.0f));
+    RunCulling("cull close up", meshlets, glm::vec3(0.0f, 0.0f, 1.6f), glm::vec3(0.3f, 0.2f, 0.9f));
+}
@@ -0,0 +1,99 @@
+#include "Benchmark.hpp"
+#include "Render/RenderGraph.hpp"
+
+namespace
+{
+    struct SyntheticPass
+    {
+        FS::Array<u32, 3> Reads{};
+        u32 ReadCount = 0;
+        bool Compute = false;
+    };
+
+    // Each pass writes a resource of its own and reads up to three earlier ones, mostly recent ones like a real
+    // frame. Passes whose output nobody reads get culled along with what only they read.
+    FS::Vec<SyntheticPass> GeneratePasses(const u32 pass_count)
+    {
+        std::mt19937 engine(42);
+        FS::Vec<SyntheticPass> passes(pass_count);
+        for (u32 i = 1; i < pass_count; ++i)
+        {
+            auto& pass = passes[i];
+            pass.Compute = engine() % 4 == 0;
+            pass.ReadCount = 1 + engine() % std::min(i, 3u);
+            for (u32 read = 0; read < pass.ReadCount; ++read)
+            {
+                const u32 distance = 1 + engine() % std::min(i, engine() % 8 == 0 ? i : 4u);
+                pass.Reads[read] = i - distance;
+            }
+        }
+        return passes;
+    }
+
+    void BuildGraph(FS::RenderGraph& graph, const FS::Span<const SyntheticPass> passes)
+    {
+        graph.Reset();
+        const auto backbuffer = graph.ImportTexture("Backbuffer", FS::TextureHandle::eNull,
+                                                    FS::ResourceState::ePresent, FS::ResourceState::ePresent);
+        FS::Vec<FS::RenderGraphResource> outputs(passes.size());
+        for (u32 i = 0; i < passes.size(); ++i)
+        {
+            const auto& pass = passes[i];
+            outputs[i] = pass.Compute
+                             ? graph.CreateBuffer("Buffer", {.NumElements = 1024, .Stride = 16})
+                             : graph.CreateTexture("Texture", {
+                                   .Dimensions = glm::uvec2(1920, 1080),
+                                   .Format = FS::Format::eR16G16B16A16_FLOAT,
+                               });
+            auto builder = graph.AddPass("Pass", {});
+            for (u32 read = 0; read < pass.ReadCount; ++read)
+            {
+                builder.Read(outputs[pass.Reads[read]]);
+            }
+            builder.Write(outputs[i], pass.Compute ? FS::ResourceState::eUnorderedAccess
+                                                   : FS::ResourceState::eRenderTarget);
+        }
+        // The last tenth of the passes feed the frame, earlier outputs only live through their readers
+        auto present = graph.AddPass("Present", {});
+        for (u32 i = static_cast<u32>(passes.size()) * 9 / 10; i < passes.size(); i += 3)
+        {
+            present.Read(outputs[i]);
+        }
+        present.Write(backbuffer);
+    }
+
+    void RunBenchmark(const u32 pass_count)
+    {
+        const auto passes = GeneratePasses(pass_count);
+        FS::RenderGraph graph;
+        BuildGraph(graph, passes);
+        graph.Compile();
+        const auto stats = graph.GetStats();
+        std::print("{} passes: {} culled, {} levels, {} barriers\n", stats.PassCount, stats.CulledCount,
+                   stats.LevelCount, stats.BarrierCount);
+
+        const auto build = FS::Benchmark::Measure(200, [&]
+        {
+            BuildGraph(graph, passes);
+            graph.Compile();
+            FS::Benchmark::DoNotOptimize(graph);
+        });
+        FS::Benchmark::Report(std::format("build and compile {} passes", pass_count), build);
+        const auto compile = FS::Benchmark::Measure(200, [&]
+        {
+            graph.Compile();
+            FS::Benchmark::DoNotOptimize(graph);
+        });
+        FS::Benchmark::Report(std::format("compile {} passes", pass_count), compile);
+        std::print("{:<40} {:>10.2f} us per compile, {:.1f} ns per pass\n", "", compile.MinMs * 1000.0,
+                   compile.MinMs * 1'000'000.0 / pass_count);
+    }
+}
+
+int main()
+{
+    for (const u32 pass_count : {100u, 500u, 1000u})
+    {
+        RunBenchmark(pass_count);
+    }
+}
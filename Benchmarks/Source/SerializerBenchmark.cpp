@@ -0,0 +1,100 @@
+#include "Benchmark.hpp"
+#include "Core/Serializer.hpp"
+
+namespace
+{
+    struct BenchmarkComponent
+    {
+        std::string Type;
+        std::vector<f32> Values;
+    };
+
+    struct BenchmarkEntity
+    {
+        u64 Id = 0;
+        std::string Name;
+        std::array<f32, 3> Position{};
+        std::array<f32, 4> Rotation{};
+        std::array<f32, 3> Scale{};
+        std::string Mesh;
+        std::vector<u64> Children;
+        std::vector<BenchmarkComponent> Components;
+    };
+
+    struct BenchmarkScene
+    {
+        std::string Name;
+        std::vector<BenchmarkEntity> Entities;
+    };
+
+    BenchmarkScene GenerateScene(const u32 entity_count)
+    {
+        std::mt19937 engine(42);
+        std::uniform_real_distribution distribution(-1000.0f, 1000.0f);
+
+        BenchmarkScene scene{.Name = "Benchmark Scene"};
+        scene.Entities.resize(entity_count);
+        for (const auto& [index, entity] : std::views::enumerate(scene.Entities))
+        {
+            entity.Id = index;
+            entity.Name = "Entity_" + std::to_string(index);
+            entity.Position = {distribution(engine), distribution(engine), distribution(engine)};
+            entity.Rotation = {0.0f, 0.0f, 0.0f, 1.0f};
+            entity.Scale = {1.0f, 1.0f, 1.0f};
+            entity.Mesh = "Meshes/Mesh_" + std::to_string(index % 512) + ".mesh";
+            for (u64 child = 1; child <= index % 4; ++child)
+            {
+                entity.Children.push_back((index + child) % entity_count);
+            }
+            entity.Components.push_back({.Type = "Light", .Values = {distribution(engine), distribution(engine)}});
+        }
+        return scene;
+    }
+
+    void RunBenchmark(const u32 entity_count, const u32 iterations)
+    {
+        std::print("--- {} entities ---\n", entity_count);
+        const auto scene = GenerateScene(entity_count);
+
+        std::string json;
+        std::string beve;
+        auto result = FS::Benchmark::Measure(iterations, [&]
+        {
+            [[maybe_unused]] const auto ec = glz::write<FS::Serializer::kJsonWriteOpts>(scene, json);
+        });
+        FS::Benchmark::Report("JSON write", result);
+        result = FS::Benchmark::Measure(iterations, [&]
+        {
+            [[maybe_unused]] const auto ec = glz::write<FS::Serializer::kBinaryWriteOpts>(scene, beve);
+        });
+        FS::Benchmark::Report("BEVE write", result);
+
+        const auto json_view = std::string_view(json);
+        const auto beve_view = std::string_view(beve);
+        BenchmarkScene parsed;
+        result = FS::Benchmark::Measure(iterations, [&]
+        {
+            [[maybe_unused]] const auto ec = glz::read<FS::Serializer::kJsonReadOpts>(parsed, json_view);
+            FS::Benchmark::DoNotOptimize(parsed);
+        });
+        FS::Benchmark::Report("JSON read", result);
+        result = FS::Benchmark::Measure(iterations, [&]
+        {
+            [[maybe_unused]] const auto ec = glz::read<FS::Serializer::kBinaryReadOpts>(parsed, beve_view);
+            FS::Benchmark::DoNotOptimize(parsed);
+        });
+        FS::Benchmark::Report("BEVE read", result);
+
+        std::print("JSON size {:.2f} MB, BEVE size {:.2f} MB ({:.1f}%)\n",
+                   static_cast<f64>(json.size()) / 1024 / 1024,
+                   static_cast<f64>(beve.size()) / 1024 / 1024,
+                   100.0 * static_cast<f64>(beve.size()) / static_cast<f64>(json.size()));
+    }
+}
+
+int main()
+{
+    RunBenchmark(1'000, 50);
+    RunBenchmark(100'000, 10);
+    RunBenchmark(1'000'000, 3);
+}
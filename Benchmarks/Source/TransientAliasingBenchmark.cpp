@@ -0,0 +1,83 @@
+#include "Benchmark.hpp"
+#include "Render/TransientAliasing.hpp"
+
+namespace
+{
+    constexpr u64 kPlacementAlignment = 64 * 1024;
+    constexpr u64 kMsaaPlacementAlignment = 4 * 1024 * 1024;
+
+    // Render targets of a 1080p frame at full, half and quarter resolution, most only live for a few passes
+    // like the intermediates of a real frame, some for most of it like the gbuffer
+    FS::Vec<FS::TransientResourceDesc> GenerateResources(const u32 resource_count, const u32 pass_count)
+    {
+        std::mt19937 engine(42);
+        constexpr FS::Array<u64, 3> pixel_counts = {1920 * 1080, 960 * 540, 480 * 270};
+        constexpr FS::Array<u64, 4> pixel_sizes = {4, 8, 16, 4};
+        FS::Vec<FS::TransientResourceDesc> resources(resource_count);
+        for (auto& resource : resources)
+        {
+            const bool msaa = engine() % 16 == 0;
+            const u32 lifetime = engine() % 8 == 0 ? pass_count / 2 : 1 + engine() % 6;
+            resource.FirstPass = engine() % pass_count;
+            resource.LastPass = std::min(resource.FirstPass + lifetime, pass_count - 1);
+            resource.Size = pixel_counts[engine() % pixel_counts.size()] * pixel_sizes[engine() % pixel_sizes.size()] *
+                            (msaa ? 4 : 1);
+            resource.Alignment = msaa ? kMsaaPlacementAlignment : kPlacementAlignment;
+        }
+        return resources;
+    }
+
+    // Resources in use at the same time must not share memory
+    bool Validate(const FS::Span<const FS::TransientResourceDesc> resources, const FS::TransientAliasingPlan& plan)
+    {
+        for (u32 a = 0; a < resources.size(); ++a)
+        {
+            if (plan.Offsets[a] % resources[a].Alignment != 0)
+            {
+                return false;
+            }
+            for (u32 b = a + 1; b < resources.size(); ++b)
+            {
+                const bool same_time = resources[a].FirstPass <= resources[b].LastPass &&
+                                       resources[b].FirstPass <= resources[a].LastPass;
+                const bool same_memory = plan.Offsets[a] < plan.Offsets[b] + resources[b].Size &&
+                                         plan.Offsets[b] < plan.Offsets[a] + resources[a].Size;
+                if (same_time && same_memory)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    void RunBenchmark(const u32 resource_count, const u32 pass_count)
+    {
+        const auto resources = GenerateResources(resource_count, pass_count);
+        FS::TransientAliasingPlan plan;
+        const auto result = FS::Benchmark::Measure(20, [&]
+        {
+            plan = FS::PlanTransientAliasing(resources);
+            FS::Benchmark::DoNotOptimize(plan);
+        });
+        FS::Benchmark::Report(std::format("{} resources {} passes", resource_count, pass_count), result);
+
+        constexpr f64 megabyte = 1024.0 * 1024.0;
+        const auto& stats = plan.Stats;
+        std::print("{:<40} {:.1f} MB unaliased, {:.1f} MB aliased, {:.1f} MB peak live, {:.1f}% saved, "
+                   "{} barriers\n", "", stats.UnaliasedSize / megabyte, stats.HeapSize / megabyte,
+                   stats.PeakLiveSize / megabyte, 100.0 * stats.SavedSize() / stats.UnaliasedSize,
+                   plan.Barriers.size());
+        if (!Validate(resources, plan))
+        {
+            std::print("{} resources overlapping placement\n", resource_count);
+        }
+    }
+}
+
+int main()
+{
+    RunBenchmark(32, 24);
+    RunBenchmark(128, 100);
+    RunBenchmark(512, 400);
+}
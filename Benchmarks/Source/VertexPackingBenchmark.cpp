@@ -0,0 +1,61 @@
+#include "Benchmark.hpp"
+#include "Asset/VertexPacking.hpp"
+
+namespace
+{
+    FS::Vec<FS::Vertex> GenerateVertices(const u32 count)
+    {
+        std::mt19937 engine(42);
+        std::uniform_real_distribution unit(-1.0f, 1.0f);
+        const auto direction = [&]
+        {
+            const glm::vec3 value(unit(engine), unit(engine), unit(engine));
+            return glm::length(value) > 0.0f ? glm::normalize(value) : glm::vec3(0.0f, 0.0f, 1.0f);
+        };
+
+        FS::Vec<FS::Vertex> vertices(count);
+        for (auto& vertex : vertices)
+        {
+            vertex = {
+                .Position = glm::vec3(unit(engine) * 50.0f, unit(engine) * 5.0f, unit(engine) * 20.0f),
+                .UVx = unit(engine) * 4.0f,
+                .Normal = direction(),
+                .UVy = unit(engine),
+                .Tangent = glm::vec4(direction(), unit(engine) < 0.0f ? -1.0f : 1.0f),
+            };
+        }
+        return vertices;
+    }
+}
+
+int main()
+{
+    const auto vertices = GenerateVertices(4'000'000);
+    const auto quantization = FS::ComputeVertexQuantization(vertices);
+    FS::Vec<FS::PackedVertex> packed(vertices.size());
+
+    const auto report_throughput = [&](const std::string_view name, const FS::Benchmark::Result& result)
+    {
+        FS::Benchmark::Report(name, result);
+        std::print("{:<40} {:>10.1f} MVertices/s\n", "", vertices.size() / 1'000'000.0 / (result.MinMs / 1000.0));
+    };
+    report_throughput("pack scalar", FS::Benchmark::Measure(5, [&]
+    {
+        for (u64 i = 0; i < vertices.size(); ++i)
+        {
+            packed[i] = FS::PackVertex(vertices[i], quantization);
+        }
+        FS::Benchmark::DoNotOptimize(packed);
+    }));
+    report_throughput("pack SIMD", FS::Benchmark::Measure(5, [&]
+    {
+        FS::PackVertices(vertices, quantization, packed);
+        FS::Benchmark::DoNotOptimize(packed);
+    }));
+
+    const auto error = FS::MeasurePackingError(vertices, packed, quantization);
+    std::print("{} bytes per vertex instead of {}\n", sizeof(FS::PackedVertex), sizeof(FS::Vertex));
+    std::print("max error position {:.6f}, normal {:.4f} deg, tangent {:.4f} deg, UV {:.6f}, handedness {}\n",
+               error.MaxPositionError, error.MaxNormalAngle, error.MaxTangentAngle, error.MaxUVError,
+               error.HandednessMismatches);
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+namespace FS
+{
+    class JobSystem;
+    struct JobCounter;
+
+    /// <summary>
+    /// One source file and the cooked files made from it. Inputs are read by the cook besides the source,
+    /// Dependencies are the items cooking an input, they always finish first.
+    /// </summary>
+    struct CookItem
+    {
+        std::string Source;
+        Vec<std::string> Outputs;
+        Vec<std::string> Inputs;
+        Vec<u32> Dependencies;
+        u32 Rule = 0;
+    };
+
+    /// <summary>
+    /// How a kind of source file is cooked. Outputs are named after the source with OutputExtensions
+    /// appended, or replacing the extension of a source that is itself a cooked file.
+    /// </summary>
+    struct CookRule
+    {
+        std::string Name;
+        /// Bump when the cooked output changes, every item of the rule is cooked again
+        u32 Version = 1;
+        Vec<std::string> SourceExtensions;
+        Vec<std::string> OutputExtensions;
+        /// Other files the cook reads, found without cooking
+        std::function<Vec<std::string>(std::string_view source)> ScanInputs;
+        std::function<bool(const CookItem& item)> Cook;
+    };
+
+    struct CookSettings
+    {
+        std::string SourceDirectory;
+        std::string OutputDirectory;
+        /// Written as JSON when set
+        std::string ReportPath;
+        /// Cook everything, even items that are up to date
+        bool Force = false;
+    };
+
+    struct CookReportAsset
+    {
+        std::string Source;
+        std::string Rule;
+        /// Cooked, UpToDate or Failed
+        std::string Status;
+        f64 Milliseconds = 0.0;
+    };
+
+    struct CookReport
+    {
+        u32 CookedCount = 0;
+        u32 UpToDateCount = 0;
+        u32 FailedCount = 0;
+        f64 Milliseconds = 0.0;
+        Vec<CookReportAsset> Assets;
+    };
+
+    /// <summary>
+    /// Incremental cook of a source directory. Every source file with a matching rule becomes an item,
+    /// cooked files matching a rule become items depending on the item that cooks them. Items run on the job
+    /// system as soon as their dependencies are done.
+    /// An item is skipped when its outputs exist and the hash of its rule, source and inputs matches the one
+    /// stored in the cook database of the output directory. Files are only read again when their size or
+    /// write time changed, so a cook costs time in proportion to what changed.
+    /// </summary>
+    class AssetCooker
+    {
+    public:
+        explicit AssetCooker(JobSystem& jobs);
+        ~AssetCooker();
+        AssetCooker(const AssetCooker&) = delete;
+        AssetCooker& operator=(const AssetCooker&) = delete;
+
+        void AddRule(CookRule rule);
+
+        /// <summary>
+        /// Textures to BC7 (BC5 for normal maps, BC6H for HDR), meshes to packed and compressed cooked
+        /// meshes and cooked meshes to meshlets.
+        /// </summary>
+        void AddDefaultRules();
+
+        [[nodiscard]] CookReport Cook(const CookSettings& settings);
+
+        /// <summary>
+        /// Items of the last cook, in the order their dependencies allow.
+        /// </summary>
+        [[nodiscard]] Span<const CookItem> GetItems() const { return m_items; }
+
+    private:
+        struct FileRecord
+        {
+            u64 Size = 0;
+            u64 WriteTime = 0;
+            u64 Hash = 0;
+        };
+
+        struct ItemResult
+        {
+            std::string Status;
+            f64 Milliseconds = 0.0;
+            u64 Key = 0;
+            /// Files whose record changed, merged into the database after the cook
+            Vec<std::pair<std::string, FileRecord>> HashedFiles;
+        };
+
+        struct Importers;
+
+        void ScanItems(const CookSettings& settings);
+        void AddItem(const std::filesystem::path& source, Opt<u32> producer);
+        void RunItem(u32 index, const CookSettings& settings, JobCounter& counter);
+        [[nodiscard]] Opt<u64> HashFile(const std::string& path, ItemResult& result) const;
+        void LoadDatabase(std::string_view path);
+        [[nodiscard]] bool SaveDatabase(std::string_view path) const;
+
+        JobSystem& m_jobs;
+        Scoped<Importers> m_importers;
+        Vec<CookRule> m_rules;
+        std::filesystem::path m_source_root;
+        std::filesystem::path m_output_root;
+        Vec<CookItem> m_items;
+        Vec<ItemResult> m_results;
+        Vec<std::atomic<u32>> m_pending;
+        Vec<Vec<u32>> m_dependents;
+        std::unordered_map<std::string, FileRecord> m_files;
+        std::unordered_map<std::string, u64> m_keys;
+    };
+} // namespace FS
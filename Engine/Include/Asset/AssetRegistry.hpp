@@ -0,0 +1,114 @@
+#pragma once
+#include "Core/MappedFile.hpp"
+#include "Tools/Tools.hpp"
+
+namespace FS
+{
+    enum class AssetType : u32
+    {
+        eUnknown,
+        eTexture,
+        eMesh,
+        eShader,
+        eMaterial,
+        eScene,
+    };
+
+    struct AssetMetadata
+    {
+        FS::Guid Guid;
+        u64 PathHash = 0;
+        AssetType Type = AssetType::eUnknown;
+        u64 Size = 0;
+        u64 CookedOffset = 0;
+        Vec<FS::Guid> Dependencies;
+    };
+
+    /// On disk layout of a registry entry, the mapped file is read in place so this must stay POD
+    struct AssetEntry
+    {
+        FS::Guid Guid;
+        u64 PathHash = 0;
+        u64 Size = 0;
+        u64 CookedOffset = 0;
+        u32 FirstDependency = 0;
+        u32 DependencyCount = 0;
+        AssetType Type = AssetType::eUnknown;
+        u32 Padding = 0;
+    };
+
+    struct AssetRegistryHeader
+    {
+        static constexpr u32 kMagic = 0x52415346; // FSAR
+        static constexpr u32 kVersion = 1;
+        u32 Magic = kMagic;
+        u32 Version = kVersion;
+        u64 EntryCount = 0;
+        u64 KeysOffset = 0;
+        u64 EntriesOffset = 0;
+        u64 DependencyCount = 0;
+        u64 DependenciesOffset = 0;
+        u64 Padding[2] = {};
+    };
+
+    /// <summary>
+    /// GUID to asset metadata lookup backed by a single memory mapped file.
+    /// The keys are stored in Eytzinger order so a lookup walks the implicit tree top down, and
+    /// the matching entry lives at the same index in a parallel array. Nothing is parsed on load.
+    /// Changes reported after loading are kept in a small overlay until Save rewrites the file.
+    /// </summary>
+    class AssetRegistry
+    {
+    public:
+        [[nodiscard]] bool Open(std::string_view path);
+        void Close();
+
+        /// <summary>
+        /// Find an asset by GUID. Returns nullptr if the asset is not registered.
+        /// The pointer is valid until the registry is modified, saved or closed.
+        /// </summary>
+        [[nodiscard]] const AssetEntry* Find(const Guid& guid) const;
+        [[nodiscard]] Span<const Guid> GetDependencies(const AssetEntry& entry) const;
+        [[nodiscard]] u64 Size() const;
+
+        /// <summary>
+        /// Add or replace an asset, used when the file watcher reports a new or changed source file.
+        /// </summary>
+        void Update(const AssetMetadata& metadata);
+        void Remove(const Guid& guid);
+        [[nodiscard]] bool HasPendingChanges() const { return !m_overlay.empty(); }
+
+        /// <summary>
+        /// Merge pending changes into the registry file and remap it.
+        /// </summary>
+        [[nodiscard]] bool Save();
+
+        /// <summary>
+        /// Build a registry file from scratch.
+        /// </summary>
+        [[nodiscard]] static bool Write(std::string_view path, Span<const AssetMetadata> assets);
+
+    private:
+        struct OverlayAsset
+        {
+            AssetEntry Entry;
+            Vec<Guid> Dependencies;
+            bool Removed = false;
+        };
+
+        [[nodiscard]] const AssetEntry* FindMapped(const Guid& guid) const;
+        [[nodiscard]] static bool Write(std::string_view path, const Vec<AssetEntry>& entries,
+                                        Span<const Guid> dependencies);
+
+        std::string m_path;
+        MappedFile m_file;
+        const Guid* m_keys = nullptr;
+        const AssetEntry* m_entries = nullptr;
+        const Guid* m_dependencies = nullptr;
+        u64 m_entry_count = 0;
+        u64 m_dependency_count = 0;
+        std::unordered_map<Guid, OverlayAsset> m_overlay;
+        u64 m_overlay_added = 0;
+        u64 m_overlay_removed = 0;
+    };
+} // namespace FS
@@ -0,0 +1,40 @@
+#pragma once
+#include "Asset/Image.hpp"
+
+namespace FS
+{
+    class JobSystem;
+
+    enum class CompressionQuality : u8
+    {
+        /// Endpoints from the extent of the block along its principal axis. BC7 only tries the best partition
+        /// estimate of each mode family
+        eFast,
+        /// Also tries every ordered clustering of the block and least squares refined endpoints. BC7 searches more
+        /// partitions, the three subset modes, rotations and P-bits, BC6H also tries the delta encoded mode
+        eQuality,
+    };
+
+    struct BlockCompressionSettings
+    {
+        CompressionQuality Quality = CompressionQuality::eQuality;
+        /// RGB holds a unit vector, BC5 stores the X and Y of the renormalised vector
+        bool NormalMap = false;
+    };
+
+    [[nodiscard]] bool IsBlockCompressionSupported(Format format);
+
+    /// <summary>
+    /// Uncompressed format the encoder for a block compressed format reads, RGBA32F for BC6H and RGBA8 otherwise.
+    /// Preparing levels in this format avoids a conversion per level.
+    /// </summary>
+    [[nodiscard]] Format GetBlockCompressionSourceFormat(Format format);
+
+    /// <summary>
+    /// Compress an image to a block compressed format. The source is converted to the source format first if
+    /// needed, and with a job system the block rows are compressed in parallel.
+    /// Returns an empty image if the format is not supported.
+    /// </summary>
+    [[nodiscard]] Image CompressImage(const Image& image, Format format, const BlockCompressionSettings& settings = {},
+                                      JobSystem* jobs = nullptr);
+} // namespace FS
@@ -0,0 +1,82 @@
+#pragma once
+#include "Asset/Mesh.hpp"
+
+namespace FS
+{
+    struct CookedMeshHeader
+    {
+        static constexpr u32 kMagic = 0x534D5346; // FSMS
+        static constexpr u32 kVersion = 2;
+        u32 Magic = kMagic;
+        u32 Version = kVersion;
+        u32 VertexCount = 0;
+        u32 IndexCount = 0;
+        FS::VertexFormat VertexFormat = FS::VertexFormat::eFull;
+        u32 VertexStride = 0;
+        u32 SubmeshCount = 0;
+        u32 NamesSize = 0;
+        /// Only used by packed vertices
+        VertexQuantization Quantization;
+        u64 SubmeshesOffset = 0;
+        u64 NamesOffset = 0;
+        u64 VertexDataOffset = 0;
+        u64 VertexDataSize = 0;
+        u64 IndexDataOffset = 0;
+        u64 IndexDataSize = 0;
+        u64 FileSize = 0;
+    };
+
+    /// <summary>
+    /// Submesh with its material name stored in the name table of the file.
+    /// </summary>
+    struct CookedSubmesh
+    {
+        u32 FirstIndex = 0;
+        u32 IndexCount = 0;
+        u32 NameOffset = 0;
+        u32 NameSize = 0;
+    };
+
+    /// <summary>
+    /// Cooked mesh with its vertex and index buffers compressed by the mesh codec. Meshes should go through
+    /// OptimizeMesh first, the codec relies on the vertex cache and fetch order for most of its gains.
+    /// </summary>
+    struct CookedMesh
+    {
+        CookedMeshHeader Header;
+        Vec<CookedSubmesh> Submeshes;
+        Vec<char> Names;
+        Vec<u8> VertexData;
+        Vec<u8> IndexData;
+
+        [[nodiscard]] static CookedMesh Create(const Mesh& mesh, VertexFormat format);
+
+        [[nodiscard]] bool Write(std::string_view path) const;
+    };
+
+    /// <summary>
+    /// Non owning view of a cooked mesh, typically pointing into a mapped file. Buffers are decoded straight
+    /// into their destination, which may be a mapped upload buffer. Vertices are predicted from the triangles,
+    /// so the indices are decoded first into memory DecodeVertices can read.
+    /// </summary>
+    struct CookedMeshView
+    {
+        const CookedMeshHeader* Header = nullptr;
+        Span<const CookedSubmesh> Submeshes;
+        Span<const char> Names;
+        Span<const u8> VertexData;
+        Span<const u8> IndexData;
+
+        [[nodiscard]] static Opt<CookedMeshView> FromMemory(Span<const char> memory);
+
+        [[nodiscard]] u64 GetVertexBufferSize() const
+        {
+            return static_cast<u64>(Header->VertexCount) * Header->VertexStride;
+        }
+        [[nodiscard]] u64 GetIndexBufferSize() const { return static_cast<u64>(Header->IndexCount) * sizeof(u32); }
+        [[nodiscard]] std::string_view GetMaterial(const CookedSubmesh& submesh) const;
+
+        [[nodiscard]] bool DecodeVertices(Span<u8> vertices, Span<const u32> indices) const;
+        [[nodiscard]] bool DecodeIndices(Span<u32> indices) const;
+    };
+} // namespace FS
@@ -0,0 +1,55 @@
+#pragma once
+#include "Asset/Meshlet.hpp"
+
+namespace FS
+{
+    struct CookedMeshletsHeader
+    {
+        static constexpr u32 kMagic = 0x4C4D5346; // FSML
+        static constexpr u32 kVersion = 1;
+        /// Every table starts aligned to this, so it can be bound as a structured buffer straight from the file
+        static constexpr u32 kTableAlignment = 16;
+        u32 Magic = kMagic;
+        u32 Version = kVersion;
+        u32 MeshletCount = 0;
+        u32 VertexIndexCount = 0;
+        u32 TriangleCount = 0;
+        u32 RangeCount = 0;
+        /// Vertex count of the mesh the meshlets were built for
+        u32 VertexCount = 0;
+        u32 Padding = 0;
+        u64 MeshletsOffset = 0;
+        u64 BoundsOffset = 0;
+        u64 VertexIndicesOffset = 0;
+        u64 TrianglesOffset = 0;
+        u64 RangesOffset = 0;
+        u64 FileSize = 0;
+    };
+
+    /// <summary>
+    /// Cooked meshlets, stored next to the vertex buffer of their mesh. Meshlets, bounds, vertex indices and
+    /// triangles are each one table ready to be uploaded as a GPU buffer.
+    /// </summary>
+    struct CookedMeshlets
+    {
+        MeshletMesh Meshlets;
+        u32 VertexCount = 0;
+
+        [[nodiscard]] bool Write(std::string_view path) const;
+    };
+
+    /// <summary>
+    /// Non owning view of cooked meshlets, typically pointing into a mapped file.
+    /// </summary>
+    struct CookedMeshletsView
+    {
+        const CookedMeshletsHeader* Header = nullptr;
+        Span<const Meshlet> Meshlets;
+        Span<const MeshletBounds> Bounds;
+        Span<const u32> VertexIndices;
+        Span<const u32> Triangles;
+        Span<const MeshletRange> Ranges;
+
+        [[nodiscard]] static Opt<CookedMeshletsView> FromMemory(Span<const char> memory);
+    };
+} // namespace FS
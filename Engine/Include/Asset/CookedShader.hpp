@@ -0,0 +1,83 @@
+#pragma once
+
+namespace FS
+{
+    struct CookedShaderHeader
+    {
+        static constexpr u32 kMagic = 0x48535346; // FSSH
+        static constexpr u32 kVersion = 1;
+        u32 Magic = kMagic;
+        u32 Version = kVersion;
+        u32 FeatureCount = 0;
+        u32 VariantCount = 0;
+        u32 NamesSize = 0;
+        u64 FeaturesOffset = 0;
+        u64 NamesOffset = 0;
+        /// 2^FeatureCount variant indices, one per permutation key
+        u64 TableOffset = 0;
+        u64 VariantsOffset = 0;
+        u64 BytecodeOffset = 0;
+        u64 BytecodeSize = 0;
+        u64 FileSize = 0;
+    };
+
+    /// <summary>
+    /// Feature with its name stored in the name table of the file.
+    /// </summary>
+    struct CookedShaderFeature
+    {
+        u32 NameOffset = 0;
+        u32 NameSize = 0;
+    };
+
+    struct CookedShaderVariant
+    {
+        u64 BytecodeOffset = 0;
+        u64 BytecodeSize = 0;
+    };
+
+    /// Table entry of a permutation that was stripped by the cook
+    inline constexpr u16 kStrippedPermutation = 0xFFFF;
+
+    /// <summary>
+    /// Cooked shader with the bytecode of every permutation the engine uses, looked up by permutation key in a
+    /// dense table. Permutations compiling to the same bytecode share their variant.
+    /// </summary>
+    struct CookedShader
+    {
+        CookedShaderHeader Header;
+        Vec<CookedShaderFeature> Features;
+        Vec<char> Names;
+        Vec<u16> Table;
+        Vec<CookedShaderVariant> Variants;
+        Vec<char> Bytecode;
+
+        [[nodiscard]] static CookedShader Create(Span<const std::string> features);
+
+        void AddPermutation(u32 key, Span<const char> bytecode);
+
+        [[nodiscard]] bool Write(std::string_view path) const;
+    };
+
+    /// <summary>
+    /// Non owning view of a cooked shader, typically pointing into a mapped file.
+    /// </summary>
+    struct CookedShaderView
+    {
+        const CookedShaderHeader* Header = nullptr;
+        Span<const CookedShaderFeature> Features;
+        Span<const char> Names;
+        Span<const u16> Table;
+        Span<const CookedShaderVariant> Variants;
+        Span<const char> Bytecode;
+
+        [[nodiscard]] static Opt<CookedShaderView> FromMemory(Span<const char> memory);
+
+        [[nodiscard]] std::string_view GetFeature(const CookedShaderFeature& feature) const;
+
+        /// <summary>
+        /// Bytecode of a permutation, empty when it was stripped.
+        /// </summary>
+        [[nodiscard]] Span<const char> GetPermutation(u32 key) const;
+    };
+} // namespace FS
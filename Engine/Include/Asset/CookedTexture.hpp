@@ -0,0 +1,61 @@
+#pragma once
+#include "Asset/Image.hpp"
+#include "Render/RenderStructs.hpp"
+
+namespace FS
+{
+    struct CookedTextureHeader
+    {
+        static constexpr u32 kMagic = 0x58545346; // FSTX
+        static constexpr u32 kVersion = 2;
+        u32 Magic = kMagic;
+        u32 Version = kVersion;
+        u32 Width = 0;
+        u32 Height = 0;
+        u16 Depth = 1;
+        u16 MipLevels = 1;
+        FS::Format Format = FS::Format::eUnknown;
+        u8 Padding = 0;
+        u16 SubresourceCount = 0;
+        u64 DataOffset = 0;
+        u64 DataSize = 0;
+    };
+
+    /// <summary>
+    /// Cooked texture ready for upload. Every subresource is laid out with the row pitch and placement
+    /// alignment the GPU copy wants, so the data can be copied into an upload buffer as is.
+    /// The subresource table starts at mip 0 but the data stores the smallest mip first.
+    /// </summary>
+    struct CookedTexture
+    {
+        CookedTextureHeader Header;
+        Vec<TextureSubresource> Subresources;
+        Vec<u8> Data;
+
+        /// <summary>
+        /// Pack a mip chain, level 0 first. Every level must have the same format.
+        /// </summary>
+        [[nodiscard]] static CookedTexture Create(Span<const Image* const> mips);
+
+        [[nodiscard]] bool Write(std::string_view path) const;
+        [[nodiscard]] TextureCreateInfo GetCreateInfo() const;
+    };
+
+    /// <summary>
+    /// Non owning view of a cooked texture, typically pointing into a mapped file.
+    /// </summary>
+    struct CookedTextureView
+    {
+        const CookedTextureHeader* Header = nullptr;
+        Span<const TextureSubresource> Subresources;
+        Span<const u8> Data;
+
+        [[nodiscard]] static Opt<CookedTextureView> FromMemory(Span<const char> memory);
+        [[nodiscard]] TextureCreateInfo GetCreateInfo() const;
+    };
+
+    /// <summary>
+    /// Bytes from the start of the data to the end of a mip, which covers the mip and every smaller one.
+    /// </summary>
+    [[nodiscard]] u64 GetMipTailSize(Span<const TextureSubresource> subresources, u16 mip);
+} // namespace FS
@@ -0,0 +1,41 @@
+#pragma once
+#include "Render/FormatInfo.hpp"
+
+namespace FS
+{
+    /// <summary>
+    /// Uncompressed CPU side image with tightly packed rows.
+    /// </summary>
+    struct Image
+    {
+        u32 Width = 0;
+        u32 Height = 0;
+        FS::Format Format = FS::Format::eUnknown;
+        Vec<u8> Pixels;
+
+        [[nodiscard]] static Image Create(u32 width, u32 height, FS::Format format);
+
+        [[nodiscard]] u32 RowPitch() const { return GetRowPitch(Format, Width); }
+        [[nodiscard]] u32 PixelSize() const { return GetFormatInfo(Format).BytesPerBlock; }
+        [[nodiscard]] u8* Row(const u32 y) { return Pixels.data() + static_cast<u64>(y) * RowPitch(); }
+        [[nodiscard]] const u8* Row(const u32 y) const { return Pixels.data() + static_cast<u64>(y) * RowPitch(); }
+        [[nodiscard]] bool IsEmpty() const { return Pixels.empty(); }
+    };
+
+    /// <summary>
+    /// Whether LoadPixel and StorePixel can convert the format.
+    /// </summary>
+    [[nodiscard]] bool IsPixelFormatSupported(Format format);
+
+    /// <summary>
+    /// Read a pixel as linear RGBA. sRGB formats are returned as stored, without decoding the gamma.
+    /// Missing channels read as 0 and alpha as 1.
+    /// </summary>
+    [[nodiscard]] glm::vec4 LoadPixel(Format format, const u8* pixel);
+    void StorePixel(Format format, u8* pixel, const glm::vec4& value);
+
+    /// <summary>
+    /// Convert an image to another uncompressed format. Returns an empty image if either format is unsupported.
+    /// </summary>
+    [[nodiscard]] Image ConvertImage(const Image& image, Format format);
+} // namespace FS
@@ -0,0 +1,41 @@
+#pragma once
+#include "Render/RenderStructs.hpp"
+
+namespace FS
+{
+    /// <summary>
+    /// Range of the index buffer drawn with one material.
+    /// </summary>
+    struct Submesh
+    {
+        u32 FirstIndex = 0;
+        u32 IndexCount = 0;
+        std::string Material;
+    };
+
+    /// <summary>
+    /// Indexed triangle list in the vertex layout the shaders read.
+    /// </summary>
+    struct Mesh
+    {
+        Vec<Vertex> Vertices;
+        Vec<u32> Indices;
+        Vec<Submesh> Submeshes;
+
+        [[nodiscard]] u64 TriangleCount() const { return Indices.size() / 3; }
+        [[nodiscard]] bool IsEmpty() const { return Indices.empty(); }
+    };
+
+    /// <summary>
+    /// Smooth normals for every vertex whose normal is zero, weighted by triangle area. Vertices at the same
+    /// position share the normal, so UV seams don't show up in the shading.
+    /// </summary>
+    void GenerateNormals(Mesh& mesh);
+
+    /// <summary>
+    /// Tangents for every vertex whose tangent is zero, following MikkTSpace: per triangle tangents from the
+    /// UV derivatives are weighted by the corner angle, orthogonalized against the normal and the handedness
+    /// of the bitangent is stored in w.
+    /// </summary>
+    void GenerateTangents(Mesh& mesh);
+} // namespace FS
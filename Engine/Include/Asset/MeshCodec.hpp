@@ -0,0 +1,47 @@
+#pragma once
+#include "Render/RenderStructs.hpp"
+
+namespace FS
+{
+    /// Vertex strides the vertex codec accepts must be a multiple of 4 up to this
+    inline constexpr u32 kVertexCodecMaxStride = 256;
+
+    /// <summary>
+    /// Encode a triangle list with an edge and a vertex FIFO. A triangle sharing an edge with one of the last
+    /// triangles costs a single byte when its third vertex is new or recently used, so an index buffer that went
+    /// through OptimizeVertexCache and OptimizeVertexFetch shrinks to about one byte per triangle. The winding
+    /// is kept but the first vertex of a triangle may change.
+    /// </summary>
+    [[nodiscard]] Vec<u8> EncodeIndexBuffer(Span<const u32> indices);
+
+    /// <summary>
+    /// Decode into the indices, whose size must match the encoded index count. The indices are written in
+    /// order and never read back, so they may point into a mapped upload buffer.
+    /// </summary>
+    [[nodiscard]] bool DecodeIndexBuffer(Span<const u8> encoded, Span<u32> indices);
+
+    /// <summary>
+    /// Encode vertices in blocks. A vertex is predicted from its triangles in indices, as the parallelogram
+    /// with the triangle across an edge whose vertices come earlier, or from the previous vertex without
+    /// indices. Every 4 byte channel picks per block whether it is predicted per byte, per 16 bit lane, as
+    /// 32 bits or by XOR, and every byte of what is left is a plane split in groups of 16 that are stored
+    /// with 0, 2, 4 or 8 bits per value, larger values are escaped. Works best on quantized vertices in the
+    /// order OptimizeVertexFetch leaves them in.
+    /// </summary>
+    [[nodiscard]] Vec<u8> EncodeVertexBuffer(Span<const u8> vertices, u32 stride, Span<const u32> indices = {});
+
+    template <typename T>
+    [[nodiscard]] Vec<u8> EncodeVertexBuffer(const Span<const T> vertices, const Span<const u32> indices = {})
+    {
+        return EncodeVertexBuffer(Span<const u8>(reinterpret_cast<const u8*>(vertices.data()), vertices.size_bytes()),
+                                  sizeof(T), indices);
+    }
+
+    /// <summary>
+    /// Decode into the vertices, whose size must be the encoded vertex count times the stride, with the indices
+    /// they were encoded with. Vertices are decoded into a scratch buffer the predictions read from and copied
+    /// out in order, so the vertices may point into a mapped upload buffer but the indices can't.
+    /// </summary>
+    [[nodiscard]] bool DecodeVertexBuffer(Span<const u8> encoded, u32 stride, Span<u8> vertices,
+                                          Span<const u32> indices = {});
+} // namespace FS
@@ -0,0 +1,36 @@
+#pragma once
+#include "Asset/Mesh.hpp"
+
+namespace FS
+{
+    class JobSystem;
+
+    struct MeshImportSettings
+    {
+        /// Generate smooth normals for vertices the source has none for
+        bool GenerateNormals = true;
+        /// Generate tangents for vertices the source has none for
+        bool GenerateTangents = true;
+    };
+
+    /// <summary>
+    /// Imports OBJ and glTF 2.0 (.gltf with .bin or embedded buffers, and .glb) files into a single mesh.
+    /// Large OBJ files are split on line boundaries and parsed on the job system. glTF buffers are memory
+    /// mapped and read in place, the node hierarchy of the default scene is flattened into the vertices.
+    /// </summary>
+    class MeshImporter
+    {
+    public:
+        explicit MeshImporter(JobSystem& jobs);
+
+        [[nodiscard]] Opt<Mesh> Import(std::string_view path, const MeshImportSettings& settings = {});
+
+        /// <summary>
+        /// Files an import reads besides the source itself, the buffers of a glTF file.
+        /// </summary>
+        [[nodiscard]] static Vec<std::string> GetInputs(std::string_view path);
+
+    private:
+        JobSystem& m_jobs;
+    };
+} // namespace FS
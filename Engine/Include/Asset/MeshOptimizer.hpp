@@ -0,0 +1,64 @@
+#pragma once
+#include "Asset/Mesh.hpp"
+
+namespace FS
+{
+    /// FIFO post-transform cache size the statistics assume, close to what current GPUs behave like
+    constexpr u32 kVertexCacheSize = 16;
+
+    struct VertexCacheStatistics
+    {
+        /// Average cache misses per triangle, between 0.5 for a regular grid and 3
+        f32 ACMR = 0.0f;
+        /// Average transforms per vertex, 1 when every vertex is transformed only once
+        f32 ATVR = 0.0f;
+        u32 VerticesTransformed = 0;
+    };
+
+    struct VertexFetchStatistics
+    {
+        /// Bytes read from the vertex buffer in 64 byte cache lines, relative to the size of the buffer
+        f32 Overfetch = 0.0f;
+        u64 BytesFetched = 0;
+    };
+
+    struct MeshOptimizationSettings
+    {
+        bool OptimizeOverdraw = true;
+        /// How much the overdraw pass may increase the ACMR, 1.05 allows 5%
+        f32 OverdrawThreshold = 1.05f;
+    };
+
+    /// <summary>
+    /// Merge bitwise identical vertices and remap the indices. Returns the number of vertices removed.
+    /// </summary>
+    u32 DeduplicateVertices(Mesh& mesh);
+
+    /// <summary>
+    /// Reorder triangles for the post-transform cache with Tom Forsyth's linear speed algorithm, which scores
+    /// vertices by their position in a simulated LRU cache and by how many triangles still use them.
+    /// </summary>
+    void OptimizeVertexCache(Span<u32> indices, u32 vertex_count);
+
+    /// <summary>
+    /// Split cache optimized triangles into clusters that each keep the ACMR within the threshold even from a
+    /// cold cache, then draw the clusters facing away from the mesh center first, after Sander et al. 2007.
+    /// </summary>
+    void OptimizeOverdraw(Span<u32> indices, Span<const Vertex> vertices, f32 threshold);
+
+    /// <summary>
+    /// Reorder the vertices in the order the indices first use them, so the vertex shader reads the buffer
+    /// mostly sequentially. Unused vertices are removed.
+    /// </summary>
+    void OptimizeVertexFetch(Mesh& mesh);
+
+    /// <summary>
+    /// Run every pass, the triangle reordering stays within each submesh.
+    /// </summary>
+    void OptimizeMesh(Mesh& mesh, const MeshOptimizationSettings& settings = {});
+
+    [[nodiscard]] VertexCacheStatistics AnalyzeVertexCache(Span<const u32> indices, u32 vertex_count,
+                                                           u32 cache_size = kVertexCacheSize);
+    [[nodiscard]] VertexFetchStatistics AnalyzeVertexFetch(Span<const u32> indices, u32 vertex_count,
+                                                           u32 vertex_size);
+} // namespace FS
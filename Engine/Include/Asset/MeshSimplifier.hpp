@@ -0,0 +1,91 @@
+#pragma once
+#include "Asset/Mesh.hpp"
+
+namespace FS
+{
+    class JobSystem;
+
+    struct SimplifySettings
+    {
+        /// Fraction of the triangles to keep
+        f32 TargetRatio = 0.5f;
+        /// Largest collapse error allowed relative to the extent of the vertices the indices reference, whichever
+        /// target is hit first stops
+        f32 TargetError = std::numeric_limits<f32>::max();
+        /// Weights of the squared UV and normal differences against the squared relative position error
+        f32 UVWeight = 1.0f;
+        f32 NormalWeight = 0.5f;
+        /// Keep open borders in place, otherwise border vertices only collapse along the border
+        bool LockBorders = false;
+    };
+
+    struct SimplifyResult
+    {
+        Vec<u32> Indices;
+        /// Largest collapse error relative to the extent of the vertices the indices reference
+        f32 Error = 0.0f;
+    };
+
+    /// <summary>
+    /// Simplify with edge collapses ordered by quadric error, after Garland and Heckbert 1997. Vertices only
+    /// collapse onto existing neighbors, so the result indexes the same vertex buffer. The error adds the UV
+    /// and normal change of the collapsed vertex, vertices on UV or normal seams are locked and collapses that
+    /// flip a triangle are rejected. Only the range of vertices the indices reference is processed.
+    /// </summary>
+    [[nodiscard]] SimplifyResult SimplifyMesh(Span<const Vertex> vertices, Span<const u32> indices,
+                                              const SimplifySettings& settings);
+
+    struct LodSettings
+    {
+        u32 MaxLods = 6;
+        /// Triangles kept by every LOD relative to the previous one
+        f32 Ratio = 0.5f;
+        /// No LOD goes past this relative error
+        f32 MaxError = 0.05f;
+        /// LODs stop once they would have fewer triangles
+        u32 MinTriangles = 64;
+        f32 UVWeight = 1.0f;
+        f32 NormalWeight = 0.5f;
+        bool LockBorders = false;
+    };
+
+    struct MeshLod
+    {
+        /// Ranges in LodChain::Indices, one per submesh of the mesh or a single one without submeshes
+        Vec<Submesh> Submeshes;
+        /// Geometric error in mesh units, grows with every LOD
+        f32 Error = 0.0f;
+    };
+
+    /// <summary>
+    /// LOD index buffers sharing the vertex buffer of their mesh, LOD 0 is the original mesh.
+    /// </summary>
+    struct LodChain
+    {
+        Vec<u32> Indices;
+        Vec<MeshLod> Lods;
+    };
+
+    /// <summary>
+    /// Simplify every submesh on its own, each LOD from the previous one. A submesh only processes the range of
+    /// vertices it references, so meshes whose submeshes own contiguous vertex ranges scale with the submesh.
+    /// </summary>
+    [[nodiscard]] LodChain GenerateLods(const Mesh& mesh, const LodSettings& settings = {});
+
+    /// <summary>
+    /// Generate the LODs of several meshes in parallel, one job per mesh.
+    /// </summary>
+    [[nodiscard]] Vec<LodChain> GenerateLods(Span<const Mesh> meshes, JobSystem& jobs,
+                                             const LodSettings& settings = {});
+
+    /// <summary>
+    /// Scale turning an error at distance 1 into pixels, viewport_height / (2 * tan(fov_y / 2)).
+    /// </summary>
+    [[nodiscard]] f32 GetLodProjectionScale(f32 fov_y, f32 viewport_height);
+
+    /// <summary>
+    /// Coarsest LOD whose error projects to at most max_pixel_error pixels at the distance.
+    /// </summary>
+    [[nodiscard]] u32 SelectLod(Span<const MeshLod> lods, f32 distance, f32 projection_scale,
+                                f32 max_pixel_error = 1.0f);
+} // namespace FS
@@ -0,0 +1,81 @@
+#pragma once
+#include "Asset/Mesh.hpp"
+
+namespace FS
+{
+    /// Limits of one meshlet, 124 triangles keep the packed triangle list of a meshlet under 512 bytes
+    constexpr u32 kMeshletMaxVertices = 64;
+    constexpr u32 kMeshletMaxTriangles = 124;
+
+    /// <summary>
+    /// Ranges of one meshlet in the shared vertex index and triangle lists.
+    /// </summary>
+    struct Meshlet
+    {
+        u32 VertexOffset = 0;
+        u32 TriangleOffset = 0;
+        u32 VertexCount = 0;
+        u32 TriangleCount = 0;
+    };
+
+    /// <summary>
+    /// Culling data of one meshlet in mesh space, laid out as two float4 for the GPU.
+    /// The cone test is the conservative one around the bounding sphere, so no separate apex is stored.
+    /// </summary>
+    struct MeshletBounds
+    {
+        glm::vec3 Center{};
+        f32 Radius = 0.0f;
+        /// Average normal of the triangles
+        glm::vec3 ConeAxis{};
+        /// Sine of the cone half angle, 1 when the triangles face too many directions to cull
+        f32 ConeCutoff = 1.0f;
+    };
+
+    /// <summary>
+    /// Meshlets of one submesh.
+    /// </summary>
+    struct MeshletRange
+    {
+        u32 FirstMeshlet = 0;
+        u32 MeshletCount = 0;
+    };
+
+    /// <summary>
+    /// Meshlets referencing the vertex buffer of a mesh. Every meshlet lists the vertex buffer indices it uses
+    /// in VertexIndices, and its triangles in Triangles as three 8 bit indices into that list packed in a u32.
+    /// </summary>
+    struct MeshletMesh
+    {
+        Vec<Meshlet> Meshlets;
+        Vec<MeshletBounds> Bounds;
+        Vec<u32> VertexIndices;
+        Vec<u32> Triangles;
+        /// One per submesh, or a single range when the mesh has no submeshes
+        Vec<MeshletRange> Ranges;
+    };
+
+    [[nodiscard]] constexpr u32 PackMeshletTriangle(const u32 a, const u32 b, const u32 c)
+    {
+        return a | b << 8 | c << 16;
+    }
+
+    [[nodiscard]] constexpr Array<u32, 3> UnpackMeshletTriangle(const u32 triangle)
+    {
+        return {triangle & 0xFF, triangle >> 8 & 0xFF, triangle >> 16 & 0xFF};
+    }
+
+    /// <summary>
+    /// Split a mesh into meshlets without crossing submeshes. Triangles are added greedily to the current
+    /// meshlet, preferring ones that reuse its vertices and then ones close to its center, so the meshlets
+    /// stay compact and their bounds tight. The triangles of every meshlet are then reordered for the vertex
+    /// cache and its vertices put in the order they are first used.
+    /// Best run on a mesh already through OptimizeMesh, whose triangle order the builder falls back to.
+    /// </summary>
+    [[nodiscard]] MeshletMesh BuildMeshlets(const Mesh& mesh);
+
+    /// <summary>
+    /// Bounding sphere and normal cone of a list of triangles, indices into the vertices.
+    /// </summary>
+    [[nodiscard]] MeshletBounds ComputeMeshletBounds(Span<const Vertex> vertices, Span<const u32> indices);
+} // namespace FS
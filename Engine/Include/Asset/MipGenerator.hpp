@@ -0,0 +1,33 @@
+#pragma once
+#include "Asset/Image.hpp"
+
+namespace FS
+{
+    class JobSystem;
+
+    enum class MipFilter : u8
+    {
+        eBox,
+        eKaiser,
+        eLanczos,
+    };
+
+    struct MipGenerationSettings
+    {
+        MipFilter Filter = MipFilter::eKaiser;
+        /// Treat RGB as a unit vector, renormalised after every level
+        bool NormalMap = false;
+        /// Scale alpha so every level passes the alpha test at AlphaReference as often as the base level
+        bool PreserveAlphaCoverage = false;
+        f32 AlphaReference = 0.5f;
+    };
+
+    /// <summary>
+    /// Build the mip chain below an image. Returns every level after the base one.
+    /// Filtering happens on linear floats, sRGB formats are decoded first and encoded again on store.
+    /// With a job system the rows of each level are filtered in parallel, and a level is converted back
+    /// to the image format while the next one is being filtered.
+    /// </summary>
+    [[nodiscard]] Vec<Image> GenerateMips(const Image& base, const MipGenerationSettings& settings = {},
+                                          JobSystem* jobs = nullptr);
+} // namespace FS
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "Asset/ShaderCompiler.hpp"
+#include "Render/ShaderPermutation.hpp"
+
+namespace FS
+{
+    class JobSystem;
+
+    struct ShaderBuildSettings
+    {
+        /// Keys of the built shaders, read before and written after the build
+        std::string CachePath;
+        /// Shader library of all cooked shaders, written by Cook when set
+        std::string LibraryPath;
+        /// Compile everything, even shaders that are up to date
+        bool Force = false;
+    };
+
+    /// <summary>
+    /// Shader source cooked to a table of its permutations.
+    /// </summary>
+    struct ShaderSource
+    {
+        std::string Path;
+        std::string OutputPath;
+        std::string Profile;
+        /// Declared with "// Feature: NAME" lines, in key bit order
+        Vec<std::string> Features;
+        /// Permutations the engine uses, the others are stripped
+        Vec<u32> Keys;
+    };
+
+    struct ShaderBuildReportShader
+    {
+        std::string Output;
+        /// Compiled, UpToDate or Failed
+        std::string Status;
+        f64 Milliseconds = 0.0;
+    };
+
+    struct ShaderBuildReport
+    {
+        u32 CompiledCount = 0;
+        u32 UpToDateCount = 0;
+        u32 FailedCount = 0;
+        f64 Milliseconds = 0.0;
+        Vec<ShaderBuildReportShader> Shaders;
+    };
+
+    /// <summary>
+    /// Incremental shader build. The key of a request hashes the compiler version, profile, entry point, defines,
+    /// include directories, source and every file it includes, a request is only compiled when its output is
+    /// missing or its key differs from the one in the cache. The remaining requests compile in parallel on the job
+    /// system, every permutation of a source is its own request with its own output.
+    /// </summary>
+    class ShaderBuilder
+    {
+    public:
+        ShaderBuilder(IShaderCompiler& compiler, JobSystem& jobs);
+
+        /// <summary>
+        /// Every .hlsl file of the source directory, cooked to its stem with .fsshader in the output directory.
+        /// Files without a stage suffix are skipped. Permutations of shaders in the usage list are limited to
+        /// the listed keys.
+        /// </summary>
+        [[nodiscard]] static Vec<ShaderSource> FindShaders(std::string_view source_directory,
+                                                           std::string_view output_directory,
+                                                           Span<const ShaderPermutationUsage> usage = {});
+
+        [[nodiscard]] ShaderBuildReport Build(Span<const ShaderCompileRequest> requests,
+                                              const ShaderBuildSettings& settings);
+
+        /// <summary>
+        /// Builds every permutation of the shaders into the Permutations folder next to their outputs, then
+        /// writes the tables of the shaders whose permutations changed and the library holding all of them.
+        /// </summary>
+        [[nodiscard]] ShaderBuildReport Cook(Span<const ShaderSource> shaders, const ShaderBuildSettings& settings);
+
+        /// <summary>
+        /// Packs the cooked tables of the shaders into a shader library, each named after its source stem.
+        /// </summary>
+        [[nodiscard]] static bool WriteLibrary(Span<const ShaderSource> shaders, std::string_view path);
+
+        /// <summary>
+        /// Files a request includes directly or through other includes. Quoted includes are looked up next to the
+        /// including file first, then in the include directories.
+        /// </summary>
+        [[nodiscard]] Vec<std::string> GetIncludes(const ShaderCompileRequest& request);
+
+    private:
+        struct SourceFile
+        {
+            bool Exists = false;
+            u64 Hash = 0;
+            /// Names as written in the #include directives, with whether they were quoted
+            Vec<std::pair<std::string, bool>> Includes;
+        };
+
+        [[nodiscard]] const SourceFile& ReadSource(const std::string& path);
+        [[nodiscard]] u64 GetKey(const ShaderCompileRequest& request);
+
+        IShaderCompiler& m_compiler;
+        JobSystem& m_jobs;
+        /// Sources read by the current build, each file is read once however many requests include it
+        std::unordered_map<std::string, SourceFile> m_sources;
+    };
+} // namespace FS
@@ -0,0 +1,55 @@
+#pragma once
+
+namespace FS
+{
+    struct ShaderCompileRequest
+    {
+        std::string SourcePath;
+        std::string OutputPath;
+        std::string EntryPoint = "main";
+        /// Target profile like vs_6_6
+        std::string Profile;
+        /// NAME or NAME=VALUE
+        Vec<std::string> Defines;
+        Vec<std::string> IncludeDirectories;
+    };
+
+    struct ShaderCompileResult
+    {
+        bool Success = false;
+        Vec<char> Bytecode;
+        /// Errors and warnings of the compiler
+        std::string Messages;
+    };
+
+    /// <summary>
+    /// Driver turning HLSL into bytecode, called from several threads at once.
+    /// </summary>
+    class IShaderCompiler
+    {
+    public:
+        virtual ~IShaderCompiler() = default;
+
+        /// <summary>
+        /// Identifies the compiler and its options, part of the cache key of every shader it compiles.
+        /// </summary>
+        [[nodiscard]] virtual std::string_view GetVersion() const = 0;
+        [[nodiscard]] virtual ShaderCompileResult Compile(const ShaderCompileRequest& request) = 0;
+    };
+
+    /// <summary>
+    /// Compiles in process with the DXC library, every call uses its own compiler instance.
+    /// </summary>
+    class DxcShaderCompiler final : public IShaderCompiler
+    {
+    public:
+        [[nodiscard]] std::string_view GetVersion() const override;
+        [[nodiscard]] ShaderCompileResult Compile(const ShaderCompileRequest& request) override;
+    };
+
+    /// <summary>
+    /// Shader model 6.6 profile of a shader whose file name ends with its stage (VS, PS, CS, MS or AS), like
+    /// GeomVS.hlsl. Empty for other names.
+    /// </summary>
+    [[nodiscard]] std::string GetShaderProfile(std::string_view path);
+} // namespace FS
@@ -0,0 +1,98 @@
+#pragma once
+
+namespace FS
+{
+    struct CookedShaderView;
+
+    struct ShaderLibraryHeader
+    {
+        static constexpr u32 kMagic = 0x4C535346; // FSSL
+        static constexpr u32 kVersion = 1;
+        u32 Magic = kMagic;
+        u32 Version = kVersion;
+        u32 ShaderCount = 0;
+        u32 PermutationCount = 0;
+        u32 BlobCount = 0;
+        u32 NamesSize = 0;
+        u64 ShadersOffset = 0;
+        u64 NamesOffset = 0;
+        u64 PermutationsOffset = 0;
+        u64 BlobsOffset = 0;
+        u64 BytecodeOffset = 0;
+        u64 BytecodeSize = 0;
+        u64 FileSize = 0;
+    };
+
+    /// <summary>
+    /// Shader of the library, the file keeps them sorted by name hash. Its 2^FeatureCount permutations are
+    /// blob indices starting at FirstPermutation.
+    /// </summary>
+    struct ShaderLibraryShader
+    {
+        u64 NameHash = 0;
+        u32 NameOffset = 0;
+        u32 NameSize = 0;
+        u32 FeatureCount = 0;
+        u32 FirstPermutation = 0;
+    };
+
+    /// <summary>
+    /// Bytecode shared by every permutation of every shader that compiled to it.
+    /// </summary>
+    struct ShaderLibraryBlob
+    {
+        u64 Hash = 0;
+        u64 BytecodeOffset = 0;
+        u64 BytecodeSize = 0;
+    };
+
+    /// Permutation of a library shader that was stripped by the cook
+    inline constexpr u32 kStrippedShaderBlob = std::numeric_limits<u32>::max();
+
+    /// <summary>
+    /// All cooked shaders of a build in one file, so loading them costs a single mapping. Bytecode is stored
+    /// once however many shaders and permutations share it.
+    /// </summary>
+    struct ShaderLibrary
+    {
+        ShaderLibraryHeader Header;
+        Vec<ShaderLibraryShader> Shaders;
+        Vec<char> Names;
+        Vec<u32> Permutations;
+        Vec<ShaderLibraryBlob> Blobs;
+        Vec<char> Bytecode;
+
+        void AddShader(std::string_view name, const CookedShaderView& shader);
+
+        [[nodiscard]] bool Write(std::string_view path) const;
+    };
+
+    /// <summary>
+    /// Non owning view of a shader library, typically pointing into a mapped file. Bytecode spans point
+    /// straight into the file.
+    /// </summary>
+    struct ShaderLibraryView
+    {
+        const ShaderLibraryHeader* Header = nullptr;
+        Span<const ShaderLibraryShader> Shaders;
+        Span<const char> Names;
+        Span<const u32> Permutations;
+        Span<const ShaderLibraryBlob> Blobs;
+        Span<const char> Bytecode;
+
+        [[nodiscard]] static Opt<ShaderLibraryView> FromMemory(Span<const char> memory);
+
+        [[nodiscard]] const ShaderLibraryShader* FindShader(std::string_view name) const;
+        [[nodiscard]] std::string_view GetName(const ShaderLibraryShader& shader) const;
+
+        /// <summary>
+        /// Bytecode of a permutation, empty when it was stripped.
+        /// </summary>
+        [[nodiscard]] Span<const char> GetPermutation(const ShaderLibraryShader& shader, u32 key) const;
+
+        /// <summary>
+        /// Content hash of the bytecode of a permutation, as HashContent computes it. 0 when it was stripped.
+        /// </summary>
+        [[nodiscard]] u64 GetPermutationHash(const ShaderLibraryShader& shader, u32 key) const;
+    };
+} // namespace FS
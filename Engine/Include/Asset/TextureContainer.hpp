@@ -0,0 +1,61 @@
+#pragma once
+#include "Core/MappedFile.hpp"
+#include "Render/FormatInfo.hpp"
+#include "Render/RenderStructs.hpp"
+
+namespace FS
+{
+    /// <summary>
+    /// Layout of a DDS or KTX2 texture. Subresource offsets are relative to the start of the file and keep the
+    /// tightly packed row pitch of the container, so the upload reads the payload in place.
+    /// </summary>
+    struct TextureContainerInfo
+    {
+        u32 Width = 0;
+        u32 Height = 0;
+        /// Array slices, six per cube map
+        u16 ArraySize = 1;
+        u16 MipLevels = 1;
+        FS::Format Format = FS::Format::eUnknown;
+        bool CubeMap = false;
+        /// Ordered like D3D12 subresources, every mip of the first slice comes first
+        Vec<TextureSubresource> Subresources;
+        /// Range of the file holding the subresources
+        u64 DataOffset = 0;
+        u64 DataSize = 0;
+    };
+
+    /// <summary>
+    /// Parse a DDS file, with or without the DX10 header. Volume textures aren't supported.
+    /// </summary>
+    [[nodiscard]] Opt<TextureContainerInfo> ParseDDS(Span<const char> memory);
+
+    /// <summary>
+    /// Parse a KTX2 file. Supercompressed and Basis Universal files need transcoding and aren't supported.
+    /// </summary>
+    [[nodiscard]] Opt<TextureContainerInfo> ParseKTX2(Span<const char> memory);
+
+    /// <summary>
+    /// Parse a DDS or KTX2 file, picked by the magic at the start of the file.
+    /// </summary>
+    [[nodiscard]] Opt<TextureContainerInfo> ParseTextureContainer(Span<const char> memory);
+
+    /// <summary>
+    /// Memory mapped DDS or KTX2 file. The create info points into the mapping, so the file has to stay open
+    /// until the texture is created.
+    /// </summary>
+    class TextureContainer
+    {
+    public:
+        [[nodiscard]] bool Open(std::string_view path);
+        void Close();
+
+        [[nodiscard]] bool IsOpen() const { return m_file.IsOpen(); }
+        [[nodiscard]] const TextureContainerInfo& GetInfo() const { return m_info; }
+        [[nodiscard]] TextureCreateInfo GetCreateInfo() const;
+
+    private:
+        MappedFile m_file;
+        TextureContainerInfo m_info;
+    };
+} // namespace FS
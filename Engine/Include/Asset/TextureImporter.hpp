@@ -0,0 +1,61 @@
+#pragma once
+#include "Asset/BlockCompression.hpp"
+#include "Asset/CookedTexture.hpp"
+#include "Asset/MipGenerator.hpp"
+
+namespace FS
+{
+    class JobSystem;
+
+    struct TextureImportSettings
+    {
+        bool SRGB = true;
+        bool GenerateMips = true;
+        MipGenerationSettings MipSettings;
+        /// Used when Format is a block compressed format
+        CompressionQuality Compression = CompressionQuality::eQuality;
+        /// Target format of the cooked texture, eUnknown keeps the decoded format (HDR images become RGBA16F)
+        FS::Format Format = FS::Format::eUnknown;
+    };
+
+    struct TextureImportRequest
+    {
+        std::string SourcePath;
+        std::string CookedPath;
+        TextureImportSettings Settings;
+    };
+
+    /// <summary>
+    /// Decodes PNG, JPG, TGA, BMP, PSD and HDR files with stb_image and cooks them into upload ready
+    /// textures. Batches are imported in parallel on the job system, the number of images in flight is
+    /// limited by a memory budget so large batches don't hold every decoded image at once. The budget is
+    /// reserved by the thread submitting the batch, jobs never wait on it.
+    /// </summary>
+    class TextureImporter
+    {
+    public:
+        explicit TextureImporter(JobSystem& jobs, u64 memory_budget = 1024ull * 1024 * 1024);
+
+        [[nodiscard]] Opt<CookedTexture> Import(std::string_view path, const TextureImportSettings& settings);
+
+        /// <summary>
+        /// Import and write every request. Returns the number of textures that were cooked successfully.
+        /// </summary>
+        u32 ImportBatch(Span<const TextureImportRequest> requests);
+
+    private:
+        /// <summary>
+        /// Mips and compression are spread over jobs when jobs is set.
+        /// </summary>
+        [[nodiscard]] Opt<CookedTexture> Import(Span<const char> memory, std::string_view path,
+                                                const TextureImportSettings& settings, JobSystem* jobs);
+        [[nodiscard]] u64 EstimateMemory(Span<const char> memory, const TextureImportSettings& settings) const;
+        [[nodiscard]] bool TryAcquireMemory(u64 size);
+        void ReleaseMemory(u64 size);
+
+        JobSystem& m_jobs;
+        u64 m_memory_budget;
+        u64 m_memory_used = 0;
+        std::mutex m_memory_mutex;
+    };
+} // namespace FS
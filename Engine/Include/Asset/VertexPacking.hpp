@@ -0,0 +1,46 @@
+#pragma once
+#include "Render/RenderStructs.hpp"
+
+namespace FS
+{
+    /// <summary>
+    /// Largest round trip errors of packed vertices. Angles are in degrees.
+    /// </summary>
+    struct VertexPackingError
+    {
+        f32 MaxPositionError = 0.0f;
+        f32 MaxNormalAngle = 0.0f;
+        f32 MaxTangentAngle = 0.0f;
+        f32 MaxUVError = 0.0f;
+        u32 HandednessMismatches = 0;
+    };
+
+    /// <summary>
+    /// Quantization spanning the bounding box of the vertices.
+    /// </summary>
+    [[nodiscard]] VertexQuantization ComputeVertexQuantization(Span<const Vertex> vertices);
+
+    /// <summary>
+    /// Octahedral mapping of a unit vector to [-1, 1]², the lower hemisphere is folded over the diagonals.
+    /// </summary>
+    [[nodiscard]] glm::vec2 EncodeOctahedral(const glm::vec3& direction);
+    [[nodiscard]] glm::vec3 DecodeOctahedral(const glm::vec2& encoded);
+
+    /// <summary>
+    /// Scalar reference of the packing, PackVertices gives bitwise the same results.
+    /// </summary>
+    [[nodiscard]] PackedVertex PackVertex(const Vertex& vertex, const VertexQuantization& quantization);
+
+    /// <summary>
+    /// Same decode as GeomVS.
+    /// </summary>
+    [[nodiscard]] Vertex UnpackVertex(const PackedVertex& vertex, const VertexQuantization& quantization);
+
+    /// <summary>
+    /// Pack vertices eight at a time with AVX2, output must be as large as vertices.
+    /// </summary>
+    void PackVertices(Span<const Vertex> vertices, const VertexQuantization& quantization, Span<PackedVertex> output);
+
+    [[nodiscard]] VertexPackingError MeasurePackingError(Span<const Vertex> vertices, Span<const PackedVertex> packed,
+                                                         const VertexQuantization& quantization);
+} // namespace FS
@@ -7,6 +7,7 @@ namespace FS
     class Window;
     class Events;
     class Project;
+    class JobSystem;
 
     class Engine
     {
@@ -19,6 +20,7 @@ namespace FS
         [[nodiscard]] Renderer& Renderer() const { return *m_renderer; }
         [[nodiscard]] Project& Project() const { return *m_project; }
         [[nodiscard]] Events& Events() const { return *m_events; } 
+        [[nodiscard]] JobSystem& Jobs() const { return *m_jobs; }
 
         void RequestQuit() { m_running = false; }
         [[nodiscard]] bool IsRunning() const { return m_running; }
@@ -55,6 +57,7 @@ namespace FS
         Ref<FS::Renderer> m_renderer = nullptr;
         Ref<FS::Project> m_project = nullptr;
         Ref<FS::Events> m_events = nullptr;
+        Ref<JobSystem> m_jobs = nullptr;
         bool m_running = true;
         float m_delta_time = 0.0f;
     };
@@ -15,8 +15,7 @@ namespace FS
         {
             Log::Debug("Subscribed to event: {}", typeid(Event).name());
             auto& listener = m_listeners[Hash<Event>()];
-            const auto number = RandomNumber(0, std::numeric_limits<int>::max());
-            const auto handle = static_cast<ListenerHandle>(number);
+            const auto handle = static_cast<ListenerHandle>(m_next_handle++);
             auto call = [callback](const void* e)
             {
                 callback(*static_cast<const Event*>(e));
@@ -56,5 +55,6 @@ namespace FS
             std::unordered_map<ListenerHandle, std::function<void(const void*)>> callbacks;
         };
         std::unordered_map<TypeHash, Listener> m_listeners;
+        u32 m_next_handle = static_cast<u32>(ListenerHandle::eNull) + 1;
     };
 }
@@ -18,7 +18,8 @@ namespace FS
         [[nodiscard]] static std::string ReadTextFile(std::string_view path);
 
         /// <summary>
-        /// Write a string to a text file. The file is created if it does not exist.
+        /// Write a string to a text file. The file is created if it does not exist, and is only
+        /// replaced once the new contents are fully on disk.
         /// Returns true if the file was written successfully.
         /// </summary>
         [[nodiscard]] static bool WriteTextFile(std::string_view path, std::string_view content);
@@ -29,11 +30,17 @@ namespace FS
         [[nodiscard]] static std::vector<char> ReadBinaryFile(std::string_view path);
 
         /// <summary>
-        /// Write a string to a binary file. The file is created if it does not exist.
+        /// Read part of a binary file into the destination, which is filled completely.
+        /// Returns false if the file was not found or is too short.
+        /// </summary>
+        [[nodiscard]] static bool ReadFileRange(std::string_view path, u64 offset, Span<char> destination);
+
+        /// <summary>
+        /// Write a buffer to a binary file. The file is created if it does not exist, and is only
+        /// replaced once the new contents are fully on disk. Use FileWriter to stream large files.
         /// Returns true if the file was written successfully.
         /// </summary>
-        [[nodiscard]] static bool
-        WriteBinaryFile(std::string_view path, const std::vector<char>& content);
+        [[nodiscard]] static bool WriteBinaryFile(std::string_view path, Span<const char> content);
 
         /// <summary>
         /// Check if a file exists.
@@ -0,0 +1,82 @@
+#pragma once
+
+namespace FS
+{
+    inline constexpr u32 kFileWriterAlignment = 4096;
+
+    struct FileWriterCreateInfo
+    {
+        u32 BufferSize = 4 * 1024 * 1024;
+        u32 BufferCount = 4;
+        /// Expected file size. Buffers beyond it aren't allocated, and a file fitting a single buffer is written
+        /// on the calling thread from a buffer of its size
+        Opt<u64> SizeHint;
+        bool Unbuffered = false;
+        bool Atomic = true;
+    };
+
+    class FileWriter
+    {
+    public:
+        FileWriter() = default;
+        ~FileWriter();
+        FileWriter(const FileWriter&) = delete;
+        FileWriter& operator=(const FileWriter&) = delete;
+
+        /// <summary>
+        /// Open a file for streaming writes. When Atomic is set the data goes to a temporary file
+        /// next to the target, and the target is only replaced once Commit succeeds.
+        /// Unbuffered bypasses the OS file cache, which avoids polluting it with large one-off saves.
+        /// </summary>
+        [[nodiscard]] bool Open(std::string_view path, const FileWriterCreateInfo& create_info = {});
+
+        /// <summary>
+        /// Append data to the file. The data is copied into the staging buffers and written by the
+        /// flush thread, so this only blocks when every buffer is still waiting to be written. Without a
+        /// flush thread a full buffer is written right away.
+        /// </summary>
+        bool Write(const void* data, u64 size);
+        bool Write(Span<const char> data) { return Write(data.data(), data.size()); }
+        bool Write(std::string_view data) { return Write(data.data(), data.size()); }
+
+        /// <summary>
+        /// Flush the remaining data, sync it to disk and replace the target file.
+        /// Returns true if every write succeeded.
+        /// </summary>
+        [[nodiscard]] bool Commit();
+
+        /// <summary>
+        /// Stop writing and delete the temporary file. The target file is left untouched.
+        /// </summary>
+        void Abort();
+
+        [[nodiscard]] bool IsOpen() const { return m_file != INVALID_HANDLE_VALUE; }
+        [[nodiscard]] u64 BytesWritten() const { return m_bytes_written; }
+
+    private:
+        void FlushThread(const std::stop_token& stop_token);
+        void SubmitBuffer();
+        bool WriteToFile(const char* data, u64 size);
+        void Close();
+
+        std::string m_path;
+        std::string m_write_path;
+        FileWriterCreateInfo m_create_info{};
+        HANDLE m_file = INVALID_HANDLE_VALUE;
+
+        char* m_buffer = nullptr;
+        Vec<u32> m_buffer_sizes;
+        u32 m_head = 0;
+        u32 m_tail = 0;
+        u32 m_pending = 0;
+        u32 m_fill = 0;
+        u64 m_bytes_written = 0;
+        bool m_synchronous = false;
+
+        std::mutex m_mutex;
+        std::condition_variable_any m_submitted;
+        std::condition_variable m_drained;
+        std::atomic<bool> m_failed = false;
+        std::jthread m_thread;
+    };
+} // namespace FS
@@ -0,0 +1,98 @@
+#pragma once
+
+namespace FS
+{
+    struct JobCounter
+    {
+        std::atomic<u32> Pending = 0;
+
+        [[nodiscard]] bool IsDone() const { return Pending.load(std::memory_order_acquire) == 0; }
+    };
+
+    /// <summary>
+    /// Fixed pool of worker threads pulling from a shared queue. Waiting on a counter runs queued jobs
+    /// on the waiting thread, so jobs can wait on jobs they spawned without deadlocking the pool.
+    /// Without workers every job runs inline on the submitting thread.
+    /// </summary>
+    class JobSystem
+    {
+    public:
+        JobSystem() = default;
+        ~JobSystem();
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        /// <summary>
+        /// Start the workers, a count of 0 uses one worker per hardware thread except the calling one.
+        /// </summary>
+        void Init(u32 worker_count = 0);
+        void Shutdown();
+
+        void Submit(std::function<void()> job, JobCounter* counter = nullptr);
+        void Wait(JobCounter& counter);
+
+        /// <summary>
+        /// Run queued jobs on the calling thread until done returns true, checked after every job.
+        /// </summary>
+        template <typename Func>
+        void WaitUntil(Func&& done)
+        {
+            while (!done())
+            {
+                if (!RunPendingJob())
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        /// <summary>
+        /// Run func(index) for every index in [0, count), split into jobs of batch_size indices.
+        /// Returns once every index has been processed.
+        /// </summary>
+        template <typename Func>
+        void ParallelFor(const u32 count, const u32 batch_size, Func&& func)
+        {
+            if (m_workers.empty() || count <= batch_size)
+            {
+                for (u32 i = 0; i < count; ++i)
+                {
+                    func(i);
+                }
+                return;
+            }
+
+            JobCounter counter;
+            for (u32 begin = 0; begin < count; begin += batch_size)
+            {
+                const u32 end = std::min(count, begin + batch_size);
+                Submit([&func, begin, end]
+                {
+                    for (u32 i = begin; i < end; ++i)
+                    {
+                        func(i);
+                    }
+                }, &counter);
+            }
+            Wait(counter);
+        }
+
+        [[nodiscard]] u32 WorkerCount() const { return static_cast<u32>(m_workers.size()); }
+
+    private:
+        struct Job
+        {
+            std::function<void()> Function;
+            JobCounter* Counter = nullptr;
+        };
+
+        void WorkerThread(const std::stop_token& stop_token);
+        bool RunPendingJob();
+        static void Run(Job& job);
+
+        std::deque<Job> m_jobs;
+        std::mutex m_mutex;
+        std::condition_variable_any m_job_available;
+        Vec<std::jthread> m_workers;
+    };
+} // namespace FS
@@ -0,0 +1,45 @@
+#pragma once
+
+namespace FS
+{
+    /// <summary>
+    /// Read only memory mapping of a whole file. The view stays valid until the file is closed, the file can't
+    /// be written meanwhile.
+    /// </summary>
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        [[nodiscard]] bool Open(std::string_view path);
+        void Close();
+
+        [[nodiscard]] bool IsOpen() const { return m_file != INVALID_HANDLE_VALUE; }
+        [[nodiscard]] const char* Data() const { return m_data; }
+        [[nodiscard]] u64 Size() const { return m_size; }
+        [[nodiscard]] Span<const char> GetSpan() const { return {m_data, m_size}; }
+
+        /// <summary>
+        /// Ask the OS to read a range in large requests instead of faulting it in page by page.
+        /// Only a hint, returns right away.
+        /// </summary>
+        void Prefetch(u64 offset, u64 size) const;
+
+        template <typename T>
+        [[nodiscard]] const T* As(const u64 offset = 0) const
+        {
+            return reinterpret_cast<const T*>(m_data + offset);
+        }
+
+    private:
+        HANDLE m_file = INVALID_HANDLE_VALUE;
+        HANDLE m_mapping = nullptr;
+        const char* m_data = nullptr;
+        u64 m_size = 0;
+    };
+} // namespace FS
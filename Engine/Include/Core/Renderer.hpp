@@ -1,7 +1,13 @@
 #pragma once 
 #include "Events.hpp"
 #include "System.hpp"
+#include "Render/AsyncPipelineCompiler.hpp"
 #include "Render/IRenderBackend.hpp"
+#include "Render/RenderGraph.hpp"
+#include "Render/ShaderHotReload.hpp"
+#include "Render/ShaderPermutation.hpp"
+#include "Render/ShaderPreloader.hpp"
+#include "Render/TextureStreamingManager.hpp"
 
 namespace FS
 {
@@ -12,6 +18,8 @@ namespace FS
         void Update(float) override;
         void Shutdown() override;
 
+        [[nodiscard]] TextureStreamingManager& TextureStreaming() { return m_texture_streaming; }
+
     private:
         void CreateMeshBuffers();
         void CreateRenderTextures();
@@ -19,6 +27,13 @@ namespace FS
         
         ListenerHandle m_window_resize_listener = ListenerHandle::eNull;
         Scoped<IRenderBackend> m_context;
+        TextureStreamingManager m_texture_streaming;
+        PipelineCache m_pipelines;
+        AsyncPipelineCompiler m_pipeline_compiler;
+        ShaderPreloader m_shader_preloader;
+        ShaderHotReload m_shader_hot_reload;
+        bool m_hot_reload = false;
+        RenderGraph m_render_graph;
 
         TextureHandle m_render_target = TextureHandle::eNull;
         TextureHandle m_depth_stencil = TextureHandle::eNull;
@@ -26,6 +41,6 @@ namespace FS
         BufferHandle m_vertex_buffer = BufferHandle::eNull;
         BufferHandle m_index_buffer = BufferHandle::eNull;
         
-        ShaderHandle m_triangle_shader = ShaderHandle::eNull;
+        ShaderPermutations<GeomFeature, PipelineHandle> m_triangle_shaders;
     };
 }
@@ -0,0 +1,138 @@
+#pragma once
+#include "Core/FileIO.hpp"
+#include "glaze/glaze.hpp"
+
+namespace FS
+{
+    enum class SerializeFormat : u8
+    {
+        eJson,
+        eBinary,
+    };
+
+    /// Bump the version of a type when a change can't be handled by adding or removing fields.
+    /// Binary files written with an older version are still read, newer versions are rejected.
+    template <typename T>
+    inline constexpr u32 kSerializeVersion = 1;
+
+    struct SerializeHeader
+    {
+        static constexpr u32 kMagic = 0x56425346; // FSBV
+        u32 Magic = kMagic;
+        u32 Version = 0;
+    };
+
+    class Serializer
+    {
+    public:
+        static constexpr glz::opts kJsonReadOpts{.null_terminated = false, .error_on_unknown_keys = false};
+        static constexpr glz::opts kJsonWriteOpts{.prettify = true};
+        static constexpr glz::opts kBinaryReadOpts{
+            .format = glz::BEVE, .null_terminated = false, .error_on_unknown_keys = false
+        };
+        static constexpr glz::opts kBinaryWriteOpts{.format = glz::BEVE};
+
+        /// <summary>
+        /// Read a file written by Write. The format is detected from the file contents.
+        /// Returns true if the file was read successfully.
+        /// </summary>
+        template <typename T>
+        [[nodiscard]] static bool Read(T& value, const std::string_view path)
+        {
+            const auto buffer = FileIO::ReadBinaryFile(path);
+            if (buffer.empty())
+            {
+                return false;
+            }
+            return ReadBuffer(value, std::string_view(buffer.data(), buffer.size()), path);
+        }
+
+        /// <summary>
+        /// Write a value as pretty printed JSON or as BEVE with a version header.
+        /// Returns true if the file was written successfully.
+        /// </summary>
+        template <typename T>
+        [[nodiscard]] static bool Write(const T& value, const std::string_view path, const SerializeFormat format)
+        {
+            std::string payload;
+            SerializeHeader header{.Version = kSerializeVersion<T>};
+            glz::error_ctx ec;
+            switch (format)
+            {
+            case SerializeFormat::eJson:
+                ec = glz::write<kJsonWriteOpts>(value, payload);
+                break;
+            case SerializeFormat::eBinary:
+                ec = glz::write<kBinaryWriteOpts>(value, payload);
+                break;
+            }
+            if (ec)
+            {
+                Log::Error("Failed to serialize {}: {}", path, glz::format_error(ec, payload));
+                return false;
+            }
+            return WriteFile(path, format == SerializeFormat::eBinary ? &header : nullptr, payload);
+        }
+
+        /// <summary>
+        /// Read a JSON source file through its binary cooked copy. The cooked copy is used when it is
+        /// newer than the source and was written with the current version, otherwise the source is
+        /// parsed and the cooked copy is regenerated.
+        /// </summary>
+        template <typename T>
+        [[nodiscard]] static bool ReadCooked(T& value, const std::string_view source_path)
+        {
+            const auto cooked_path = GetCookedPath(source_path);
+            if (IsCookedUpToDate(source_path, cooked_path, kSerializeVersion<T>) && Read(value, cooked_path))
+            {
+                return true;
+            }
+            if (!Read(value, source_path))
+            {
+                return false;
+            }
+            if (!Write(value, cooked_path, SerializeFormat::eBinary))
+            {
+                Log::Warn("Failed to write cooked copy of {}", source_path);
+            }
+            return true;
+        }
+
+        [[nodiscard]] static std::string GetCookedPath(std::string_view source_path);
+
+    private:
+        template <typename T>
+        [[nodiscard]] static bool ReadBuffer(T& value, const std::string_view buffer, const std::string_view path)
+        {
+            glz::error_ctx ec;
+            const auto header = ReadHeader(buffer);
+            if (header)
+            {
+                if (header->Version > kSerializeVersion<T>)
+                {
+                    Log::Error("{} was written with a newer version ({} > {})", path, header->Version,
+                               kSerializeVersion<T>);
+                    return false;
+                }
+                ec = glz::read<kBinaryReadOpts>(value, buffer.substr(sizeof(SerializeHeader)));
+            }
+            else
+            {
+                ec = glz::read<kJsonReadOpts>(value, buffer);
+            }
+
+            if (ec)
+            {
+                Log::Error("Failed to deserialize {}: {}", path, glz::format_error(ec, buffer));
+                return false;
+            }
+            return true;
+        }
+
+        [[nodiscard]] static Opt<SerializeHeader> ReadHeader(std::string_view buffer);
+        [[nodiscard]] static bool IsCookedUpToDate(std::string_view source_path, std::string_view cooked_path,
+                                                   u32 version);
+        [[nodiscard]] static bool WriteFile(std::string_view path, const SerializeHeader* header,
+                                            std::string_view payload);
+    };
+} // namespace FS
@@ -0,0 +1,138 @@
+#pragma once
+#include "Core/JobSystem.hpp"
+#include "Render/PipelineCache.hpp"
+
+namespace FS
+{
+    class Events;
+
+    enum class PipelineHandle : u32
+    {
+        eNull = std::numeric_limits<u32>::max(),
+    };
+
+    enum class PipelineState : u8
+    {
+        ePending,
+        eReady,
+        eFailed,
+    };
+
+    /// <summary>
+    /// Broadcast from AsyncPipelineCompiler::Update on the main thread once a pipeline is done compiling.
+    /// </summary>
+    struct PipelineCompiledEvent
+    {
+        PipelineHandle Pipeline = PipelineHandle::eNull;
+        bool Success = false;
+        /// Compiled by a reload, a failed reload keeps the previous pipeline
+        bool Reloaded = false;
+        f64 Milliseconds = 0.0;
+    };
+
+    /// <summary>
+    /// Creates pipelines without blocking the calling thread. A request returns a handle at once and compiles
+    /// through the pipeline cache on a job system of its own, so a thread waiting on the engine job system
+    /// never picks up a compile and stalls on it. Until a pipeline is ready it resolves to its fallback, which
+    /// is eNull when the draw should be skipped. Only IPipelineCache is used, a fake with a set latency can
+    /// stand in for the backend.
+    /// Compiles finish on worker threads but only show up in Update, everything else is main thread only and
+    /// needs no lock.
+    /// </summary>
+    class AsyncPipelineCompiler
+    {
+    public:
+        /// <summary>
+        /// Start worker_count compile threads, at least one.
+        /// </summary>
+        void Init(IPipelineCache& pipelines, Events& events, u32 worker_count = 2);
+
+        /// <summary>
+        /// Wait for the compiles in flight and release every pipeline, the GPU must be done with them.
+        /// </summary>
+        void Shutdown();
+
+        /// <summary>
+        /// Queue the pipeline and return its handle without waiting. The create info must not own its bytecode,
+        /// which has to stay valid until the pipeline is done compiling.
+        /// </summary>
+        [[nodiscard]] PipelineHandle CreateShaderAsync(const GraphicsShaderCreateInfo& create_info,
+                                                       std::string debug_name,
+                                                       ShaderHandle fallback = ShaderHandle::eNull);
+        [[nodiscard]] PipelineHandle CreateShaderAsync(const ComputeShaderCreateInfo& create_info,
+                                                       std::string debug_name,
+                                                       ShaderHandle fallback = ShaderHandle::eNull);
+
+        /// <summary>
+        /// Compile the pipeline again from a new create info, same rules as CreateShaderAsync. A ready pipeline
+        /// keeps its shader handle, which gets the new pipeline in the Update after it compiled. A pipeline that
+        /// is pending or failed compiles from the new create info instead.
+        /// </summary>
+        void Reload(PipelineHandle pipeline, const GraphicsShaderCreateInfo& create_info, std::string debug_name);
+        void Reload(PipelineHandle pipeline, const ComputeShaderCreateInfo& create_info, std::string debug_name);
+
+        /// <summary>
+        /// Release the pipeline, compiles still running for it are released once done. The GPU must be done
+        /// with it.
+        /// </summary>
+        void Destroy(PipelineHandle pipeline);
+
+        /// <summary>
+        /// Apply the compiles finished since the last call and broadcast a PipelineCompiledEvent for each,
+        /// called once per frame before anything is bound.
+        /// </summary>
+        void Update();
+
+        /// <summary>
+        /// Shader to bind for the pipeline: the pipeline once ready, its fallback while pending or after
+        /// a failed compile. eNull means the draw is skipped.
+        /// </summary>
+        [[nodiscard]] ShaderHandle GetShader(PipelineHandle pipeline) const;
+        [[nodiscard]] PipelineState GetState(PipelineHandle pipeline) const;
+        [[nodiscard]] u32 GetPendingCount() const { return m_pending_count; }
+
+    private:
+        struct Pipeline
+        {
+            ShaderHandle Shader = ShaderHandle::eNull;
+            ShaderHandle Fallback = ShaderHandle::eNull;
+            PipelineState State = PipelineState::ePending;
+            /// Bumped by every compile and by Destroy, compiles finishing with an older version are dropped.
+            /// Kept when the slot is reused.
+            u32 Version = 0;
+            bool Destroyed = false;
+        };
+
+        struct Completion
+        {
+            PipelineHandle Pipeline = PipelineHandle::eNull;
+            u32 Version = 0;
+            ShaderHandle Shader = ShaderHandle::eNull;
+            Opt<PipelineReload> Reload;
+            f64 Milliseconds = 0.0;
+        };
+
+        template <typename CreateInfo>
+        [[nodiscard]] PipelineHandle Enqueue(const CreateInfo& create_info, std::string debug_name,
+                                             ShaderHandle fallback);
+        template <typename CreateInfo>
+        void Compile(PipelineHandle pipeline, const CreateInfo& create_info, std::string debug_name);
+        template <typename CreateInfo>
+        void ReloadPipeline(PipelineHandle pipeline, const CreateInfo& create_info, std::string debug_name);
+        void Complete(Completion completion, std::chrono::steady_clock::time_point start);
+        [[nodiscard]] Pipeline* Find(PipelineHandle pipeline);
+        [[nodiscard]] const Pipeline* Find(PipelineHandle pipeline) const;
+
+        IPipelineCache* m_pipelines = nullptr;
+        Events* m_events = nullptr;
+        JobSystem m_jobs;
+        JobCounter m_in_flight;
+
+        Vec<Pipeline> m_slots;
+        Vec<u32> m_free_slots;
+        u32 m_pending_count = 0;
+
+        std::mutex m_completed_mutex;
+        Vec<Completion> m_completed;
+    };
+} // namespace FS
@@ -164,17 +164,43 @@ namespace FS::DX12
         case ViewType::eBuffer:
             return D3D12_SRV_DIMENSION_BUFFER;
         case ViewType::eTexture1D:
-        case ViewType::eTexture1DArray:
             return D3D12_SRV_DIMENSION_TEXTURE1D;
+        case ViewType::eTexture1DArray:
+            return D3D12_SRV_DIMENSION_TEXTURE1DARRAY;
         case ViewType::eTexture2D:
-        case ViewType::eTexture2DArray:
             return D3D12_SRV_DIMENSION_TEXTURE2D;
+        case ViewType::eTexture2DArray:
+            return D3D12_SRV_DIMENSION_TEXTURE2DARRAY;
         case ViewType::eTexture3D:
             return D3D12_SRV_DIMENSION_TEXTURE3D;
         }
         return D3D12_SRV_DIMENSION_UNKNOWN;
     }
 
+    inline D3D12_RESOURCE_STATES GetResourceState(const ResourceState state)
+    {
+        constexpr std::array<D3D12_RESOURCE_STATES, 9> kStates = {
+            D3D12_RESOURCE_STATE_RENDER_TARGET,
+            D3D12_RESOURCE_STATE_DEPTH_WRITE,
+            D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+            D3D12_RESOURCE_STATE_COPY_DEST,
+            D3D12_RESOURCE_STATE_DEPTH_READ,
+            D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE,
+            D3D12_RESOURCE_STATE_COPY_SOURCE,
+            D3D12_RESOURCE_STATE_INDEX_BUFFER,
+            D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT,
+        };
+        auto result = D3D12_RESOURCE_STATE_COMMON;
+        for (u32 bit = 0; bit < kStates.size(); ++bit)
+        {
+            if ((static_cast<u32>(state) & 1u << bit) != 0)
+            {
+                result |= kStates[bit];
+            }
+        }
+        return result;
+    }
+
     inline ID3D12Resource2* GetSwapchainBuffer(IDXGISwapChain4* const swapchain, const u32 index)
     {
         ID3D12Resource2* resource;
@@ -189,7 +215,4 @@ namespace FS::DX12
         const auto nameResult = object->SetName(wDebugName.c_str());
         ThrowIfFailed(nameResult, "Failed to name swap chain buffer resource");
     }
-
-    // This is generic enough that it can be used for other backends, so maybe will move it later
-    inline u64 Align(const u64 value, const u64 alignment) { return (value + alignment - 1) & ~(alignment - 1); }
 } // namespace FS::DX12
\ No newline at end of file
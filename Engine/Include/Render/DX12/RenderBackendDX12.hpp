@@ -26,6 +26,7 @@ namespace FS
         void BeginRenderPass(CommandHandle commandHandle, const RenderPassInfo& renderPassInfo) override;
         void EndRenderPass(CommandHandle commandHandle) override;
         void BindShader(CommandHandle commandHandle, ShaderHandle shaderHandle) override;
+        void Barrier(CommandHandle command_handle, Span<const ResourceBarrier> barriers) override;
         void ClearRenderTarget(CommandHandle command_handle, TextureHandle render_target_handle,
                                glm::vec4 clear_color) override;
         void Draw(CommandHandle commandHandle,
@@ -52,6 +53,12 @@ namespace FS
 
         void DestroyTexture(TextureHandle texture_handle) override;
         void DestroyBuffer(BufferHandle buffer_handle) override;
+        void DestroyShader(ShaderHandle shader_handle) override;
+        void SwapShader(ShaderHandle shader_handle, ShaderHandle replacement_handle) override;
+
+        bool LoadPipelineLibrary(Span<const char> data) override;
+        [[nodiscard]] Vec<char> SavePipelineLibrary() override;
+        [[nodiscard]] u32 GetPipelineLibraryHits() const override;
 
         void* MapBuffer(BufferHandle bufferHandle) override;
         void UnmapBuffer(BufferHandle bufferHandle) override;
@@ -73,9 +80,14 @@ namespace FS
         void CheckRebarSupport();
 
         [[nodiscard]] ResourceHandle
-        CreateResource(const DX12::Heap& heap, const TextureCreateInfo& create_info, std::string_view debug_name);
+        CreateResource(DX12::Heap& heap, const TextureCreateInfo& create_info, std::string_view debug_name);
         [[nodiscard]] ResourceHandle
         CreateResource(DX12::Heap& heap, const BufferCreateInfo& create_info, std::string_view debug_name);
+        /// <summary>
+        /// Offset placing the resource after everything else in the heap, nullopt when the heap is exhausted.
+        /// </summary>
+        [[nodiscard]] Opt<u64> AllocateFromHeap(DX12::Heap& heap, const D3D12_RESOURCE_DESC& resource_desc,
+                                                std::string_view debug_name) const;
         [[nodiscard]] DX12::Heap CreateHeap(D3D12_HEAP_TYPE type, u32 size, std::string_view debug_name) const;
         [[nodiscard]] DX12::DescriptorAllocator CreateDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE heap_type,
                                                                      std::string_view debug_name) const;
@@ -86,6 +98,16 @@ namespace FS
         [[nodiscard]] DX12::Descriptor CreateRenderTargetView(ResourceHandle resource_handle,
                                                               const TextureCreateInfo& create_info);
         [[nodiscard]] DX12::Descriptor CreateDepthStencilView(ResourceHandle resource_handle);
+        void UploadToTexture(ResourceHandle resource_handle, const TextureUploadInfo& info);
+        /// <summary>
+        /// Upload whose copy finished with a staging buffer of at least size bytes, created when none is free.
+        /// </summary>
+        [[nodiscard]] DX12::Upload& AcquireUpload(u64 size);
+        void ReleaseUploads();
+        [[nodiscard]] ShaderHandle AddShader(ID3D12PipelineState* pipeline_state, std::string_view debug_name);
+        void StorePipeline(u64 key, const std::wstring& name, ID3D12PipelineState* pipeline_state) const;
+        void ReleaseRetiredPipelines(bool all);
+        void ReleasePipelineLibraries();
         void TransitionResource(CommandHandle command_handle,
                                 ResourceHandle resource_handle,
                                 D3D12_RESOURCE_STATES new_state);
@@ -117,7 +139,22 @@ namespace FS
         Vec<TextureHandle> m_free_textures;
         Vec<DX12::Buffer> m_buffers;
         Vec<ID3D12PipelineState*> m_shaders;
+        Vec<ShaderHandle> m_free_shaders;
+        /// Guards m_shaders, pipelines are created on compile threads while frames bind them
+        std::mutex m_shader_mutex;
+        /// Loaded from the earlier run, only read
+        ID3D12PipelineLibrary* m_pipeline_library = nullptr;
+        /// The library reads its pipelines from the data it was created from for as long as it lives
+        Vec<char> m_pipeline_library_data;
+        /// Every pipeline created this run, saved in place of the loaded one so unused pipelines drop out
+        ID3D12PipelineLibrary* m_new_pipeline_library = nullptr;
+        std::atomic<u32> m_pipeline_library_hits = 0;
+        /// Only touched by the main thread
+        Vec<DX12::RetiredPipeline> m_retired_pipelines;
+        Vec<DX12::Upload> m_uploads;
         Vec<DX12::Resource> m_resources;
+        /// Scratch of Barrier, kept to record batches without allocating
+        Vec<D3D12_RESOURCE_BARRIER> m_barriers;
 
         bool m_rebar_supported = false;
     };
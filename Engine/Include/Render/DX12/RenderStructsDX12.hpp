@@ -89,4 +89,27 @@ namespace FS::DX12
         ResourceHandle ResourceHandle = ResourceHandle::eNull;
         BufferType BufferType = BufferType::eStorage;
     };
+
+    /// <summary>
+    /// Staging buffer and copy commands of a texture upload, reused once the transfer fence passed FenceValue.
+    /// </summary>
+    struct Upload
+    {
+        ID3D12Resource* Staging = nullptr;
+        /// Stays mapped for as long as the staging buffer lives
+        char* Mapped = nullptr;
+        u64 Size = 0;
+        ID3D12CommandAllocator* CommandAllocator = nullptr;
+        ID3D12GraphicsCommandList* CommandList = nullptr;
+        u64 FenceValue = 0;
+    };
+
+    /// <summary>
+    /// Pipeline replaced by a shader swap, released once the frames that may still use it are done.
+    /// </summary>
+    struct RetiredPipeline
+    {
+        ID3D12PipelineState* PipelineState = nullptr;
+        u32 FramesLeft = 0;
+    };
 } // namespace FS::DX12
\ No newline at end of file
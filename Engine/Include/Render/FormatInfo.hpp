@@ -0,0 +1,138 @@
+#pragma once
+#include "Render/RenderEnums.hpp"
+
+namespace FS
+{
+    struct FormatInfo
+    {
+        u8 BytesPerBlock = 0;
+        u8 BlockSize = 1;
+        u8 Channels = 0;
+        bool SRGB = false;
+
+        [[nodiscard]] constexpr bool IsCompressed() const { return BlockSize > 1; }
+    };
+
+    constexpr FormatInfo GetFormatInfo(const Format format)
+    {
+        switch (format)
+        {
+        case Format::eR32G32B32A32_FLOAT:
+        case Format::eR32G32B32A32_UINT:
+        case Format::eR32G32B32A32_SINT:
+            return {.BytesPerBlock = 16, .Channels = 4};
+        case Format::eR32G32B32_FLOAT:
+        case Format::eR32G32B32_UINT:
+        case Format::eR32G32B32_SINT:
+            return {.BytesPerBlock = 12, .Channels = 3};
+        case Format::eR16G16B16A16_FLOAT:
+        case Format::eR16G16B16A16_UNORM:
+        case Format::eR16G16B16A16_UINT:
+        case Format::eR16G16B16A16_SNORM:
+        case Format::eR16G16B16A16_SINT:
+            return {.BytesPerBlock = 8, .Channels = 4};
+        case Format::eR32G32_FLOAT:
+        case Format::eR32G32_UINT:
+        case Format::eR32G32_SINT:
+            return {.BytesPerBlock = 8, .Channels = 2};
+        case Format::eR10G10B10A2_UNORM:
+        case Format::eR10G10B10A2_UINT:
+        case Format::eR8G8B8A8_UNORM:
+        case Format::eR8G8B8A8_UINT:
+        case Format::eR8G8B8A8_SNORM:
+        case Format::eR8G8B8A8_SINT:
+        case Format::eB8G8R8A8_UNORM:
+            return {.BytesPerBlock = 4, .Channels = 4};
+        case Format::eR8G8B8A8_UNORM_SRGB:
+        case Format::eB8G8R8A8_UNORM_SRGB:
+            return {.BytesPerBlock = 4, .Channels = 4, .SRGB = true};
+        case Format::eR11G11B10_FLOAT:
+            return {.BytesPerBlock = 4, .Channels = 3};
+        case Format::eR16G16_FLOAT:
+        case Format::eR16G16_UNORM:
+        case Format::eR16G16_UINT:
+        case Format::eR16G16_SNORM:
+        case Format::eR16G16_SINT:
+            return {.BytesPerBlock = 4, .Channels = 2};
+        case Format::eD32_FLOAT:
+        case Format::eR32_FLOAT:
+        case Format::eR32_UINT:
+        case Format::eR32_SINT:
+            return {.BytesPerBlock = 4, .Channels = 1};
+        case Format::eD24_UNORM_S8_UINT:
+            return {.BytesPerBlock = 4, .Channels = 2};
+        case Format::eR8G8_UNORM:
+        case Format::eR8G8_UINT:
+        case Format::eR8G8_SNORM:
+        case Format::eR8G8_SINT:
+            return {.BytesPerBlock = 2, .Channels = 2};
+        case Format::eR16_FLOAT:
+        case Format::eD16_UNORM:
+        case Format::eR16_UNORM:
+        case Format::eR16_UINT:
+        case Format::eR16_SNORM:
+        case Format::eR16_SINT:
+            return {.BytesPerBlock = 2, .Channels = 1};
+        case Format::eB5G6R5_UNORM:
+            return {.BytesPerBlock = 2, .Channels = 3};
+        case Format::eB5G5R5A1_UNORM:
+            return {.BytesPerBlock = 2, .Channels = 4};
+        case Format::eR8_UNORM:
+        case Format::eR8_UINT:
+        case Format::eR8_SNORM:
+        case Format::eR8_SINT:
+        case Format::eA8_UNORM:
+            return {.BytesPerBlock = 1, .Channels = 1};
+        case Format::eR8G8_B8G8_UNORM:
+        case Format::eG8R8_G8B8_UNORM:
+            return {.BytesPerBlock = 4, .Channels = 3};
+        case Format::eBC1_UNORM:
+            return {.BytesPerBlock = 8, .BlockSize = 4, .Channels = 4};
+        case Format::eBC1_UNORM_SRGB:
+            return {.BytesPerBlock = 8, .BlockSize = 4, .Channels = 4, .SRGB = true};
+        case Format::eBC2_UNORM:
+        case Format::eBC3_UNORM:
+            return {.BytesPerBlock = 16, .BlockSize = 4, .Channels = 4};
+        case Format::eBC2_UNORM_SRGB:
+        case Format::eBC3_UNORM_SRGB:
+            return {.BytesPerBlock = 16, .BlockSize = 4, .Channels = 4, .SRGB = true};
+        case Format::eBC4_UNORM:
+        case Format::eBC4_SNORM:
+            return {.BytesPerBlock = 8, .BlockSize = 4, .Channels = 1};
+        case Format::eBC5_UNORM:
+        case Format::eBC5_SNORM:
+            return {.BytesPerBlock = 16, .BlockSize = 4, .Channels = 2};
+        case Format::eBC6H_UF16:
+        case Format::eBC6H_SF16:
+            return {.BytesPerBlock = 16, .BlockSize = 4, .Channels = 3};
+        case Format::eBC7_UNORM:
+            return {.BytesPerBlock = 16, .BlockSize = 4, .Channels = 4};
+        case Format::eBC7_UNORM_SRGB:
+            return {.BytesPerBlock = 16, .BlockSize = 4, .Channels = 4, .SRGB = true};
+        case Format::eR1_UNORM:
+        case Format::eUnknown:
+            break;
+        }
+        return {};
+    }
+
+    /// <summary>
+    /// Row pitch and row count of a tightly packed mip, rows are block rows for compressed formats.
+    /// </summary>
+    constexpr u32 GetRowPitch(const Format format, const u32 width)
+    {
+        const auto info = GetFormatInfo(format);
+        return (width + info.BlockSize - 1) / info.BlockSize * info.BytesPerBlock;
+    }
+
+    constexpr u32 GetRowCount(const Format format, const u32 height)
+    {
+        const auto info = GetFormatInfo(format);
+        return (height + info.BlockSize - 1) / info.BlockSize;
+    }
+
+    constexpr u16 GetMipCount(const glm::uvec2 dimensions)
+    {
+        return static_cast<u16>(std::bit_width(std::max(dimensions.x, dimensions.y)));
+    }
+} // namespace FS
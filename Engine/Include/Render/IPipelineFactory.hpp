@@ -0,0 +1,50 @@
+#pragma once
+#include "Render/RenderStructs.hpp"
+
+namespace FS
+{
+    /// <summary>
+    /// The part of the render backend that creates pipelines, all the pipeline cache needs from it.
+    /// </summary>
+    class IPipelineFactory
+    {
+    public:
+        virtual ~IPipelineFactory() = default;
+
+        /// <summary>
+        /// Shaders can be created from several threads at once, also while other shaders are bound. Returns eNull
+        /// when the pipeline fails to create.
+        /// </summary>
+        [[nodiscard]] virtual ShaderHandle CreateShader(const GraphicsShaderCreateInfo& create_info,
+                                                        std::string_view debug_name) = 0;
+        [[nodiscard]] virtual ShaderHandle CreateShader(const ComputeShaderCreateInfo& create_info,
+                                                        std::string_view debug_name) = 0;
+
+        /// <summary>
+        /// The shader must not be in use by the GPU anymore.
+        /// </summary>
+        virtual void DestroyShader(ShaderHandle shader_handle) = 0;
+        /// <summary>
+        /// Move the pipeline of replacement into shader and free replacement, so everything holding shader binds
+        /// the new pipeline from now on. The previous pipeline is destroyed once the frames in flight are done
+        /// with it. Called between frames from the main thread.
+        /// </summary>
+        virtual void SwapShader(ShaderHandle shader_handle, ShaderHandle replacement_handle) = 0;
+
+        /// <summary>
+        /// Seed shader creation with a pipeline library saved by an earlier run, shaders whose create info has a
+        /// PipelineKey are looked up in it. Empty data or data from another driver or device starts an empty
+        /// library. Returns false when the saved library couldn't be used.
+        /// </summary>
+        virtual bool LoadPipelineLibrary(Span<const char> data) = 0;
+        /// <summary>
+        /// Library of the pipelines with a PipelineKey created since it was loaded, pipelines of the loaded
+        /// library that weren't created again are left out.
+        /// </summary>
+        [[nodiscard]] virtual Vec<char> SavePipelineLibrary() = 0;
+        /// <summary>
+        /// Pipelines with a PipelineKey loaded from the library instead of compiled since it was loaded.
+        /// </summary>
+        [[nodiscard]] virtual u32 GetPipelineLibraryHits() const = 0;
+    };
+} // namespace FS
@@ -1,10 +1,11 @@
 #pragma once
+#include "Render/IPipelineFactory.hpp"
 #include "Render/RenderStructs.hpp"
 #include "Render/RenderConstants.hpp"
 
 namespace FS
 {
-    class IRenderBackend
+    class IRenderBackend : public IPipelineFactory
     {
     public:
         virtual ~IRenderBackend() = default;
@@ -28,6 +29,10 @@ namespace FS
         virtual void BeginRenderPass(CommandHandle commandHandle, const RenderPassInfo& renderPassInfo) = 0;
         virtual void EndRenderPass(CommandHandle commandHandle) = 0;
         virtual void BindShader(CommandHandle commandHandle, ShaderHandle shaderHandle) = 0;
+        /// <summary>
+        /// Record the barriers as one batch, barriers to the state a resource is already in are skipped.
+        /// </summary>
+        virtual void Barrier(CommandHandle command_handle, Span<const ResourceBarrier> barriers) = 0;
         virtual void ClearRenderTarget(CommandHandle command_handle, TextureHandle render_target_handle,
                                        glm::vec4 clear_color) = 0;
         virtual void Draw(CommandHandle commandHandle,
@@ -48,11 +53,6 @@ namespace FS
         [[nodiscard]] virtual CommandHandle CreateCommand(QueueType queue_type, std::string_view debug_name) = 0;
         [[nodiscard]] virtual BufferHandle CreateBuffer(const BufferCreateInfo& create_info,
                                                         std::string_view debug_name) = 0;
-        [[nodiscard]] virtual ShaderHandle CreateShader(const GraphicsShaderCreateInfo& create_info,
-                                                        std::string_view debug_name) = 0;
-        [[nodiscard]] virtual ShaderHandle CreateShader(const ComputeShaderCreateInfo& create_info,
-                                                        std::string_view debug_name) = 0;
-
         virtual void DestroyTexture(TextureHandle render_target_handle) = 0;
         virtual void DestroyBuffer(BufferHandle buffer_handle) = 0;
 
@@ -0,0 +1,44 @@
+#pragma once
+#include "Asset/Meshlet.hpp"
+
+namespace FS
+{
+    /// <summary>
+    /// Six normalized planes pointing inside, left, right, bottom, top, near and far.
+    /// </summary>
+    struct Frustum
+    {
+        Array<glm::vec4, 6> Planes{};
+
+        /// <summary>
+        /// Planes of a view projection matrix with the D3D depth range of 0 to 1. Passing the matrix
+        /// multiplied with a model matrix gives the planes in the space of that model.
+        /// </summary>
+        [[nodiscard]] static Frustum FromMatrix(const glm::mat4& view_projection);
+
+        [[nodiscard]] bool IntersectsSphere(glm::vec3 center, f32 radius) const;
+    };
+
+    struct MeshletCullStatistics
+    {
+        u32 MeshletCount = 0;
+        u32 FrustumCulled = 0;
+        u32 ConeCulled = 0;
+
+        [[nodiscard]] u32 VisibleCount() const { return MeshletCount - FrustumCulled - ConeCulled; }
+    };
+
+    /// <summary>
+    /// True when every triangle of the meshlet faces away from the camera, conservatively for any point in
+    /// its bounding sphere.
+    /// </summary>
+    [[nodiscard]] bool IsMeshletBackfacing(const MeshletBounds& bounds, glm::vec3 camera_position);
+
+    /// <summary>
+    /// CPU reference of the GPU meshlet culling, to validate it and measure cull rates. The frustum and camera
+    /// position are in mesh space. The indices of the meshlets passing both tests are written to visible when
+    /// it is set.
+    /// </summary>
+    MeshletCullStatistics CullMeshlets(Span<const MeshletBounds> bounds, const Frustum& frustum,
+                                       glm::vec3 camera_position, Vec<u32>* visible = nullptr);
+} // namespace FS
@@ -0,0 +1,144 @@
+#pragma once
+#include "Render/IPipelineFactory.hpp"
+
+namespace FS
+{
+    struct PipelineCacheHeader
+    {
+        static constexpr u32 kMagic = 0x43505346; // FSPC
+        static constexpr u32 kVersion = 2;
+        u32 Magic = kMagic;
+        u32 Version = kVersion;
+        /// Pipeline library of the backend, stored after the header
+        u64 LibrarySize = 0;
+    };
+
+    struct PipelineCacheStats
+    {
+        /// Pipelines the backend created
+        u32 Created = 0;
+        /// Requests served by a pipeline that already existed
+        u32 Deduplicated = 0;
+        /// Created pipelines the backend loaded from the pipeline library of an earlier run instead of compiling
+        u32 Persisted = 0;
+    };
+
+    /// <summary>
+    /// New pipeline of a shader, created ahead of the swap that puts it in place.
+    /// </summary>
+    struct PipelineReload
+    {
+        ShaderHandle Shader = ShaderHandle::eNull;
+        /// eNull when the new pipeline failed to create
+        ShaderHandle Replacement = ShaderHandle::eNull;
+        u64 Key = 0;
+    };
+
+    /// <summary>
+    /// Creates, releases and swaps the pipelines of the asynchronous pipeline compiler. Acquire and PrepareReload
+    /// are called from compile threads at once, the rest from the main thread. A pipeline that fails to create
+    /// is eNull, Acquire returns it and PrepareReload reports it as the replacement.
+    /// </summary>
+    class IPipelineCache
+    {
+    public:
+        virtual ~IPipelineCache() = default;
+
+        [[nodiscard]] virtual ShaderHandle Acquire(const GraphicsShaderCreateInfo& create_info,
+                                                   std::string_view debug_name) = 0;
+        [[nodiscard]] virtual ShaderHandle Acquire(const ComputeShaderCreateInfo& create_info,
+                                                   std::string_view debug_name) = 0;
+        virtual void Release(ShaderHandle shader) = 0;
+
+        [[nodiscard]] virtual PipelineReload PrepareReload(ShaderHandle shader,
+                                                           const GraphicsShaderCreateInfo& create_info,
+                                                           std::string_view debug_name) = 0;
+        [[nodiscard]] virtual PipelineReload PrepareReload(ShaderHandle shader,
+                                                           const ComputeShaderCreateInfo& create_info,
+                                                           std::string_view debug_name) = 0;
+        virtual void CommitReload(const PipelineReload& reload) = 0;
+        virtual void CancelReload(const PipelineReload& reload) = 0;
+    };
+
+    /// <summary>
+    /// Deduplicates pipelines above the pipeline factory of the backend. A request is keyed by a hash of
+    /// everything that shapes the pipeline, bytecode included, requests with the same key share one reference
+    /// counted shader. The key is the PipelineKey of the create info, so the pipeline library of the backend,
+    /// saved between runs, loads pipelines created by an earlier run instead of compiling them again. Only the
+    /// pipelines created by the run are saved, so ones no longer used drop out. Only IPipelineFactory is used, so
+    /// the cache runs against any backend or a fake. Safe to call from several threads, a request for a pipeline
+    /// another thread is creating waits for it.
+    /// </summary>
+    class PipelineCache final : public IPipelineCache
+    {
+    public:
+        /// <summary>
+        /// Load the pipeline library saved at path, missing or outdated files start an empty cache.
+        /// </summary>
+        void Init(IPipelineFactory& factory, std::string_view path);
+
+        /// <summary>
+        /// Save the cache and destroy every pipeline, the GPU must be done with them.
+        /// </summary>
+        void Shutdown();
+
+        [[nodiscard]] ShaderHandle Acquire(const GraphicsShaderCreateInfo& create_info,
+                                           std::string_view debug_name) override;
+        [[nodiscard]] ShaderHandle Acquire(const ComputeShaderCreateInfo& create_info,
+                                           std::string_view debug_name) override;
+
+        /// <summary>
+        /// Drop a reference, the last one destroys the pipeline. The GPU must be done with it.
+        /// </summary>
+        void Release(ShaderHandle shader) override;
+
+        /// <summary>
+        /// Create the pipeline that replaces shader, from any thread. Nothing changes until the reload is
+        /// committed.
+        /// </summary>
+        [[nodiscard]] PipelineReload PrepareReload(ShaderHandle shader, const GraphicsShaderCreateInfo& create_info,
+                                                   std::string_view debug_name) override;
+        [[nodiscard]] PipelineReload PrepareReload(ShaderHandle shader, const ComputeShaderCreateInfo& create_info,
+                                                   std::string_view debug_name) override;
+
+        /// <summary>
+        /// Swap the new pipeline into the shader, so every holder of the shader binds it from now on, and key the
+        /// shader by its new create info. Called between frames.
+        /// </summary>
+        void CommitReload(const PipelineReload& reload) override;
+
+        /// <summary>
+        /// Destroy the new pipeline of a reload that won't be committed.
+        /// </summary>
+        void CancelReload(const PipelineReload& reload) override;
+
+        [[nodiscard]] bool Save() const;
+        [[nodiscard]] PipelineCacheStats GetStats() const;
+
+        [[nodiscard]] static u64 GetKey(const GraphicsShaderCreateInfo& create_info);
+        [[nodiscard]] static u64 GetKey(const ComputeShaderCreateInfo& create_info);
+
+    private:
+        struct Entry
+        {
+            ShaderHandle Shader = ShaderHandle::eNull;
+            u32 References = 0;
+            bool Created = false;
+        };
+
+        template <typename CreateInfo>
+        [[nodiscard]] ShaderHandle AcquireShader(CreateInfo create_info, std::string_view debug_name);
+        template <typename CreateInfo>
+        [[nodiscard]] PipelineReload PrepareShaderReload(ShaderHandle shader, CreateInfo create_info,
+                                                         std::string_view debug_name);
+
+        IPipelineFactory* m_factory = nullptr;
+        std::string m_path;
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_created;
+        std::unordered_map<u64, Entry> m_entries;
+        std::unordered_map<ShaderHandle, u64> m_shader_keys;
+        PipelineCacheStats m_stats;
+    };
+} // namespace FS
@@ -3,4 +3,6 @@
 namespace FS
 {
     inline constexpr u32 kFrameCount = 3;
+    inline constexpr u32 kTextureRowPitchAlignment = 256;
+    inline constexpr u32 kTextureSubresourceAlignment = 512;
 }
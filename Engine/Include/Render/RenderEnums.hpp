@@ -140,4 +140,30 @@ namespace FS
         eStaging,
         eReadback
     };
+
+    /// <summary>
+    /// How the GPU accesses a resource. The read only states are bits that combine, a resource can be read
+    /// several ways at once.
+    /// </summary>
+    enum class ResourceState : u16
+    {
+        eCommon = 0,
+        ePresent = eCommon,
+        eRenderTarget = 1 << 0,
+        eDepthWrite = 1 << 1,
+        eUnorderedAccess = 1 << 2,
+        eCopyDest = 1 << 3,
+        eDepthRead = 1 << 4,
+        eShaderResource = 1 << 5,
+        eCopySource = 1 << 6,
+        eIndexBuffer = 1 << 7,
+        eIndirectArgument = 1 << 8,
+    };
+
+    /// Layout of the vertex buffer GeomVS reads, packed vertices use its PACKED_VERTICES permutation
+    enum class VertexFormat : u32
+    {
+        eFull = 0,
+        ePacked = 1,
+    };
 } // namespace FS
\ No newline at end of file
@@ -0,0 +1,249 @@
+#pragma once
+#include "Render/IRenderBackend.hpp"
+
+namespace FS
+{
+    class RenderGraph;
+
+    /// <summary>
+    /// Texture or buffer of a render graph, valid until the graph is reset.
+    /// </summary>
+    enum class RenderGraphResource : u32
+    {
+        eNull = std::numeric_limits<u32>::max(),
+    };
+
+    struct RenderGraphTextureDesc
+    {
+        glm::uvec2 Dimensions = glm::uvec2(0);
+        Format Format = Format::eUnknown;
+        TextureFlags Flags = TextureFlags::eRenderTexture;
+
+        bool operator==(const RenderGraphTextureDesc&) const = default;
+    };
+
+    struct RenderGraphBufferDesc
+    {
+        u32 NumElements = 0;
+        u32 Stride = 0;
+
+        bool operator==(const RenderGraphBufferDesc&) const = default;
+    };
+
+    struct RenderGraphContext
+    {
+        IRenderBackend& Backend;
+        CommandHandle Command;
+        const RenderGraph& Graph;
+    };
+
+    using RenderPassFunction = std::function<void(const RenderGraphContext& context)>;
+
+    /// <summary>
+    /// Transition of a graph resource, Before equal to After is an unordered access barrier.
+    /// </summary>
+    struct RenderGraphBarrier
+    {
+        RenderGraphResource Resource = RenderGraphResource::eNull;
+        ResourceState Before = ResourceState::eCommon;
+        ResourceState After = ResourceState::eCommon;
+    };
+
+    /// <summary>
+    /// Passes that only depend on passes of earlier levels, they run after a single batch of barriers.
+    /// </summary>
+    struct RenderGraphLevel
+    {
+        u32 FirstPass = 0;
+        u32 PassCount = 0;
+        u32 FirstBarrier = 0;
+        u32 BarrierCount = 0;
+    };
+
+    struct RenderGraphStats
+    {
+        u32 PassCount = 0;
+        u32 CulledCount = 0;
+        u32 LevelCount = 0;
+        u32 BarrierCount = 0;
+    };
+
+    /// <summary>
+    /// Declares the accesses of the pass AddPass returned, used before the next pass is added.
+    /// </summary>
+    class RenderPassBuilder
+    {
+    public:
+        RenderPassBuilder& Read(RenderGraphResource resource, ResourceState state = ResourceState::eShaderResource);
+        RenderPassBuilder& Write(RenderGraphResource resource, ResourceState state = ResourceState::eRenderTarget);
+
+        /// <summary>
+        /// Keep the pass even when nothing reads what it writes.
+        /// </summary>
+        RenderPassBuilder& SideEffect();
+
+    private:
+        friend class RenderGraph;
+        RenderPassBuilder(RenderGraph& graph, const u32 pass) : m_graph(graph), m_pass(pass) {}
+
+        RenderGraph& m_graph;
+        u32 m_pass;
+    };
+
+    /// <summary>
+    /// Frame of passes declaring what they read and write. Compiling culls the passes whose writes nobody reads,
+    /// groups the remaining ones into levels of passes that don't depend on each other and computes the
+    /// transitions each level needs, batched per level. Writing an imported resource is an output of the frame.
+    /// Compiling only touches flat arrays kept between frames, so rebuilding the graph every frame costs
+    /// microseconds. Transient resources are created by the graph on execute and reused by later frames.
+    /// </summary>
+    class RenderGraph
+    {
+    public:
+        /// <summary>
+        /// Start a new frame, the resources and passes of the previous one are dropped.
+        /// </summary>
+        void Reset();
+
+        /// <summary>
+        /// Destroy the transient resources, the GPU must be done with them.
+        /// </summary>
+        void Shutdown(IRenderBackend& backend);
+
+        /// <summary>
+        /// Resource created outside the graph, in state when the frame starts and left in final_state.
+        /// </summary>
+        [[nodiscard]] RenderGraphResource ImportTexture(std::string_view name, TextureHandle texture,
+                                                        ResourceState state, ResourceState final_state);
+        [[nodiscard]] RenderGraphResource ImportBuffer(std::string_view name, BufferHandle buffer,
+                                                       ResourceState state, ResourceState final_state);
+
+        [[nodiscard]] RenderGraphResource CreateTexture(std::string_view name, const RenderGraphTextureDesc& desc);
+        [[nodiscard]] RenderGraphResource CreateBuffer(std::string_view name, const RenderGraphBufferDesc& desc);
+
+        /// <summary>
+        /// Passes are added in an order that respects their dependencies, a pass only reads what earlier
+        /// passes wrote. Names of passes and resources are not copied, they are typically literals.
+        /// </summary>
+        [[nodiscard]] RenderPassBuilder AddPass(std::string_view name, RenderPassFunction function);
+
+        void Compile();
+
+        /// <summary>
+        /// Run the compiled passes level by level, each level after its barriers.
+        /// </summary>
+        void Execute(IRenderBackend& backend, CommandHandle command);
+
+        /// <summary>
+        /// Backend handle of a resource, only valid while executing.
+        /// </summary>
+        [[nodiscard]] TextureHandle GetTexture(RenderGraphResource resource) const;
+        [[nodiscard]] BufferHandle GetBuffer(RenderGraphResource resource) const;
+
+        /// <summary>
+        /// Passes that survived culling, in execution order, and the levels and barriers splitting them.
+        /// </summary>
+        [[nodiscard]] Span<const u32> GetOrder() const { return m_order; }
+        [[nodiscard]] Span<const RenderGraphLevel> GetLevels() const { return m_levels; }
+        [[nodiscard]] Span<const RenderGraphBarrier> GetBarriers() const { return m_barriers; }
+        /// <summary>
+        /// Barriers leaving the imported resources in their final state, after the last level.
+        /// </summary>
+        [[nodiscard]] Span<const RenderGraphBarrier> GetFinalBarriers() const;
+        [[nodiscard]] std::string_view GetPassName(const u32 pass) const { return m_passes[pass].Name; }
+        [[nodiscard]] RenderGraphStats GetStats() const;
+
+    private:
+        friend class RenderPassBuilder;
+
+        struct Resource
+        {
+            std::string_view Name;
+            TextureHandle Texture = TextureHandle::eNull;
+            BufferHandle Buffer = BufferHandle::eNull;
+            ResourceState InitialState = ResourceState::eCommon;
+            ResourceState FinalState = ResourceState::eCommon;
+            bool Imported = false;
+            bool IsTexture = false;
+            RenderGraphTextureDesc TextureDesc;
+            RenderGraphBufferDesc BufferDesc;
+        };
+
+        struct Access
+        {
+            u32 Resource = 0;
+            ResourceState State = ResourceState::eCommon;
+            bool Write = false;
+        };
+
+        struct Pass
+        {
+            std::string_view Name;
+            RenderPassFunction Function;
+            u32 FirstAccess = 0;
+            u32 AccessCount = 0;
+            bool SideEffect = false;
+        };
+
+        /// Per resource scratch of Compile
+        struct ResourceTracking
+        {
+            u32 LastWriter = 0;
+            bool Written = false;
+            /// One past the level of the last writer and of its latest reader, 0 when there is none
+            u32 WriterLevel = 0;
+            u32 ReaderLevel = 0;
+            ResourceState State = ResourceState::eCommon;
+            bool StateKnown = false;
+            bool WrittenUnordered = false;
+            /// State the level being gathered needs, PendingLevel tells whether it was set for that level
+            u32 PendingLevel = 0;
+            ResourceState PendingState = ResourceState::eCommon;
+            bool PendingWrite = false;
+        };
+
+        struct PooledTexture
+        {
+            RenderGraphTextureDesc Desc;
+            TextureHandle Texture = TextureHandle::eNull;
+            u64 LastFrame = 0;
+        };
+
+        struct PooledBuffer
+        {
+            RenderGraphBufferDesc Desc;
+            BufferHandle Buffer = BufferHandle::eNull;
+            u64 LastFrame = 0;
+        };
+
+        void AddAccess(u32 pass, RenderGraphResource resource, ResourceState state, bool write);
+        void CullPasses();
+        void ScheduleLevels();
+        void ComputeBarriers();
+        void AcquireTransients(IRenderBackend& backend);
+        void RecordBarriers(IRenderBackend& backend, CommandHandle command, Span<const RenderGraphBarrier> barriers);
+
+        Vec<Resource> m_resources;
+        Vec<Access> m_accesses;
+        Vec<Pass> m_passes;
+
+        // Compile results and scratch, kept between frames so compiling doesn't allocate
+        Vec<u8> m_live;
+        /// Writers of what each pass reads or writes, the passes it needs
+        Vec<u32> m_producers;
+        Vec<u32> m_producer_offsets;
+        Vec<u32> m_pass_levels;
+        Vec<u32> m_level_offsets;
+        Vec<ResourceTracking> m_tracking;
+        Vec<u32> m_touched;
+        Vec<u32> m_order;
+        Vec<RenderGraphLevel> m_levels;
+        Vec<RenderGraphBarrier> m_barriers;
+        u32 m_final_barrier = 0;
+        Vec<ResourceBarrier> m_backend_barriers;
+
+        Vec<PooledTexture> m_texture_pool;
+        Vec<PooledBuffer> m_buffer_pool;
+        u64 m_frame = 0;
+    };
+} // namespace FS
@@ -62,6 +62,18 @@ namespace FS
         float ClearDepth = 1.0f;
     };
 
+    /// <summary>
+    /// Transition of a texture or a buffer. Before equal to After on an unordered access resource orders the
+    /// unordered accesses before the barrier with those after it.
+    /// </summary>
+    struct ResourceBarrier
+    {
+        TextureHandle Texture = TextureHandle::eNull;
+        BufferHandle Buffer = BufferHandle::eNull;
+        ResourceState Before = ResourceState::eCommon;
+        ResourceState After = ResourceState::eCommon;
+    };
+
     struct FrameData
     {
         CommandHandle CommandHandle = CommandHandle::eNull;
@@ -94,6 +106,22 @@ namespace FS
         eShaderResource = 1 << 2
     };
     
+    /// Where a subresource lives inside a texture upload, rows are block rows for compressed formats
+    struct TextureSubresource
+    {
+        u64 Offset = 0;
+        u32 Width = 0;
+        u32 Height = 0;
+        u32 RowPitch = 0;
+        u32 RowCount = 0;
+    };
+
+    struct TextureUploadInfo
+    {
+        const void* Data = nullptr;
+        Span<const TextureSubresource> Subresources{};
+    };
+
     struct TextureCreateInfo
     {
         glm::uvec2 Dimensions;
@@ -103,12 +131,14 @@ namespace FS
         ViewType ViewType{};
         EnumFlags<TextureFlags> TextureFlags;
         ResourceHandle ResourceHandle = ResourceHandle::eNull;
+        TextureUploadInfo UploadInfo;
     };
 
+    /// Bytecode is only read during CreateShader, it typically points into the mapped shader library
     struct GraphicsShaderCreateInfo
     {
-        std::vector<char> VertexCode = {};
-        std::vector<char> FragmentCode = {};
+        Span<const char> VertexCode = {};
+        Span<const char> FragmentCode = {};
         PrimitiveTopology PrimitiveTopology = PrimitiveTopology::eTriangle;
         std::vector<Format> RenderTargetFormats{};
         u32 NumRenderTargets = 0;
@@ -116,11 +146,15 @@ namespace FS
         FillMode FillMode = FillMode::eSolid;
         CullMode CullMode = CullMode::eBack;
         FrontFace FrontFace = FrontFace::eCounterClockwise;
+        /// Name of the pipeline in the pipeline library, 0 to bypass it
+        u64 PipelineKey = 0;
     };
 
     struct ComputeShaderCreateInfo
     {
-        std::vector<char> ComputeCode = {};
+        Span<const char> ComputeCode = {};
+        /// Name of the pipeline in the pipeline library, 0 to bypass it
+        u64 PipelineKey = 0;
     };
 
     struct Viewport
@@ -144,4 +178,26 @@ namespace FS
         float UVy;
         glm::vec4 Tangent;
     };
+
+    /// <summary>
+    /// Compact Vertex of 20 bytes. Positions are unorm16 in the bounds of the mesh, normal and tangent are
+    /// octahedral snorm16 pairs, the bitangent sign is bit 16 of PositionZFlags and UVs are halves.
+    /// </summary>
+    struct PackedVertex
+    {
+        u32 PositionXY = 0;
+        u32 PositionZFlags = 0;
+        u32 Normal = 0;
+        u32 Tangent = 0;
+        u32 UV = 0;
+    };
+
+    /// <summary>
+    /// Decodes the packed positions of a mesh as PositionMin + quantized * PositionScale.
+    /// </summary>
+    struct VertexQuantization
+    {
+        glm::vec3 PositionMin{0.0f};
+        glm::vec3 PositionScale{0.0f};
+    };
 } // namespace FS
@@ -0,0 +1,99 @@
+#pragma once
+#include "Asset/ShaderCompiler.hpp"
+#include "Asset/ShaderLibrary.hpp"
+#include "Core/JobSystem.hpp"
+#include "Render/AsyncPipelineCompiler.hpp"
+
+namespace FS
+{
+    struct ShaderHotReloadSettings
+    {
+        /// Directory of the .hlsl sources, cooked like FirestormCook -s does
+        std::string SourceDirectory;
+        /// Directory of the cooked shaders, holding the shader cache, Shaders.fslib and the reloaded versions
+        std::string OutputDirectory;
+        f32 PollSeconds = 0.25f;
+        /// Threads compiling the changed shaders, 0 uses half the hardware threads
+        u32 WorkerCount = 0;
+    };
+
+    /// <summary>
+    /// Permutation of a shader of the library.
+    /// </summary>
+    struct ShaderPermutationRef
+    {
+        std::string Shader;
+        u32 Key = 0;
+    };
+
+    /// <summary>
+    /// Recompiles shaders while the engine runs. Sources are polled on a thread of its own, a change cooks the
+    /// changed permutations into a new version of the shader library next to the one of the build. The newest
+    /// library is loaded, so one written by the build is picked up too, which needs the shader preloader to read
+    /// the library instead of mapping it.
+    /// Tracked pipelines whose bytecode changed are reloaded through the asynchronous pipeline compiler, which
+    /// swaps the new pipeline into the existing shader handle between frames. The main thread never waits on a
+    /// compile or a file.
+    /// </summary>
+    class ShaderHotReload
+    {
+    public:
+        void Init(AsyncPipelineCompiler& compiler, const ShaderHotReloadSettings& settings);
+        void Shutdown();
+
+        /// <summary>
+        /// Reload the pipeline when the bytecode of its vertex or fragment permutation changes. The create info
+        /// is the one the pipeline was created from, its bytecode is replaced on reload.
+        /// </summary>
+        void Track(PipelineHandle pipeline, const GraphicsShaderCreateInfo& create_info, std::string debug_name,
+                   ShaderPermutationRef vertex, ShaderPermutationRef fragment);
+
+        /// <summary>
+        /// Start a poll when due and reload the pipelines of a library the last poll loaded, called once per
+        /// frame on the main thread.
+        /// </summary>
+        void Update();
+
+    private:
+        struct TrackedPipeline
+        {
+            PipelineHandle Pipeline = PipelineHandle::eNull;
+            GraphicsShaderCreateInfo CreateInfo;
+            std::string DebugName;
+            ShaderPermutationRef Vertex;
+            ShaderPermutationRef Fragment;
+            u64 VertexHash = 0;
+            u64 FragmentHash = 0;
+        };
+
+        struct Library
+        {
+            Vec<char> Data;
+            ShaderLibraryView View;
+        };
+
+        /// <summary>
+        /// Cook the sources when they changed and load the library when it changed, on the poll thread.
+        /// </summary>
+        void Poll();
+        void Apply(const Ref<Library>& library);
+
+        AsyncPipelineCompiler* m_compiler = nullptr;
+        ShaderHotReloadSettings m_settings;
+        DxcShaderCompiler m_shader_compiler;
+        JobSystem m_jobs;
+        JobCounter m_poll;
+        std::chrono::steady_clock::time_point m_last_poll;
+
+        Vec<TrackedPipeline> m_pipelines;
+        /// Libraries the bytecode of queued reloads points into, kept until the compiles are done
+        Vec<Ref<Library>> m_libraries;
+
+        // Only touched by the poll, the main thread reads m_loaded once the poll is done
+        u64 m_source_stamp = 0;
+        u32 m_library_version = 0;
+        std::filesystem::path m_library_path;
+        std::filesystem::file_time_type m_library_time;
+        Ref<Library> m_loaded;
+    };
+} // namespace FS
@@ -0,0 +1,93 @@
+#pragma once
+#include "Render/RenderStructs.hpp"
+
+namespace FS
+{
+    /// Permutations of a shader live in a dense table of 2^features entries
+    inline constexpr u32 kMaxShaderFeatures = 8;
+
+    /// <summary>
+    /// Key of a shader permutation. A shader declares its features with one "// Feature: NAME" line each and sees
+    /// every feature as a define set to 0 or 1, bit i of the key is the ith declared feature. Feature is an enum
+    /// listing the same features in the same order, followed by eCount.
+    /// </summary>
+    template <typename Feature>
+    class PermutationKey
+    {
+        static_assert(static_cast<u32>(Feature::eCount) <= kMaxShaderFeatures, "Too many shader features");
+
+    public:
+        static constexpr u32 kCount = 1u << static_cast<u32>(Feature::eCount);
+
+        constexpr PermutationKey() = default;
+        constexpr PermutationKey(const std::initializer_list<Feature> features)
+        {
+            for (const Feature feature : features)
+            {
+                m_bits |= GetBit(feature);
+            }
+        }
+
+        [[nodiscard]] constexpr PermutationKey With(const Feature feature, const bool enabled = true) const
+        {
+            PermutationKey key = *this;
+            key.m_bits = enabled ? m_bits | GetBit(feature) : m_bits & ~GetBit(feature);
+            return key;
+        }
+        [[nodiscard]] constexpr bool Has(const Feature feature) const { return (m_bits & GetBit(feature)) != 0; }
+        [[nodiscard]] constexpr u32 Value() const { return m_bits; }
+
+        constexpr bool operator==(const PermutationKey&) const = default;
+
+    private:
+        [[nodiscard]] static constexpr u32 GetBit(const Feature feature) { return 1u << static_cast<u32>(feature); }
+
+        u32 m_bits = 0;
+    };
+
+    /// <summary>
+    /// Shaders of every permutation of a feature set, selecting one is a single array index. Stripped
+    /// permutations stay eNull. Handle is a ShaderHandle or a PipelineHandle of pipelines still compiling.
+    /// </summary>
+    template <typename Feature, typename Handle = ShaderHandle>
+    class ShaderPermutations
+    {
+    public:
+        [[nodiscard]] Handle Get(const PermutationKey<Feature> key) const { return m_shaders[key.Value()]; }
+        [[nodiscard]] Handle& operator[](const u32 key) { return m_shaders[key]; }
+        [[nodiscard]] static constexpr u32 Count() { return PermutationKey<Feature>::kCount; }
+
+    private:
+        Array<Handle, PermutationKey<Feature>::kCount> m_shaders = MakeFilled();
+
+        static constexpr Array<Handle, PermutationKey<Feature>::kCount> MakeFilled()
+        {
+            Array<Handle, PermutationKey<Feature>::kCount> shaders;
+            shaders.fill(Handle::eNull);
+            return shaders;
+        }
+    };
+
+    /// <summary>
+    /// Permutations of a shader the engine can select.
+    /// </summary>
+    struct ShaderPermutationUsage
+    {
+        /// Name of the shader source without its extension, like GeomVS
+        std::string_view Shader;
+        Span<const u32> Keys;
+    };
+
+    /// <summary>
+    /// Usage of every shader with features, the cook strips the other permutations from the tables. Shaders
+    /// missing from the list keep all their permutations.
+    /// </summary>
+    [[nodiscard]] Span<const ShaderPermutationUsage> GetShaderPermutationUsage();
+
+    /// Features of GeomVS
+    enum class GeomFeature : u8
+    {
+        ePackedVertices,
+        eCount,
+    };
+} // namespace FS
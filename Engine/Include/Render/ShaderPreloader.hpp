@@ -0,0 +1,32 @@
+#pragma once
+#include "Asset/ShaderLibrary.hpp"
+#include "Core/MappedFile.hpp"
+
+namespace FS
+{
+    /// <summary>
+    /// Maps the shader library for the asynchronous pipeline compiler. Loading every shader costs a single
+    /// mapping, the bytecode handed to the backend points straight into it and is never copied.
+    /// </summary>
+    class ShaderPreloader
+    {
+    public:
+        /// <summary>
+        /// Map the library, or read it into memory when read_file is set. A mapped file can't be written, so
+        /// with shader hot reload the library is read to let the build replace it while the engine runs.
+        /// </summary>
+        [[nodiscard]] bool Init(std::string_view library_path, bool read_file = false);
+        void Shutdown();
+
+        /// <summary>
+        /// Bytecode of a permutation of a shader, empty when the shader is missing or the permutation was
+        /// stripped. Valid until shutdown.
+        /// </summary>
+        [[nodiscard]] Span<const char> GetBytecode(std::string_view shader, u32 key = 0) const;
+
+    private:
+        MappedFile m_file;
+        Vec<char> m_data;
+        ShaderLibraryView m_library;
+    };
+} // namespace FS
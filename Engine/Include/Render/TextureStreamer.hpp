@@ -0,0 +1,138 @@
+#pragma once
+
+namespace FS
+{
+    enum class StreamingTextureHandle : u32
+    {
+        eNull = std::numeric_limits<u32>::max(),
+    };
+
+    enum class StreamingAction : u8
+    {
+        /// Make every mip from Mip down resident
+        eLoad,
+        /// Drop every mip finer than Mip
+        eEvict,
+    };
+
+    struct StreamingRequest
+    {
+        StreamingTextureHandle Texture = StreamingTextureHandle::eNull;
+        StreamingAction Action = StreamingAction::eLoad;
+        u16 Mip = 0;
+    };
+
+    struct StreamingTextureDesc
+    {
+        /// Bytes of every mip, level 0 first
+        Span<const u64> MipSizes;
+        /// Smallest mips that are resident from registration on and never evicted
+        u16 TailMipCount = 1;
+    };
+
+    struct TextureStreamerSettings
+    {
+        /// Bytes the streamed mips may use, the mip tails are always resident on top of it
+        u64 Budget = 512ull << 20;
+        u32 MaxPendingLoads = 8;
+    };
+
+    /// <summary>
+    /// Finest mip worth having resident for a texture drawn screen_size pixels across its largest dimension.
+    /// </summary>
+    [[nodiscard]] u16 GetRequiredMip(glm::uvec2 dimensions, f32 screen_size, u16 mip_levels);
+
+    /// <summary>
+    /// Decides which mips of which textures are resident. Textures stay resident from some mip down to the
+    /// end of the chain, draws request the mip they need every frame and Update turns the requests into
+    /// loads and evictions that keep the streamed mips within the budget, evicting the least recently used
+    /// textures first. Doesn't touch files or the GPU, the caller carries out the requests and reports
+    /// finished loads with CompleteLoad. Evicted mips and replaced GPU textures count against the budget until
+    /// the caller reports them gone with Retire and FreeRetired, so loads wait for that memory.
+    /// </summary>
+    class TextureStreamer
+    {
+    public:
+        explicit TextureStreamer(const TextureStreamerSettings& settings = {});
+
+        [[nodiscard]] StreamingTextureHandle Register(const StreamingTextureDesc& desc);
+        void Unregister(StreamingTextureHandle texture);
+
+        /// <summary>
+        /// Ask for a mip to be resident this frame, the finest mip requested during a frame wins.
+        /// </summary>
+        void Request(StreamingTextureHandle texture, u16 mip);
+
+        /// <summary>
+        /// Schedule the requests of the frame that just ended and start the next frame. Loads are counted
+        /// against the budget as soon as they are issued, evictions take effect immediately.
+        /// </summary>
+        [[nodiscard]] Vec<StreamingRequest> Update();
+
+        void CompleteLoad(StreamingTextureHandle texture, bool success);
+
+        /// <summary>
+        /// The GPU texture holding mip and everything coarser was replaced but stays alive for the frames in
+        /// flight. Its streamed bytes count against the budget until passed to FreeRetired, returns them.
+        /// </summary>
+        [[nodiscard]] u64 Retire(StreamingTextureHandle texture, u16 mip);
+        void FreeRetired(u64 size);
+
+        [[nodiscard]] u16 GetResidentMip(StreamingTextureHandle texture) const;
+        [[nodiscard]] bool IsLoadPending(StreamingTextureHandle texture) const;
+        /// Streamed bytes resident or being loaded, the mip tails aren't included
+        [[nodiscard]] u64 GetStreamedSize() const { return m_streamed_size; }
+        /// Streamed bytes evicted or replaced whose GPU textures are still alive
+        [[nodiscard]] u64 GetRetiredSize() const { return m_replaced_size + m_retired_size; }
+        [[nodiscard]] u64 GetTailSize() const { return m_tail_size; }
+        [[nodiscard]] u64 GetBudget() const { return m_settings.Budget; }
+
+    private:
+        static constexpr u32 kNone = std::numeric_limits<u32>::max();
+
+        struct Entry
+        {
+            /// Bytes from a mip to the end of the chain, with a trailing zero
+            Vec<u64> ChainSizes;
+            u16 TailMip = 0;
+            u16 ResidentMip = 0;
+            u16 RequestedMip = 0;
+            u16 PendingMip = 0;
+            u64 LastUsedFrame = 0;
+            /// Streamed bytes of the GPU texture mips were evicted from, alive until the smaller one is created
+            u64 ReplacedSize = 0;
+            /// Streamed bytes of the GPU texture the pending load replaces
+            u64 LoadReplacedSize = 0;
+            bool Registered = false;
+            bool Pending = false;
+            bool Evicted = false;
+            /// Least recently used links, the head is the most recent
+            u32 Prev = kNone;
+            u32 Next = kNone;
+        };
+
+        [[nodiscard]] u64 GetStreamedSize(const Entry& entry, u16 mip) const;
+        /// Finest mip the entry could be evicted down to without hurting this frame
+        [[nodiscard]] u16 GetEvictionLimit(const Entry& entry) const;
+        /// <summary>
+        /// Evict for size more streamed bytes, true once they fit next to replaced_size bytes of the texture they
+        /// replace and the textures still alive from earlier evictions and loads.
+        /// </summary>
+        bool MakeRoom(u64 size, u64 replaced_size, u32 requester);
+        void Release(u32 index);
+        void Unlink(u32 index);
+        void PushFront(u32 index);
+
+        TextureStreamerSettings m_settings;
+        Vec<Entry> m_entries;
+        Vec<u32> m_free_entries;
+        u32 m_lru_head = kNone;
+        u32 m_lru_tail = kNone;
+        u32 m_pending_loads = 0;
+        u64 m_streamed_size = 0;
+        u64 m_replaced_size = 0;
+        u64 m_retired_size = 0;
+        u64 m_tail_size = 0;
+        u64 m_frame = 1;
+    };
+} // namespace FS
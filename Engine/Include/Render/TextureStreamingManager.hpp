@@ -0,0 +1,90 @@
+#pragma once
+#include "Asset/CookedTexture.hpp"
+#include "Core/JobSystem.hpp"
+#include "Render/IRenderBackend.hpp"
+#include "Render/TextureStreamer.hpp"
+
+namespace FS
+{
+    /// <summary>
+    /// Streams the mips of cooked textures. Loading a texture only reads its mip tail, finer mips are read on
+    /// worker threads when draws request them and dropped again under memory pressure. The cooked data stores
+    /// the smallest mip first, so every residency change is a single read of a prefix of the data, after which
+    /// the GPU texture is recreated with the new mip range.
+    /// </summary>
+    class TextureStreamingManager
+    {
+    public:
+        /// Mips up to this size along their largest dimension are loaded with the texture and never evicted
+        static constexpr u32 kMipTailDimension = 64;
+
+        void Init(IRenderBackend& backend, const TextureStreamerSettings& settings = {});
+        void Shutdown();
+
+        [[nodiscard]] StreamingTextureHandle Load(std::string_view path);
+        void Unload(StreamingTextureHandle texture);
+
+        /// <summary>
+        /// Report that the texture is drawn this frame covering screen_size pixels along its largest dimension.
+        /// </summary>
+        void Request(StreamingTextureHandle texture, f32 screen_size);
+
+        /// <summary>
+        /// Swap in finished reads and issue the reads for this frame's requests, call once per frame.
+        /// </summary>
+        void Update();
+
+        /// <summary>
+        /// Current GPU texture, which changes whenever the resident mips do.
+        /// </summary>
+        [[nodiscard]] TextureHandle GetTexture(StreamingTextureHandle texture) const;
+        [[nodiscard]] const TextureStreamer& GetStreamer() const { return m_streamer; }
+
+    private:
+        struct Texture
+        {
+            std::string Path;
+            CookedTextureHeader Header;
+            Vec<TextureSubresource> Subresources;
+            TextureHandle Handle = TextureHandle::eNull;
+            /// Finest mip Handle holds
+            u16 Mip = 0;
+            /// Bumped on unload, so reads still in flight for a previous texture are dropped
+            u32 Generation = 0;
+        };
+
+        struct CompletedRead
+        {
+            StreamingTextureHandle Texture = StreamingTextureHandle::eNull;
+            u32 Generation = 0;
+            StreamingAction Action = StreamingAction::eLoad;
+            u16 Mip = 0;
+            Vec<char> Data;
+            bool Success = false;
+        };
+
+        struct RetiredTexture
+        {
+            TextureHandle Handle = TextureHandle::eNull;
+            u64 Frame = 0;
+            /// Bytes the streamer counts against the budget until the texture is destroyed
+            u64 StreamedSize = 0;
+        };
+
+        void Retire(StreamingTextureHandle handle, Texture& texture);
+
+        void Read(StreamingTextureHandle texture, StreamingAction action, u16 mip);
+        void Recreate(StreamingTextureHandle handle, u16 mip, const Vec<char>& data);
+
+        IRenderBackend* m_backend = nullptr;
+        TextureStreamer m_streamer;
+        Vec<Texture> m_textures;
+
+        std::mutex m_completed_mutex;
+        Vec<CompletedRead> m_completed;
+        JobCounter m_reads;
+
+        Vec<RetiredTexture> m_retired;
+        u64 m_frame = 0;
+    };
+} // namespace FS
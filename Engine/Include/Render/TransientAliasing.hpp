@@ -0,0 +1,59 @@
+#pragma once
+
+namespace FS
+{
+    /// <summary>
+    /// Transient texture or buffer as the aliasing planner sees it. Passes are indices in execution order, the
+    /// resource is in use from FirstPass to LastPass inclusive. Size and a power of two alignment are the ones
+    /// the backend reports for the resource.
+    /// </summary>
+    struct TransientResourceDesc
+    {
+        u32 FirstPass = 0;
+        u32 LastPass = 0;
+        u64 Size = 0;
+        u64 Alignment = 1;
+    };
+
+    /// <summary>
+    /// Recorded right before Pass: After takes over memory Before used last. Before is kAnyResource when
+    /// several earlier resources used that memory.
+    /// </summary>
+    struct AliasingBarrier
+    {
+        static constexpr u32 kAnyResource = std::numeric_limits<u32>::max();
+
+        u32 Pass = 0;
+        u32 Before = kAnyResource;
+        u32 After = 0;
+    };
+
+    struct TransientAliasingStats
+    {
+        /// Heap size with every resource in memory of its own
+        u64 UnaliasedSize = 0;
+        /// Heap size of the plan
+        u64 HeapSize = 0;
+        /// Largest sum of the sizes of the resources in use by the same pass, no plan gets below it
+        u64 PeakLiveSize = 0;
+
+        [[nodiscard]] u64 SavedSize() const { return UnaliasedSize - HeapSize; }
+    };
+
+    struct TransientAliasingPlan
+    {
+        /// Heap offset of each resource, in the order they were passed
+        Vec<u64> Offsets;
+        /// Sorted by pass
+        Vec<AliasingBarrier> Barriers;
+        TransientAliasingStats Stats;
+    };
+
+    /// <summary>
+    /// Places transient resources in one heap so resources whose lifetimes don't overlap share memory. The
+    /// resources conflicting in time form an interval graph, which is coloured greedily with offsets: largest
+    /// resources first, each at the lowest aligned offset no resource it conflicts with occupies. Aliasing
+    /// barriers are emitted wherever a resource reuses memory of an earlier one. Pure CPU, backend agnostic.
+    /// </summary>
+    [[nodiscard]] TransientAliasingPlan PlanTransientAliasing(Span<const TransientResourceDesc> resources);
+} // namespace FS
@@ -0,0 +1,41 @@
+#pragma once
+
+namespace FS
+{
+    /// <summary>
+    /// Streaming XXH64 (Collet), fast enough to hash source assets on every build. Feeding the same bytes in
+    /// any split gives the same hash as one call over all of them.
+    /// </summary>
+    class ContentHasher
+    {
+    public:
+        explicit ContentHasher(u64 seed = 0);
+
+        void Update(const void* data, u64 size);
+        void Update(const std::string_view string)
+        {
+            // Length first, so a list of strings can't hash like their concatenation
+            Update(static_cast<u64>(string.size()));
+            Update(string.data(), string.size());
+        }
+
+        template <typename T>
+            requires std::is_trivially_copyable_v<T>
+        void Update(const T& value)
+        {
+            Update(&value, sizeof(T));
+        }
+
+        [[nodiscard]] u64 Finalize() const;
+
+    private:
+        Array<u64, 4> m_accumulators{};
+        Array<u8, 32> m_buffer{};
+        u64 m_buffered = 0;
+        u64 m_total = 0;
+        u64 m_seed = 0;
+    };
+
+    [[nodiscard]] u64 HashContent(const void* data, u64 size, u64 seed = 0);
+    [[nodiscard]] inline u64 HashContent(const Span<const char> data) { return HashContent(data.data(), data.size()); }
+} // namespace FS
@@ -0,0 +1,108 @@
+#pragma once
+#include "random"
+#include "Tools/Tools.hpp"
+
+namespace FS
+{
+    constexpr u64 SplitMix64(u64& state)
+    {
+        u64 z = state += 0x9e3779b97f4a7c15;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+    }
+
+    /// xoshiro256** (Blackman and Vigna). 32 bytes of state, so every thread can own one.
+    /// Satisfies UniformRandomBitGenerator and can be used with the std distributions.
+    class Xoshiro256
+    {
+    public:
+        using result_type = u64;
+
+        constexpr explicit Xoshiro256(const u64 seed = 0x853c49e6748fea9b) { Seed(seed); }
+
+        constexpr void Seed(u64 seed)
+        {
+            for (auto& state : m_state)
+            {
+                state = SplitMix64(seed);
+            }
+        }
+
+        static constexpr u64 min() { return 0; }
+        static constexpr u64 max() { return std::numeric_limits<u64>::max(); }
+
+        constexpr u64 operator()()
+        {
+            const u64 result = std::rotl(m_state[1] * 5, 7) * 9;
+            const u64 t = m_state[1] << 17;
+            m_state[2] ^= m_state[0];
+            m_state[3] ^= m_state[1];
+            m_state[1] ^= m_state[2];
+            m_state[0] ^= m_state[3];
+            m_state[2] ^= t;
+            m_state[3] = std::rotl(m_state[3], 45);
+            return result;
+        }
+
+    private:
+        Array<u64, 4> m_state{};
+    };
+
+    /// <summary>
+    /// Unique seed for a new thread local engine, mixes the system entropy source with a global counter
+    /// so two threads never share a stream.
+    /// </summary>
+    u64 CreateThreadSeed();
+
+    /// <summary>
+    /// Random engine owned by the calling thread. Never shared, so no locking is needed.
+    /// </summary>
+    inline Xoshiro256& ThreadRandom()
+    {
+        thread_local Xoshiro256 engine(CreateThreadSeed());
+        return engine;
+    }
+
+    template <typename T>
+    T RandomNumber(T min, T max)
+    {
+        if constexpr (std::is_integral_v<T>)
+        {
+            std::uniform_int_distribution<T> distribution(min, max);
+            return distribution(ThreadRandom());
+        }
+        else if constexpr (std::is_floating_point_v<T>)
+        {
+            std::uniform_real_distribution<T> distribution(min, max);
+            return distribution(ThreadRandom());
+        }
+        else
+        {
+            static_assert(false, "Unsupported type for RandomNumber");
+        }
+        return 0;
+    }
+
+    /// <summary>
+    /// Fill a span with uniformly distributed values in [min, max) for floats and [min, max] for integers.
+    /// Uses a separate vectorised engine per thread, integers use a multiply shift reduction which has a
+    /// negligible bias for ranges much smaller than 2^32.
+    /// </summary>
+    void RandomFill(Span<f32> values, f32 min, f32 max);
+    void RandomFill(Span<u32> values, u32 min, u32 max);
+    void RandomFill(Span<i32> values, i32 min, i32 max);
+
+    /// <summary>
+    /// Random (version 4) GUID.
+    /// </summary>
+    Guid CreateGuid();
+
+    /// <summary>
+    /// Time ordered (version 7) GUID. GUIDs from the same thread are strictly increasing, which keeps
+    /// sorted tables like the asset registry append friendly.
+    /// </summary>
+    Guid CreateGuidV7();
+
+    void CreateGuids(Span<Guid> guids);
+} // namespace FS
@@ -1,5 +1,4 @@
 #pragma once
-#include <random>
 
 namespace FS
 {
@@ -29,42 +28,27 @@ namespace FS
         return result;
     }
 
-    inline std::mt19937 g_random_engine;
+    inline u64 Align(const u64 value, const u64 alignment) { return (value + alignment - 1) & ~(alignment - 1); }
 
-    template <typename T>
-    T RandomNumber(T min, T max)
+    struct Guid
     {
-        if constexpr (std::is_integral_v<T>)
-        {
-            std::uniform_int_distribution<T> distribution(min, max);
-            return distribution(g_random_engine);
-        }
-        else if constexpr (std::is_floating_point_v<T>)
-        {
-            std::uniform_real_distribution<T> distribution(min, max);
-            return distribution(g_random_engine);
-        }
-        else
-        {
-            static_assert(false, "Unsupported type for RandomNumber");
-        }
-        return 0;
-    }
+        u64 High = 0;
+        u64 Low = 0;
 
-    inline GUID CreateGuid()
-    {
-        GUID guid;
-        HRESULT result = E_FAIL;
-        for (int i = 0; i < 10 && FAILED(result); ++i)
-        {
-            result = CoCreateGuid(&guid);
-        }
+        auto operator<=>(const Guid&) const = default;
+        [[nodiscard]] bool IsValid() const { return High != 0 || Low != 0; }
+    };
 
-        if (FAILED(result))
+    // FNV-1a, good enough for path and name lookups but not for content hashing
+    constexpr u64 HashString(const std::string_view string)
+    {
+        u64 hash = 0xcbf29ce484222325;
+        for (const char c : string)
         {
-            ThrowError("Failed to create GUID");
+            hash ^= static_cast<u8>(c);
+            hash *= 0x100000001b3;
         }
-        return guid;
+        return hash;
     }
 
     struct TypeHash
@@ -84,6 +68,15 @@ namespace FS
     }
 }
 
+template <>
+struct std::hash<FS::Guid>
+{
+    size_t operator()(const FS::Guid& guid) const noexcept
+    {
+        return guid.High ^ (guid.Low * 0x9e3779b97f4a7c15);
+    }
+};
+
 template <>
 struct std::hash<FS::TypeHash>
 {
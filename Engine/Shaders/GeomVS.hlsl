@@ -1,20 +1,27 @@
 
-struct Vertex
-{
-    float3 Position;
-    float UVx;
-    float3 Normal;
-    float UVy;
-    float4 Tangent;
-};
+// Feature: PACKED_VERTICES
+#include "VertexPacking.hlsli"
 
 struct PerDrawConstants
 {
+    float3 positionMin;
     uint vertexBufferIndex;
+    float3 positionScale;
 };
 
 ConstantBuffer<PerDrawConstants> PerDraw : register(b0);
 
+Vertex LoadVertex(uint vertexIndex)
+{
+#if PACKED_VERTICES
+    StructuredBuffer<PackedVertex> packedBuffer = ResourceDescriptorHeap[PerDraw.vertexBufferIndex];
+    return UnpackVertex(packedBuffer.Load(vertexIndex), PerDraw.positionMin, PerDraw.positionScale);
+#else
+    StructuredBuffer<Vertex> vertexBuffer = ResourceDescriptorHeap[PerDraw.vertexBufferIndex];
+    return vertexBuffer.Load(vertexIndex);
+#endif
+}
+
 void main(
         in  uint   inVertexIndex   : SV_VertexID,
         out float4 outPosition     : SV_Position,
@@ -22,10 +29,10 @@ void main(
         out float4 outTangent      : TANGENT,
         out float4 outColor        : COLOR)
 {
-    StructuredBuffer<Vertex> vertexBuffer = ResourceDescriptorHeap[PerDraw.vertexBufferIndex];
-    Vertex vertex = vertexBuffer.Load(inVertexIndex);
+    Vertex vertex = LoadVertex(inVertexIndex);
 
     outPosition = float4(vertex.Position, 1.0);
     outUv = float2(vertex.UVx, vertex.UVy);
-    outColor = float4(1,1,1,1);   
-}
\ No newline at end of file
+    outTangent = vertex.Tangent;
+    outColor = float4(1,1,1,1);
+}
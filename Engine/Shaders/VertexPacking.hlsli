@@ -0,0 +1,53 @@
+#ifndef VERTEX_PACKING_HLSLI
+#define VERTEX_PACKING_HLSLI
+
+struct Vertex
+{
+    float3 Position;
+    float UVx;
+    float3 Normal;
+    float UVy;
+    float4 Tangent;
+};
+
+// Must match FS::PackedVertex, decoded the same way as FS::UnpackVertex
+struct PackedVertex
+{
+    uint PositionXY;
+    uint PositionZFlags;
+    uint Normal;
+    uint Tangent;
+    uint UV;
+};
+
+float2 UnpackSnorm16x2(uint value)
+{
+    int2 bits = int2(value << 16, value) >> 16;
+    return max(float2(bits) / 32767.0, -1.0);
+}
+
+float3 DecodeOctahedral(float2 encoded)
+{
+    float3 direction = float3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    float fold = max(-direction.z, 0.0);
+    direction.x += direction.x >= 0.0 ? -fold : fold;
+    direction.y += direction.y >= 0.0 ? -fold : fold;
+    return normalize(direction);
+}
+
+Vertex UnpackVertex(PackedVertex packed, float3 positionMin, float3 positionScale)
+{
+    float3 quantized = float3(packed.PositionXY & 0xFFFF, packed.PositionXY >> 16, packed.PositionZFlags & 0xFFFF);
+    float2 uv = f16tof32(uint2(packed.UV, packed.UV >> 16));
+
+    Vertex vertex;
+    vertex.Position = positionMin + quantized * positionScale;
+    vertex.UVx = uv.x;
+    vertex.Normal = DecodeOctahedral(UnpackSnorm16x2(packed.Normal));
+    vertex.UVy = uv.y;
+    vertex.Tangent = float4(DecodeOctahedral(UnpackSnorm16x2(packed.Tangent)),
+                            packed.PositionZFlags & 0x10000 ? -1.0 : 1.0);
+    return vertex;
+}
+
+#endif
@@ -0,0 +1,478 @@
+#include "Asset/AssetCooker.hpp"
+#include "Asset/CookedMesh.hpp"
+#include "Asset/CookedMeshlets.hpp"
+#include "Asset/MeshImporter.hpp"
+#include "Asset/MeshOptimizer.hpp"
+#include "Asset/TextureImporter.hpp"
+#include "Asset/VertexPacking.hpp"
+#include "Core/JobSystem.hpp"
+#include "Core/MappedFile.hpp"
+#include "Core/Serializer.hpp"
+#include "Tools/ContentHash.hpp"
+
+namespace
+{
+    constexpr auto kDatabaseName = "CookDatabase.bin";
+    constexpr auto kStatusCooked = "Cooked";
+    constexpr auto kStatusUpToDate = "UpToDate";
+    constexpr auto kStatusFailed = "Failed";
+
+    struct CookDatabaseFile
+    {
+        std::string Path;
+        u64 Size = 0;
+        u64 WriteTime = 0;
+        u64 Hash = 0;
+    };
+
+    struct CookDatabaseItem
+    {
+        std::string Source;
+        u64 Key = 0;
+    };
+
+    struct CookDatabase
+    {
+        FS::Vec<CookDatabaseFile> Files;
+        FS::Vec<CookDatabaseItem> Items;
+    };
+
+    std::string GetExtension(const std::filesystem::path& path)
+    {
+        auto extension = path.extension().string();
+        std::ranges::transform(extension, extension.begin(), [](const char c) { return std::tolower(c); });
+        return extension;
+    }
+
+    bool IsInside(const std::filesystem::path& path, const std::filesystem::path& directory)
+    {
+        const auto [directory_end, path_end] = std::ranges::mismatch(directory, path);
+        return directory_end == directory.end();
+    }
+
+    FS::TextureImportSettings GetTextureSettings(const std::filesystem::path& path)
+    {
+        auto stem = path.stem().string();
+        std::ranges::transform(stem, stem.begin(), [](const char c) { return std::tolower(c); });
+        FS::TextureImportSettings settings{.Format = FS::Format::eBC7_UNORM_SRGB};
+        if (GetExtension(path) == ".hdr")
+        {
+            settings.SRGB = false;
+            settings.Format = FS::Format::eBC6H_UF16;
+        }
+        else if (stem.ends_with("_n") || stem.ends_with("_nrm") || stem.ends_with("_normal"))
+        {
+            settings.SRGB = false;
+            settings.MipSettings.NormalMap = true;
+            settings.Format = FS::Format::eBC5_UNORM;
+        }
+        return settings;
+    }
+
+    // Meshlets are built from the cooked mesh, so they see the same quantized vertices the GPU does
+    bool CookMeshlets(const FS::CookItem& item)
+    {
+        FS::MappedFile file;
+        if (!file.Open(item.Source))
+        {
+            return false;
+        }
+        const auto view = FS::CookedMeshView::FromMemory(file.GetSpan());
+        if (!view)
+        {
+            return false;
+        }
+
+        FS::Mesh mesh;
+        mesh.Indices.resize(view->Header->IndexCount);
+        mesh.Vertices.resize(view->Header->VertexCount);
+        if (!view->DecodeIndices(mesh.Indices))
+        {
+            return false;
+        }
+        if (view->Header->VertexFormat == FS::VertexFormat::ePacked)
+        {
+            FS::Vec<FS::PackedVertex> packed(view->Header->VertexCount);
+            const FS::Span<u8> bytes(reinterpret_cast<u8*>(packed.data()), view->GetVertexBufferSize());
+            if (!view->DecodeVertices(bytes, mesh.Indices))
+            {
+                return false;
+            }
+            std::ranges::transform(packed, mesh.Vertices.begin(), [&](const FS::PackedVertex& vertex)
+            {
+                return FS::UnpackVertex(vertex, view->Header->Quantization);
+            });
+        }
+        else if (!view->DecodeVertices(FS::Span<u8>(reinterpret_cast<u8*>(mesh.Vertices.data()),
+                                                    view->GetVertexBufferSize()),
+                                       mesh.Indices))
+        {
+            return false;
+        }
+        for (const auto& submesh : view->Submeshes)
+        {
+            mesh.Submeshes.push_back({
+                .FirstIndex = submesh.FirstIndex,
+                .IndexCount = submesh.IndexCount,
+                .Material = std::string(view->GetMaterial(submesh)),
+            });
+        }
+
+        const FS::CookedMeshlets meshlets{
+            .Meshlets = FS::BuildMeshlets(mesh),
+            .VertexCount = view->Header->VertexCount,
+        };
+        return meshlets.Write(item.Outputs.front());
+    }
+}
+
+namespace FS
+{
+    struct AssetCooker::Importers
+    {
+        explicit Importers(JobSystem& jobs) : Textures(jobs), Meshes(jobs) {}
+
+        TextureImporter Textures;
+        MeshImporter Meshes;
+    };
+
+    AssetCooker::AssetCooker(JobSystem& jobs) : m_jobs(jobs), m_importers(std::make_unique<Importers>(jobs))
+    {
+    }
+
+    AssetCooker::~AssetCooker() = default;
+
+    void AssetCooker::AddRule(CookRule rule)
+    {
+        m_rules.push_back(std::move(rule));
+    }
+
+    void AssetCooker::AddDefaultRules()
+    {
+        AddRule({
+            .Name = "Texture",
+            .SourceExtensions = {".png", ".jpg", ".jpeg", ".tga", ".bmp", ".psd", ".hdr"},
+            .OutputExtensions = {".fstex"},
+            .Cook = [this](const CookItem& item)
+            {
+                const auto texture = m_importers->Textures.Import(item.Source, GetTextureSettings(item.Source));
+                return texture && texture->Write(item.Outputs.front());
+            },
+        });
+        AddRule({
+            .Name = "Mesh",
+            .SourceExtensions = {".obj", ".gltf", ".glb"},
+            .OutputExtensions = {".fsmesh"},
+            .ScanInputs = [](const std::string_view source) { return MeshImporter::GetInputs(source); },
+            .Cook = [this](const CookItem& item)
+            {
+                auto mesh = m_importers->Meshes.Import(item.Source);
+                if (!mesh)
+                {
+                    return false;
+                }
+                OptimizeMesh(*mesh);
+                return CookedMesh::Create(*mesh, VertexFormat::ePacked).Write(item.Outputs.front());
+            },
+        });
+        AddRule({
+            .Name = "Meshlets",
+            .SourceExtensions = {".fsmesh"},
+            .OutputExtensions = {".fsmeshlets"},
+            .Cook = CookMeshlets,
+        });
+    }
+
+    CookReport AssetCooker::Cook(const CookSettings& settings)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const auto database_path = (std::filesystem::path(settings.OutputDirectory) / kDatabaseName).string();
+        LoadDatabase(database_path);
+        ScanItems(settings);
+
+        m_results.assign(m_items.size(), {});
+        m_pending = Vec<std::atomic<u32>>(m_items.size());
+        m_dependents.assign(m_items.size(), {});
+        for (u32 i = 0; i < m_items.size(); ++i)
+        {
+            m_pending[i].store(static_cast<u32>(m_items[i].Dependencies.size()), std::memory_order_relaxed);
+            for (const u32 dependency : m_items[i].Dependencies)
+            {
+                m_dependents[dependency].push_back(i);
+            }
+        }
+
+        JobCounter counter;
+        for (u32 i = 0; i < m_items.size(); ++i)
+        {
+            if (m_items[i].Dependencies.empty())
+            {
+                m_jobs.Submit([this, i, &settings, &counter] { RunItem(i, settings, counter); }, &counter);
+            }
+        }
+        m_jobs.Wait(counter);
+
+        CookReport report;
+        for (u32 i = 0; i < m_items.size(); ++i)
+        {
+            const auto& result = m_results[i];
+            report.CookedCount += result.Status == kStatusCooked;
+            report.UpToDateCount += result.Status == kStatusUpToDate;
+            report.FailedCount += result.Status == kStatusFailed;
+            report.Assets.push_back({
+                .Source = m_items[i].Source,
+                .Rule = m_rules[m_items[i].Rule].Name,
+                .Status = result.Status,
+                .Milliseconds = result.Milliseconds,
+            });
+        }
+        if (!SaveDatabase(database_path))
+        {
+            Log::Warn("AssetCooker Failed to write {}", database_path);
+        }
+        report.Milliseconds =
+            std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (!settings.ReportPath.empty() && !Serializer::Write(report, settings.ReportPath, SerializeFormat::eJson))
+        {
+            Log::Warn("AssetCooker Failed to write the report {}", settings.ReportPath);
+        }
+        Log::Info("AssetCooker {} cooked, {} up to date, {} failed in {:.1f} ms", report.CookedCount,
+                  report.UpToDateCount, report.FailedCount, report.Milliseconds);
+        return report;
+    }
+
+    void AssetCooker::ScanItems(const CookSettings& settings)
+    {
+        std::error_code ec;
+        m_items.clear();
+        m_source_root = std::filesystem::weakly_canonical(settings.SourceDirectory, ec);
+        m_output_root = std::filesystem::weakly_canonical(settings.OutputDirectory, ec);
+
+        // Sorted, so item indices and the report don't depend on the directory iteration order
+        Vec<std::filesystem::path> sources;
+        const auto options = std::filesystem::directory_options::skip_permission_denied;
+        for (std::filesystem::recursive_directory_iterator it(m_source_root, options, ec), end; it != end;
+             it.increment(ec))
+        {
+            if (it->is_directory(ec) && IsInside(it->path(), m_output_root))
+            {
+                it.disable_recursion_pending();
+            }
+            else if (it->is_regular_file(ec))
+            {
+                sources.push_back(it->path());
+            }
+        }
+        if (ec)
+        {
+            Log::Warn("AssetCooker Failed to scan {}: {}", settings.SourceDirectory, ec.message());
+        }
+        std::ranges::sort(sources);
+        for (const auto& source : sources)
+        {
+            AddItem(source, std::nullopt);
+        }
+    }
+
+    void AssetCooker::AddItem(const std::filesystem::path& source, const Opt<u32> producer)
+    {
+        const auto extension = GetExtension(source);
+        const auto rule = std::ranges::find_if(m_rules, [&](const CookRule& candidate)
+        {
+            return std::ranges::find(candidate.SourceExtensions, extension) != candidate.SourceExtensions.end();
+        });
+        if (rule == m_rules.end())
+        {
+            return;
+        }
+
+        CookItem item{.Source = source.generic_string(), .Rule = static_cast<u32>(rule - m_rules.begin())};
+        for (const auto& output_extension : rule->OutputExtensions)
+        {
+            auto output = producer ? source : m_output_root / std::filesystem::relative(source, m_source_root);
+            if (producer)
+            {
+                output.replace_extension(output_extension);
+            }
+            else
+            {
+                output += output_extension;
+            }
+            item.Outputs.push_back(output.generic_string());
+        }
+        if (producer)
+        {
+            item.Dependencies.push_back(*producer);
+        }
+
+        // Cooked outputs are cooked further by the rules matching them, always after the item producing them
+        const auto outputs = item.Outputs;
+        const u32 index = static_cast<u32>(m_items.size());
+        m_items.push_back(std::move(item));
+        for (const auto& output : outputs)
+        {
+            AddItem(output, index);
+        }
+    }
+
+    void AssetCooker::RunItem(const u32 index, const CookSettings& settings, JobCounter& counter)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        auto& item = m_items[index];
+        auto& result = m_results[index];
+        const auto& rule = m_rules[item.Rule];
+
+        const bool dependencies_cooked = std::ranges::none_of(item.Dependencies, [&](const u32 dependency)
+        {
+            return m_results[dependency].Status == kStatusFailed;
+        });
+        const auto source_hash = dependencies_cooked ? HashFile(item.Source, result) : std::nullopt;
+        if (!source_hash)
+        {
+            Log::Error("AssetCooker Can't cook {}, {}", item.Source,
+                       dependencies_cooked ? "the source can't be read" : "a dependency failed");
+            result.Status = kStatusFailed;
+        }
+        else
+        {
+            if (rule.ScanInputs)
+            {
+                item.Inputs = rule.ScanInputs(item.Source);
+            }
+            ContentHasher hasher;
+            hasher.Update(std::string_view(rule.Name));
+            hasher.Update(rule.Version);
+            hasher.Update(*source_hash);
+            for (const auto& input : item.Inputs)
+            {
+                // A missing input is part of the key too, the item cooks again once it shows up
+                hasher.Update(std::string_view(input));
+                hasher.Update(HashFile(input, result).value_or(0));
+            }
+            result.Key = hasher.Finalize();
+
+            const auto key = m_keys.find(item.Source);
+            const bool up_to_date = !settings.Force && key != m_keys.end() && key->second == result.Key &&
+                                    std::ranges::all_of(item.Outputs, [](const std::string& output)
+                                    {
+                                        std::error_code ec;
+                                        return std::filesystem::exists(output, ec);
+                                    });
+            if (up_to_date)
+            {
+                result.Status = kStatusUpToDate;
+            }
+            else
+            {
+                for (const auto& output : item.Outputs)
+                {
+                    std::error_code ec;
+                    std::filesystem::create_directories(std::filesystem::path(output).parent_path(), ec);
+                }
+                result.Status = rule.Cook(item) ? kStatusCooked : kStatusFailed;
+                if (result.Status == kStatusFailed)
+                {
+                    Log::Error("AssetCooker Failed to cook {}", item.Source);
+                }
+            }
+        }
+        result.Milliseconds = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        for (const u32 dependent : m_dependents[index])
+        {
+            if (m_pending[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                m_jobs.Submit([this, dependent, &settings, &counter] { RunItem(dependent, settings, counter); },
+                              &counter);
+            }
+        }
+    }
+
+    Opt<u64> AssetCooker::HashFile(const std::string& path, ItemResult& result) const
+    {
+        std::error_code ec;
+        const u64 size = std::filesystem::file_size(path, ec);
+        const auto write_time = std::filesystem::last_write_time(path, ec);
+        if (ec)
+        {
+            return std::nullopt;
+        }
+        const FileRecord record{.Size = size, .WriteTime = static_cast<u64>(write_time.time_since_epoch().count())};
+        if (const auto it = m_files.find(path);
+            it != m_files.end() && it->second.Size == record.Size && it->second.WriteTime == record.WriteTime)
+        {
+            return it->second.Hash;
+        }
+
+        MappedFile file;
+        if (size > 0 && !file.Open(path))
+        {
+            return std::nullopt;
+        }
+        auto& hashed = result.HashedFiles.emplace_back(path, record).second;
+        hashed.Hash = size > 0 ? HashContent(file.GetSpan()) : HashContent(nullptr, 0);
+        return hashed.Hash;
+    }
+
+    void AssetCooker::LoadDatabase(const std::string_view path)
+    {
+        m_files.clear();
+        m_keys.clear();
+        CookDatabase database;
+        if (!FileIO::Exists(path) || !Serializer::Read(database, path))
+        {
+            return;
+        }
+        for (auto& file : database.Files)
+        {
+            m_files.emplace(std::move(file.Path), FileRecord{file.Size, file.WriteTime, file.Hash});
+        }
+        for (auto& item : database.Items)
+        {
+            m_keys.emplace(std::move(item.Source), item.Key);
+        }
+    }
+
+    bool AssetCooker::SaveDatabase(const std::string_view path) const
+    {
+        std::unordered_map<std::string, FileRecord> hashed;
+        for (const auto& result : m_results)
+        {
+            for (const auto& [file_path, record] : result.HashedFiles)
+            {
+                hashed.insert_or_assign(file_path, record);
+            }
+        }
+
+        // Only what this cook used is kept, so removed sources drop out of the database
+        CookDatabase database;
+        std::unordered_map<std::string_view, const FileRecord*> files;
+        const auto add_file = [&](const std::string& file_path)
+        {
+            if (const auto it = hashed.find(file_path); it != hashed.end())
+            {
+                files.emplace(file_path, &it->second);
+            }
+            else if (const auto previous = m_files.find(file_path); previous != m_files.end())
+            {
+                files.emplace(file_path, &previous->second);
+            }
+        };
+        for (u32 i = 0; i < m_items.size(); ++i)
+        {
+            if (m_results[i].Status == kStatusFailed)
+            {
+                continue;
+            }
+            const auto& item = m_items[i];
+            database.Items.push_back({.Source = item.Source, .Key = m_results[i].Key});
+            add_file(item.Source);
+            std::ranges::for_each(item.Inputs, add_file);
+        }
+        for (const auto& [file_path, record] : files)
+        {
+            database.Files.push_back({std::string(file_path), record->Size, record->WriteTime, record->Hash});
+        }
+        return Serializer::Write(database, path, SerializeFormat::eBinary);
+    }
+} // namespace FS
@@ -0,0 +1,302 @@
+#include "Asset/AssetRegistry.hpp"
+#include "Core/FileWriter.hpp"
+#include "Tools/Log.hpp"
+
+namespace
+{
+    constexpr u64 kSectionAlignment = 64;
+
+    void BuildEytzinger(const FS::Vec<FS::AssetEntry>& sorted, FS::Vec<FS::AssetEntry>& layout, u64& next,
+                        const u64 node)
+    {
+        if (node > sorted.size())
+        {
+            return;
+        }
+        BuildEytzinger(sorted, layout, next, node * 2);
+        layout[node - 1] = sorted[next++];
+        BuildEytzinger(sorted, layout, next, node * 2 + 1);
+    }
+
+    void WritePadding(FS::FileWriter& writer, const u64 alignment)
+    {
+        constexpr std::array<char, kSectionAlignment> zeros{};
+        const u64 padding = FS::Align(writer.BytesWritten(), alignment) - writer.BytesWritten();
+        writer.Write(zeros.data(), padding);
+    }
+}
+
+namespace FS
+{
+    bool AssetRegistry::Open(const std::string_view path)
+    {
+        Close();
+        m_path = path;
+        if (!m_file.Open(path))
+        {
+            return false;
+        }
+
+        const auto* header = m_file.As<AssetRegistryHeader>();
+        if (m_file.Size() < sizeof(AssetRegistryHeader) ||
+            header->Magic != AssetRegistryHeader::kMagic ||
+            header->Version != AssetRegistryHeader::kVersion)
+        {
+            Log::Error("AssetRegistry::Open {} is not a valid asset registry", path);
+            m_file.Close();
+            return false;
+        }
+
+        const u64 keys_end = header->KeysOffset + (header->EntryCount + 1) * sizeof(Guid);
+        const u64 entries_end = header->EntriesOffset + header->EntryCount * sizeof(AssetEntry);
+        const u64 dependencies_end = header->DependenciesOffset + header->DependencyCount * sizeof(Guid);
+        if (std::max({keys_end, entries_end, dependencies_end}) > m_file.Size())
+        {
+            Log::Error("AssetRegistry::Open {} is truncated", path);
+            m_file.Close();
+            return false;
+        }
+
+        m_keys = m_file.As<Guid>(header->KeysOffset);
+        m_entries = m_file.As<AssetEntry>(header->EntriesOffset);
+        m_dependencies = m_file.As<Guid>(header->DependenciesOffset);
+        m_entry_count = header->EntryCount;
+        m_dependency_count = header->DependencyCount;
+        return true;
+    }
+
+    void AssetRegistry::Close()
+    {
+        m_file.Close();
+        m_keys = nullptr;
+        m_entries = nullptr;
+        m_dependencies = nullptr;
+        m_entry_count = 0;
+        m_dependency_count = 0;
+        m_overlay.clear();
+        m_overlay_added = 0;
+        m_overlay_removed = 0;
+    }
+
+    const AssetEntry* AssetRegistry::Find(const Guid& guid) const
+    {
+        if (!m_overlay.empty())
+        {
+            const auto it = m_overlay.find(guid);
+            if (it != m_overlay.end())
+            {
+                return it->second.Removed ? nullptr : &it->second.Entry;
+            }
+        }
+        return FindMapped(guid);
+    }
+
+    Span<const Guid> AssetRegistry::GetDependencies(const AssetEntry& entry) const
+    {
+        if (&entry >= m_entries && &entry < m_entries + m_entry_count)
+        {
+            return {m_dependencies + entry.FirstDependency, entry.DependencyCount};
+        }
+        const auto it = m_overlay.find(entry.Guid);
+        if (it == m_overlay.end())
+        {
+            return {};
+        }
+        return it->second.Dependencies;
+    }
+
+    u64 AssetRegistry::Size() const
+    {
+        return m_entry_count + m_overlay_added - m_overlay_removed;
+    }
+
+    void AssetRegistry::Update(const AssetMetadata& metadata)
+    {
+        const bool mapped = FindMapped(metadata.Guid) != nullptr;
+        auto [it, inserted] = m_overlay.try_emplace(metadata.Guid);
+        auto& overlay = it->second;
+        const bool present = inserted ? mapped : !overlay.Removed;
+        if (!present && mapped)
+        {
+            --m_overlay_removed;
+        }
+        else if (!present)
+        {
+            ++m_overlay_added;
+        }
+
+        overlay.Entry = AssetEntry{
+            .Guid = metadata.Guid,
+            .PathHash = metadata.PathHash,
+            .Size = metadata.Size,
+            .CookedOffset = metadata.CookedOffset,
+            .DependencyCount = static_cast<u32>(metadata.Dependencies.size()),
+            .Type = metadata.Type,
+        };
+        overlay.Dependencies = metadata.Dependencies;
+        overlay.Removed = false;
+    }
+
+    void AssetRegistry::Remove(const Guid& guid)
+    {
+        const bool mapped = FindMapped(guid) != nullptr;
+        const auto it = m_overlay.find(guid);
+        const bool present = it != m_overlay.end() ? !it->second.Removed : mapped;
+        if (!present)
+        {
+            return;
+        }
+
+        if (mapped)
+        {
+            ++m_overlay_removed;
+            m_overlay[guid] = OverlayAsset{.Entry = {}, .Dependencies = {}, .Removed = true};
+        }
+        else
+        {
+            --m_overlay_added;
+            m_overlay.erase(it);
+        }
+    }
+
+    bool AssetRegistry::Save()
+    {
+        Vec<AssetEntry> entries;
+        Vec<Guid> dependencies;
+        entries.reserve(Size());
+        dependencies.reserve(m_dependency_count);
+
+        const auto add_entry = [&](AssetEntry entry, const Span<const Guid> entry_dependencies)
+        {
+            entry.FirstDependency = static_cast<u32>(dependencies.size());
+            entry.DependencyCount = static_cast<u32>(entry_dependencies.size());
+            dependencies.insert(dependencies.end(), entry_dependencies.begin(), entry_dependencies.end());
+            entries.push_back(entry);
+        };
+
+        for (u64 i = 0; i < m_entry_count; ++i)
+        {
+            const auto& entry = m_entries[i];
+            if (!m_overlay.contains(entry.Guid))
+            {
+                add_entry(entry, GetDependencies(entry));
+            }
+        }
+        for (const auto& overlay : std::views::values(m_overlay))
+        {
+            if (!overlay.Removed)
+            {
+                add_entry(overlay.Entry, overlay.Dependencies);
+            }
+        }
+        std::ranges::sort(entries, {}, &AssetEntry::Guid);
+
+        // The mapping keeps the file locked, so it has to go before the new file replaces it.
+        // The overlay is kept around in case the write fails and the old file is mapped again.
+        const auto path = m_path;
+        auto overlay = std::move(m_overlay);
+        const u64 overlay_added = m_overlay_added;
+        const u64 overlay_removed = m_overlay_removed;
+        Close();
+        const bool written = Write(path, entries, dependencies);
+        const bool opened = Open(path);
+        if (!written)
+        {
+            m_overlay = std::move(overlay);
+            m_overlay_added = overlay_added;
+            m_overlay_removed = overlay_removed;
+            return false;
+        }
+        return opened;
+    }
+
+    bool AssetRegistry::Write(const std::string_view path, const Span<const AssetMetadata> assets)
+    {
+        Vec<const AssetMetadata*> sorted;
+        sorted.reserve(assets.size());
+        for (const auto& asset : assets)
+        {
+            sorted.push_back(&asset);
+        }
+        std::ranges::sort(sorted, {}, [](const AssetMetadata* asset) { return asset->Guid; });
+
+        Vec<AssetEntry> entries;
+        Vec<Guid> dependencies;
+        entries.reserve(sorted.size());
+        for (const auto* asset : sorted)
+        {
+            if (!entries.empty() && entries.back().Guid == asset->Guid)
+            {
+                Log::Error("AssetRegistry::Write Duplicate asset GUID {:016x}{:016x}", asset->Guid.High,
+                           asset->Guid.Low);
+                return false;
+            }
+            entries.push_back({
+                .Guid = asset->Guid,
+                .PathHash = asset->PathHash,
+                .Size = asset->Size,
+                .CookedOffset = asset->CookedOffset,
+                .FirstDependency = static_cast<u32>(dependencies.size()),
+                .DependencyCount = static_cast<u32>(asset->Dependencies.size()),
+                .Type = asset->Type,
+            });
+            dependencies.insert(dependencies.end(), asset->Dependencies.begin(), asset->Dependencies.end());
+        }
+        return Write(path, entries, dependencies);
+    }
+
+    const AssetEntry* AssetRegistry::FindMapped(const Guid& guid) const
+    {
+        // Keys are 1-indexed so the four grandchildren of a node share a cache line
+        const u64 count = m_entry_count;
+        u64 node = 1;
+        while (node <= count)
+        {
+            _mm_prefetch(reinterpret_cast<const char*>(m_keys) + node * 4 * sizeof(Guid), _MM_HINT_T0);
+            node = node * 2 + (m_keys[node] < guid);
+        }
+        node >>= std::countr_one(node) + 1;
+        if (node == 0 || m_keys[node] != guid)
+        {
+            return nullptr;
+        }
+        return &m_entries[node - 1];
+    }
+
+    bool AssetRegistry::Write(const std::string_view path, const Vec<AssetEntry>& entries,
+                              const Span<const Guid> dependencies)
+    {
+        Vec<AssetEntry> layout(entries.size());
+        u64 next = 0;
+        BuildEytzinger(entries, layout, next, 1);
+
+        Vec<Guid> keys(layout.size() + 1);
+        for (u64 i = 0; i < layout.size(); ++i)
+        {
+            keys[i + 1] = layout[i].Guid;
+        }
+
+        AssetRegistryHeader header{
+            .EntryCount = layout.size(),
+            .KeysOffset = Align(sizeof(AssetRegistryHeader), kSectionAlignment),
+            .DependencyCount = dependencies.size(),
+        };
+        header.EntriesOffset = Align(header.KeysOffset + keys.size() * sizeof(Guid), kSectionAlignment);
+        header.DependenciesOffset = Align(header.EntriesOffset + layout.size() * sizeof(AssetEntry),
+                                          kSectionAlignment);
+
+        FileWriter writer;
+        if (!writer.Open(path))
+        {
+            return false;
+        }
+        writer.Write(&header, sizeof(header));
+        WritePadding(writer, kSectionAlignment);
+        writer.Write(keys.data(), keys.size() * sizeof(Guid));
+        WritePadding(writer, kSectionAlignment);
+        writer.Write(layout.data(), layout.size() * sizeof(AssetEntry));
+        WritePadding(writer, kSectionAlignment);
+        writer.Write(dependencies.data(), dependencies.size() * sizeof(Guid));
+        return writer.Commit();
+    }
+} // namespace FS
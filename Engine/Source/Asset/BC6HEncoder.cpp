@@ -0,0 +1,341 @@
+#include "BlockEncoding.hpp"
+#include "glm/gtc/packing.hpp"
+
+namespace
+{
+    using namespace FS::BlockEncoding;
+
+    constexpr FS::Array<u8, 16> kWeights{0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+    constexpr i32 kMaxHalf = 0x7BFF;
+
+    /// <summary>
+    /// The single region modes. Mode 11 stores both endpoints with 10 bits, mode 12 stores the first with
+    /// 11 bits and the second as a 9 bit signed delta from it.
+    /// </summary>
+    enum class EncodingMode : u8
+    {
+        eMode11,
+        eMode12,
+    };
+
+    struct Block
+    {
+        alignas(32) FS::Array<BlockValues, 3> Channels{};
+    };
+
+    struct Encoding
+    {
+        EncodingMode Mode = EncodingMode::eMode11;
+        /// Quantized endpoints, two's complement for signed formats
+        FS::Array<glm::ivec3, 2> Endpoints{};
+        FS::Array<u8, kBlockPixels> Indices{};
+        f32 Error = std::numeric_limits<f32>::max();
+    };
+
+    u32 GetEndpointBits(const EncodingMode mode)
+    {
+        return mode == EncodingMode::eMode11 ? 10 : 11;
+    }
+
+    /// <summary>
+    /// Half float bits as an integer that interpolates like the hardware does. Endpoints are unquantized to
+    /// this range and the final value is scaled by 31/64 (31/32 for signed) back to half bits, so the encoder
+    /// matches pixels against the pre-scaled halves.
+    /// </summary>
+    f32 ToInterpolationDomain(const f32 value, const bool is_signed)
+    {
+        const auto bits = static_cast<i32>(glm::packHalf1x16(value));
+        i32 half = bits & 0x7FFF;
+        if (half > 0x7C00)
+        {
+            half = 0; // NaN
+        }
+        half = std::min(half, kMaxHalf);
+        if (!is_signed)
+        {
+            return bits & 0x8000 ? 0.0f : static_cast<f32>(half) * 64.0f / 31.0f;
+        }
+        return static_cast<f32>(bits & 0x8000 ? -half : half) * 32.0f / 31.0f;
+    }
+
+    i32 Unquantize(const i32 value, const u32 bits, const bool is_signed)
+    {
+        if (!is_signed)
+        {
+            if (value == 0)
+            {
+                return 0;
+            }
+            if (value == (1 << bits) - 1)
+            {
+                return 0xFFFF;
+            }
+            return ((value << 16) + 0x8000) >> bits;
+        }
+
+        const i32 magnitude = std::abs(value);
+        i32 result;
+        if (magnitude == 0)
+        {
+            result = 0;
+        }
+        else if (magnitude >= (1 << (bits - 1)) - 1)
+        {
+            result = 0x7FFF;
+        }
+        else
+        {
+            result = ((magnitude << 15) + 0x4000) >> (bits - 1);
+        }
+        return value < 0 ? -result : result;
+    }
+
+    /// Stored value whose unquantized result is closest to the target
+    i32 Quantize(const f32 target, const u32 bits, const bool is_signed)
+    {
+        const i32 min_value = is_signed ? -(1 << (bits - 1)) + 1 : 0;
+        const i32 max_value = is_signed ? (1 << (bits - 1)) - 1 : (1 << bits) - 1;
+        const f32 scale = is_signed ? static_cast<f32>(1 << (bits - 1)) / 32768.0f
+                                    : static_cast<f32>(1 << bits) / 65536.0f;
+        const auto estimate = static_cast<i32>(std::floor(target * scale));
+
+        i32 best = 0;
+        f32 best_error = std::numeric_limits<f32>::max();
+        for (i32 candidate = std::max(estimate - 1, min_value); candidate <= std::min(estimate + 1, max_value);
+             ++candidate)
+        {
+            const f32 error = std::abs(static_cast<f32>(Unquantize(candidate, bits, is_signed)) - target);
+            if (error < best_error)
+            {
+                best_error = error;
+                best = candidate;
+            }
+        }
+        return best;
+    }
+
+    Encoding Evaluate(const Block& block, const EncodingMode mode, const bool is_signed,
+                      const FS::Array<glm::ivec3, 2>& endpoints)
+    {
+        const u32 bits = GetEndpointBits(mode);
+        FS::Array<glm::vec4, 16> palette{};
+        for (u32 channel = 0; channel < 3; ++channel)
+        {
+            const i32 e0 = Unquantize(endpoints[0][channel], bits, is_signed);
+            const i32 e1 = Unquantize(endpoints[1][channel], bits, is_signed);
+            for (u32 code = 0; code < 16; ++code)
+            {
+                const i32 value = ((64 - kWeights[code]) * e0 + kWeights[code] * e1 + 32) >> 6;
+                palette[code][channel] = static_cast<f32>(value);
+            }
+        }
+
+        alignas(32) BlockValues codes{};
+        alignas(32) BlockValues errors{};
+        const BlockChannels channels{block.Channels[0].data(), block.Channels[1].data(), block.Channels[2].data()};
+        SelectNearest(channels, 3, palette, 16, codes, errors);
+
+        Encoding encoding{.Mode = mode, .Endpoints = endpoints, .Error = 0.0f};
+        for (u32 i = 0; i < kBlockPixels; ++i)
+        {
+            encoding.Indices[i] = static_cast<u8>(codes[i]);
+            encoding.Error += errors[i];
+        }
+        return encoding;
+    }
+
+    /// <summary>
+    /// Swap the endpoints if the anchor index has its top bit set, which the format implies to be zero.
+    /// Returns false if mode 12 can't represent the endpoints as a base and a delta.
+    /// </summary>
+    bool FixEndpoints(Encoding& encoding)
+    {
+        auto& [e0, e1] = encoding.Endpoints;
+        if (encoding.Indices[0] >= 8)
+        {
+            std::swap(e0, e1);
+            for (auto& index : encoding.Indices)
+            {
+                index = 15 - index;
+            }
+        }
+        if (encoding.Mode == EncodingMode::eMode12)
+        {
+            const auto delta = e1 - e0;
+            for (u32 channel = 0; channel < 3; ++channel)
+            {
+                if (delta[channel] < -256 || delta[channel] > 255)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    Encoding Fit(const Block& block, const EncodingMode mode, const bool is_signed,
+                 const FS::CompressionQuality quality)
+    {
+        glm::vec3 mean{};
+        for (u32 i = 0; i < kBlockPixels; ++i)
+        {
+            mean += glm::vec3(block.Channels[0][i], block.Channels[1][i], block.Channels[2][i]);
+        }
+        mean /= static_cast<f32>(kBlockPixels);
+
+        // Principal axis from the covariance, the channel sums are vectorised
+        alignas(32) FS::Array<BlockValues, 3> centered{};
+        for (u32 channel = 0; channel < 3; ++channel)
+        {
+            for (u32 i = 0; i < kBlockPixels; ++i)
+            {
+                centered[channel][i] = block.Channels[channel][i] - mean[channel];
+            }
+        }
+        FS::Array<glm::vec3, 3> covariance{};
+        for (u32 row = 0; row < 3; ++row)
+        {
+            for (u32 column = row; column < 3; ++column)
+            {
+                covariance[row][column] = covariance[column][row] = Dot(centered[row].data(),
+                                                                        centered[column].data());
+            }
+        }
+        glm::vec3 axis(1.0f);
+        for (u32 iteration = 0; iteration < 8; ++iteration)
+        {
+            const auto next = covariance[0] * axis.x + covariance[1] * axis.y + covariance[2] * axis.z;
+            const f32 scale = std::max({std::abs(next.x), std::abs(next.y), std::abs(next.z)});
+            if (scale < 1e-6f)
+            {
+                axis = glm::vec3(0.0f);
+                break;
+            }
+            axis = next / scale;
+        }
+        if (axis.x != 0.0f || axis.y != 0.0f || axis.z != 0.0f)
+        {
+            axis = glm::normalize(axis);
+        }
+
+        f32 min = 0.0f;
+        f32 max = 0.0f;
+        for (u32 i = 0; i < kBlockPixels; ++i)
+        {
+            const f32 t = glm::dot(glm::vec3(centered[0][i], centered[1][i], centered[2][i]), axis);
+            min = std::min(min, t);
+            max = std::max(max, t);
+        }
+        auto endpoint0 = mean + axis * min;
+        auto endpoint1 = mean + axis * max;
+
+        const u32 bits = GetEndpointBits(mode);
+        const auto quantize = [&](const glm::vec3& a, const glm::vec3& b)
+        {
+            FS::Array<glm::ivec3, 2> endpoints{};
+            for (u32 channel = 0; channel < 3; ++channel)
+            {
+                endpoints[0][channel] = Quantize(a[channel], bits, is_signed);
+                endpoints[1][channel] = Quantize(b[channel], bits, is_signed);
+            }
+            return Evaluate(block, mode, is_signed, endpoints);
+        };
+
+        auto best = quantize(endpoint0, endpoint1);
+        for (u32 iteration = 0; quality == FS::CompressionQuality::eQuality && iteration < 2 && best.Error > 0.0f;
+             ++iteration)
+        {
+            f32 aa = 0.0f, ab = 0.0f, bb = 0.0f;
+            glm::vec3 ax{}, bx{};
+            for (u32 i = 0; i < kBlockPixels; ++i)
+            {
+                const glm::vec3 value(block.Channels[0][i], block.Channels[1][i], block.Channels[2][i]);
+                const f32 beta = kWeights[best.Indices[i]] / 64.0f;
+                const f32 alpha = 1.0f - beta;
+                aa += alpha * alpha;
+                ab += alpha * beta;
+                bb += beta * beta;
+                ax += value * alpha;
+                bx += value * beta;
+            }
+            const f32 determinant = aa * bb - ab * ab;
+            if (std::abs(determinant) < 1e-6f)
+            {
+                break;
+            }
+            endpoint0 = (ax * bb - bx * ab) / determinant;
+            endpoint1 = (bx * aa - ax * ab) / determinant;
+            const auto refined = quantize(endpoint0, endpoint1);
+            if (refined.Error >= best.Error)
+            {
+                break;
+            }
+            best = refined;
+        }
+        return best;
+    }
+
+    void WriteBlock(const Encoding& encoding, u8* block)
+    {
+        BitWriter writer;
+        const auto& [e0, e1] = encoding.Endpoints;
+        if (encoding.Mode == EncodingMode::eMode11)
+        {
+            writer.Write(0x03, 5);
+            for (const auto& endpoint : {e0, e1})
+            {
+                for (u32 channel = 0; channel < 3; ++channel)
+                {
+                    writer.Write(static_cast<u32>(endpoint[channel]), 10);
+                }
+            }
+        }
+        else
+        {
+            writer.Write(0x07, 5);
+            for (u32 channel = 0; channel < 3; ++channel)
+            {
+                writer.Write(static_cast<u32>(e0[channel]), 10);
+            }
+            for (u32 channel = 0; channel < 3; ++channel)
+            {
+                writer.Write(static_cast<u32>(e1[channel] - e0[channel]), 9);
+                writer.Write(static_cast<u32>(e0[channel]) >> 10, 1);
+            }
+        }
+        for (u32 i = 0; i < kBlockPixels; ++i)
+        {
+            writer.Write(encoding.Indices[i], i == 0 ? 3 : 4);
+        }
+        writer.CopyTo(block);
+    }
+}
+
+namespace FS::BlockEncoding
+{
+    void CompressBlockBC6H(const HdrBlockPixels& pixels, const bool is_signed,
+                           const CompressionQuality quality, u8* block)
+    {
+        Block source;
+        for (u32 i = 0; i < kBlockPixels; ++i)
+        {
+            for (u32 channel = 0; channel < 3; ++channel)
+            {
+                source.Channels[channel][i] = ToInterpolationDomain(pixels[i * 4 + channel], is_signed);
+            }
+        }
+
+        auto best = Fit(source, EncodingMode::eMode11, is_signed, quality);
+        FixEndpoints(best);
+        if (quality == CompressionQuality::eQuality && best.Error > 0.0f)
+        {
+            // The extra endpoint precision helps smooth gradients as long as the endpoints are close
+            auto precise = Fit(source, EncodingMode::eMode12, is_signed, quality);
+            if (FixEndpoints(precise) && precise.Error < best.Error)
+            {
+                best = precise;
+            }
+        }
+        WriteBlock(best, block);
+    }
+} // namespace FS::BlockEncoding
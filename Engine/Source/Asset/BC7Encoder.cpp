@@ -0,0 +1,763 @@
+#include "BlockEncoding.hpp"
+
+namespace
+{
+    using namespace FS::BlockEncoding;
+
+    enum class PBitMode : u8
+    {
+        eNone,
+        /// Every endpoint has its own P-bit
+        eEndpoint,
+        /// Both endpoints of a subset share one P-bit
+        eShared,
+    };
+
+    struct ModeInfo
+    {
+        u8 Subsets = 1;
+        u8 PartitionBits = 0;
+        u8 RotationBits = 0;
+        u8 IndexSelectionBits = 0;
+        u8 ColorBits = 0;
+        u8 AlphaBits = 0;
+        PBitMode PBits = PBitMode::eNone;
+        u8 IndexBits = 0;
+        u8 SecondaryIndexBits = 0;
+    };
+
+    constexpr FS::Array<ModeInfo, 8> kModes{{
+        {.Subsets = 3, .PartitionBits = 4, .ColorBits = 4, .PBits = PBitMode::eEndpoint, .IndexBits = 3},
+        {.Subsets = 2, .PartitionBits = 6, .ColorBits = 6, .PBits = PBitMode::eShared, .IndexBits = 3},
+        {.Subsets = 3, .PartitionBits = 6, .ColorBits = 5, .IndexBits = 2},
+        {.Subsets = 2, .PartitionBits = 6, .ColorBits = 7, .PBits = PBitMode::eEndpoint, .IndexBits = 2},
+        {.RotationBits = 2, .IndexSelectionBits = 1, .ColorBits = 5, .AlphaBits = 6, .IndexBits = 2,
+         .SecondaryIndexBits = 3},
+        {.RotationBits = 2, .ColorBits = 7, .AlphaBits = 8, .IndexBits = 2, .SecondaryIndexBits = 2},
+        {.ColorBits = 7, .AlphaBits = 7, .PBits = PBitMode::eEndpoint, .IndexBits = 4},
+        {.Subsets = 2, .PartitionBits = 6, .ColorBits = 5, .AlphaBits = 5, .PBits = PBitMode::eEndpoint,
+         .IndexBits = 2},
+    }};
+
+    /// Two subset partitions, bit i is set if pixel i belongs to the second subset
+    constexpr FS::Array<u16, 64> kPartitions{
+        0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80, 0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8,
+        0xFF00, 0xFFF0, 0xF000, 0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE, 0x088C, 0x3110,
+        0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C, 0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696,
+        0xA55A, 0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660, 0x0272, 0x04E4, 0x4E40, 0x2720,
+        0xC936, 0x936C, 0x39C6, 0x639C, 0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22,
+    };
+
+    /// Anchor pixel of the second subset, the first subset is always anchored at pixel 0
+    constexpr FS::Array<u8, 64> kAnchors{
+        15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+        15, 2, 8, 2, 2, 8, 8, 15, 2, 8, 2, 2, 8, 8, 2, 2,
+        15, 15, 6, 8, 2, 8, 15, 15, 2, 8, 2, 2, 2, 15, 15, 6,
+        6, 2, 6, 8, 15, 15, 2, 2, 15, 15, 15, 15, 15, 2, 2, 15,
+    };
+
+    /// Bits 2i and 2i + 1 hold the subset of pixel i, mode 0 only reaches the first 16
+    constexpr FS::Array<u32, 64> kPartitions3{
+        0xAA685050, 0x6A5A5040, 0x5A5A4200, 0x5450A0A8, 0xA5A50000, 0xA0A05050, 0x5555A0A0, 0x5A5A5050,
+        0xAA550000, 0xAA555500, 0xAAAA5500, 0x90909090, 0x94949494, 0xA4A4A4A4, 0xA9A59450, 0x2A0A4250,
+        0xA5945040, 0x0A425054, 0xA5A5A500, 0x55A0A0A0, 0xA8A85454, 0x6A6A4040, 0xA4A45000, 0x1A1A0500,
+        0x0050A4A4, 0xAAA59090, 0x14696914, 0x69691400, 0xA08585A0, 0xAA821414, 0x50A4A450, 0x6A5A0200,
+        0xA9A58000, 0x5090A0A8, 0xA8A09050, 0x24242424, 0x00AA5500, 0x24924924, 0x24499224, 0x50A50A50,
+        0x500AA550, 0xAAAA4444, 0x66660000, 0xA5A0A5A0, 0x50A050A0, 0x69286928, 0x44AAAA44, 0x66666600,
+        0xAA444444, 0x54A854A8, 0x95809580, 0x96969600, 0xA85454A8, 0x80959580, 0xAA141414, 0x96960000,
+        0xAAAA1414, 0xA05050A0, 0xA0A5A5A0, 0x96000000, 0x40804080, 0xA9A8A9A8, 0xAAAAAA44, 0x2A4A5254,
+    };
+
+    /// Anchor pixels of the second and third subset of the three subset partitions
+    constexpr FS::Array<u8, 64> kSecondAnchors3{
+        3, 3, 15, 15, 8, 3, 15, 15, 8, 8, 6, 6, 6, 5, 3, 3,
+        3, 3, 8, 15, 3, 3, 6, 10, 5, 8, 8, 6, 8, 5, 15, 15,
+        8, 15, 3, 5, 6, 10, 8, 15, 15, 3, 15, 5, 15, 15, 15, 15,
+        3, 15, 5, 5, 5, 8, 5, 10, 5, 10, 8, 13, 15, 12, 3, 3,
+    };
+    constexpr FS::Array<u8, 64> kThirdAnchors3{
+        15, 8, 8, 3, 15, 15, 3, 8, 15, 15, 15, 15, 15, 15, 15, 8,
+        15, 8, 15, 3, 15, 8, 15, 8, 3, 15, 6, 10, 15, 15, 10, 8,
+        15, 3, 15, 10, 10, 8, 9, 10, 6, 15, 8, 15, 3, 6, 6, 8,
+        15, 3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 3, 15, 15, 8,
+    };
+
+    constexpr FS::Array<u8, 4> kWeights2{0, 21, 43, 64};
+    constexpr FS::Array<u8, 8> kWeights3{0, 9, 18, 27, 37, 46, 55, 64};
+    constexpr FS::Array<u8, 16> kWeights4{0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+    const u8* GetWeights(const u32 index_bits)
+    {
+        return index_bits == 2 ? kWeights2.data() : index_bits == 3 ? kWeights3.data() : kWeights4.data();
+    }
+
+    struct Block
+    {
+        alignas(32) FS::Array<BlockValues, 4> Channels{};
+    };
+
+    struct EndpointPair
+    {
+        FS::Array<glm::ivec4, 2> Values{};
+        FS::Array<i32, 2> PBits{};
+    };
+
+    struct FitParameters
+    {
+        u32 FirstChannel = 0;
+        u32 ChannelCount = 0;
+        u32 Bits = 0;
+        PBitMode PBits = PBitMode::eNone;
+        u32 IndexBits = 0;
+        FS::CompressionQuality Quality = FS::CompressionQuality::eFast;
+    };
+
+    struct SubsetFit
+    {
+        EndpointPair Endpoints;
+        FS::Array<u8, kBlockPixels> Indices{};
+        f32 Error = std::numeric_limits<f32>::max();
+    };
+
+    struct Encoding
+    {
+        u32 Mode = 0;
+        u32 Partition = 0;
+        u32 Rotation = 0;
+        u32 IndexSelection = 0;
+        FS::Array<EndpointPair, 3> Endpoints{};
+        FS::Array<u8, kBlockPixels> Indices{};
+        FS::Array<u8, kBlockPixels> SecondaryIndices{};
+        f32 Error = std::numeric_limits<f32>::max();
+    };
+
+    /// Sums of the values and their outer products, enough to get the mean and covariance of a subset
+    struct SubsetStats
+    {
+        f32 Count = 0.0f;
+        glm::vec4 Sum{};
+        FS::Array<glm::vec4, 4> Products{};
+
+        void Add(const glm::vec4& value)
+        {
+            Count += 1.0f;
+            Sum += value;
+            for (u32 row = 0; row < 4; ++row)
+            {
+                Products[row] += value * value[row];
+            }
+        }
+    };
+
+    u32 GetSubset(const u32 subsets, const u32 partition, const u32 pixel)
+    {
+        if (subsets == 3)
+        {
+            return kPartitions3[partition] >> pixel * 2 & 3;
+        }
+        return subsets == 2 ? kPartitions[partition] >> pixel & 1 : 0;
+    }
+
+    /// Bit i of mask s is set if pixel i belongs to subset s
+    FS::Array<u16, 3> GetSubsetMasks(const u32 subsets, const u32 partition)
+    {
+        FS::Array<u16, 3> masks{};
+        for (u32 i = 0; i < kBlockPixels; ++i)
+        {
+            masks[GetSubset(subsets, partition, i)] |= static_cast<u16>(1u << i);
+        }
+        return masks;
+    }
+
+    u32 GetAnchor(const u32 subsets, const u32 partition, const u32 subset)
+    {
+        if (subset == 0)
+        {
+            return 0;
+        }
+        if (subsets == 3)
+        {
+            return subset == 1 ? kSecondAnchors3[partition] : kThirdAnchors3[partition];
+        }
+        return kAnchors[partition];
+    }
+
+    glm::vec4 GetPixel(const Block& block, const u32 pixel, const u32 first, const u32 count)
+    {
+        glm::vec4 value{};
+        for (u32 channel = 0; channel < count; ++channel)
+        {
+            value[channel] = block.Channels[first + channel][pixel];
+        }
+        return value;
+    }
+
+    /// <summary>
+    /// Covariance of the subset and its largest eigenvector by power iteration, returns the eigenvalue.
+    /// </summary>
+    f32 GetPrincipalAxis(const SubsetStats& stats, glm::vec4& mean, glm::vec4& axis, f32& trace)
+    {
+        mean = stats.Sum / stats.Count;
+        FS::Array<glm::vec4, 4> covariance{};
+        u32 largest = 0;
+        trace = 0.0f;
+        for (u32 row = 0; row < 4; ++row)
+        {
+            covariance[row] = stats.Products[row] / stats.Count - mean * mean[row];
+            trace += covariance[row][row];
+            largest = covariance[row][row] > covariance[largest][largest] ? row : largest;
+        }
+
+        axis = covariance[largest];
+        for (u32 iteration = 0; iteration < 8; ++iteration)
+        {
+            glm::vec4 next{};
+            for (u32 row = 0; row < 4; ++row)
+            {
+                next += covariance[row] * axis[row];
+            }
+            const f32 scale = std::max({std::abs(next.x), std::abs(next.y), std::abs(next.z), std::abs(next.w)});
+            if (scale < 1e-6f)
+            {
+                axis = glm::vec4(0.0f);
+                return 0.0f;
+            }
+            axis = next / scale;
+        }
+        axis = glm::normalize(axis);
+
+        glm::vec4 projected{};
+        for (u32 row = 0; row < 4; ++row)
+        {
+            projected += covariance[row] * axis[row];
+        }
+        return glm::dot(axis, projected);
+    }
+
+    /// <summary>
+    /// Partitions into the given number of subsets ordered by the estimated error of fitting each subset with a
+    /// line through its principal axis, which is the variance left over after the largest eigenvalue.
+    /// </summary>
+    FS::Array<u8, 64> RankPartitions(const Block& block, const u32 channel_count, const u32 subsets)
+    {
+        FS::Array<glm::vec4, kBlockPixels> pixels{};
+        for (u32 i = 0; i < kBlockPixels; ++i)
+        {
+            pixels[i] = GetPixel(block, i, 0, channel_count);
+        }
+
+        FS::Array<f32, 64> estimates{};
+        for (u32 partition = 0; partition < 64; ++partition)
+        {
+            FS::Array<SubsetStats, 3> stats{};
+            for (u32 i = 0; i < kBlockPixels; ++i)
+            {
+                stats[GetSubset(subsets, partition, i)].Add(pixels[i]);
+            }
+            for (u32 subset = 0; subset < subsets; ++subset)
+            {
+                glm::vec4 mean, axis;
+                f32 trace;
+                const f32 eigenvalue = GetPrincipalAxis(stats[subset], mean, axis, trace);
+                estimates[partition] += (trace - eigenvalue) * stats[subset].Count;
+            }
+        }
+
+        FS::Array<u8, 64> order{};
+        std::iota(order.begin(), order.end(), u8{0});
+        std::ranges::stable_sort(order, {}, [&](const u8 partition) { return estimates[partition]; });
+        return order;
+    }
+
+    i32 ExpandComponent(const i32 value, const u32 bits)
+    {
+        const i32 shifted = value << (8 - bits);
+        return shifted | shifted >> bits;
+    }
+
+    glm::ivec4 ExpandEndpoint(const glm::ivec4& value, const i32 pbit, const FitParameters& parameters)
+    {
+        const bool has_pbit = parameters.PBits != PBitMode::eNone;
+        glm::ivec4 expanded{};
+        for (u32 channel = 0; channel < parameters.ChannelCount; ++channel)
+        {
+            const i32 stored = has_pbit ? value[channel] << 1 | pbit : value[channel];
+            expanded[channel] = ExpandComponent(stored, parameters.Bits + has_pbit);
+        }
+        return expanded;
+    }
+
+    /// Closest stored value to an 8 bit target after expansion, returns the squared error of the endpoint
+    f32 QuantizeEndpoint(const glm::vec4& target, const i32 pbit, const FitParameters& parameters, glm::ivec4& value)
+    {
+        const bool has_pbit = parameters.PBits != PBitMode::eNone;
+        const u32 total_bits = parameters.Bits + has_pbit;
+        const i32 max_value = (1 << parameters.Bits) - 1;
+        f32 error = 0.0f;
+        for (u32 channel = 0; channel < parameters.ChannelCount; ++channel)
+        {
+            const f32 scaled = target[channel] / 255.0f * static_cast<f32>((1 << total_bits) - 1);
+            const auto estimate = static_cast<i32>(std::round(has_pbit ? (scaled - pbit) * 0.5f : scaled));
+            f32 best_error = std::numeric_limits<f32>::max();
+            for (i32 candidate = std::max(estimate - 1, 0); candidate <= std::min(estimate + 1, max_value);
+                 ++candidate)
+            {
+                const i32 stored = has_pbit ? candidate << 1 | pbit : candidate;
+                const f32 difference = static_cast<f32>(ExpandComponent(stored, total_bits)) - target[channel];
+                if (difference * difference < best_error)
+                {
+                    best_error = difference * difference;
+                    value[channel] = candidate;
+                }
+            }
+            error += best_error;
+        }
+        return error;
+    }
+
+    SubsetFit EvaluateSubset(const Block& block, const FitParameters& parameters, const u16 mask,
+                             const EndpointPair& endpoints)
+    {
+        const auto e0 = ExpandEndpoint(endpoints.Values[0], endpoints.PBits[0], parameters);
+        const auto e1 = ExpandEndpoint(endpoints.Values[1], endpoints.PBits[1], parameters);
+        const u32 palette_size = 1u << parameters.IndexBits;
+        const u8* weights = GetWeights(parameters.IndexBits);
+        FS::Array<glm::vec4, 16> palette{};
+        for (u32 code = 0; code < palette_size; ++code)
+        {
+            for (u32 channel = 0; channel < parameters.ChannelCount; ++channel)
+            {
+                palette[code][channel] = static_cast<f32>(
+                    ((64 - weights[code]) * e0[channel] + weights[code] * e1[channel] + 32) >> 6);
+            }
+        }
+
+        BlockChannels channels{};
+        for (u32 channel = 0; channel < parameters.ChannelCount; ++channel)
+        {
+            channels[channel] = block.Channels[parameters.FirstChannel + channel].data();
+        }
+        alignas(32) BlockValues codes{};
+        alignas(32) BlockValues errors{};
+        SelectNearest(channels, parameters.ChannelCount, palette, palette_size, codes, errors);
+
+        SubsetFit fit{.Endpoints = endpoints, .Error = 0.0f};
+        for (u32 i = 0; i < kBlockPixels; ++i)
+        {
+            if (mask >> i & 1)
+            {
+                fit.Indices[i] = static_cast<u8>(codes[i]);
+                fit.Error += errors[i];
+            }
+        }
+        return fit;
+    }
+
+    /// <summary>
+    /// Quantize float endpoints for every allowed P-bit combination. The fast preset only evaluates the
+    /// combination that quantizes the endpoints themselves best.
+    /// </summary>
+    SubsetFit QuantizeSubset(const Block& block, const FitParameters& parameters, const u16 mask,
+                             const glm::vec4& endpoint0, const glm::vec4& endpoint1)
+    {
+        u32 combinations = 1;
+        if (parameters.PBits == PBitMode::eEndpoint)
+        {
+            combinations = 4;
+        }
+        else if (parameters.PBits == PBitMode::eShared)
+        {
+            combinations = 2;
+        }
+
+        FS::Array<EndpointPair, 4> candidates{};
+        FS::Array<f32, 4> quantization_errors{};
+        for (u32 combination = 0; combination < combinations; ++combination)
+        {
+            auto& candidate = candidates[combination];
+            candidate.PBits[0] = static_cast<i32>(combination & 1);
+            candidate.PBits[1] = static_cast<i32>(parameters.PBits == PBitMode::eShared ? combination & 1
+                                                                                        : combination >> 1);
+            quantization_errors[combination] =
+                QuantizeEndpoint(endpoint0, candidate.PBits[0], parameters, candidate.Values[0]) +
+                QuantizeEndpoint(endpoint1, candidate.PBits[1], parameters, candidate.Values[1]);
+        }
+
+        if (parameters.Quality == FS::CompressionQuality::eFast)
+        {
+            const auto best = std::min_element(quantization_errors.begin(),
+                                               quantization_errors.begin() + combinations);
+            return EvaluateSubset(block, parameters, mask, candidates[best - quantization_errors.begin()]);
+        }
+
+        SubsetFit best;
+        for (u32 combination = 0; combination < combinations; ++combination)
+        {
+            auto fit = EvaluateSubset(block, parameters, mask, candidates[combination]);
+            if (fit.Error < best.Error)
+            {
+                best = fit;
+            }
+        }
+        return best;
+    }
+
+    /// Least squares endpoints for the chosen indices, false if the indices don't constrain both endpoints
+    bool RefineEndpoints(const Block& block, const FitParameters& parameters, const u16 mask, const SubsetFit& fit,
+                         glm::vec4& endpoint0, glm::vec4& endpoint1)
+    {
+        const u8* weights = GetWeights(parameters.IndexBits);
+        f32 aa = 0.0f, ab = 0.0f, bb = 0.0f;
+        glm::vec4 ax{}, bx{};
+        for (u32 i = 0; i < kBlockPixels; ++i)
+        {
+            if (mask >> i & 1)
+            {
+                const auto value = GetPixel(block, i, parameters.FirstChannel, parameters.ChannelCount);
+                const f32 beta = weights[fit.Indices[i]] / 64.0f;
+                const f32 alpha = 1.0f - beta;
+                aa += alpha * alpha;
+                ab += alpha * beta;
+                bb += beta * beta;
+                ax += value * alpha;
+                bx += value * beta;
+            }
+        }
+        const f32 determinant = aa * bb - ab * ab;
+        if (std::abs(determinant) < 1e-6f)
+        {
+            return false;
+        }
+        endpoint0 = glm::clamp((ax * bb - bx * ab) / determinant, 0.0f, 255.0f);
+        endpoint1 = glm::clamp((bx * aa - ax * ab) / determinant, 0.0f, 255.0f);
+        return true;
+    }
+
+    SubsetFit FitSubset(const Block& block, const FitParameters& parameters, const u16 mask)
+    {
+        SubsetStats stats;
+        for (u32 i = 0; i < kBlockPixels; ++i)
+        {
+            if (mask >> i & 1)
+            {
+                stats.Add(GetPixel(block, i, parameters.FirstChannel, parameters.ChannelCount));
+            }
+        }
+        if (stats.Count == 0.0f)
+        {
+            return {.Error = 0.0f};
+        }
+
+        glm::vec4 mean, axis;
+        f32 trace;
+        GetPrincipalAxis(stats, mean, axis, trace);
+        f32 min = 0.0f;
+        f32 max = 0.0f;
+        for (u32 i = 0; i < kBlockPixels; ++i)
+        {
+            if (mask >> i & 1)
+            {
+                const f32 t = glm::dot(GetPixel(block, i, parameters.FirstChannel, parameters.ChannelCount) - mean,
+                                       axis);
+                min = std::min(min, t);
+                max = std::max(max, t);
+            }
+        }
+
+        auto endpoint0 = glm::clamp(mean + axis * min, 0.0f, 255.0f);
+        auto endpoint1 = glm::clamp(mean + axis * max, 0.0f, 255.0f);
+        auto fit = QuantizeSubset(block, parameters, mask, endpoint0, endpoint1);
+        if (parameters.Quality == FS::CompressionQuality::eQuality)
+        {
+            for (u32 iteration = 0; iteration < 2 && fit.Error > 0.0f; ++iteration)
+            {
+                if (!RefineEndpoints(block, parameters, mask, fit, endpoint0, endpoint1))
+                {
+                    break;
+                }
+                const auto refined = QuantizeSubset(block, parameters, mask, endpoint0, endpoint1);
+                if (refined.Error >= fit.Error)
+                {
+                    break;
+                }
+                fit = refined;
+            }
+        }
+        return fit;
+    }
+
+    /// Modes 0, 1, 2, 3, 6 and 7, every subset fits colour and alpha along one line
+    Encoding EncodeCombined(const Block& block, const u32 mode, const u32 partition,
+                            const FS::CompressionQuality quality)
+    {
+        const auto& info = kModes[mode];
+        const FitParameters parameters{
+            .ChannelCount = info.AlphaBits ? 4u : 3u,
+            .Bits = info.ColorBits,
+            .PBits = info.PBits,
+            .IndexBits = info.IndexBits,
+            .Quality = quality,
+        };
+
+        Encoding encoding{.Mode = mode, .Partition = partition, .Error = 0.0f};
+        const auto masks = GetSubsetMasks(info.Subsets, partition);
+        for (u32 subset = 0; subset < info.Subsets; ++subset)
+        {
+            const auto fit = FitSubset(block, parameters, masks[subset]);
+            encoding.Endpoints[subset] = fit.Endpoints;
+            encoding.Error += fit.Error;
+            for (u32 i = 0; i < kBlockPixels; ++i)
+            {
+                if (masks[subset] >> i & 1)
+                {
+                    encoding.Indices[i] = fit.Indices[i];
+                }
+            }
+        }
+        return encoding;
+    }
+
+    /// <summary>
+    /// Modes 4 and 5 fit colour and alpha separately. The rotation swaps alpha with one of the colour channels
+    /// so a channel that doesn't correlate with the others gets its own indices.
+    /// </summary>
+    Encoding EncodeSeparate(const Block& source, const u32 mode, const u32 rotation, const u32 index_selection,
+                            const FS::CompressionQuality quality)
+    {
+        Block block = source;
+        if (rotation != 0)
+        {
+            std::swap(block.Channels[rotation - 1], block.Channels[3]);
+        }
+
+        const auto& info = kModes[mode];
+        const FitParameters color_parameters{
+            .ChannelCount = 3,
+            .Bits = info.ColorBits,
+            .IndexBits = index_selection ? info.SecondaryIndexBits : info.IndexBits,
+            .Quality = quality,
+        };
+        const FitParameters alpha_parameters{
+            .FirstChannel = 3,
+            .ChannelCount = 1,
+            .Bits = info.AlphaBits,
+            .IndexBits = index_selection ? info.IndexBits : info.SecondaryIndexBits,
+            .Quality = quality,
+        };
+        const auto color = FitSubset(block, color_parameters, 0xFFFF);
+        const auto alpha = FitSubset(block, alpha_parameters, 0xFFFF);
+
+        Encoding encoding{
+            .Mode = mode,
+            .Rotation = rotation,
+            .IndexSelection = index_selection,
+            .Indices = index_selection ? alpha.Indices : color.Indices,
+            .SecondaryIndices = index_selection ? color.Indices : alpha.Indices,
+            .Error = color.Error + alpha.Error,
+        };
+        for (u32 endpoint = 0; endpoint < 2; ++endpoint)
+        {
+            encoding.Endpoints[0].Values[endpoint] = glm::ivec4(color.Endpoints.Values[endpoint].x,
+                                                                color.Endpoints.Values[endpoint].y,
+                                                                color.Endpoints.Values[endpoint].z,
+                                                                alpha.Endpoints.Values[endpoint].x);
+        }
+        return encoding;
+    }
+
+    bool IsAnchor(const ModeInfo& info, const u32 partition, const u32 pixel)
+    {
+        for (u32 subset = 0; subset < info.Subsets; ++subset)
+        {
+            if (pixel == GetAnchor(info.Subsets, partition, subset))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// <summary>
+    /// The most significant bit of every anchor index is implied to be zero, so subsets whose anchor has it
+    /// set get their endpoints swapped and their indices inverted.
+    /// </summary>
+    void FixAnchors(Encoding& encoding)
+    {
+        const auto& info = kModes[encoding.Mode];
+        const bool separate = info.SecondaryIndexBits != 0;
+        const auto masks = GetSubsetMasks(info.Subsets, encoding.Partition);
+        const auto swap_endpoints = [&](EndpointPair& endpoints, const bool color, const bool alpha)
+        {
+            auto& [e0, e1] = endpoints.Values;
+            if (color)
+            {
+                std::swap(e0.x, e1.x);
+                std::swap(e0.y, e1.y);
+                std::swap(e0.z, e1.z);
+            }
+            if (alpha)
+            {
+                std::swap(e0.w, e1.w);
+            }
+            if (color && alpha)
+            {
+                std::swap(endpoints.PBits[0], endpoints.PBits[1]);
+            }
+        };
+
+        for (u32 subset = 0; subset < info.Subsets; ++subset)
+        {
+            const u32 anchor = GetAnchor(info.Subsets, encoding.Partition, subset);
+            const u8 max_index = static_cast<u8>((1u << info.IndexBits) - 1);
+            if (encoding.Indices[anchor] >> (info.IndexBits - 1))
+            {
+                const bool alpha = !separate || encoding.IndexSelection;
+                swap_endpoints(encoding.Endpoints[subset], !separate || !encoding.IndexSelection, alpha);
+                for (u32 i = 0; i < kBlockPixels; ++i)
+                {
+                    if (masks[subset] >> i & 1)
+                    {
+                        encoding.Indices[i] = max_index - encoding.Indices[i];
+                    }
+                }
+            }
+        }
+
+        if (separate && encoding.SecondaryIndices[0] >> (info.SecondaryIndexBits - 1))
+        {
+            swap_endpoints(encoding.Endpoints[0], encoding.IndexSelection, !encoding.IndexSelection);
+            const u8 max_index = static_cast<u8>((1u << info.SecondaryIndexBits) - 1);
+            for (auto& index : encoding.SecondaryIndices)
+            {
+                index = max_index - index;
+            }
+        }
+    }
+
+    void WriteBlock(Encoding encoding, u8* block)
+    {
+        FixAnchors(encoding);
+        const auto& info = kModes[encoding.Mode];
+        BitWriter writer;
+        writer.Write(1u << encoding.Mode, encoding.Mode + 1);
+        writer.Write(encoding.Partition, info.PartitionBits);
+        writer.Write(encoding.Rotation, info.RotationBits);
+        writer.Write(encoding.IndexSelection, info.IndexSelectionBits);
+        for (u32 channel = 0; channel < 3; ++channel)
+        {
+            for (u32 subset = 0; subset < info.Subsets; ++subset)
+            {
+                writer.Write(encoding.Endpoints[subset].Values[0][channel], info.ColorBits);
+                writer.Write(encoding.Endpoints[subset].Values[1][channel], info.ColorBits);
+            }
+        }
+        for (u32 subset = 0; info.AlphaBits && subset < info.Subsets; ++subset)
+        {
+            writer.Write(encoding.Endpoints[subset].Values[0].w, info.AlphaBits);
+            writer.Write(encoding.Endpoints[subset].Values[1].w, info.AlphaBits);
+        }
+        for (u32 subset = 0; subset < info.Subsets; ++subset)
+        {
+            if (info.PBits == PBitMode::eEndpoint)
+            {
+                writer.Write(encoding.Endpoints[subset].PBits[0], 1);
+                writer.Write(encoding.Endpoints[subset].PBits[1], 1);
+            }
+            else if (info.PBits == PBitMode::eShared)
+            {
+                writer.Write(encoding.Endpoints[subset].PBits[0], 1);
+            }
+        }
+        for (u32 i = 0; i < kBlockPixels; ++i)
+        {
+            writer.Write(encoding.Indices[i], info.IndexBits - IsAnchor(info, encoding.Partition, i));
+        }
+        for (u32 i = 0; info.SecondaryIndexBits && i < kBlockPixels; ++i)
+        {
+            writer.Write(encoding.SecondaryIndices[i], info.SecondaryIndexBits - (i == 0));
+        }
+        writer.CopyTo(block);
+    }
+}
+
+namespace FS::BlockEncoding
+{
+    void CompressBlockBC7(const BlockPixels& pixels, const CompressionQuality quality, u8* block)
+    {
+        Block source;
+        bool opaque = true;
+        for (u32 i = 0; i < kBlockPixels; ++i)
+        {
+            for (u32 channel = 0; channel < 4; ++channel)
+            {
+                source.Channels[channel][i] = pixels[i * 4 + channel];
+            }
+            opaque &= pixels[i * 4 + 3] == 255;
+        }
+
+        auto best = EncodeCombined(source, 6, 0, quality);
+        const auto consider = [&](const Encoding& encoding)
+        {
+            if (encoding.Error < best.Error)
+            {
+                best = encoding;
+            }
+        };
+
+        const bool fast = quality == CompressionQuality::eFast;
+        if (opaque)
+        {
+            // Two subset modes without alpha, on the partitions that split the block best
+            const auto partitions = RankPartitions(source, 3, 2);
+            for (u32 i = 0; i < (fast ? 1u : 8u) && best.Error > 0.0f; ++i)
+            {
+                consider(EncodeCombined(source, 1, partitions[i], quality));
+            }
+            for (u32 i = 0; i < (fast ? 1u : 4u) && best.Error > 0.0f; ++i)
+            {
+                consider(EncodeCombined(source, 3, partitions[i], quality));
+            }
+            if (!fast && best.Error > 0.0f)
+            {
+                // Three subset modes for blocks with more than two regions, mode 0 only reaches the first 16
+                // partitions so it takes the best ranked of those
+                const auto partitions3 = RankPartitions(source, 3, 3);
+                for (u32 i = 0; i < 4 && best.Error > 0.0f; ++i)
+                {
+                    consider(EncodeCombined(source, 2, partitions3[i], quality));
+                }
+                const u32 mode0_partitions = 1u << kModes[0].PartitionBits;
+                for (u32 i = 0, tried = 0; i < partitions3.size() && tried < 2 && best.Error > 0.0f; ++i)
+                {
+                    if (partitions3[i] < mode0_partitions)
+                    {
+                        consider(EncodeCombined(source, 0, partitions3[i], quality));
+                        ++tried;
+                    }
+                }
+            }
+        }
+        else
+        {
+            consider(EncodeSeparate(source, 5, 0, 0, quality));
+            if (!fast)
+            {
+                for (u32 rotation = 1; rotation < 4 && best.Error > 0.0f; ++rotation)
+                {
+                    consider(EncodeSeparate(source, 5, rotation, 0, quality));
+                }
+                for (u32 rotation = 0; rotation < 4 && best.Error > 0.0f; ++rotation)
+                {
+                    consider(EncodeSeparate(source, 4, rotation, 0, quality));
+                    consider(EncodeSeparate(source, 4, rotation, 1, quality));
+                }
+                const auto partitions = RankPartitions(source, 4, 2);
+                for (u32 i = 0; i < 8 && best.Error > 0.0f; ++i)
+                {
+                    consider(EncodeCombined(source, 7, partitions[i], quality));
+                }
+            }
+        }
+        WriteBlock(best, block);
+    }
+} // namespace FS::BlockEncoding
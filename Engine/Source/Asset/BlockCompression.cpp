@@ -0,0 +1,632 @@
+#include "Asset/BlockCompression.hpp"
+#include "BlockEncoding.hpp"
+#include "Core/JobSystem.hpp"
+
+namespace
+{
+    using namespace FS::BlockEncoding;
+
+    struct ColorBlock
+    {
+        alignas(32) BlockValues R{};
+        alignas(32) BlockValues G{};
+        alignas(32) BlockValues B{};
+        /// 0 for pixels that are transparent in a BC1 block, 1 otherwise
+        alignas(32) BlockValues Weights{};
+        u32 TransparentMask = 0;
+    };
+
+    struct ColorFit
+    {
+        u16 Color0 = 0;
+        u16 Color1 = 0;
+        u32 Indices = 0;
+        f32 Error = std::numeric_limits<f32>::max();
+    };
+
+    struct AlphaFit
+    {
+        i32 Endpoint0 = 0;
+        i32 Endpoint1 = 0;
+        u64 Indices = 0;
+        f32 Error = std::numeric_limits<f32>::max();
+    };
+
+    ColorBlock LoadColorBlock(const BlockPixels& pixels, const bool allow_transparent)
+    {
+        ColorBlock block;
+        for (u32 i = 0; i < kBlockPixels; ++i)
+        {
+            block.R[i] = pixels[i * 4 + 0];
+            block.G[i] = pixels[i * 4 + 1];
+            block.B[i] = pixels[i * 4 + 2];
+            const bool transparent = allow_transparent && pixels[i * 4 + 3] < 128;
+            block.Weights[i] = transparent ? 0.0f : 1.0f;
+            block.TransparentMask |= static_cast<u32>(transparent) << i;
+        }
+        return block;
+    }
+
+    u16 PackColor(const glm::vec3& color)
+    {
+        const auto clamped = glm::clamp(color, 0.0f, 255.0f);
+        const auto r = static_cast<u16>(clamped.x * 31.0f / 255.0f + 0.5f);
+        const auto g = static_cast<u16>(clamped.y * 63.0f / 255.0f + 0.5f);
+        const auto b = static_cast<u16>(clamped.z * 31.0f / 255.0f + 0.5f);
+        return static_cast<u16>(r << 11 | g << 5 | b);
+    }
+
+    glm::vec3 UnpackColor(const u16 color)
+    {
+        const u32 r = color >> 11 & 31;
+        const u32 g = color >> 5 & 63;
+        const u32 b = color & 31;
+        return {static_cast<f32>(r << 3 | r >> 2), static_cast<f32>(g << 2 | g >> 4), static_cast<f32>(b << 3 | b >> 2)};
+    }
+
+    glm::vec3 GetPrincipalAxis(const ColorBlock& block, glm::vec3& mean)
+    {
+        const f32 count = Dot(block.Weights.data(), block.Weights.data());
+        alignas(32) BlockValues weighted_r{};
+        alignas(32) BlockValues weighted_g{};
+        alignas(32) BlockValues weighted_b{};
+        for (u32 i = 0; i < kBlockPixels; i += kLanes)
+        {
+            const FloatV weights = VLoad(block.Weights.data() + i);
+            VStore(weighted_r.data() + i, VMul(VLoad(block.R.data() + i), weights));
+            VStore(weighted_g.data() + i, VMul(VLoad(block.G.data() + i), weights));
+            VStore(weighted_b.data() + i, VMul(VLoad(block.B.data() + i), weights));
+        }
+
+        const f32 inverse_count = 1.0f / std::max(count, 1.0f);
+        mean = glm::vec3(Dot(weighted_r.data(), block.Weights.data()), Dot(weighted_g.data(), block.Weights.data()),
+                         Dot(weighted_b.data(), block.Weights.data())) * inverse_count;
+        const f32 rr = Dot(weighted_r.data(), block.R.data()) * inverse_count - mean.x * mean.x;
+        const f32 rg = Dot(weighted_r.data(), block.G.data()) * inverse_count - mean.x * mean.y;
+        const f32 rb = Dot(weighted_r.data(), block.B.data()) * inverse_count - mean.x * mean.z;
+        const f32 gg = Dot(weighted_g.data(), block.G.data()) * inverse_count - mean.y * mean.y;
+        const f32 gb = Dot(weighted_g.data(), block.B.data()) * inverse_count - mean.y * mean.z;
+        const f32 bb = Dot(weighted_b.data(), block.B.data()) * inverse_count - mean.z * mean.z;
+
+        // Power iteration, starting from the column with the largest variance so the start can't be
+        // orthogonal to the principal axis
+        glm::vec3 axis = rr >= gg && rr >= bb ? glm::vec3(rr, rg, rb)
+                                               : gg >= bb ? glm::vec3(rg, gg, gb) : glm::vec3(rb, gb, bb);
+        for (u32 iteration = 0; iteration < 8; ++iteration)
+        {
+            axis = glm::vec3(rr * axis.x + rg * axis.y + rb * axis.z, rg * axis.x + gg * axis.y + gb * axis.z,
+                             rb * axis.x + gb * axis.y + bb * axis.z);
+            const f32 length = glm::length(axis);
+            if (length < 1e-6f)
+            {
+                return glm::vec3(0.0f);
+            }
+            axis /= length;
+        }
+        return axis;
+    }
+
+    void ProjectExtents(const ColorBlock& block, const glm::vec3& mean, const glm::vec3& axis, f32& min, f32& max)
+    {
+        FloatV min_values = VSplat(std::numeric_limits<f32>::max());
+        FloatV max_values = VSplat(std::numeric_limits<f32>::lowest());
+        for (u32 i = 0; i < kBlockPixels; i += kLanes)
+        {
+            FloatV t = VMul(VSub(VLoad(block.R.data() + i), VSplat(mean.x)), VSplat(axis.x));
+            t = VMulAdd(VSub(VLoad(block.G.data() + i), VSplat(mean.y)), VSplat(axis.y), t);
+            t = VMulAdd(VSub(VLoad(block.B.data() + i), VSplat(mean.z)), VSplat(axis.z), t);
+            const FloatV transparent = VLess(VLoad(block.Weights.data() + i), VSplat(0.5f));
+            min_values = VMin(min_values, VSelect(transparent, t, VSplat(std::numeric_limits<f32>::max())));
+            max_values = VMax(max_values, VSelect(transparent, t, VSplat(std::numeric_limits<f32>::lowest())));
+        }
+        alignas(32) FS::Array<f32, kLanes> mins{};
+        alignas(32) FS::Array<f32, kLanes> maxs{};
+        VStore(mins.data(), min_values);
+        VStore(maxs.data(), max_values);
+        min = *std::ranges::min_element(mins);
+        max = *std::ranges::max_element(maxs);
+    }
+
+    ColorFit EvaluateColors(const ColorBlock& block, u16 color0, u16 color1)
+    {
+        // BC1 picks the mode from the endpoint order, four colours when color0 > color1 and three colours
+        // plus transparent black otherwise
+        const bool three_color = block.TransparentMask != 0;
+        if (three_color == (color0 > color1))
+        {
+            std::swap(color0, color1);
+        }
+
+        const auto c0 = UnpackColor(color0);
+        const auto c1 = UnpackColor(color1);
+        FS::Array<glm::vec4, 4> palette{glm::vec4(c0, 0.0f), glm::vec4(c1, 0.0f)};
+        u32 palette_size = 4;
+        if (three_color)
+        {
+            palette[2] = glm::vec4((c0 + c1) * 0.5f, 0.0f);
+            palette_size = 3;
+        }
+        else if (color0 == color1)
+        {
+            palette_size = 1;
+        }
+        else
+        {
+            palette[2] = glm::vec4((c0 * 2.0f + c1) / 3.0f, 0.0f);
+            palette[3] = glm::vec4((c0 + c1 * 2.0f) / 3.0f, 0.0f);
+        }
+
+        alignas(32) BlockValues codes{};
+        alignas(32) BlockValues errors{};
+        SelectNearest(BlockChannels{block.R.data(), block.G.data(), block.B.data()}, 3, palette,
+                      palette_size, codes, errors);
+
+        ColorFit fit{.Color0 = color0, .Color1 = color1, .Error = 0.0f};
+        for (u32 i = 0; i < kBlockPixels; ++i)
+        {
+            const bool transparent = block.TransparentMask >> i & 1;
+            const u32 code = transparent ? 3 : static_cast<u32>(codes[i]);
+            fit.Indices |= code << i * 2;
+            fit.Error += transparent ? 0.0f : errors[i];
+        }
+        return fit;
+    }
+
+    // Tries every split of the pixels, ordered along the principal axis, into the four palette entries and
+    // solves for the least squares endpoints of each split (the cluster fit from libsquish)
+    ColorFit ClusterFit(const ColorBlock& block, const glm::vec3& axis)
+    {
+        FS::Array<u8, kBlockPixels> order{};
+        FS::Array<f32, kBlockPixels> projections{};
+        std::iota(order.begin(), order.end(), u8{0});
+        for (u32 i = 0; i < kBlockPixels; ++i)
+        {
+            projections[i] = block.R[i] * axis.x + block.G[i] * axis.y + block.B[i] * axis.z;
+        }
+        std::ranges::sort(order, {}, [&](const u8 index) { return projections[index]; });
+
+        __m128 points[kBlockPixels];
+        __m128 total = _mm_setzero_ps();
+        for (u32 i = 0; i < kBlockPixels; ++i)
+        {
+            const u8 index = order[i];
+            points[i] = _mm_setr_ps(block.R[index] / 255.0f, block.G[index] / 255.0f, block.B[index] / 255.0f, 0.0f);
+            total = _mm_add_ps(total, points[i]);
+        }
+
+        const __m128 one_third = _mm_set1_ps(1.0f / 3.0f);
+        const __m128 two_thirds = _mm_set1_ps(2.0f / 3.0f);
+        const __m128 grid = _mm_setr_ps(31.0f, 63.0f, 31.0f, 0.0f);
+        const __m128 grid_reciprocal = _mm_setr_ps(1.0f / 31.0f, 1.0f / 63.0f, 1.0f / 31.0f, 0.0f);
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+
+        f32 best_error = std::numeric_limits<f32>::max();
+        __m128 best_start = zero;
+        __m128 best_end = zero;
+        __m128 part0 = zero;
+        for (u32 i = 0; i <= kBlockPixels; ++i)
+        {
+            __m128 part1 = zero;
+            for (u32 j = i; j <= kBlockPixels; ++j)
+            {
+                __m128 part2 = zero;
+                for (u32 k = j; k <= kBlockPixels; ++k)
+                {
+                    const auto count1 = static_cast<f32>(j - i);
+                    const auto count2 = static_cast<f32>(k - j);
+                    const f32 alpha2 = static_cast<f32>(i) + count1 * (4.0f / 9.0f) + count2 * (1.0f / 9.0f);
+                    const f32 beta2 = static_cast<f32>(kBlockPixels - k) + count2 * (4.0f / 9.0f) +
+                        count1 * (1.0f / 9.0f);
+                    const f32 alpha_beta = (count1 + count2) * (2.0f / 9.0f);
+                    const f32 determinant = alpha2 * beta2 - alpha_beta * alpha_beta;
+                    if (determinant > 1e-6f)
+                    {
+                        const __m128 part3 = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(total, part0), part1), part2);
+                        const __m128 alpha_x = _mm_add_ps(
+                            part0, _mm_add_ps(_mm_mul_ps(part1, two_thirds), _mm_mul_ps(part2, one_third)));
+                        const __m128 beta_x = _mm_add_ps(
+                            part3, _mm_add_ps(_mm_mul_ps(part2, two_thirds), _mm_mul_ps(part1, one_third)));
+
+                        const __m128 factor = _mm_set1_ps(1.0f / determinant);
+                        __m128 start = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(alpha_x, _mm_set1_ps(beta2)),
+                                                             _mm_mul_ps(beta_x, _mm_set1_ps(alpha_beta))), factor);
+                        __m128 end = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(beta_x, _mm_set1_ps(alpha2)),
+                                                           _mm_mul_ps(alpha_x, _mm_set1_ps(alpha_beta))), factor);
+
+                        // Snap to the 565 grid before measuring so the error matches what gets stored
+                        start = _mm_min_ps(one, _mm_max_ps(zero, start));
+                        end = _mm_min_ps(one, _mm_max_ps(zero, end));
+                        start = _mm_mul_ps(_mm_round_ps(_mm_add_ps(_mm_mul_ps(grid, start), half),
+                                                        _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC), grid_reciprocal);
+                        end = _mm_mul_ps(_mm_round_ps(_mm_add_ps(_mm_mul_ps(grid, end), half),
+                                                      _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC), grid_reciprocal);
+
+                        // |start * alpha + end * beta - x|^2 summed over the block, without the constant x^2 term
+                        const __m128 e1 = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(start, start), _mm_set1_ps(alpha2)),
+                                                     _mm_mul_ps(_mm_mul_ps(end, end), _mm_set1_ps(beta2)));
+                        const __m128 e2 = _mm_sub_ps(_mm_mul_ps(_mm_mul_ps(start, end), _mm_set1_ps(alpha_beta)),
+                                                     _mm_add_ps(_mm_mul_ps(start, alpha_x), _mm_mul_ps(end, beta_x)));
+                        const __m128 error = _mm_add_ps(e1, _mm_add_ps(e2, e2));
+                        alignas(16) FS::Array<f32, 4> lanes{};
+                        _mm_store_ps(lanes.data(), error);
+                        const f32 total_error = lanes[0] + lanes[1] + lanes[2];
+                        if (total_error < best_error)
+                        {
+                            best_error = total_error;
+                            best_start = start;
+                            best_end = end;
+                        }
+                    }
+                    if (k < kBlockPixels)
+                    {
+                        part2 = _mm_add_ps(part2, points[k]);
+                    }
+                }
+                if (j < kBlockPixels)
+                {
+                    part1 = _mm_add_ps(part1, points[j]);
+                }
+            }
+            if (i < kBlockPixels)
+            {
+                part0 = _mm_add_ps(part0, points[i]);
+            }
+        }
+
+        alignas(16) FS::Array<f32, 4> start{};
+        alignas(16) FS::Array<f32, 4> end{};
+        _mm_store_ps(start.data(), _mm_mul_ps(best_start, _mm_set1_ps(255.0f)));
+        _mm_store_ps(end.data(), _mm_mul_ps(best_end, _mm_set1_ps(255.0f)));
+        return EvaluateColors(block, PackColor({start[0], start[1], start[2]}), PackColor({end[0], end[1], end[2]}));
+    }
+
+    void CompressColorBlock(const BlockPixels& pixels, const bool allow_transparent,
+                            const FS::CompressionQuality quality, u8* block)
+    {
+        const auto colors = LoadColorBlock(pixels, allow_transparent);
+        ColorFit fit;
+        if (colors.TransparentMask == 0xFFFF)
+        {
+            fit.Indices = 0xFFFFFFFF;
+        }
+        else
+        {
+            glm::vec3 mean;
+            const auto axis = GetPrincipalAxis(colors, mean);
+            f32 min, max;
+            ProjectExtents(colors, mean, axis, min, max);
+            fit = EvaluateColors(colors, PackColor(mean + axis * max), PackColor(mean + axis * min));
+            if (quality == FS::CompressionQuality::eQuality && colors.TransparentMask == 0 && fit.Error > 0.0f)
+            {
+                const auto cluster = ClusterFit(colors, axis);
+                if (cluster.Error < fit.Error)
+                {
+                    fit = cluster;
+                }
+            }
+        }
+        std::memcpy(block, &fit.Color0, sizeof(u16));
+        std::memcpy(block + 2, &fit.Color1, sizeof(u16));
+        std::memcpy(block + 4, &fit.Indices, sizeof(u32));
+    }
+
+    // BC4 palette, eight interpolated values when endpoint0 > endpoint1 and six plus both extremes otherwise
+    AlphaFit EvaluateAlpha(const BlockValues& values, const i32 endpoint0, const i32 endpoint1, const i32 min_value,
+                           const i32 max_value)
+    {
+        const auto e0 = static_cast<f32>(endpoint0);
+        const auto e1 = static_cast<f32>(endpoint1);
+        FS::Array<glm::vec4, 8> palette{};
+        palette[0].x = e0;
+        palette[1].x = e1;
+        if (endpoint0 > endpoint1)
+        {
+            for (u32 i = 1; i <= 6; ++i)
+            {
+                palette[i + 1].x = (e0 * static_cast<f32>(7 - i) + e1 * static_cast<f32>(i)) / 7.0f;
+            }
+        }
+        else
+        {
+            for (u32 i = 1; i <= 4; ++i)
+            {
+                palette[i + 1].x = (e0 * static_cast<f32>(5 - i) + e1 * static_cast<f32>(i)) / 5.0f;
+            }
+            palette[6].x = static_cast<f32>(min_value);
+            palette[7].x = static_cast<f32>(max_value);
+        }
+
+        alignas(32) BlockValues codes{};
+        alignas(32) BlockValues errors{};
+        SelectNearest(BlockChannels{values.data()}, 1, palette, 8, codes, errors);
+
+        AlphaFit fit{.Endpoint0 = endpoint0, .Endpoint1 = endpoint1, .Error = 0.0f};
+        for (u32 i = 0; i < kBlockPixels; ++i)
+        {
+            fit.Indices |= static_cast<u64>(codes[i]) << i * 3;
+            fit.Error += errors[i];
+        }
+        return fit;
+    }
+
+    // Least squares endpoints for the current codes, codes that select an explicit extreme are left out
+    AlphaFit RefineAlpha(const BlockValues& values, const AlphaFit& fit, const i32 min_value, const i32 max_value)
+    {
+        const bool eight_values = fit.Endpoint0 > fit.Endpoint1;
+        const f32 steps = eight_values ? 7.0f : 5.0f;
+        f32 aa = 0.0f, ab = 0.0f, bb = 0.0f, ax = 0.0f, bx = 0.0f;
+        for (u32 i = 0; i < kBlockPixels; ++i)
+        {
+            const u32 code = fit.Indices >> i * 3 & 7;
+            if (!eight_values && code >= 6)
+            {
+                continue;
+            }
+            const f32 beta = code == 0 ? 0.0f : code == 1 ? 1.0f : static_cast<f32>(code - 1) / steps;
+            const f32 alpha = 1.0f - beta;
+            aa += alpha * alpha;
+            ab += alpha * beta;
+            bb += beta * beta;
+            ax += alpha * values[i];
+            bx += beta * values[i];
+        }
+        const f32 determinant = aa * bb - ab * ab;
+        if (std::abs(determinant) < 1e-6f)
+        {
+            return fit;
+        }
+        const auto e0 = static_cast<i32>(std::round((ax * bb - bx * ab) / determinant));
+        const auto e1 = static_cast<i32>(std::round((bx * aa - ax * ab) / determinant));
+        return EvaluateAlpha(values, std::clamp(e0, min_value, max_value), std::clamp(e1, min_value, max_value),
+                             min_value, max_value);
+    }
+
+    void CompressAlphaBlock(const BlockValues& values, const bool snorm, const FS::CompressionQuality quality, u8* block)
+    {
+        const i32 min_value = snorm ? -127 : 0;
+        const i32 max_value = snorm ? 127 : 255;
+        const auto [min_it, max_it] = std::ranges::minmax_element(values);
+        const auto min = static_cast<i32>(*min_it);
+        const auto max = static_cast<i32>(*max_it);
+
+        auto fit = EvaluateAlpha(values, max, min, min_value, max_value);
+        if (min != max)
+        {
+            // The six value mode stores the extremes exactly, which helps blocks that mix them with a gradient
+            i32 inner_min = max_value;
+            i32 inner_max = min_value;
+            for (const f32 value : values)
+            {
+                const auto integer = static_cast<i32>(value);
+                if (integer != min_value && integer != max_value)
+                {
+                    inner_min = std::min(inner_min, integer);
+                    inner_max = std::max(inner_max, integer);
+                }
+            }
+            if (inner_min <= inner_max && (min == min_value || max == max_value))
+            {
+                const auto six_values = EvaluateAlpha(values, inner_min, inner_max, min_value, max_value);
+                if (six_values.Error < fit.Error)
+                {
+                    fit = six_values;
+                }
+            }
+
+            if (quality == FS::CompressionQuality::eQuality)
+            {
+                for (u32 iteration = 0; iteration < 3 && fit.Error > 0.0f; ++iteration)
+                {
+                    const auto refined = RefineAlpha(values, fit, min_value, max_value);
+                    if (refined.Error >= fit.Error)
+                    {
+                        break;
+                    }
+                    fit = refined;
+                }
+            }
+        }
+
+        const u64 bits = static_cast<u64>(static_cast<u8>(fit.Endpoint0)) |
+            static_cast<u64>(static_cast<u8>(fit.Endpoint1)) << 8 | fit.Indices << 16;
+        std::memcpy(block, &bits, sizeof(bits));
+    }
+
+    BlockValues GetChannel(const BlockPixels& pixels, const u32 channel, const bool snorm)
+    {
+        alignas(32) BlockValues values{};
+        for (u32 i = 0; i < kBlockPixels; ++i)
+        {
+            const f32 value = pixels[i * 4 + channel];
+            values[i] = snorm ? std::round((value / 255.0f * 2.0f - 1.0f) * 127.0f) : value;
+        }
+        return values;
+    }
+
+    void CompressNormalBlock(const BlockPixels& pixels, const bool snorm, const FS::CompressionQuality quality,
+                             u8* block)
+    {
+        alignas(32) BlockValues x{};
+        alignas(32) BlockValues y{};
+        for (u32 i = 0; i < kBlockPixels; ++i)
+        {
+            auto normal = glm::vec3(pixels[i * 4], pixels[i * 4 + 1], pixels[i * 4 + 2]) / 127.5f - 1.0f;
+            const f32 length = glm::length(normal);
+            normal = length > 1e-6f ? normal / length : glm::vec3(0.0f, 0.0f, 1.0f);
+            x[i] = snorm ? std::round(normal.x * 127.0f) : std::round((normal.x * 0.5f + 0.5f) * 255.0f);
+            y[i] = snorm ? std::round(normal.y * 127.0f) : std::round((normal.y * 0.5f + 0.5f) * 255.0f);
+        }
+        CompressAlphaBlock(x, snorm, quality, block);
+        CompressAlphaBlock(y, snorm, quality, block + 8);
+    }
+
+    void CompressBlock(const BlockPixels& pixels, const FS::Format format, const FS::BlockCompressionSettings& settings,
+                       u8* block)
+    {
+        switch (format)
+        {
+        case FS::Format::eBC1_UNORM:
+        case FS::Format::eBC1_UNORM_SRGB:
+            CompressColorBlock(pixels, true, settings.Quality, block);
+            break;
+        case FS::Format::eBC3_UNORM:
+        case FS::Format::eBC3_UNORM_SRGB:
+            CompressAlphaBlock(GetChannel(pixels, 3, false), false, settings.Quality, block);
+            CompressColorBlock(pixels, false, settings.Quality, block + 8);
+            break;
+        case FS::Format::eBC4_UNORM:
+        case FS::Format::eBC4_SNORM:
+            {
+                const bool snorm = format == FS::Format::eBC4_SNORM;
+                CompressAlphaBlock(GetChannel(pixels, 0, snorm), snorm, settings.Quality, block);
+                break;
+            }
+        case FS::Format::eBC5_UNORM:
+        case FS::Format::eBC5_SNORM:
+            {
+                const bool snorm = format == FS::Format::eBC5_SNORM;
+                if (settings.NormalMap)
+                {
+                    CompressNormalBlock(pixels, snorm, settings.Quality, block);
+                    break;
+                }
+                CompressAlphaBlock(GetChannel(pixels, 0, snorm), snorm, settings.Quality, block);
+                CompressAlphaBlock(GetChannel(pixels, 1, snorm), snorm, settings.Quality, block + 8);
+                break;
+            }
+        case FS::Format::eBC7_UNORM:
+        case FS::Format::eBC7_UNORM_SRGB:
+            CompressBlockBC7(pixels, settings.Quality, block);
+            break;
+        default:
+            break;
+        }
+    }
+
+    // Pixels past the edge of the image repeat the last row and column
+    void LoadBlock(const FS::Image& image, const u32 block_x, const u32 block_y, BlockPixels& pixels)
+    {
+        for (u32 y = 0; y < 4; ++y)
+        {
+            const u8* row = image.Row(std::min(block_y * 4 + y, image.Height - 1));
+            for (u32 x = 0; x < 4; ++x)
+            {
+                std::memcpy(pixels.data() + (y * 4 + x) * 4, row + std::min(block_x * 4 + x, image.Width - 1) * 4, 4);
+            }
+        }
+    }
+
+    void LoadBlock(const FS::Image& image, const u32 block_x, const u32 block_y, HdrBlockPixels& pixels)
+    {
+        for (u32 y = 0; y < 4; ++y)
+        {
+            const u8* row = image.Row(std::min(block_y * 4 + y, image.Height - 1));
+            for (u32 x = 0; x < 4; ++x)
+            {
+                std::memcpy(pixels.data() + (y * 4 + x) * 4,
+                            row + std::min(block_x * 4 + x, image.Width - 1) * sizeof(glm::vec4), sizeof(glm::vec4));
+            }
+        }
+    }
+}
+
+namespace FS
+{
+    bool IsBlockCompressionSupported(const Format format)
+    {
+        switch (format)
+        {
+        case Format::eBC1_UNORM:
+        case Format::eBC1_UNORM_SRGB:
+        case Format::eBC3_UNORM:
+        case Format::eBC3_UNORM_SRGB:
+        case Format::eBC4_UNORM:
+        case Format::eBC4_SNORM:
+        case Format::eBC5_UNORM:
+        case Format::eBC5_SNORM:
+        case Format::eBC6H_UF16:
+        case Format::eBC6H_SF16:
+        case Format::eBC7_UNORM:
+        case Format::eBC7_UNORM_SRGB:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    Format GetBlockCompressionSourceFormat(const Format format)
+    {
+        if (format == Format::eBC6H_UF16 || format == Format::eBC6H_SF16)
+        {
+            return Format::eR32G32B32A32_FLOAT;
+        }
+        return GetFormatInfo(format).SRGB ? Format::eR8G8B8A8_UNORM_SRGB : Format::eR8G8B8A8_UNORM;
+    }
+
+    Image CompressImage(const Image& image, const Format format, const BlockCompressionSettings& settings,
+                        JobSystem* jobs)
+    {
+        if (!IsBlockCompressionSupported(format))
+        {
+            Log::Error("CompressImage Unsupported format {}", static_cast<u32>(format));
+            return {};
+        }
+
+        // RGBA8 sources are read as stored, whichever of the two gamma variants they are
+        const auto source_format = GetBlockCompressionSourceFormat(format);
+        const bool hdr = source_format == Format::eR32G32B32A32_FLOAT;
+        const Image* source = &image;
+        Image converted;
+        if (hdr ? image.Format != source_format
+                : image.Format != Format::eR8G8B8A8_UNORM && image.Format != Format::eR8G8B8A8_UNORM_SRGB)
+        {
+            converted = ConvertImage(image, source_format);
+            if (converted.IsEmpty())
+            {
+                return {};
+            }
+            source = &converted;
+        }
+
+        auto result = Image::Create(image.Width, image.Height, format);
+        const u32 block_rows = GetRowCount(format, image.Height);
+        const u32 blocks_per_row = (image.Width + 3) / 4;
+        const u32 block_size = GetFormatInfo(format).BytesPerBlock;
+        const auto compress_row = [&](const u32 block_y)
+        {
+            u8* row = result.Row(block_y);
+            if (hdr)
+            {
+                const bool is_signed = format == Format::eBC6H_SF16;
+                HdrBlockPixels pixels{};
+                for (u32 block_x = 0; block_x < blocks_per_row; ++block_x)
+                {
+                    LoadBlock(*source, block_x, block_y, pixels);
+                    CompressBlockBC6H(pixels, is_signed, settings.Quality, row + block_x * block_size);
+                }
+                return;
+            }
+            BlockPixels pixels{};
+            for (u32 block_x = 0; block_x < blocks_per_row; ++block_x)
+            {
+                LoadBlock(*source, block_x, block_y, pixels);
+                CompressBlock(pixels, format, settings, row + block_x * block_size);
+            }
+        };
+
+        if (jobs)
+        {
+            jobs->ParallelFor(block_rows, 1, compress_row);
+        }
+        else
+        {
+            for (u32 block_y = 0; block_y < block_rows; ++block_y)
+            {
+                compress_row(block_y);
+            }
+        }
+        return result;
+    }
+} // namespace FS
@@ -0,0 +1,108 @@
+#pragma once
+#include "Asset/BlockCompression.hpp"
+
+// Shared by the block encoders, a channel of a 4x4 block is two AVX2 registers or four SSE registers
+namespace FS::BlockEncoding
+{
+    constexpr u32 kBlockPixels = 16;
+
+#ifdef __AVX2__
+    constexpr u32 kLanes = 8;
+    using FloatV = __m256;
+    inline FloatV VLoad(const f32* values) { return _mm256_load_ps(values); }
+    inline void VStore(f32* values, const FloatV v) { _mm256_store_ps(values, v); }
+    inline FloatV VSplat(const f32 value) { return _mm256_set1_ps(value); }
+    inline FloatV VAdd(const FloatV a, const FloatV b) { return _mm256_add_ps(a, b); }
+    inline FloatV VSub(const FloatV a, const FloatV b) { return _mm256_sub_ps(a, b); }
+    inline FloatV VMul(const FloatV a, const FloatV b) { return _mm256_mul_ps(a, b); }
+    inline FloatV VMulAdd(const FloatV a, const FloatV b, const FloatV c) { return _mm256_fmadd_ps(a, b, c); }
+    inline FloatV VMin(const FloatV a, const FloatV b) { return _mm256_min_ps(a, b); }
+    inline FloatV VMax(const FloatV a, const FloatV b) { return _mm256_max_ps(a, b); }
+    inline FloatV VLess(const FloatV a, const FloatV b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    inline FloatV VSelect(const FloatV mask, const FloatV a, const FloatV b) { return _mm256_blendv_ps(a, b, mask); }
+#else
+    constexpr u32 kLanes = 4;
+    using FloatV = __m128;
+    inline FloatV VLoad(const f32* values) { return _mm_load_ps(values); }
+    inline void VStore(f32* values, const FloatV v) { _mm_store_ps(values, v); }
+    inline FloatV VSplat(const f32 value) { return _mm_set1_ps(value); }
+    inline FloatV VAdd(const FloatV a, const FloatV b) { return _mm_add_ps(a, b); }
+    inline FloatV VSub(const FloatV a, const FloatV b) { return _mm_sub_ps(a, b); }
+    inline FloatV VMul(const FloatV a, const FloatV b) { return _mm_mul_ps(a, b); }
+    inline FloatV VMulAdd(const FloatV a, const FloatV b, const FloatV c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+    inline FloatV VMin(const FloatV a, const FloatV b) { return _mm_min_ps(a, b); }
+    inline FloatV VMax(const FloatV a, const FloatV b) { return _mm_max_ps(a, b); }
+    inline FloatV VLess(const FloatV a, const FloatV b) { return _mm_cmplt_ps(a, b); }
+    inline FloatV VSelect(const FloatV mask, const FloatV a, const FloatV b) { return _mm_blendv_ps(a, b, mask); }
+#endif
+
+    using BlockValues = Array<f32, kBlockPixels>;
+    using BlockPixels = Array<u8, kBlockPixels * 4>;
+    /// RGBA floats for BC6H
+    using HdrBlockPixels = Array<f32, kBlockPixels * 4>;
+    using BlockChannels = Array<const f32*, 4>;
+
+    inline f32 Dot(const f32* a, const f32* b)
+    {
+        FloatV sum = VMul(VLoad(a), VLoad(b));
+        for (u32 i = kLanes; i < kBlockPixels; i += kLanes)
+        {
+            sum = VMulAdd(VLoad(a + i), VLoad(b + i), sum);
+        }
+        alignas(32) Array<f32, kLanes> lanes{};
+        VStore(lanes.data(), sum);
+        return std::accumulate(lanes.begin(), lanes.end(), 0.0f);
+    }
+
+    /// <summary>
+    /// Nearest palette entry for every pixel of the block, returns the per pixel codes and squared errors.
+    /// Channels must be 32 byte aligned.
+    /// </summary>
+    template <std::size_t kPaletteSize>
+    void SelectNearest(const BlockChannels& channels, const u32 channel_count,
+                       const Array<glm::vec4, kPaletteSize>& palette, const u32 palette_size, BlockValues& codes,
+                       BlockValues& errors)
+    {
+        for (u32 i = 0; i < kBlockPixels; i += kLanes)
+        {
+            FloatV best_error = VSplat(std::numeric_limits<f32>::max());
+            FloatV best_code = VSplat(0.0f);
+            for (u32 code = 0; code < palette_size; ++code)
+            {
+                FloatV error = VSplat(0.0f);
+                for (u32 channel = 0; channel < channel_count; ++channel)
+                {
+                    const FloatV difference = VSub(VLoad(channels[channel] + i), VSplat(palette[code][channel]));
+                    error = VMulAdd(difference, difference, error);
+                }
+                const FloatV closer = VLess(error, best_error);
+                best_error = VMin(error, best_error);
+                best_code = VSelect(closer, best_code, VSplat(static_cast<f32>(code)));
+            }
+            VStore(codes.data() + i, best_code);
+            VStore(errors.data() + i, best_error);
+        }
+    }
+
+    /// Little endian bit stream of a 128 bit block
+    class BitWriter
+    {
+    public:
+        void Write(const u64 value, const u32 count)
+        {
+            for (u32 i = 0; i < count; ++i, ++m_offset)
+            {
+                m_bits[m_offset / 64] |= (value >> i & 1) << m_offset % 64;
+            }
+        }
+
+        void CopyTo(u8* block) const { std::memcpy(block, m_bits.data(), sizeof(m_bits)); }
+
+    private:
+        Array<u64, 2> m_bits{};
+        u32 m_offset = 0;
+    };
+
+    void CompressBlockBC7(const BlockPixels& pixels, CompressionQuality quality, u8* block);
+    void CompressBlockBC6H(const HdrBlockPixels& pixels, bool is_signed, CompressionQuality quality, u8* block);
+} // namespace FS::BlockEncoding
@@ -0,0 +1,156 @@
+#include "Asset/CookedMesh.hpp"
+#include "Asset/MeshCodec.hpp"
+#include "Asset/VertexPacking.hpp"
+#include "Core/FileWriter.hpp"
+
+namespace
+{
+    constexpr u64 kSectionAlignment = 16;
+
+    bool IsSectionValid(const FS::Span<const char> memory, const u64 offset, const u64 size)
+    {
+        return offset >= sizeof(FS::CookedMeshHeader) && offset <= memory.size() && size <= memory.size() - offset;
+    }
+}
+
+namespace FS
+{
+    CookedMesh CookedMesh::Create(const Mesh& mesh, const VertexFormat format)
+    {
+        CookedMesh cooked;
+        cooked.Header.VertexCount = static_cast<u32>(mesh.Vertices.size());
+        cooked.Header.IndexCount = static_cast<u32>(mesh.Indices.size());
+        cooked.Header.VertexFormat = format;
+        if (format == VertexFormat::ePacked)
+        {
+            cooked.Header.VertexStride = sizeof(PackedVertex);
+            cooked.Header.Quantization = ComputeVertexQuantization(mesh.Vertices);
+            Vec<PackedVertex> packed(mesh.Vertices.size());
+            PackVertices(mesh.Vertices, cooked.Header.Quantization, packed);
+            cooked.VertexData = EncodeVertexBuffer(Span<const PackedVertex>(packed), mesh.Indices);
+        }
+        else
+        {
+            cooked.Header.VertexStride = sizeof(Vertex);
+            cooked.VertexData = EncodeVertexBuffer(Span<const Vertex>(mesh.Vertices), mesh.Indices);
+        }
+        cooked.IndexData = EncodeIndexBuffer(mesh.Indices);
+
+        for (const auto& submesh : mesh.Submeshes)
+        {
+            cooked.Submeshes.push_back({
+                .FirstIndex = submesh.FirstIndex,
+                .IndexCount = submesh.IndexCount,
+                .NameOffset = static_cast<u32>(cooked.Names.size()),
+                .NameSize = static_cast<u32>(submesh.Material.size()),
+            });
+            cooked.Names.insert(cooked.Names.end(), submesh.Material.begin(), submesh.Material.end());
+        }
+        cooked.Header.SubmeshCount = static_cast<u32>(cooked.Submeshes.size());
+        cooked.Header.NamesSize = static_cast<u32>(cooked.Names.size());
+        return cooked;
+    }
+
+    bool CookedMesh::Write(const std::string_view path) const
+    {
+        auto header = Header;
+        u64 offset = sizeof(CookedMeshHeader);
+        const auto place_section = [&](const u64 size)
+        {
+            const u64 section_offset = Align(offset, kSectionAlignment);
+            offset = section_offset + size;
+            return section_offset;
+        };
+        header.SubmeshesOffset = place_section(Submeshes.size() * sizeof(CookedSubmesh));
+        header.NamesOffset = place_section(Names.size());
+        header.VertexDataOffset = place_section(VertexData.size());
+        header.VertexDataSize = VertexData.size();
+        header.IndexDataOffset = place_section(IndexData.size());
+        header.IndexDataSize = IndexData.size();
+        header.FileSize = offset;
+
+        constexpr Array<char, kSectionAlignment> padding{};
+        FileWriter writer;
+        if (!writer.Open(path))
+        {
+            return false;
+        }
+        const auto write_section = [&](const u64 section_offset, const void* data, const u64 size)
+        {
+            writer.Write(padding.data(), section_offset - writer.BytesWritten());
+            writer.Write(data, size);
+        };
+        writer.Write(&header, sizeof(header));
+        write_section(header.SubmeshesOffset, Submeshes.data(), Submeshes.size() * sizeof(CookedSubmesh));
+        write_section(header.NamesOffset, Names.data(), Names.size());
+        write_section(header.VertexDataOffset, VertexData.data(), VertexData.size());
+        write_section(header.IndexDataOffset, IndexData.data(), IndexData.size());
+        return writer.Commit();
+    }
+
+    Opt<CookedMeshView> CookedMeshView::FromMemory(const Span<const char> memory)
+    {
+        if (memory.size() < sizeof(CookedMeshHeader))
+        {
+            return std::nullopt;
+        }
+        const auto* header = reinterpret_cast<const CookedMeshHeader*>(memory.data());
+        if (header->Magic != CookedMeshHeader::kMagic || header->Version != CookedMeshHeader::kVersion ||
+            header->FileSize > memory.size() || header->SubmeshesOffset % alignof(CookedSubmesh) != 0 ||
+            !IsSectionValid(memory, header->SubmeshesOffset, header->SubmeshCount * sizeof(CookedSubmesh)) ||
+            !IsSectionValid(memory, header->NamesOffset, header->NamesSize) ||
+            !IsSectionValid(memory, header->VertexDataOffset, header->VertexDataSize) ||
+            !IsSectionValid(memory, header->IndexDataOffset, header->IndexDataSize))
+        {
+            Log::Error("CookedMeshView::FromMemory Invalid cooked mesh");
+            return std::nullopt;
+        }
+
+        const auto* data = reinterpret_cast<const u8*>(memory.data());
+        CookedMeshView view{
+            .Header = header,
+            .Submeshes = Span<const CookedSubmesh>(
+                reinterpret_cast<const CookedSubmesh*>(data + header->SubmeshesOffset), header->SubmeshCount),
+            .Names = memory.subspan(header->NamesOffset, header->NamesSize),
+            .VertexData = Span<const u8>(data + header->VertexDataOffset, header->VertexDataSize),
+            .IndexData = Span<const u8>(data + header->IndexDataOffset, header->IndexDataSize),
+        };
+        for (const auto& submesh : view.Submeshes)
+        {
+            if (submesh.NameOffset > view.Names.size() || submesh.NameSize > view.Names.size() - submesh.NameOffset ||
+                submesh.FirstIndex > header->IndexCount || submesh.IndexCount > header->IndexCount - submesh.FirstIndex)
+            {
+                Log::Error("CookedMeshView::FromMemory Invalid submesh");
+                return std::nullopt;
+            }
+        }
+        return view;
+    }
+
+    std::string_view CookedMeshView::GetMaterial(const CookedSubmesh& submesh) const
+    {
+        return {Names.data() + submesh.NameOffset, submesh.NameSize};
+    }
+
+    bool CookedMeshView::DecodeVertices(const Span<u8> vertices, const Span<const u32> indices) const
+    {
+        if (vertices.size() != GetVertexBufferSize())
+        {
+            Log::Error("CookedMeshView::DecodeVertices Expected {} bytes, got {}", GetVertexBufferSize(),
+                       vertices.size());
+            return false;
+        }
+        return DecodeVertexBuffer(VertexData, Header->VertexStride, vertices, indices);
+    }
+
+    bool CookedMeshView::DecodeIndices(const Span<u32> indices) const
+    {
+        if (indices.size() != Header->IndexCount)
+        {
+            Log::Error("CookedMeshView::DecodeIndices Expected {} indices, got {}", Header->IndexCount,
+                       indices.size());
+            return false;
+        }
+        return DecodeIndexBuffer(IndexData, indices);
+    }
+} // namespace FS
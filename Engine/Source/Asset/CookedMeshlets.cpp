@@ -0,0 +1,95 @@
+#include "Asset/CookedMeshlets.hpp"
+#include "Core/FileWriter.hpp"
+
+namespace
+{
+    template <typename T>
+    bool IsTableValid(const FS::Span<const char> memory, const u64 offset, const u32 count)
+    {
+        return offset % FS::CookedMeshletsHeader::kTableAlignment == 0 &&
+               offset >= sizeof(FS::CookedMeshletsHeader) && offset <= memory.size() &&
+               count <= (memory.size() - offset) / sizeof(T);
+    }
+
+    template <typename T>
+    FS::Span<const T> GetTable(const FS::Span<const char> memory, const u64 offset, const u32 count)
+    {
+        return FS::Span<const T>(reinterpret_cast<const T*>(memory.data() + offset), count);
+    }
+}
+
+namespace FS
+{
+    bool CookedMeshlets::Write(const std::string_view path) const
+    {
+        CookedMeshletsHeader header{
+            .MeshletCount = static_cast<u32>(Meshlets.Meshlets.size()),
+            .VertexIndexCount = static_cast<u32>(Meshlets.VertexIndices.size()),
+            .TriangleCount = static_cast<u32>(Meshlets.Triangles.size()),
+            .RangeCount = static_cast<u32>(Meshlets.Ranges.size()),
+            .VertexCount = VertexCount,
+        };
+        u64 offset = sizeof(CookedMeshletsHeader);
+        const auto place_table = [&](const u64 size)
+        {
+            const u64 table_offset = Align(offset, CookedMeshletsHeader::kTableAlignment);
+            offset = table_offset + size;
+            return table_offset;
+        };
+        header.MeshletsOffset = place_table(Meshlets.Meshlets.size() * sizeof(Meshlet));
+        header.BoundsOffset = place_table(Meshlets.Bounds.size() * sizeof(MeshletBounds));
+        header.VertexIndicesOffset = place_table(Meshlets.VertexIndices.size() * sizeof(u32));
+        header.TrianglesOffset = place_table(Meshlets.Triangles.size() * sizeof(u32));
+        header.RangesOffset = place_table(Meshlets.Ranges.size() * sizeof(MeshletRange));
+        header.FileSize = offset;
+
+        constexpr Array<char, CookedMeshletsHeader::kTableAlignment> padding{};
+        FileWriter writer;
+        if (!writer.Open(path))
+        {
+            return false;
+        }
+        const auto write_table = [&](const u64 table_offset, const void* data, const u64 size)
+        {
+            writer.Write(padding.data(), table_offset - writer.BytesWritten());
+            writer.Write(data, size);
+        };
+        writer.Write(&header, sizeof(header));
+        write_table(header.MeshletsOffset, Meshlets.Meshlets.data(), Meshlets.Meshlets.size() * sizeof(Meshlet));
+        write_table(header.BoundsOffset, Meshlets.Bounds.data(), Meshlets.Bounds.size() * sizeof(MeshletBounds));
+        write_table(header.VertexIndicesOffset, Meshlets.VertexIndices.data(),
+                    Meshlets.VertexIndices.size() * sizeof(u32));
+        write_table(header.TrianglesOffset, Meshlets.Triangles.data(), Meshlets.Triangles.size() * sizeof(u32));
+        write_table(header.RangesOffset, Meshlets.Ranges.data(), Meshlets.Ranges.size() * sizeof(MeshletRange));
+        return writer.Commit();
+    }
+
+    Opt<CookedMeshletsView> CookedMeshletsView::FromMemory(const Span<const char> memory)
+    {
+        if (memory.size() < sizeof(CookedMeshletsHeader))
+        {
+            return std::nullopt;
+        }
+        const auto* header = reinterpret_cast<const CookedMeshletsHeader*>(memory.data());
+        if (header->Magic != CookedMeshletsHeader::kMagic || header->Version != CookedMeshletsHeader::kVersion ||
+            header->FileSize > memory.size() ||
+            !IsTableValid<Meshlet>(memory, header->MeshletsOffset, header->MeshletCount) ||
+            !IsTableValid<MeshletBounds>(memory, header->BoundsOffset, header->MeshletCount) ||
+            !IsTableValid<u32>(memory, header->VertexIndicesOffset, header->VertexIndexCount) ||
+            !IsTableValid<u32>(memory, header->TrianglesOffset, header->TriangleCount) ||
+            !IsTableValid<MeshletRange>(memory, header->RangesOffset, header->RangeCount))
+        {
+            Log::Error("CookedMeshletsView::FromMemory Invalid cooked meshlets");
+            return std::nullopt;
+        }
+
+        return CookedMeshletsView{
+            .Header = header,
+            .Meshlets = GetTable<Meshlet>(memory, header->MeshletsOffset, header->MeshletCount),
+            .Bounds = GetTable<MeshletBounds>(memory, header->BoundsOffset, header->MeshletCount),
+            .VertexIndices = GetTable<u32>(memory, header->VertexIndicesOffset, header->VertexIndexCount),
+            .Triangles = GetTable<u32>(memory, header->TrianglesOffset, header->TriangleCount),
+            .Ranges = GetTable<MeshletRange>(memory, header->RangesOffset, header->RangeCount),
+        };
+    }
+} // namespace FS
@@ -0,0 +1,160 @@
+#include "Asset/CookedShader.hpp"
+#include "Core/FileWriter.hpp"
+#include "Render/ShaderPermutation.hpp"
+
+namespace
+{
+    constexpr u64 kSectionAlignment = 16;
+
+    bool IsSectionValid(const FS::Span<const char> memory, const u64 offset, const u64 size)
+    {
+        return offset >= sizeof(FS::CookedShaderHeader) && offset <= memory.size() && size <= memory.size() - offset;
+    }
+}
+
+namespace FS
+{
+    CookedShader CookedShader::Create(const Span<const std::string> features)
+    {
+        CookedShader cooked;
+        for (const auto& feature : features)
+        {
+            cooked.Features.push_back({
+                .NameOffset = static_cast<u32>(cooked.Names.size()),
+                .NameSize = static_cast<u32>(feature.size()),
+            });
+            cooked.Names.insert(cooked.Names.end(), feature.begin(), feature.end());
+        }
+        cooked.Table.assign(1ull << features.size(), kStrippedPermutation);
+        cooked.Header.FeatureCount = static_cast<u32>(cooked.Features.size());
+        cooked.Header.NamesSize = static_cast<u32>(cooked.Names.size());
+        return cooked;
+    }
+
+    void CookedShader::AddPermutation(const u32 key, const Span<const char> bytecode)
+    {
+        const auto same = std::ranges::find_if(Variants, [&](const CookedShaderVariant& variant)
+        {
+            return std::ranges::equal(Span<const char>(Bytecode).subspan(variant.BytecodeOffset, variant.BytecodeSize),
+                                      bytecode);
+        });
+        Table[key] = static_cast<u16>(same - Variants.begin());
+        if (same == Variants.end())
+        {
+            Variants.push_back({.BytecodeOffset = Bytecode.size(), .BytecodeSize = bytecode.size()});
+            Bytecode.insert(Bytecode.end(), bytecode.begin(), bytecode.end());
+            // Bytecode of every variant starts aligned, the backend hands it to the driver in place
+            Bytecode.resize(Align(Bytecode.size(), 4));
+        }
+        Header.VariantCount = static_cast<u32>(Variants.size());
+    }
+
+    bool CookedShader::Write(const std::string_view path) const
+    {
+        auto header = Header;
+        u64 offset = sizeof(CookedShaderHeader);
+        const auto place_section = [&](const u64 size)
+        {
+            const u64 section_offset = Align(offset, kSectionAlignment);
+            offset = section_offset + size;
+            return section_offset;
+        };
+        header.FeaturesOffset = place_section(Features.size() * sizeof(CookedShaderFeature));
+        header.NamesOffset = place_section(Names.size());
+        header.TableOffset = place_section(Table.size() * sizeof(u16));
+        header.VariantsOffset = place_section(Variants.size() * sizeof(CookedShaderVariant));
+        header.BytecodeOffset = place_section(Bytecode.size());
+        header.BytecodeSize = Bytecode.size();
+        header.FileSize = offset;
+
+        constexpr Array<char, kSectionAlignment> padding{};
+        FileWriter writer;
+        if (!writer.Open(path))
+        {
+            return false;
+        }
+        const auto write_section = [&](const u64 section_offset, const void* data, const u64 size)
+        {
+            writer.Write(padding.data(), section_offset - writer.BytesWritten());
+            writer.Write(data, size);
+        };
+        writer.Write(&header, sizeof(header));
+        write_section(header.FeaturesOffset, Features.data(), Features.size() * sizeof(CookedShaderFeature));
+        write_section(header.NamesOffset, Names.data(), Names.size());
+        write_section(header.TableOffset, Table.data(), Table.size() * sizeof(u16));
+        write_section(header.VariantsOffset, Variants.data(), Variants.size() * sizeof(CookedShaderVariant));
+        write_section(header.BytecodeOffset, Bytecode.data(), Bytecode.size());
+        return writer.Commit();
+    }
+
+    Opt<CookedShaderView> CookedShaderView::FromMemory(const Span<const char> memory)
+    {
+        if (memory.size() < sizeof(CookedShaderHeader))
+        {
+            return std::nullopt;
+        }
+        const auto* header = reinterpret_cast<const CookedShaderHeader*>(memory.data());
+        const u64 table_size = (1ull << std::min(header->FeatureCount, kMaxShaderFeatures)) * sizeof(u16);
+        if (header->Magic != CookedShaderHeader::kMagic || header->Version != CookedShaderHeader::kVersion ||
+            header->FileSize > memory.size() || header->FeatureCount > kMaxShaderFeatures ||
+            header->FeaturesOffset % alignof(CookedShaderFeature) != 0 || header->TableOffset % alignof(u16) != 0 ||
+            header->VariantsOffset % alignof(CookedShaderVariant) != 0 ||
+            !IsSectionValid(memory, header->FeaturesOffset, header->FeatureCount * sizeof(CookedShaderFeature)) ||
+            !IsSectionValid(memory, header->NamesOffset, header->NamesSize) ||
+            !IsSectionValid(memory, header->TableOffset, table_size) ||
+            !IsSectionValid(memory, header->VariantsOffset, header->VariantCount * sizeof(CookedShaderVariant)) ||
+            !IsSectionValid(memory, header->BytecodeOffset, header->BytecodeSize))
+        {
+            Log::Error("CookedShaderView::FromMemory Invalid cooked shader");
+            return std::nullopt;
+        }
+
+        const auto* data = memory.data();
+        CookedShaderView view{
+            .Header = header,
+            .Features = Span<const CookedShaderFeature>(
+                reinterpret_cast<const CookedShaderFeature*>(data + header->FeaturesOffset), header->FeatureCount),
+            .Names = memory.subspan(header->NamesOffset, header->NamesSize),
+            .Table = Span<const u16>(reinterpret_cast<const u16*>(data + header->TableOffset), table_size / 2),
+            .Variants = Span<const CookedShaderVariant>(
+                reinterpret_cast<const CookedShaderVariant*>(data + header->VariantsOffset), header->VariantCount),
+            .Bytecode = memory.subspan(header->BytecodeOffset, header->BytecodeSize),
+        };
+        const bool valid =
+            std::ranges::all_of(view.Features, [&](const CookedShaderFeature& feature)
+            {
+                return feature.NameOffset <= view.Names.size() &&
+                       feature.NameSize <= view.Names.size() - feature.NameOffset;
+            }) &&
+            std::ranges::all_of(view.Variants, [&](const CookedShaderVariant& variant)
+            {
+                return variant.BytecodeOffset <= view.Bytecode.size() &&
+                       variant.BytecodeSize <= view.Bytecode.size() - variant.BytecodeOffset;
+            }) &&
+            std::ranges::all_of(view.Table, [&](const u16 variant)
+            {
+                return variant == kStrippedPermutation || variant < view.Variants.size();
+            });
+        if (!valid)
+        {
+            Log::Error("CookedShaderView::FromMemory Invalid feature, variant or permutation");
+            return std::nullopt;
+        }
+        return view;
+    }
+
+    std::string_view CookedShaderView::GetFeature(const CookedShaderFeature& feature) const
+    {
+        return {Names.data() + feature.NameOffset, feature.NameSize};
+    }
+
+    Span<const char> CookedShaderView::GetPermutation(const u32 key) const
+    {
+        const u16 variant = key < Table.size() ? Table[key] : kStrippedPermutation;
+        if (variant == kStrippedPermutation)
+        {
+            return {};
+        }
+        return Bytecode.subspan(Variants[variant].BytecodeOffset, Variants[variant].BytecodeSize);
+    }
+} // namespace FS
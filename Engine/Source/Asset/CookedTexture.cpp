@@ -0,0 +1,136 @@
+#include "Asset/CookedTexture.hpp"
+#include "Core/FileWriter.hpp"
+#include "Render/RenderConstants.hpp"
+
+namespace
+{
+    FS::TextureCreateInfo GetTextureCreateInfo(const FS::CookedTextureHeader& header,
+                                               const FS::Span<const FS::TextureSubresource> subresources,
+                                               const void* data)
+    {
+        return {
+            .Dimensions = {header.Width, header.Height},
+            .Depth = header.Depth,
+            .MipLevels = header.MipLevels,
+            .Format = header.Format,
+            .ViewType = FS::ViewType::eTexture2D,
+            .TextureFlags = FS::TextureFlags::eShaderResource,
+            .UploadInfo = {.Data = data, .Subresources = subresources},
+        };
+    }
+}
+
+namespace FS
+{
+    CookedTexture CookedTexture::Create(const Span<const Image* const> mips)
+    {
+        CookedTexture texture;
+        if (mips.empty())
+        {
+            return texture;
+        }
+
+        const auto& base = *mips.front();
+        texture.Header.Width = base.Width;
+        texture.Header.Height = base.Height;
+        texture.Header.MipLevels = static_cast<u16>(mips.size());
+        texture.Header.SubresourceCount = static_cast<u16>(mips.size());
+        texture.Header.Format = base.Format;
+
+        // Stored smallest first, so the mip tail is a prefix of the data and streaming in a finer mip is one
+        // contiguous read
+        u64 offset = 0;
+        texture.Subresources.resize(mips.size());
+        for (u64 i = mips.size(); i-- > 0;)
+        {
+            const auto* mip = mips[i];
+            const TextureSubresource subresource{
+                .Offset = Align(offset, kTextureSubresourceAlignment),
+                .Width = mip->Width,
+                .Height = mip->Height,
+                .RowPitch = static_cast<u32>(Align(mip->RowPitch(), kTextureRowPitchAlignment)),
+                .RowCount = GetRowCount(mip->Format, mip->Height),
+            };
+            offset = subresource.Offset + static_cast<u64>(subresource.RowPitch) * subresource.RowCount;
+            texture.Subresources[i] = subresource;
+        }
+
+        texture.Data.resize(offset);
+        for (u64 i = 0; i < mips.size(); ++i)
+        {
+            const auto* mip = mips[i];
+            const auto& subresource = texture.Subresources[i];
+            const u32 row_size = mip->RowPitch();
+            for (u32 row = 0; row < subresource.RowCount; ++row)
+            {
+                std::memcpy(texture.Data.data() + subresource.Offset + static_cast<u64>(row) * subresource.RowPitch,
+                            mip->Pixels.data() + static_cast<u64>(row) * row_size, row_size);
+            }
+        }
+        texture.Header.DataSize = texture.Data.size();
+        return texture;
+    }
+
+    bool CookedTexture::Write(const std::string_view path) const
+    {
+        auto header = Header;
+        const u64 table_size = Subresources.size() * sizeof(TextureSubresource);
+        header.SubresourceCount = static_cast<u16>(Subresources.size());
+        header.DataOffset = Align(sizeof(CookedTextureHeader) + table_size, kTextureSubresourceAlignment);
+        header.DataSize = Data.size();
+
+        constexpr Array<char, kTextureSubresourceAlignment> padding{};
+        FileWriter writer;
+        if (!writer.Open(path))
+        {
+            return false;
+        }
+        writer.Write(&header, sizeof(header));
+        writer.Write(Subresources.data(), table_size);
+        writer.Write(padding.data(), header.DataOffset - writer.BytesWritten());
+        writer.Write(Data.data(), Data.size());
+        return writer.Commit();
+    }
+
+    u64 GetMipTailSize(const Span<const TextureSubresource> subresources, const u16 mip)
+    {
+        const auto& subresource = subresources[mip];
+        return subresource.Offset + static_cast<u64>(subresource.RowPitch) * subresource.RowCount;
+    }
+
+    TextureCreateInfo CookedTexture::GetCreateInfo() const
+    {
+        return GetTextureCreateInfo(Header, Subresources, Data.data());
+    }
+
+    Opt<CookedTextureView> CookedTextureView::FromMemory(const Span<const char> memory)
+    {
+        if (memory.size() < sizeof(CookedTextureHeader))
+        {
+            return std::nullopt;
+        }
+        const auto* header = reinterpret_cast<const CookedTextureHeader*>(memory.data());
+        const u64 table_end = sizeof(CookedTextureHeader) + header->SubresourceCount * sizeof(TextureSubresource);
+        if (header->Magic != CookedTextureHeader::kMagic || header->Version != CookedTextureHeader::kVersion ||
+            table_end > header->DataOffset || header->DataOffset + header->DataSize > memory.size())
+        {
+            Log::Error("CookedTextureView::FromMemory Invalid cooked texture");
+            return std::nullopt;
+        }
+
+        const auto* data = reinterpret_cast<const u8*>(memory.data());
+        return CookedTextureView{
+            .Header = header,
+            .Subresources = {
+                reinterpret_cast<const TextureSubresource*>(data + sizeof(CookedTextureHeader)),
+                header->SubresourceCount
+            },
+            .Data = {data + header->DataOffset, header->DataSize},
+        };
+    }
+
+    TextureCreateInfo CookedTextureView::GetCreateInfo() const
+    {
+        return GetTextureCreateInfo(*Header, Subresources, Data.data());
+    }
+} // namespace FS
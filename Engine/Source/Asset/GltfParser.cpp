@@ -0,0 +1,785 @@
+#include "MeshParsing.hpp"
+#include "Core/MappedFile.hpp"
+#include "glaze/glaze.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+namespace
+{
+    constexpr u32 kGlbMagic = 0x46546C67; // glTF
+    constexpr u32 kGlbJsonChunk = 0x4E4F534A; // JSON
+    constexpr u32 kGlbBinaryChunk = 0x004E4942; // BIN
+    constexpr u32 kTriangles = 4;
+
+    enum ComponentType : u32
+    {
+        eByte = 5120,
+        eUnsignedByte = 5121,
+        eShort = 5122,
+        eUnsignedShort = 5123,
+        eUnsignedInt = 5125,
+        eFloat = 5126,
+    };
+
+    struct GlbHeader
+    {
+        u32 Magic = 0;
+        u32 Version = 0;
+        u32 Length = 0;
+    };
+
+    struct GlbChunkHeader
+    {
+        u32 Length = 0;
+        u32 Type = 0;
+    };
+
+    struct GltfBuffer
+    {
+        FS::Opt<std::string> Uri;
+        u64 ByteLength = 0;
+    };
+
+    struct GltfBufferView
+    {
+        u32 Buffer = 0;
+        u64 ByteOffset = 0;
+        u64 ByteLength = 0;
+        FS::Opt<u32> ByteStride;
+    };
+
+    struct GltfAccessor
+    {
+        FS::Opt<u32> BufferView;
+        u64 ByteOffset = 0;
+        u32 ComponentType = 0;
+        bool Normalized = false;
+        u64 Count = 0;
+        std::string Type;
+        FS::Opt<glz::raw_json> Sparse;
+    };
+
+    struct GltfPrimitive
+    {
+        std::unordered_map<std::string, u32> Attributes;
+        FS::Opt<u32> Indices;
+        FS::Opt<u32> Material;
+        u32 Mode = kTriangles;
+    };
+
+    struct GltfMesh
+    {
+        std::string Name;
+        FS::Vec<GltfPrimitive> Primitives;
+    };
+
+    struct GltfNode
+    {
+        FS::Opt<u32> Mesh;
+        FS::Vec<u32> Children;
+        FS::Opt<FS::Array<f32, 16>> Matrix;
+        FS::Array<f32, 3> Translation{0.0f, 0.0f, 0.0f};
+        FS::Array<f32, 4> Rotation{0.0f, 0.0f, 0.0f, 1.0f};
+        FS::Array<f32, 3> Scale{1.0f, 1.0f, 1.0f};
+    };
+
+    struct GltfScene
+    {
+        FS::Vec<u32> Nodes;
+    };
+
+    struct GltfMaterial
+    {
+        std::string Name;
+    };
+
+    struct GltfDocument
+    {
+        FS::Vec<GltfBuffer> Buffers;
+        FS::Vec<GltfBufferView> BufferViews;
+        FS::Vec<GltfAccessor> Accessors;
+        FS::Vec<GltfMesh> Meshes;
+        FS::Vec<GltfNode> Nodes;
+        FS::Vec<GltfScene> Scenes;
+        FS::Vec<GltfMaterial> Materials;
+        FS::Opt<u32> Scene;
+        FS::Vec<std::string> ExtensionsRequired;
+    };
+}
+
+template <>
+struct glz::meta<GltfBuffer>
+{
+    using T = GltfBuffer;
+    static constexpr auto value = object("uri", &T::Uri, "byteLength", &T::ByteLength);
+};
+
+template <>
+struct glz::meta<GltfBufferView>
+{
+    using T = GltfBufferView;
+    static constexpr auto value = object("buffer", &T::Buffer, "byteOffset", &T::ByteOffset,
+                                         "byteLength", &T::ByteLength, "byteStride", &T::ByteStride);
+};
+
+template <>
+struct glz::meta<GltfAccessor>
+{
+    using T = GltfAccessor;
+    static constexpr auto value = object("bufferView", &T::BufferView, "byteOffset", &T::ByteOffset,
+                                         "componentType", &T::ComponentType, "normalized", &T::Normalized,
+                                         "count", &T::Count, "type", &T::Type, "sparse", &T::Sparse);
+};
+
+template <>
+struct glz::meta<GltfPrimitive>
+{
+    using T = GltfPrimitive;
+    static constexpr auto value = object("attributes", &T::Attributes, "indices", &T::Indices,
+                                         "material", &T::Material, "mode", &T::Mode);
+};
+
+template <>
+struct glz::meta<GltfMesh>
+{
+    using T = GltfMesh;
+    static constexpr auto value = object("name", &T::Name, "primitives", &T::Primitives);
+};
+
+template <>
+struct glz::meta<GltfNode>
+{
+    using T = GltfNode;
+    static constexpr auto value = object("mesh", &T::Mesh, "children", &T::Children, "matrix", &T::Matrix,
+                                         "translation", &T::Translation, "rotation", &T::Rotation,
+                                         "scale", &T::Scale);
+};
+
+template <>
+struct glz::meta<GltfScene>
+{
+    using T = GltfScene;
+    static constexpr auto value = object("nodes", &T::Nodes);
+};
+
+template <>
+struct glz::meta<GltfMaterial>
+{
+    using T = GltfMaterial;
+    static constexpr auto value = object("name", &T::Name);
+};
+
+template <>
+struct glz::meta<GltfDocument>
+{
+    using T = GltfDocument;
+    static constexpr auto value = object("buffers", &T::Buffers, "bufferViews", &T::BufferViews,
+                                         "accessors", &T::Accessors, "meshes", &T::Meshes, "nodes", &T::Nodes,
+                                         "scenes", &T::Scenes, "materials", &T::Materials, "scene", &T::Scene,
+                                         "extensionsRequired", &T::ExtensionsRequired);
+};
+
+namespace
+{
+    constexpr glz::opts kReadOpts{.null_terminated = false, .error_on_unknown_keys = false};
+
+    /// <summary>
+    /// Buffer contents, either pointing into the mapped .glb or .bin files or decoded from data URIs.
+    /// </summary>
+    struct BufferData
+    {
+        FS::Vec<FS::Span<const u8>> Buffers;
+        std::deque<FS::MappedFile> Files;
+        std::deque<FS::Vec<u8>> Decoded;
+    };
+
+    /// <summary>
+    /// Strided elements of an accessor, read in place from the buffer.
+    /// </summary>
+    struct AccessorView
+    {
+        const u8* Data = nullptr;
+        u64 Count = 0;
+        u64 Stride = 0;
+        u32 ComponentType = 0;
+        u32 ComponentCount = 0;
+        bool Normalized = false;
+    };
+
+    struct Primitive
+    {
+        const GltfPrimitive* Source = nullptr;
+        glm::mat4 Transform{1.0f};
+    };
+
+    u32 GetComponentSize(const u32 component_type)
+    {
+        switch (component_type)
+        {
+        case eByte:
+        case eUnsignedByte:
+            return 1;
+        case eShort:
+        case eUnsignedShort:
+            return 2;
+        case eUnsignedInt:
+        case eFloat:
+            return 4;
+        default:
+            return 0;
+        }
+    }
+
+    u32 GetComponentCount(const std::string_view type)
+    {
+        constexpr std::pair<std::string_view, u32> kTypes[]{
+            {"SCALAR", 1}, {"VEC2", 2}, {"VEC3", 3}, {"VEC4", 4}, {"MAT2", 4}, {"MAT3", 9}, {"MAT4", 16},
+        };
+        for (const auto& [name, count] : kTypes)
+        {
+            if (name == type)
+            {
+                return count;
+            }
+        }
+        return 0;
+    }
+
+    f32 ReadComponent(const u8* data, const u32 component_type, const bool normalized)
+    {
+        const auto read = [data]<typename T>(T)
+        {
+            T value;
+            std::memcpy(&value, data, sizeof(T));
+            return value;
+        };
+        switch (component_type)
+        {
+        case eByte:
+            return normalized ? std::max(read(i8{}) / 127.0f, -1.0f) : read(i8{});
+        case eUnsignedByte:
+            return normalized ? read(u8{}) / 255.0f : read(u8{});
+        case eShort:
+            return normalized ? std::max(read(i16{}) / 32767.0f, -1.0f) : read(i16{});
+        case eUnsignedShort:
+            return normalized ? read(u16{}) / 65535.0f : read(u16{});
+        case eUnsignedInt:
+            return static_cast<f32>(read(u32{}));
+        default:
+            return read(f32{});
+        }
+    }
+
+    /// <summary>
+    /// Call func(index, values) for every element, converting the components to floats. Floats are copied
+    /// straight out of the buffer.
+    /// </summary>
+    template <u32 N, typename Func>
+    void ReadElements(const AccessorView& view, Func&& func)
+    {
+        const u32 count = std::min(N, view.ComponentCount);
+        FS::Array<f32, N> values{};
+        if (view.ComponentType == eFloat)
+        {
+            for (u64 i = 0; i < view.Count; ++i)
+            {
+                std::memcpy(values.data(), view.Data + i * view.Stride, count * sizeof(f32));
+                func(i, values);
+            }
+            return;
+        }
+
+        const u32 component_size = GetComponentSize(view.ComponentType);
+        for (u64 i = 0; i < view.Count; ++i)
+        {
+            const u8* element = view.Data + i * view.Stride;
+            for (u32 component = 0; component < count; ++component)
+            {
+                values[component] = ReadComponent(element + component * component_size, view.ComponentType,
+                                                  view.Normalized);
+            }
+            func(i, values);
+        }
+    }
+
+    FS::Opt<AccessorView> GetAccessor(const GltfDocument& document, const BufferData& buffers, const u32 index,
+                                      const std::string_view path)
+    {
+        if (index >= document.Accessors.size())
+        {
+            FS::Log::Error("GltfParser {} references missing accessor {}", path, index);
+            return std::nullopt;
+        }
+        const auto& accessor = document.Accessors[index];
+        if (!accessor.BufferView || accessor.Sparse)
+        {
+            FS::Log::Error("GltfParser {} accessor {} is sparse or has no buffer view, which isn't supported",
+                           path, index);
+            return std::nullopt;
+        }
+        if (*accessor.BufferView >= document.BufferViews.size())
+        {
+            FS::Log::Error("GltfParser {} references missing buffer view {}", path, *accessor.BufferView);
+            return std::nullopt;
+        }
+        const auto& buffer_view = document.BufferViews[*accessor.BufferView];
+
+        const u32 component_size = GetComponentSize(accessor.ComponentType);
+        const u32 component_count = GetComponentCount(accessor.Type);
+        const u64 element_size = static_cast<u64>(component_size) * component_count;
+        const u64 stride = buffer_view.ByteStride.value_or(element_size);
+        if (element_size == 0 || buffer_view.Buffer >= buffers.Buffers.size())
+        {
+            FS::Log::Error("GltfParser {} accessor {} is invalid", path, index);
+            return std::nullopt;
+        }
+
+        const auto& buffer = buffers.Buffers[buffer_view.Buffer];
+        const u64 accessor_size = accessor.Count > 0 ? stride * (accessor.Count - 1) + element_size : 0;
+        if (buffer_view.ByteOffset + buffer_view.ByteLength > buffer.size() ||
+            accessor.ByteOffset + accessor_size > buffer_view.ByteLength)
+        {
+            FS::Log::Error("GltfParser {} accessor {} is out of the bounds of its buffer", path, index);
+            return std::nullopt;
+        }
+
+        return AccessorView{
+            .Data = buffer.data() + buffer_view.ByteOffset + accessor.ByteOffset,
+            .Count = accessor.Count,
+            .Stride = stride,
+            .ComponentType = accessor.ComponentType,
+            .ComponentCount = component_count,
+            .Normalized = accessor.Normalized,
+        };
+    }
+
+    FS::Opt<FS::Vec<u8>> DecodeBase64(const std::string_view text)
+    {
+        constexpr auto kDecodeTable = []
+        {
+            FS::Array<u8, 256> table{};
+            table.fill(0xFF);
+            constexpr std::string_view kAlphabet =
+                "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+            for (u32 i = 0; i < kAlphabet.size(); ++i)
+            {
+                table[static_cast<u8>(kAlphabet[i])] = static_cast<u8>(i);
+            }
+            return table;
+        }();
+
+        FS::Vec<u8> bytes;
+        bytes.reserve(text.size() / 4 * 3);
+        u32 accumulator = 0;
+        u32 bits = 0;
+        for (const char c : text)
+        {
+            if (c == '=')
+            {
+                break;
+            }
+            const u8 value = kDecodeTable[static_cast<u8>(c)];
+            if (value == 0xFF)
+            {
+                return std::nullopt;
+            }
+            accumulator = accumulator << 6 | value;
+            bits += 6;
+            if (bits >= 8)
+            {
+                bits -= 8;
+                bytes.push_back(static_cast<u8>(accumulator >> bits));
+            }
+        }
+        return bytes;
+    }
+
+    std::string DecodeUri(const std::string_view uri)
+    {
+        std::string decoded;
+        decoded.reserve(uri.size());
+        for (u64 i = 0; i < uri.size(); ++i)
+        {
+            u32 value;
+            if (uri[i] == '%' && i + 2 < uri.size() &&
+                std::from_chars(uri.data() + i + 1, uri.data() + i + 3, value, 16).ptr == uri.data() + i + 3)
+            {
+                decoded.push_back(static_cast<char>(value));
+                i += 2;
+            }
+            else
+            {
+                decoded.push_back(uri[i]);
+            }
+        }
+        return decoded;
+    }
+
+    bool LoadBuffers(const GltfDocument& document, const FS::Span<const u8> glb_binary, const std::string_view path,
+                     BufferData& buffers)
+    {
+        const auto directory = std::filesystem::path(path).parent_path();
+        for (u64 i = 0; i < document.Buffers.size(); ++i)
+        {
+            const auto& buffer = document.Buffers[i];
+            FS::Span<const u8> data;
+            if (!buffer.Uri)
+            {
+                // Only the first buffer of a .glb can live in the binary chunk
+                if (i != 0 || glb_binary.empty())
+                {
+                    FS::Log::Error("GltfParser {} buffer {} has no data", path, i);
+                    return false;
+                }
+                data = glb_binary;
+            }
+            else if (buffer.Uri->starts_with("data:"))
+            {
+                const auto separator = buffer.Uri->find(";base64,");
+                auto decoded = separator != std::string::npos
+                                   ? DecodeBase64(std::string_view(*buffer.Uri).substr(separator + 8))
+                                   : std::nullopt;
+                if (!decoded)
+                {
+                    FS::Log::Error("GltfParser {} buffer {} has an invalid data URI", path, i);
+                    return false;
+                }
+                data = buffers.Decoded.emplace_back(std::move(*decoded));
+            }
+            else
+            {
+                auto& file = buffers.Files.emplace_back();
+                if (!file.Open((directory / DecodeUri(*buffer.Uri)).string()))
+                {
+                    return false;
+                }
+                data = {reinterpret_cast<const u8*>(file.Data()), file.Size()};
+            }
+
+            if (data.size() < buffer.ByteLength)
+            {
+                FS::Log::Error("GltfParser {} buffer {} is shorter than its byteLength", path, i);
+                return false;
+            }
+            buffers.Buffers.push_back(data.first(buffer.ByteLength));
+        }
+        return true;
+    }
+
+    glm::mat4 GetLocalTransform(const GltfNode& node)
+    {
+        if (node.Matrix)
+        {
+            glm::mat4 matrix;
+            std::memcpy(&matrix, node.Matrix->data(), sizeof(matrix));
+            return matrix;
+        }
+        const auto& [tx, ty, tz] = node.Translation;
+        const auto& [rx, ry, rz, rw] = node.Rotation;
+        const auto& [sx, sy, sz] = node.Scale;
+        glm::mat4 matrix = glm::mat4_cast(glm::quat(rw, rx, ry, rz));
+        matrix[0] *= sx;
+        matrix[1] *= sy;
+        matrix[2] *= sz;
+        matrix[3] = glm::vec4(tx, ty, tz, 1.0f);
+        return matrix;
+    }
+
+    /// <summary>
+    /// Every primitive of the default scene with its world transform. Files without scenes get every mesh
+    /// once, untransformed.
+    /// </summary>
+    FS::Vec<Primitive> CollectPrimitives(const GltfDocument& document)
+    {
+        FS::Vec<Primitive> primitives;
+        const auto add_mesh = [&](const u32 mesh, const glm::mat4& transform)
+        {
+            if (mesh < document.Meshes.size())
+            {
+                for (const auto& primitive : document.Meshes[mesh].Primitives)
+                {
+                    primitives.push_back({.Source = &primitive, .Transform = transform});
+                }
+            }
+        };
+
+        if (document.Scenes.empty())
+        {
+            for (u32 mesh = 0; mesh < document.Meshes.size(); ++mesh)
+            {
+                add_mesh(mesh, glm::mat4(1.0f));
+            }
+            return primitives;
+        }
+
+        const auto& scene = document.Scenes[std::min<u64>(document.Scene.value_or(0), document.Scenes.size() - 1)];
+        FS::Vec<std::pair<u32, glm::mat4>> stack;
+        for (const u32 node : scene.Nodes)
+        {
+            stack.emplace_back(node, glm::mat4(1.0f));
+        }
+        // Bounded by the node count so a cyclic file can't loop forever
+        for (u64 visited = 0; !stack.empty() && visited <= document.Nodes.size(); ++visited)
+        {
+            const auto [index, parent] = stack.back();
+            stack.pop_back();
+            if (index >= document.Nodes.size())
+            {
+                continue;
+            }
+            const auto& node = document.Nodes[index];
+            const glm::mat4 transform = parent * GetLocalTransform(node);
+            if (node.Mesh)
+            {
+                add_mesh(*node.Mesh, transform);
+            }
+            for (const u32 child : node.Children)
+            {
+                stack.emplace_back(child, transform);
+            }
+        }
+        return primitives;
+    }
+
+    bool AppendPrimitive(const GltfDocument& document, const BufferData& buffers, const Primitive& primitive,
+                         const std::string_view path, FS::Mesh& mesh)
+    {
+        const auto& source = *primitive.Source;
+        if (source.Mode != kTriangles)
+        {
+            FS::Log::Warn("GltfParser {} skipped a primitive that isn't a triangle list", path);
+            return true;
+        }
+        const auto position_attribute = source.Attributes.find("POSITION");
+        if (position_attribute == source.Attributes.end())
+        {
+            return true;
+        }
+        const auto positions = GetAccessor(document, buffers, position_attribute->second, path);
+        if (!positions)
+        {
+            return false;
+        }
+
+        const u64 base_vertex = mesh.Vertices.size();
+        const u64 vertex_count = positions->Count;
+        mesh.Vertices.resize(base_vertex + vertex_count);
+        FS::Vertex* vertices = mesh.Vertices.data() + base_vertex;
+
+        const glm::mat4& transform = primitive.Transform;
+        const glm::mat3 rotation(transform);
+        const glm::mat3 normal_matrix = glm::transpose(glm::inverse(rotation));
+        // Mirroring transforms flip the winding and the bitangent
+        const bool mirrored = glm::determinant(rotation) < 0.0f;
+
+        ReadElements<3>(*positions, [&](const u64 i, const FS::Array<f32, 3>& value)
+        {
+            vertices[i].Position = glm::vec3(transform * glm::vec4(value[0], value[1], value[2], 1.0f));
+        });
+
+        const auto read_attribute = [&]<u32 N>(const char* name, auto&& func)
+        {
+            const auto attribute = source.Attributes.find(name);
+            if (attribute == source.Attributes.end())
+            {
+                return true;
+            }
+            const auto view = GetAccessor(document, buffers, attribute->second, path);
+            if (!view || view->Count != vertex_count)
+            {
+                FS::Log::Error("GltfParser {} has an invalid {} attribute", path, name);
+                return false;
+            }
+            ReadElements<N>(*view, func);
+            return true;
+        };
+
+        const bool attributes_valid =
+            read_attribute.template operator()<3>("NORMAL", [&](const u64 i, const FS::Array<f32, 3>& value)
+            {
+                const glm::vec3 normal = normal_matrix * glm::vec3(value[0], value[1], value[2]);
+                const f32 length = glm::length(normal);
+                vertices[i].Normal = length > 0.0f ? normal / length : glm::vec3(0.0f);
+            }) &&
+            read_attribute.template operator()<2>("TEXCOORD_0", [&](const u64 i, const FS::Array<f32, 2>& value)
+            {
+                vertices[i].UVx = value[0];
+                vertices[i].UVy = value[1];
+            }) &&
+            read_attribute.template operator()<4>("TANGENT", [&](const u64 i, const FS::Array<f32, 4>& value)
+            {
+                const glm::vec3 tangent = rotation * glm::vec3(value[0], value[1], value[2]);
+                const f32 length = glm::length(tangent);
+                if (length > 0.0f)
+                {
+                    vertices[i].Tangent = glm::vec4(tangent / length, mirrored ? -value[3] : value[3]);
+                }
+            });
+        if (!attributes_valid)
+        {
+            return false;
+        }
+
+        const u64 first_index = mesh.Indices.size();
+        if (source.Indices)
+        {
+            const auto indices = GetAccessor(document, buffers, *source.Indices, path);
+            if (!indices || indices->ComponentCount != 1 || indices->ComponentType == eFloat ||
+                indices->ComponentType == eByte || indices->ComponentType == eShort)
+            {
+                FS::Log::Error("GltfParser {} has an invalid index accessor", path);
+                return false;
+            }
+            mesh.Indices.resize(first_index + indices->Count);
+            u32* destination = mesh.Indices.data() + first_index;
+            const u32 index_size = GetComponentSize(indices->ComponentType);
+            for (u64 i = 0; i < indices->Count; ++i)
+            {
+                u32 index = 0;
+                std::memcpy(&index, indices->Data + i * indices->Stride, index_size);
+                if (index >= vertex_count)
+                {
+                    FS::Log::Error("GltfParser {} has an index out of range", path);
+                    return false;
+                }
+                destination[i] = static_cast<u32>(base_vertex) + index;
+            }
+        }
+        else
+        {
+            mesh.Indices.resize(first_index + vertex_count);
+            std::iota(mesh.Indices.begin() + static_cast<i64>(first_index), mesh.Indices.end(),
+                      static_cast<u32>(base_vertex));
+        }
+        mesh.Indices.resize(first_index + (mesh.Indices.size() - first_index) / 3 * 3);
+        if (mirrored)
+        {
+            for (u64 i = first_index; i < mesh.Indices.size(); i += 3)
+            {
+                std::swap(mesh.Indices[i + 1], mesh.Indices[i + 2]);
+            }
+        }
+
+        std::string material;
+        if (source.Material)
+        {
+            const u32 index = *source.Material;
+            const bool named = index < document.Materials.size() && !document.Materials[index].Name.empty();
+            material = named ? document.Materials[index].Name : std::format("Material{}", index);
+        }
+        mesh.Submeshes.push_back({
+            .FirstIndex = static_cast<u32>(first_index),
+            .IndexCount = static_cast<u32>(mesh.Indices.size() - first_index),
+            .Material = std::move(material),
+        });
+        return true;
+    }
+
+    bool ReadDocument(const FS::MappedFile& file, const std::string_view path, GltfDocument& document,
+                      FS::Span<const u8>& binary)
+    {
+        // A .glb is a JSON chunk followed by an optional binary chunk, a .gltf is only the JSON
+        std::string_view json(file.Data(), file.Size());
+        if (file.Size() >= sizeof(GlbHeader) && file.As<GlbHeader>()->Magic == kGlbMagic)
+        {
+            const u64 size = std::min<u64>(file.As<GlbHeader>()->Length, file.Size());
+            u64 offset = sizeof(GlbHeader);
+            json = {};
+            while (offset + sizeof(GlbChunkHeader) <= size)
+            {
+                GlbChunkHeader chunk;
+                std::memcpy(&chunk, file.Data() + offset, sizeof(chunk));
+                offset += sizeof(GlbChunkHeader);
+                if (offset + chunk.Length > size)
+                {
+                    break;
+                }
+                if (chunk.Type == kGlbJsonChunk && json.empty())
+                {
+                    json = {file.Data() + offset, chunk.Length};
+                }
+                else if (chunk.Type == kGlbBinaryChunk && binary.empty())
+                {
+                    binary = {reinterpret_cast<const u8*>(file.Data()) + offset, chunk.Length};
+                }
+                offset += chunk.Length;
+            }
+            if (json.empty())
+            {
+                FS::Log::Error("GltfParser {} has no JSON chunk", path);
+                return false;
+            }
+        }
+
+        if (const auto ec = glz::read<kReadOpts>(document, json))
+        {
+            FS::Log::Error("GltfParser Failed to parse {}: {}", path, glz::format_error(ec, json));
+            return false;
+        }
+        return true;
+    }
+}
+
+namespace FS::MeshParsing
+{
+    Opt<Mesh> ParseGltf(const std::string_view path)
+    {
+        MappedFile file;
+        if (!file.Open(path))
+        {
+            return std::nullopt;
+        }
+
+        GltfDocument document;
+        Span<const u8> binary;
+        if (!ReadDocument(file, path, document, binary))
+        {
+            return std::nullopt;
+        }
+        for (const auto& extension : document.ExtensionsRequired)
+        {
+            if (extension != "KHR_mesh_quantization")
+            {
+                Log::Error("GltfParser {} requires the unsupported extension {}", path, extension);
+                return std::nullopt;
+            }
+        }
+
+        BufferData buffers;
+        if (!LoadBuffers(document, binary, path, buffers))
+        {
+            return std::nullopt;
+        }
+
+        Mesh mesh;
+        for (const auto& primitive : CollectPrimitives(document))
+        {
+            if (!AppendPrimitive(document, buffers, primitive, path, mesh))
+            {
+                return std::nullopt;
+            }
+        }
+        return mesh;
+    }
+
+    Vec<std::string> GetGltfBufferPaths(const std::string_view path)
+    {
+        MappedFile file;
+        GltfDocument document;
+        Span<const u8> binary;
+        if (!file.Open(path) || !ReadDocument(file, path, document, binary))
+        {
+            return {};
+        }
+
+        Vec<std::string> paths;
+        const auto directory = std::filesystem::path(path).parent_path();
+        for (const auto& buffer : document.Buffers)
+        {
+            if (buffer.Uri && !buffer.Uri->starts_with("data:"))
+            {
+                paths.push_back((directory / DecodeUri(*buffer.Uri)).generic_string());
+            }
+        }
+        return paths;
+    }
+} // namespace FS::MeshParsing
@@ -0,0 +1,190 @@
+#include "Asset/Image.hpp"
+#include "glm/gtc/packing.hpp"
+
+namespace
+{
+    template <typename T>
+    T Load(const u8* data, const u32 index)
+    {
+        T value;
+        std::memcpy(&value, data + index * sizeof(T), sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    void Store(u8* data, const u32 index, const T value)
+    {
+        std::memcpy(data + index * sizeof(T), &value, sizeof(T));
+    }
+
+    u8 ToUnorm8(const f32 value)
+    {
+        return static_cast<u8>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+
+    u16 ToUnorm16(const f32 value)
+    {
+        return static_cast<u16>(std::clamp(value, 0.0f, 1.0f) * 65535.0f + 0.5f);
+    }
+}
+
+namespace FS
+{
+    Image Image::Create(const u32 width, const u32 height, const FS::Format format)
+    {
+        Image image{.Width = width, .Height = height, .Format = format};
+        image.Pixels.resize(static_cast<u64>(image.RowPitch()) * GetRowCount(format, height));
+        return image;
+    }
+
+    bool IsPixelFormatSupported(const Format format)
+    {
+        switch (format)
+        {
+        case Format::eR8_UNORM:
+        case Format::eR8G8_UNORM:
+        case Format::eR8G8B8A8_UNORM:
+        case Format::eR8G8B8A8_UNORM_SRGB:
+        case Format::eB8G8R8A8_UNORM:
+        case Format::eB8G8R8A8_UNORM_SRGB:
+        case Format::eR16_UNORM:
+        case Format::eR16G16_UNORM:
+        case Format::eR16G16B16A16_UNORM:
+        case Format::eR16_FLOAT:
+        case Format::eR16G16_FLOAT:
+        case Format::eR16G16B16A16_FLOAT:
+        case Format::eR32_FLOAT:
+        case Format::eR32G32_FLOAT:
+        case Format::eR32G32B32_FLOAT:
+        case Format::eR32G32B32A32_FLOAT:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    glm::vec4 LoadPixel(const Format format, const u8* pixel)
+    {
+        glm::vec4 value(0.0f, 0.0f, 0.0f, 1.0f);
+        const u32 channels = GetFormatInfo(format).Channels;
+        switch (format)
+        {
+        case Format::eR8_UNORM:
+        case Format::eR8G8_UNORM:
+        case Format::eR8G8B8A8_UNORM:
+        case Format::eR8G8B8A8_UNORM_SRGB:
+            for (u32 i = 0; i < channels; ++i)
+            {
+                value[i] = pixel[i] / 255.0f;
+            }
+            break;
+        case Format::eB8G8R8A8_UNORM:
+        case Format::eB8G8R8A8_UNORM_SRGB:
+            value = glm::vec4(pixel[2], pixel[1], pixel[0], pixel[3]) / 255.0f;
+            break;
+        case Format::eR16_UNORM:
+        case Format::eR16G16_UNORM:
+        case Format::eR16G16B16A16_UNORM:
+            for (u32 i = 0; i < channels; ++i)
+            {
+                value[i] = Load<u16>(pixel, i) / 65535.0f;
+            }
+            break;
+        case Format::eR16_FLOAT:
+        case Format::eR16G16_FLOAT:
+        case Format::eR16G16B16A16_FLOAT:
+            for (u32 i = 0; i < channels; ++i)
+            {
+                value[i] = glm::unpackHalf1x16(Load<u16>(pixel, i));
+            }
+            break;
+        case Format::eR32_FLOAT:
+        case Format::eR32G32_FLOAT:
+        case Format::eR32G32B32_FLOAT:
+        case Format::eR32G32B32A32_FLOAT:
+            for (u32 i = 0; i < channels; ++i)
+            {
+                value[i] = Load<f32>(pixel, i);
+            }
+            break;
+        default:
+            break;
+        }
+        return value;
+    }
+
+    void StorePixel(const Format format, u8* pixel, const glm::vec4& value)
+    {
+        const u32 channels = GetFormatInfo(format).Channels;
+        switch (format)
+        {
+        case Format::eR8_UNORM:
+        case Format::eR8G8_UNORM:
+        case Format::eR8G8B8A8_UNORM:
+        case Format::eR8G8B8A8_UNORM_SRGB:
+            for (u32 i = 0; i < channels; ++i)
+            {
+                pixel[i] = ToUnorm8(value[i]);
+            }
+            break;
+        case Format::eB8G8R8A8_UNORM:
+        case Format::eB8G8R8A8_UNORM_SRGB:
+            pixel[0] = ToUnorm8(value.z);
+            pixel[1] = ToUnorm8(value.y);
+            pixel[2] = ToUnorm8(value.x);
+            pixel[3] = ToUnorm8(value.w);
+            break;
+        case Format::eR16_UNORM:
+        case Format::eR16G16_UNORM:
+        case Format::eR16G16B16A16_UNORM:
+            for (u32 i = 0; i < channels; ++i)
+            {
+                Store(pixel, i, ToUnorm16(value[i]));
+            }
+            break;
+        case Format::eR16_FLOAT:
+        case Format::eR16G16_FLOAT:
+        case Format::eR16G16B16A16_FLOAT:
+            for (u32 i = 0; i < channels; ++i)
+            {
+                Store(pixel, i, glm::packHalf1x16(value[i]));
+            }
+            break;
+        case Format::eR32_FLOAT:
+        case Format::eR32G32_FLOAT:
+        case Format::eR32G32B32_FLOAT:
+        case Format::eR32G32B32A32_FLOAT:
+            for (u32 i = 0; i < channels; ++i)
+            {
+                Store(pixel, i, value[i]);
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    Image ConvertImage(const Image& image, const Format format)
+    {
+        if (!IsPixelFormatSupported(image.Format) || !IsPixelFormatSupported(format))
+        {
+            Log::Error("ConvertImage Unsupported conversion from {} to {}", static_cast<u32>(image.Format),
+                       static_cast<u32>(format));
+            return {};
+        }
+
+        auto result = Image::Create(image.Width, image.Height, format);
+        const u32 source_size = image.PixelSize();
+        const u32 destination_size = result.PixelSize();
+        for (u32 y = 0; y < image.Height; ++y)
+        {
+            const u8* source = image.Row(y);
+            u8* destination = result.Row(y);
+            for (u32 x = 0; x < image.Width; ++x)
+            {
+                StorePixel(format, destination + x * destination_size, LoadPixel(image.Format, source + x * source_size));
+            }
+        }
+        return result;
+    }
+} // namespace FS
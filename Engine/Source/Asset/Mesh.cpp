@@ -0,0 +1,156 @@
+#include "Asset/Mesh.hpp"
+
+namespace
+{
+    struct PositionKey
+    {
+        u32 X = 0;
+        u32 Y = 0;
+        u32 Z = 0;
+
+        bool operator==(const PositionKey&) const = default;
+    };
+
+    struct PositionKeyHash
+    {
+        u64 operator()(const PositionKey& key) const
+        {
+            const u64 hash = key.X * 0x9E3779B97F4A7C15ull ^ key.Y * 0xC2B2AE3D27D4EB4Full ^
+                             key.Z * 0x165667B19E3779F9ull;
+            return hash ^ hash >> 29;
+        }
+    };
+
+    bool IsZero(const glm::vec3& value)
+    {
+        return value.x == 0.0f && value.y == 0.0f && value.z == 0.0f;
+    }
+
+    /// Angle between two edges leaving a corner
+    f32 GetCornerAngle(const glm::vec3& a, const glm::vec3& b)
+    {
+        const f32 lengths = glm::length(a) * glm::length(b);
+        if (lengths <= 0.0f)
+        {
+            return 0.0f;
+        }
+        return std::acos(std::clamp(glm::dot(a, b) / lengths, -1.0f, 1.0f));
+    }
+
+    glm::vec3 GetPerpendicular(const glm::vec3& normal)
+    {
+        const glm::vec3 axis = std::abs(normal.x) > 0.9f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+        return glm::normalize(glm::cross(normal, axis));
+    }
+}
+
+namespace FS
+{
+    void GenerateNormals(Mesh& mesh)
+    {
+        auto& vertices = mesh.Vertices;
+        if (std::ranges::none_of(vertices, [](const Vertex& vertex) { return IsZero(vertex.Normal); }))
+        {
+            return;
+        }
+
+        std::unordered_map<PositionKey, u32, PositionKeyHash> positions;
+        positions.reserve(vertices.size());
+        Vec<u32> position_ids(vertices.size());
+        for (u64 i = 0; i < vertices.size(); ++i)
+        {
+            const auto& position = vertices[i].Position;
+            const PositionKey key{
+                std::bit_cast<u32>(position.x), std::bit_cast<u32>(position.y), std::bit_cast<u32>(position.z)
+            };
+            position_ids[i] = positions.try_emplace(key, static_cast<u32>(positions.size())).first->second;
+        }
+
+        // The cross product is twice the triangle area, which is the weight
+        Vec<glm::vec3> normals(positions.size(), glm::vec3(0.0f));
+        for (u64 i = 0; i + 2 < mesh.Indices.size(); i += 3)
+        {
+            const u32 i0 = mesh.Indices[i];
+            const u32 i1 = mesh.Indices[i + 1];
+            const u32 i2 = mesh.Indices[i + 2];
+            const auto& p0 = vertices[i0].Position;
+            const auto normal = glm::cross(vertices[i1].Position - p0, vertices[i2].Position - p0);
+            normals[position_ids[i0]] += normal;
+            normals[position_ids[i1]] += normal;
+            normals[position_ids[i2]] += normal;
+        }
+
+        for (u64 i = 0; i < vertices.size(); ++i)
+        {
+            if (!IsZero(vertices[i].Normal))
+            {
+                continue;
+            }
+            const auto& normal = normals[position_ids[i]];
+            vertices[i].Normal = IsZero(normal) ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::normalize(normal);
+        }
+    }
+
+    void GenerateTangents(Mesh& mesh)
+    {
+        auto& vertices = mesh.Vertices;
+        const auto needs_tangent = [](const Vertex& vertex)
+        {
+            return vertex.Tangent.x == 0.0f && vertex.Tangent.y == 0.0f && vertex.Tangent.z == 0.0f;
+        };
+        if (std::ranges::none_of(vertices, needs_tangent))
+        {
+            return;
+        }
+
+        Vec<glm::vec3> tangents(vertices.size(), glm::vec3(0.0f));
+        Vec<glm::vec3> bitangents(vertices.size(), glm::vec3(0.0f));
+        for (u64 i = 0; i + 2 < mesh.Indices.size(); i += 3)
+        {
+            const Array<u32, 3> corners{mesh.Indices[i], mesh.Indices[i + 1], mesh.Indices[i + 2]};
+            const auto& v0 = vertices[corners[0]];
+            const auto& v1 = vertices[corners[1]];
+            const auto& v2 = vertices[corners[2]];
+            const glm::vec3 edge1 = v1.Position - v0.Position;
+            const glm::vec3 edge2 = v2.Position - v0.Position;
+            const glm::vec2 uv1(v1.UVx - v0.UVx, v1.UVy - v0.UVy);
+            const glm::vec2 uv2(v2.UVx - v0.UVx, v2.UVy - v0.UVy);
+            const f32 determinant = uv1.x * uv2.y - uv2.x * uv1.y;
+            if (std::abs(determinant) < 1e-12f)
+            {
+                continue; // Degenerate UVs, the vertices fall back to an arbitrary tangent
+            }
+            const f32 scale = 1.0f / determinant;
+            const glm::vec3 tangent = (edge1 * uv2.y - edge2 * uv1.y) * scale;
+            const glm::vec3 bitangent = (edge2 * uv1.x - edge1 * uv2.x) * scale;
+
+            for (u32 corner = 0; corner < 3; ++corner)
+            {
+                const auto& vertex = vertices[corners[corner]];
+                const auto& previous = vertices[corners[(corner + 2) % 3]].Position;
+                const auto& next = vertices[corners[(corner + 1) % 3]].Position;
+                const f32 angle = GetCornerAngle(next - vertex.Position, previous - vertex.Position);
+
+                // Projected into the tangent plane of the vertex first, so the weights compare like vectors
+                const auto& normal = vertex.Normal;
+                tangents[corners[corner]] += (tangent - normal * glm::dot(normal, tangent)) * angle;
+                bitangents[corners[corner]] += (bitangent - normal * glm::dot(normal, bitangent)) * angle;
+            }
+        }
+
+        for (u64 i = 0; i < vertices.size(); ++i)
+        {
+            auto& vertex = vertices[i];
+            if (!needs_tangent(vertex))
+            {
+                continue;
+            }
+            const auto& normal = vertex.Normal;
+            glm::vec3 tangent = tangents[i] - normal * glm::dot(normal, tangents[i]);
+            const f32 length = glm::length(tangent);
+            tangent = length > 1e-8f ? tangent / length : GetPerpendicular(normal);
+            const f32 handedness = glm::dot(glm::cross(normal, tangent), bitangents[i]) < 0.0f ? -1.0f : 1.0f;
+            vertex.Tangent = glm::vec4(tangent, handedness);
+        }
+    }
+} // namespace FS
@@ -0,0 +1,813 @@
+#include "Asset/MeshCodec.hpp"
+
+namespace
+{
+    constexpr u8 kIndexCodecHeader = 0xE1;
+    constexpr u8 kVertexCodecHeader = 0xA2;
+    constexpr u32 kNone = std::numeric_limits<u32>::max();
+
+    // Codes 0-14 of the FIFOs are valid, 15 escapes
+    constexpr u32 kFifoSize = 16;
+    constexpr u32 kFifoSearch = 15;
+    constexpr u8 kEscapeCode = 15;
+
+    constexpr u32 kGroupSize = 16;
+    constexpr u32 kBlockMaxVertices = 256;
+    // The decoder reads 16 bytes past a group header, the tail keeps those reads inside the buffer
+    constexpr u32 kMinTailSize = 32;
+
+    u32 ZigZag(const i32 value) { return static_cast<u32>(value) << 1 ^ static_cast<u32>(value >> 31); }
+    i32 UnZigZag(const u32 value) { return static_cast<i32>(value >> 1) ^ -static_cast<i32>(value & 1); }
+
+    void WriteVarint(FS::Vec<u8>& output, u32 value)
+    {
+        while (value >= 0x80)
+        {
+            output.push_back(static_cast<u8>(value | 0x80));
+            value >>= 7;
+        }
+        output.push_back(static_cast<u8>(value));
+    }
+
+    bool ReadVarint(const u8*& data, const u8* end, u32& value)
+    {
+        value = 0;
+        for (u32 shift = 0; shift < 35; shift += 7)
+        {
+            if (data == end)
+            {
+                return false;
+            }
+            const u8 byte = *data++;
+            value |= static_cast<u32>(byte & 0x7F) << shift;
+            if (byte < 0x80)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Edges are stored reversed, so a triangle looks up its own edges to find the triangle across them
+    class EdgeFifo
+    {
+    public:
+        EdgeFifo() { m_edges.fill({~0u, ~0u}); }
+
+        [[nodiscard]] u32 Find(const u32 a, const u32 b) const
+        {
+            for (u32 i = 0; i < kFifoSearch; ++i)
+            {
+                if (m_edges[(m_offset - 1 - i) % kFifoSize] == std::pair{a, b})
+                {
+                    return i;
+                }
+            }
+            return kEscapeCode;
+        }
+
+        [[nodiscard]] std::pair<u32, u32> Get(const u32 index) const
+        {
+            return m_edges[(m_offset - 1 - index) % kFifoSize];
+        }
+        void Push(const u32 a, const u32 b) { m_edges[m_offset++ % kFifoSize] = {a, b}; }
+
+    private:
+        FS::Array<std::pair<u32, u32>, kFifoSize> m_edges{};
+        u32 m_offset = 0;
+    };
+
+    class VertexFifo
+    {
+    public:
+        VertexFifo() { m_vertices.fill(~0u); }
+
+        // Codes 1-14 hit the FIFO
+        [[nodiscard]] u32 Find(const u32 vertex) const
+        {
+            for (u32 i = 0; i < kFifoSearch - 1; ++i)
+            {
+                if (m_vertices[(m_offset - 1 - i) % kFifoSize] == vertex)
+                {
+                    return i + 1;
+                }
+            }
+            return kEscapeCode;
+        }
+
+        [[nodiscard]] u32 Get(const u32 code) const { return m_vertices[(m_offset - code) % kFifoSize]; }
+        void Push(const u32 vertex) { m_vertices[m_offset++ % kFifoSize] = vertex; }
+
+    private:
+        FS::Array<u32, kFifoSize> m_vertices{};
+        u32 m_offset = 0;
+    };
+
+    // Vertices are the next unused one (code 0), in the vertex FIFO or stored as a delta to the last stored one
+    struct IndexEncoder
+    {
+        FS::Vec<u8>& Data;
+        EdgeFifo Edges;
+        VertexFifo Vertices;
+        u32 Next = 0;
+        u32 Last = 0;
+
+        u8 EncodeVertex(const u32 vertex)
+        {
+            if (vertex == Next)
+            {
+                ++Next;
+                Vertices.Push(vertex);
+                return 0;
+            }
+            if (const u32 code = Vertices.Find(vertex); code != kEscapeCode)
+            {
+                return static_cast<u8>(code);
+            }
+            WriteVarint(Data, ZigZag(static_cast<i32>(vertex - Last)));
+            Last = vertex;
+            Vertices.Push(vertex);
+            return kEscapeCode;
+        }
+    };
+
+    struct IndexDecoder
+    {
+        const u8*& Data;
+        const u8* End;
+        EdgeFifo Edges;
+        VertexFifo Vertices;
+        u32 Next = 0;
+        u32 Last = 0;
+
+        bool DecodeVertex(const u32 code, u32& vertex)
+        {
+            if (code == 0)
+            {
+                vertex = Next++;
+            }
+            else if (code != kEscapeCode)
+            {
+                vertex = Vertices.Get(code);
+                return true;
+            }
+            else
+            {
+                u32 delta = 0;
+                if (!ReadVarint(Data, End, delta))
+                {
+                    return false;
+                }
+                vertex = Last + static_cast<u32>(UnZigZag(delta));
+                Last = vertex;
+            }
+            Vertices.Push(vertex);
+            return true;
+        }
+    };
+
+    // Vertices a vertex is predicted from as the parallelogram A + B - C, C being the third vertex of the triangle
+    // across the edge A-B. They index the vertices after a vertex of zeros, which predicts the first vertex, and
+    // are all the same when the prediction is a single vertex
+    struct VertexPrediction
+    {
+        u32 A = 0;
+        u32 B = 0;
+        u32 C = 0;
+    };
+
+    bool IsValidIndexBuffer(const FS::Span<const u32> indices, const u64 vertex_count)
+    {
+        return indices.size() % 3 == 0 &&
+               std::ranges::all_of(indices, [vertex_count](const u32 index) { return index < vertex_count; });
+    }
+
+    // A vertex whose triangle has its other two vertices earlier is predicted from them, as a parallelogram with
+    // the triangle across their edge when its third vertex is earlier too. Other vertices use the previous one
+    FS::Vec<VertexPrediction> ComputePredictions(const FS::Span<const u32> indices, const u32 vertex_count)
+    {
+        FS::Vec<VertexPrediction> predictions(vertex_count);
+        FS::Vec<u32> offsets(vertex_count + 1, 0);
+        FS::Vec<u32> triangles(indices.size());
+        for (const u32 index : indices)
+        {
+            ++offsets[index + 1];
+        }
+        for (u32 vertex = 0; vertex < vertex_count; ++vertex)
+        {
+            offsets[vertex + 1] += offsets[vertex];
+        }
+        FS::Vec<u32> cursors(offsets.begin(), offsets.end() - 1);
+        for (u64 i = 0; i < indices.size(); ++i)
+        {
+            triangles[cursors[indices[i]]++] = static_cast<u32>(i / 3);
+        }
+
+        const auto find_opposite = [&](const u32 triangle, const u32 a, const u32 b, const u32 vertex)
+        {
+            for (u32 i = offsets[a]; i < offsets[a + 1]; ++i)
+            {
+                const u32* corners = indices.data() + static_cast<u64>(triangles[i]) * 3;
+                if (triangles[i] != triangle && (corners[0] == b || corners[1] == b || corners[2] == b))
+                {
+                    if (const u32 c = corners[0] + corners[1] + corners[2] - a - b; c < vertex)
+                    {
+                        return c;
+                    }
+                }
+            }
+            return kNone;
+        };
+
+        for (u32 vertex = 0; vertex < vertex_count; ++vertex)
+        {
+            // The previous vertex unless a triangle does better, the zero vertex for the first
+            u32 a = vertex;
+            u32 b = vertex;
+            u32 c = vertex;
+            for (u32 i = offsets[vertex]; i < offsets[vertex + 1]; ++i)
+            {
+                const u32* corners = indices.data() + static_cast<u64>(triangles[i]) * 3;
+                const u32 r = corners[0] == vertex ? 0 : corners[1] == vertex ? 1 : 2;
+                const u32 next = corners[(r + 1) % 3];
+                const u32 previous = corners[(r + 2) % 3];
+                if (next >= vertex || previous >= vertex)
+                {
+                    continue;
+                }
+                if (const u32 opposite = find_opposite(triangles[i], next, previous, vertex); opposite != kNone)
+                {
+                    a = next + 1;
+                    b = previous + 1;
+                    c = opposite + 1;
+                    break;
+                }
+                // Without a triangle across the edge, a vertex of the triangle is still closer than the previous one
+                if (c == vertex)
+                {
+                    a = next + 1;
+                    b = next + 1;
+                    c = next + 1;
+                }
+            }
+            predictions[vertex] = {.A = a, .B = b, .C = c};
+        }
+        return predictions;
+    }
+
+    // How a 4 byte channel is predicted and what is left of it, before its bytes are split into planes
+    enum class ChannelMode : u8
+    {
+        eByte,   // Each byte on its own, for packed bytes
+        eWord16, // Two 16 bit lanes, for quantized positions, octahedral normals and half UVs
+        eWord32, // One 32 bit value, for indices and colors
+        eXor,    // Changed bits of a 32 bit value, for floats whose sign and exponent rarely change
+    };
+    constexpr u32 kChannelModeCount = 4;
+
+    using ChannelPlanes = FS::Array<FS::Array<u8, kBlockMaxVertices>, 4>;
+
+    // Lane arithmetic without carries between the lanes of the mode
+    template <ChannelMode Mode>
+    constexpr u32 kHighBits = Mode == ChannelMode::eByte     ? 0x80808080u
+                              : Mode == ChannelMode::eWord16 ? 0x80008000u
+                                                             : 0u;
+
+    template <ChannelMode Mode>
+    u32 AddLanes(const u32 a, const u32 b)
+    {
+        constexpr u32 high = kHighBits<Mode>;
+        return ((a & ~high) + (b & ~high)) ^ ((a ^ b) & high);
+    }
+
+    template <ChannelMode Mode>
+    u32 SubLanes(const u32 a, const u32 b)
+    {
+        constexpr u32 high = kHighBits<Mode>;
+        return ((a | high) - (b & ~high)) ^ ((a ^ ~b) & high);
+    }
+
+    template <ChannelMode Mode>
+    u32 GetResidual(const u32 value, const u32 prediction)
+    {
+        const u32 delta = SubLanes<Mode>(value, prediction);
+        switch (Mode)
+        {
+        case ChannelMode::eByte:
+            return (delta << 1 & 0xFEFEFEFEu) ^ (delta >> 7 & 0x01010101u) * 0xFF;
+        case ChannelMode::eWord16:
+            return (delta << 1 & 0xFFFEFFFEu) ^ (delta >> 15 & 0x00010001u) * 0xFFFF;
+        case ChannelMode::eWord32:
+            return ZigZag(static_cast<i32>(delta));
+        default:
+            return value ^ prediction;
+        }
+    }
+
+    template <ChannelMode Mode>
+    u32 ApplyResidual(const u32 residual, const u32 prediction)
+    {
+        switch (Mode)
+        {
+        case ChannelMode::eByte:
+            return AddLanes<Mode>((residual >> 1 & 0x7F7F7F7Fu) ^ (residual & 0x01010101u) * 0xFF, prediction);
+        case ChannelMode::eWord16:
+            return AddLanes<Mode>((residual >> 1 & 0x7FFF7FFFu) ^ (residual & 0x00010001u) * 0xFFFF, prediction);
+        case ChannelMode::eWord32:
+            return static_cast<u32>(UnZigZag(residual)) + prediction;
+        default:
+            return residual ^ prediction;
+        }
+    }
+
+    u32 LoadChannel(const u8* vertices, const u32 vertex, const u32 stride, const u32 offset)
+    {
+        u32 value = 0;
+        std::memcpy(&value, vertices + static_cast<u64>(vertex) * stride + offset, sizeof(value));
+        return value;
+    }
+
+    template <ChannelMode Mode>
+    u32 Predict(const u8* vertices, const VertexPrediction& prediction, const u32 stride, const u32 offset)
+    {
+        return SubLanes<Mode>(AddLanes<Mode>(LoadChannel(vertices, prediction.A, stride, offset),
+                                             LoadChannel(vertices, prediction.B, stride, offset)),
+                              LoadChannel(vertices, prediction.C, stride, offset));
+    }
+
+    // Vertices start with the vertex of zeros predictions refer to
+    template <ChannelMode Mode>
+    void PredictChannel(const u8* vertices, const u32 first, const u32 count, const u32 stride, const u32 offset,
+                        const VertexPrediction* predictions, ChannelPlanes& planes)
+    {
+        for (u32 i = 0; i < count; ++i)
+        {
+            const u32 vertex = first + i;
+            const u32 residual = GetResidual<Mode>(LoadChannel(vertices, vertex + 1, stride, offset),
+                                                   Predict<Mode>(vertices, predictions[vertex], stride, offset));
+            for (u32 j = 0; j < 4; ++j)
+            {
+                planes[j][i] = static_cast<u8>(residual >> j * 8);
+            }
+        }
+    }
+
+    // Predicts the vertices in order, so the earlier vertices predictions read are already decoded. Vertices
+    // start with the vertex of zeros predictions refer to
+    template <ChannelMode Mode>
+    void ReconstructChannel(const ChannelPlanes& planes, const u32 first, const u32 count, const u32 stride,
+                            const u32 offset, const VertexPrediction* predictions, u8* vertices)
+    {
+        for (u32 i = 0; i < count; ++i)
+        {
+            const u32 vertex = first + i;
+            const u32 residual = planes[0][i] | planes[1][i] << 8 | planes[2][i] << 16 | planes[3][i] << 24;
+            const u32 value = ApplyResidual<Mode>(residual, Predict<Mode>(vertices, predictions[vertex], stride,
+                                                                          offset));
+            std::memcpy(vertices + (static_cast<u64>(vertex) + 1) * stride + offset, &value, sizeof(value));
+        }
+    }
+
+    // Group modes 0-3 store 0, 2, 4 or 8 bits per delta. Packed deltas start with the high bits of the first byte
+    u32 GetGroupSize(const u8* deltas, const u32 mode)
+    {
+        if (mode == 0)
+        {
+            return std::all_of(deltas, deltas + kGroupSize, [](const u8 delta) { return delta == 0; })
+                       ? 0
+                       : ~0u;
+        }
+        if (mode == 3)
+        {
+            return kGroupSize;
+        }
+        const u32 bits = 1u << mode;
+        const u32 escape = (1u << bits) - 1;
+        u32 size = kGroupSize * bits / 8;
+        for (u32 i = 0; i < kGroupSize; ++i)
+        {
+            size += deltas[i] >= escape ? 1 : 0;
+        }
+        return size;
+    }
+
+    void EncodeGroup(FS::Vec<u8>& output, const u8* deltas, const u32 mode)
+    {
+        if (mode == 0)
+        {
+            return;
+        }
+        if (mode == 3)
+        {
+            output.insert(output.end(), deltas, deltas + kGroupSize);
+            return;
+        }
+        const u32 bits = 1u << mode;
+        const u32 escape = (1u << bits) - 1;
+        const u32 per_byte = 8 / bits;
+        for (u32 i = 0; i < kGroupSize; i += per_byte)
+        {
+            u8 byte = 0;
+            for (u32 j = 0; j < per_byte; ++j)
+            {
+                byte = static_cast<u8>(byte << bits | std::min<u32>(deltas[i + j], escape));
+            }
+            output.push_back(byte);
+        }
+        for (u32 i = 0; i < kGroupSize; ++i)
+        {
+            if (deltas[i] >= escape)
+            {
+                output.push_back(deltas[i]);
+            }
+        }
+    }
+
+    u32 GetBestGroupMode(const u8* deltas, u32& best_size)
+    {
+        u32 best_mode = 3;
+        best_size = kGroupSize;
+        for (u32 mode = 0; mode < 3; ++mode)
+        {
+            if (const u32 size = GetGroupSize(deltas, mode); size < best_size)
+            {
+                best_mode = mode;
+                best_size = size;
+            }
+        }
+        return best_mode;
+    }
+
+    void EncodeBlock(FS::Vec<u8>& output, const u8* vertices, const u32 first, const u32 count, const u32 stride,
+                     const VertexPrediction* predictions)
+    {
+        const u32 group_count = (count + kGroupSize - 1) / kGroupSize;
+        const u32 channel_count = stride / 4;
+        const u64 modes = output.size();
+        output.resize(modes + (channel_count + 3) / 4);
+
+        // The padding of the last group stays zero
+        alignas(16) ChannelPlanes planes{};
+        alignas(16) ChannelPlanes best_planes{};
+        for (u32 channel = 0; channel < channel_count; ++channel)
+        {
+            const u32 offset = channel * 4;
+            u32 best_mode = 0;
+            u32 best_size = ~0u;
+            for (u32 mode = 0; mode < kChannelModeCount; ++mode)
+            {
+                switch (static_cast<ChannelMode>(mode))
+                {
+                case ChannelMode::eByte:
+                    PredictChannel<ChannelMode::eByte>(vertices, first, count, stride, offset, predictions, planes);
+                    break;
+                case ChannelMode::eWord16:
+                    PredictChannel<ChannelMode::eWord16>(vertices, first, count, stride, offset, predictions, planes);
+                    break;
+                case ChannelMode::eWord32:
+                    PredictChannel<ChannelMode::eWord32>(vertices, first, count, stride, offset, predictions, planes);
+                    break;
+                case ChannelMode::eXor:
+                    PredictChannel<ChannelMode::eXor>(vertices, first, count, stride, offset, predictions, planes);
+                    break;
+                }
+                u32 size = 0;
+                for (const auto& plane : planes)
+                {
+                    for (u32 group = 0; group < group_count; ++group)
+                    {
+                        u32 group_size = 0;
+                        (void)GetBestGroupMode(plane.data() + group * kGroupSize, group_size);
+                        size += group_size;
+                    }
+                }
+                if (size < best_size)
+                {
+                    best_mode = mode;
+                    best_size = size;
+                    best_planes = planes;
+                }
+            }
+            output[modes + channel / 4] |= static_cast<u8>(best_mode << (channel % 4 * 2));
+
+            for (const auto& plane : best_planes)
+            {
+                const u64 header = output.size();
+                output.resize(header + (group_count + 3) / 4);
+                for (u32 group = 0; group < group_count; ++group)
+                {
+                    const u8* group_deltas = plane.data() + group * kGroupSize;
+                    u32 size = 0;
+                    const u32 mode = GetBestGroupMode(group_deltas, size);
+                    output[header + group / 4] |= static_cast<u8>(mode << (group % 4 * 2));
+                    EncodeGroup(output, group_deltas, mode);
+                }
+            }
+        }
+    }
+
+    // Shuffles moving the escaped bytes of half a group into place, indexed by the escape mask of the half
+    constexpr auto kEscapeShuffles = []
+    {
+        FS::Array<FS::Array<u8, 8>, 256> shuffles{};
+        for (u32 mask = 0; mask < 256; ++mask)
+        {
+            u8 next = 0;
+            for (u32 i = 0; i < 8; ++i)
+            {
+                shuffles[mask][i] = mask & 1u << i ? next++ : 0x80;
+            }
+        }
+        return shuffles;
+    }();
+
+    __m128i DecodeEscapes(const __m128i values, const __m128i escape, const u8* rest, u32& escape_count)
+    {
+        const __m128i mask = _mm_cmpeq_epi8(values, escape);
+        const u32 bits = static_cast<u32>(_mm_movemask_epi8(mask));
+        const u32 low_count = std::popcount(bits & 0xFF);
+        escape_count = low_count + std::popcount(bits >> 8);
+
+        u64 low = 0;
+        u64 high = 0;
+        std::memcpy(&low, kEscapeShuffles[bits & 0xFF].data(), sizeof(low));
+        std::memcpy(&high, kEscapeShuffles[bits >> 8].data(), sizeof(high));
+        // Entries of 0x80 stay at or above 0x80 and keep zeroing their lane
+        high += 0x0101010101010101ull * low_count;
+        const __m128i shuffle = _mm_set_epi64x(static_cast<i64>(high), static_cast<i64>(low));
+        const __m128i escaped = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rest)), shuffle);
+        return _mm_or_si128(_mm_andnot_si128(mask, values), escaped);
+    }
+
+    // Reads at most 24 bytes from data, the caller makes sure they are inside the buffer
+    const u8* DecodeGroup(const u8* data, const u32 mode, u8* output)
+    {
+        __m128i values = _mm_setzero_si128();
+        u32 escape_count = 0;
+        switch (mode)
+        {
+        case 0:
+            break;
+        case 1:
+        {
+            const __m128i packed = _mm_cvtsi32_si128(*reinterpret_cast<const i32*>(data));
+            const __m128i nibbles = _mm_unpacklo_epi8(_mm_srli_epi16(packed, 4), packed);
+            const __m128i pairs = _mm_unpacklo_epi8(_mm_srli_epi16(nibbles, 2), nibbles);
+            values = DecodeEscapes(_mm_and_si128(pairs, _mm_set1_epi8(3)), _mm_set1_epi8(3), data + 4, escape_count);
+            data += 4;
+            break;
+        }
+        case 2:
+        {
+            const __m128i packed = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(data));
+            const __m128i nibbles = _mm_unpacklo_epi8(_mm_srli_epi16(packed, 4), packed);
+            values = DecodeEscapes(_mm_and_si128(nibbles, _mm_set1_epi8(15)), _mm_set1_epi8(15), data + 8,
+                                   escape_count);
+            data += 8;
+            break;
+        }
+        default:
+            values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+            data += kGroupSize;
+            break;
+        }
+        _mm_store_si128(reinterpret_cast<__m128i*>(output), values);
+        return data + escape_count;
+    }
+
+    const u8* DecodeBlock(const u8* data, const u8* data_end, const u32 first, const u32 count, const u32 stride,
+                          const VertexPrediction* predictions, u8* vertices)
+    {
+        const u32 group_count = (count + kGroupSize - 1) / kGroupSize;
+        const u32 channel_count = stride / 4;
+        const u8* modes = data;
+        data += (channel_count + 3) / 4;
+        alignas(16) ChannelPlanes planes;
+        for (u32 channel = 0; channel < channel_count; ++channel)
+        {
+            for (auto& plane : planes)
+            {
+                const u8* header = data;
+                data += (group_count + 3) / 4;
+                for (u32 group = 0; group < group_count; ++group)
+                {
+                    if (data > data_end)
+                    {
+                        return nullptr;
+                    }
+                    const u32 mode = header[group / 4] >> (group % 4 * 2) & 3;
+                    data = DecodeGroup(data, mode, plane.data() + group * kGroupSize);
+                }
+            }
+            if (data > data_end)
+            {
+                return nullptr;
+            }
+
+            const u32 offset = channel * 4;
+            switch (static_cast<ChannelMode>(modes[channel / 4] >> (channel % 4 * 2) & 3))
+            {
+            case ChannelMode::eByte:
+                ReconstructChannel<ChannelMode::eByte>(planes, first, count, stride, offset, predictions, vertices);
+                break;
+            case ChannelMode::eWord16:
+                ReconstructChannel<ChannelMode::eWord16>(planes, first, count, stride, offset, predictions, vertices);
+                break;
+            case ChannelMode::eWord32:
+                ReconstructChannel<ChannelMode::eWord32>(planes, first, count, stride, offset, predictions, vertices);
+                break;
+            case ChannelMode::eXor:
+                ReconstructChannel<ChannelMode::eXor>(planes, first, count, stride, offset, predictions, vertices);
+                break;
+            }
+        }
+        return data;
+    }
+}
+
+namespace FS
+{
+    Vec<u8> EncodeIndexBuffer(const Span<const u32> indices)
+    {
+        const u64 triangle_count = indices.size() / 3;
+        Vec<u8> codes;
+        Vec<u8> data;
+        codes.reserve(triangle_count + 1);
+        data.reserve(triangle_count);
+        codes.push_back(kIndexCodecHeader);
+
+        IndexEncoder encoder{.Data = data};
+        for (u64 triangle = 0; triangle < triangle_count; ++triangle)
+        {
+            const u32* corners = indices.data() + triangle * 3;
+            u32 best_edge = kEscapeCode;
+            u32 rotation = 0;
+            for (u32 r = 0; r < 3; ++r)
+            {
+                if (const u32 edge = encoder.Edges.Find(corners[r], corners[(r + 1) % 3]); edge < best_edge)
+                {
+                    best_edge = edge;
+                    rotation = r;
+                }
+            }
+            const u32 a = corners[rotation];
+            const u32 b = corners[(rotation + 1) % 3];
+            const u32 c = corners[(rotation + 2) % 3];
+
+            if (best_edge != kEscapeCode)
+            {
+                codes.push_back(static_cast<u8>(best_edge << 4 | encoder.EncodeVertex(c)));
+                encoder.Edges.Push(c, b);
+                encoder.Edges.Push(a, c);
+                continue;
+            }
+
+            const u64 vertex_codes = data.size();
+            data.push_back(0);
+            const u8 code_a = encoder.EncodeVertex(a);
+            const u8 code_b = encoder.EncodeVertex(b);
+            const u8 code_c = encoder.EncodeVertex(c);
+            codes.push_back(static_cast<u8>(kEscapeCode << 4 | code_a));
+            data[vertex_codes] = static_cast<u8>(code_b << 4 | code_c);
+            encoder.Edges.Push(b, a);
+            encoder.Edges.Push(c, b);
+            encoder.Edges.Push(a, c);
+        }
+        codes.insert(codes.end(), data.begin(), data.end());
+        return codes;
+    }
+
+    bool DecodeIndexBuffer(const Span<const u8> encoded, const Span<u32> indices)
+    {
+        const u64 triangle_count = indices.size() / 3;
+        if (indices.size() % 3 != 0 || encoded.size() < triangle_count + 1 || encoded[0] != kIndexCodecHeader)
+        {
+            Log::Error("DecodeIndexBuffer Invalid encoded index buffer");
+            return false;
+        }
+
+        const u8* codes = encoded.data() + 1;
+        const u8* data = codes + triangle_count;
+        IndexDecoder decoder{.Data = data, .End = encoded.data() + encoded.size()};
+        u32* output = indices.data();
+        for (u64 triangle = 0; triangle < triangle_count; ++triangle, output += 3)
+        {
+            const u32 code = codes[triangle];
+            const u32 edge = code >> 4;
+            u32 a = 0;
+            u32 b = 0;
+            u32 c = 0;
+            if (edge != kEscapeCode)
+            {
+                std::tie(a, b) = decoder.Edges.Get(edge);
+                if (!decoder.DecodeVertex(code & 15, c))
+                {
+                    break;
+                }
+                decoder.Edges.Push(c, b);
+                decoder.Edges.Push(a, c);
+            }
+            else
+            {
+                if (data == decoder.End)
+                {
+                    break;
+                }
+                const u32 vertex_codes = *data++;
+                if (!decoder.DecodeVertex(code & 15, a) || !decoder.DecodeVertex(vertex_codes >> 4, b) ||
+                    !decoder.DecodeVertex(vertex_codes & 15, c))
+                {
+                    break;
+                }
+                decoder.Edges.Push(b, a);
+                decoder.Edges.Push(c, b);
+                decoder.Edges.Push(a, c);
+            }
+            output[0] = a;
+            output[1] = b;
+            output[2] = c;
+        }
+
+        if (output != indices.data() + triangle_count * 3 || data != decoder.End)
+        {
+            Log::Error("DecodeIndexBuffer Corrupt encoded index buffer");
+            return false;
+        }
+        return true;
+    }
+
+    Vec<u8> EncodeVertexBuffer(const Span<const u8> vertices, const u32 stride, const Span<const u32> indices)
+    {
+        if (stride == 0 || stride % 4 != 0 || stride > kVertexCodecMaxStride || vertices.size() % stride != 0)
+        {
+            Log::Error("EncodeVertexBuffer Unsupported vertex stride {}", stride);
+            return {};
+        }
+        const u64 vertex_count = vertices.size() / stride;
+        if (!IsValidIndexBuffer(indices, vertex_count))
+        {
+            Log::Error("EncodeVertexBuffer Invalid index buffer for {} vertices", vertex_count);
+            return {};
+        }
+
+        const auto predictions = ComputePredictions(indices, static_cast<u32>(vertex_count));
+        Vec<u8> predicted(stride + vertices.size(), 0);
+        std::ranges::copy(vertices, predicted.begin() + stride);
+        Vec<u8> output;
+        output.reserve(vertices.size() / 2 + kMinTailSize + 2);
+        output.push_back(kVertexCodecHeader);
+        output.push_back(indices.empty() ? 0 : 1);
+        for (u64 vertex = 0; vertex < vertex_count; vertex += kBlockMaxVertices)
+        {
+            const u32 count = static_cast<u32>(std::min<u64>(kBlockMaxVertices, vertex_count - vertex));
+            EncodeBlock(output, predicted.data(), static_cast<u32>(vertex), count, stride, predictions.data());
+        }
+        output.resize(output.size() + kMinTailSize);
+        return output;
+    }
+
+    bool DecodeVertexBuffer(const Span<const u8> encoded, const u32 stride, const Span<u8> vertices,
+                            const Span<const u32> indices)
+    {
+        if (stride == 0 || stride % 4 != 0 || stride > kVertexCodecMaxStride || vertices.size() % stride != 0 ||
+            encoded.size() < kMinTailSize + 2 || encoded[0] != kVertexCodecHeader)
+        {
+            Log::Error("DecodeVertexBuffer Invalid encoded vertex buffer");
+            return false;
+        }
+        const u64 vertex_count = vertices.size() / stride;
+        // Vertices encoded without triangles are predicted from the previous one, whatever indices are passed
+        const bool predicted = encoded[1] != 0;
+        if (predicted && (indices.empty() || !IsValidIndexBuffer(indices, vertex_count)))
+        {
+            Log::Error("DecodeVertexBuffer Missing or invalid index buffer for {} vertices", vertex_count);
+            return false;
+        }
+
+        // Predictions read earlier vertices, which can't come from vertices when it is a mapped upload buffer
+        const auto predictions =
+            ComputePredictions(predicted ? indices : Span<const u32>(), static_cast<u32>(vertex_count));
+        Vec<u8> decoded(stride + vertices.size());
+        std::fill_n(decoded.begin(), stride, u8{0});
+        const u8* data = encoded.data() + 2;
+        const u8* data_end = encoded.data() + encoded.size() - kMinTailSize;
+        for (u64 vertex = 0; vertex < vertex_count && data; vertex += kBlockMaxVertices)
+        {
+            const u32 count = static_cast<u32>(std::min<u64>(kBlockMaxVertices, vertex_count - vertex));
+            data = DecodeBlock(data, data_end, static_cast<u32>(vertex), count, stride, predictions.data(),
+                               decoded.data());
+            if (data)
+            {
+                std::memcpy(vertices.data() + vertex * stride, decoded.data() + (vertex + 1) * stride,
+                            static_cast<u64>(count) * stride);
+            }
+        }
+
+        if (data != data_end)
+        {
+            Log::Error("DecodeVertexBuffer Corrupt encoded vertex buffer");
+            return false;
+        }
+        return true;
+    }
+} // namespace FS
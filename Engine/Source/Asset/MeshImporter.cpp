@@ -0,0 +1,72 @@
+#include "Asset/MeshImporter.hpp"
+#include "Core/MappedFile.hpp"
+#include "MeshParsing.hpp"
+
+namespace
+{
+    std::string GetExtension(const std::string_view path)
+    {
+        auto extension = std::filesystem::path(path).extension().string();
+        std::ranges::transform(extension, extension.begin(), [](const char c) { return std::tolower(c); });
+        return extension;
+    }
+}
+
+namespace FS
+{
+    MeshImporter::MeshImporter(JobSystem& jobs) : m_jobs(jobs)
+    {
+    }
+
+    Opt<Mesh> MeshImporter::Import(const std::string_view path, const MeshImportSettings& settings)
+    {
+        const auto extension = GetExtension(path);
+        Opt<Mesh> mesh;
+        if (extension == ".obj")
+        {
+            MappedFile file;
+            if (!file.Open(path))
+            {
+                return std::nullopt;
+            }
+            mesh = MeshParsing::ParseObj(file.GetSpan(), path, m_jobs);
+        }
+        else if (extension == ".gltf" || extension == ".glb")
+        {
+            mesh = MeshParsing::ParseGltf(path);
+        }
+        else
+        {
+            Log::Error("MeshImporter Unsupported file type {}", path);
+            return std::nullopt;
+        }
+
+        if (!mesh)
+        {
+            return std::nullopt;
+        }
+        if (mesh->IsEmpty())
+        {
+            Log::Warn("MeshImporter {} has no triangles", path);
+        }
+        if (settings.GenerateNormals)
+        {
+            GenerateNormals(*mesh);
+        }
+        if (settings.GenerateTangents)
+        {
+            GenerateTangents(*mesh);
+        }
+        return mesh;
+    }
+
+    Vec<std::string> MeshImporter::GetInputs(const std::string_view path)
+    {
+        const auto extension = GetExtension(path);
+        if (extension == ".gltf" || extension == ".glb")
+        {
+            return MeshParsing::GetGltfBufferPaths(path);
+        }
+        return {};
+    }
+} // namespace FS
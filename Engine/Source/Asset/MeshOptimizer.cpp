@@ -0,0 +1,448 @@
+#include "Asset/MeshOptimizer.hpp"
+
+namespace
+{
+    constexpr u32 kNone = std::numeric_limits<u32>::max();
+    /// LRU cache size of the Forsyth scoring, larger than the real cache so the scores fall off smoothly
+    constexpr u32 kForsythCacheSize = 32;
+    constexpr u32 kMaxValence = 32;
+    constexpr u32 kCacheLineSize = 64;
+    /// Vertex fetch cache of the statistics, 4 KB
+    constexpr u32 kFetchCacheLines = 64;
+
+    struct ForsythScores
+    {
+        /// Indexed by cache position, the last entry is for vertices outside the cache
+        FS::Array<f32, kForsythCacheSize + 1> Cache{};
+        FS::Array<f32, kMaxValence + 1> Valence{};
+
+        ForsythScores()
+        {
+            for (u32 position = 0; position < kForsythCacheSize; ++position)
+            {
+                // The three vertices of the last triangle get a fixed score, so the next triangle doesn't
+                // simply reuse its edge
+                Cache[position] = position < 3 ? 0.75f : std::pow(1.0f - static_cast<f32>(position - 3) /
+                                                                  (kForsythCacheSize - 3), 1.5f);
+            }
+            for (u32 valence = 1; valence <= kMaxValence; ++valence)
+            {
+                // Vertices with few triangles left are boosted, so they leave the mesh early
+                Valence[valence] = 2.0f / std::sqrt(static_cast<f32>(valence));
+            }
+        }
+
+        [[nodiscard]] f32 Score(const u32 cache_position, const u32 remaining) const
+        {
+            if (remaining == 0)
+            {
+                return -1.0f;
+            }
+            return Cache[std::min(cache_position, kForsythCacheSize)] + Valence[std::min(remaining, kMaxValence)];
+        }
+    };
+
+    /// <summary>
+    /// FIFO cache that knows whether a vertex is cached from when it was last loaded.
+    /// </summary>
+    class FifoCache
+    {
+    public:
+        FifoCache(const u32 entry_count, const u32 cache_size)
+            : m_times(entry_count, 0), m_cache_size(cache_size), m_time(cache_size)
+        {
+        }
+
+        /// Returns true on a miss
+        bool Access(const u32 entry)
+        {
+            if (m_time - m_times[entry] < m_cache_size)
+            {
+                return false;
+            }
+            m_times[entry] = m_time++;
+            return true;
+        }
+
+        void Flush()
+        {
+            m_time += m_cache_size;
+        }
+
+    private:
+        FS::Vec<u32> m_times;
+        u32 m_cache_size;
+        u32 m_time;
+    };
+
+    u64 HashVertex(const FS::Vertex& vertex)
+    {
+        FS::Array<u32, sizeof(FS::Vertex) / sizeof(u32)> words;
+        std::memcpy(words.data(), &vertex, sizeof(vertex));
+        u64 hash = 0xCBF29CE484222325ull;
+        for (const u32 word : words)
+        {
+            hash = (hash ^ word) * 0x100000001B3ull;
+        }
+        return hash ^ hash >> 32;
+    }
+
+    glm::vec3 GetTriangleNormal(const FS::Span<const FS::Vertex> vertices, const u32* triangle)
+    {
+        const auto& p0 = vertices[triangle[0]].Position;
+        return glm::cross(vertices[triangle[1]].Position - p0, vertices[triangle[2]].Position - p0);
+    }
+
+    glm::vec3 GetTriangleCenter(const FS::Span<const FS::Vertex> vertices, const u32* triangle)
+    {
+        return (vertices[triangle[0]].Position + vertices[triangle[1]].Position + vertices[triangle[2]].Position) /
+               3.0f;
+    }
+}
+
+namespace FS
+{
+    u32 DeduplicateVertices(Mesh& mesh)
+    {
+        auto& vertices = mesh.Vertices;
+        const u64 capacity = std::bit_ceil(std::max<u64>(vertices.size() * 2, 16));
+        Vec<u32> table(capacity, kNone);
+        Vec<u32> remap(vertices.size());
+        u32 unique_count = 0;
+        for (u64 i = 0; i < vertices.size(); ++i)
+        {
+            u64 slot = HashVertex(vertices[i]) & (capacity - 1);
+            while (table[slot] != kNone && std::memcmp(&vertices[table[slot]], &vertices[i], sizeof(Vertex)) != 0)
+            {
+                slot = (slot + 1) & (capacity - 1);
+            }
+            if (table[slot] == kNone)
+            {
+                // Compacting in place is safe, the unique vertices never move past the one being read
+                vertices[unique_count] = vertices[i];
+                table[slot] = unique_count++;
+            }
+            remap[i] = table[slot];
+        }
+
+        const auto removed = static_cast<u32>(vertices.size() - unique_count);
+        vertices.resize(unique_count);
+        for (auto& index : mesh.Indices)
+        {
+            index = remap[index];
+        }
+        return removed;
+    }
+
+    void OptimizeVertexCache(const Span<u32> indices, const u32 vertex_count)
+    {
+        static const ForsythScores kScores;
+        const u64 triangle_count = indices.size() / 3;
+        if (triangle_count < 2)
+        {
+            return;
+        }
+
+        // Triangles of every vertex, the first Remaining entries of each list haven't been emitted yet
+        Vec<u32> remaining(vertex_count, 0);
+        for (u64 i = 0; i < triangle_count * 3; ++i)
+        {
+            ++remaining[indices[i]];
+        }
+        Vec<u32> offsets(vertex_count + 1, 0);
+        for (u32 vertex = 0; vertex < vertex_count; ++vertex)
+        {
+            offsets[vertex + 1] = offsets[vertex] + remaining[vertex];
+        }
+        Vec<u32> adjacency(triangle_count * 3);
+        {
+            Vec<u32> cursors(offsets.begin(), offsets.end() - 1);
+            for (u64 i = 0; i < triangle_count * 3; ++i)
+            {
+                adjacency[cursors[indices[i]]++] = static_cast<u32>(i / 3);
+            }
+        }
+
+        Vec<u32> cache_positions(vertex_count, kForsythCacheSize);
+        Vec<f32> vertex_scores(vertex_count);
+        for (u32 vertex = 0; vertex < vertex_count; ++vertex)
+        {
+            vertex_scores[vertex] = kScores.Score(kForsythCacheSize, remaining[vertex]);
+        }
+        const auto score_triangle = [&](const u64 triangle)
+        {
+            return vertex_scores[indices[triangle * 3]] + vertex_scores[indices[triangle * 3 + 1]] +
+                   vertex_scores[indices[triangle * 3 + 2]];
+        };
+
+        Vec<f32> triangle_scores(triangle_count);
+        u64 best = 0;
+        for (u64 triangle = 0; triangle < triangle_count; ++triangle)
+        {
+            triangle_scores[triangle] = score_triangle(triangle);
+            if (triangle_scores[triangle] > triangle_scores[best])
+            {
+                best = triangle;
+            }
+        }
+
+        Vec<u8> emitted(triangle_count, 0);
+        Vec<u32> output(triangle_count * 3);
+        Array<u32, kForsythCacheSize + 3> cache{};
+        u32 cache_count = 0;
+        u64 next_unemitted = 0;
+        for (u64 emit = 0; emit < triangle_count; ++emit)
+        {
+            if (best == kNone)
+            {
+                // Nothing in the cache has triangles left, continue with the next triangle in the input order
+                while (emitted[next_unemitted])
+                {
+                    ++next_unemitted;
+                }
+                best = next_unemitted;
+            }
+
+            const Array<u32, 3> triangle{indices[best * 3], indices[best * 3 + 1], indices[best * 3 + 2]};
+            std::ranges::copy(triangle, output.begin() + static_cast<i64>(emit * 3));
+            emitted[best] = 1;
+            for (const u32 vertex : triangle)
+            {
+                u32* list = adjacency.data() + offsets[vertex];
+                for (u32 i = 0; i < remaining[vertex]; ++i)
+                {
+                    if (list[i] == best)
+                    {
+                        std::swap(list[i], list[--remaining[vertex]]);
+                        break;
+                    }
+                }
+            }
+
+            // The triangle moves to the front of the LRU cache, vertices pushed past the end are evicted
+            Array<u32, kForsythCacheSize + 3> next_cache;
+            u32 next_count = 0;
+            for (const u32 vertex : triangle)
+            {
+                if (std::find(next_cache.begin(), next_cache.begin() + next_count, vertex) ==
+                    next_cache.begin() + next_count)
+                {
+                    next_cache[next_count++] = vertex;
+                }
+            }
+            for (u32 i = 0; i < cache_count; ++i)
+            {
+                if (std::ranges::find(triangle, cache[i]) == triangle.end())
+                {
+                    next_cache[next_count++] = cache[i];
+                }
+            }
+            for (u32 i = 0; i < next_count; ++i)
+            {
+                const u32 vertex = next_cache[i];
+                cache_positions[vertex] = std::min(i, kForsythCacheSize);
+                vertex_scores[vertex] = kScores.Score(cache_positions[vertex], remaining[vertex]);
+            }
+            cache = next_cache;
+            cache_count = std::min(next_count, kForsythCacheSize);
+
+            // Only triangles touching a vertex whose score changed can change their score
+            best = kNone;
+            f32 best_score = -std::numeric_limits<f32>::max();
+            for (u32 i = 0; i < next_count; ++i)
+            {
+                const u32 vertex = next_cache[i];
+                const u32* list = adjacency.data() + offsets[vertex];
+                for (u32 j = 0; j < remaining[vertex]; ++j)
+                {
+                    const u32 candidate = list[j];
+                    triangle_scores[candidate] = score_triangle(candidate);
+                    if (triangle_scores[candidate] > best_score)
+                    {
+                        best_score = triangle_scores[candidate];
+                        best = candidate;
+                    }
+                }
+            }
+        }
+
+        std::ranges::copy(output, indices.begin());
+    }
+
+    void OptimizeOverdraw(const Span<u32> indices, const Span<const Vertex> vertices, const f32 threshold)
+    {
+        const u64 triangle_count = indices.size() / 3;
+        if (triangle_count < 2)
+        {
+            return;
+        }
+        const auto vertex_count = static_cast<u32>(vertices.size());
+        const f32 target = AnalyzeVertexCache(indices, vertex_count).ACMR * threshold;
+
+        // A cluster ends once its misses, counted from a cold cache, are within the target ACMR, so drawing
+        // the clusters in any order costs at most the threshold
+        Vec<u64> cluster_starts{0};
+        FifoCache cache(vertex_count, kVertexCacheSize);
+        u32 misses = 0;
+        for (u64 triangle = 0; triangle < triangle_count; ++triangle)
+        {
+            for (u32 corner = 0; corner < 3; ++corner)
+            {
+                misses += cache.Access(indices[triangle * 3 + corner]);
+            }
+            const u64 cluster_size = triangle + 1 - cluster_starts.back();
+            if (triangle + 1 < triangle_count && static_cast<f32>(misses) <= target * static_cast<f32>(cluster_size))
+            {
+                cluster_starts.push_back(triangle + 1);
+                cache.Flush();
+                misses = 0;
+            }
+        }
+        cluster_starts.push_back(triangle_count);
+        const u64 cluster_count = cluster_starts.size() - 1;
+        if (cluster_count < 2)
+        {
+            return;
+        }
+
+        // Area weighted centers, the cross product is twice the area
+        Vec<glm::vec3> cluster_centers(cluster_count, glm::vec3(0.0f));
+        Vec<glm::vec3> cluster_normals(cluster_count, glm::vec3(0.0f));
+        glm::vec3 mesh_center(0.0f);
+        f32 mesh_area = 0.0f;
+        for (u64 cluster = 0; cluster < cluster_count; ++cluster)
+        {
+            f32 area = 0.0f;
+            for (u64 triangle = cluster_starts[cluster]; triangle < cluster_starts[cluster + 1]; ++triangle)
+            {
+                const u32* corners = indices.data() + triangle * 3;
+                const glm::vec3 normal = GetTriangleNormal(vertices, corners);
+                const f32 triangle_area = glm::length(normal);
+                cluster_centers[cluster] += GetTriangleCenter(vertices, corners) * triangle_area;
+                cluster_normals[cluster] += normal;
+                area += triangle_area;
+            }
+            mesh_center += cluster_centers[cluster];
+            mesh_area += area;
+            cluster_centers[cluster] = area > 0.0f ? cluster_centers[cluster] / area : glm::vec3(0.0f);
+        }
+        mesh_center = mesh_area > 0.0f ? mesh_center / mesh_area : glm::vec3(0.0f);
+
+        // Clusters facing away from the center are in front of the rest from most directions, so draw them first
+        Vec<f32> sort_keys(cluster_count);
+        for (u64 cluster = 0; cluster < cluster_count; ++cluster)
+        {
+            const f32 length = glm::length(cluster_normals[cluster]);
+            sort_keys[cluster] = length > 0.0f
+                                     ? glm::dot(cluster_centers[cluster] - mesh_center, cluster_normals[cluster]) /
+                                       length
+                                     : -std::numeric_limits<f32>::max();
+        }
+        Vec<u32> order(cluster_count);
+        std::iota(order.begin(), order.end(), 0);
+        std::ranges::stable_sort(order, [&](const u32 a, const u32 b) { return sort_keys[a] > sort_keys[b]; });
+
+        Vec<u32> output;
+        output.reserve(triangle_count * 3);
+        for (const u32 cluster : order)
+        {
+            output.insert(output.end(), indices.begin() + static_cast<i64>(cluster_starts[cluster] * 3),
+                          indices.begin() + static_cast<i64>(cluster_starts[cluster + 1] * 3));
+        }
+        std::ranges::copy(output, indices.begin());
+    }
+
+    void OptimizeVertexFetch(Mesh& mesh)
+    {
+        Vec<u32> remap(mesh.Vertices.size(), kNone);
+        u32 next = 0;
+        for (auto& index : mesh.Indices)
+        {
+            if (remap[index] == kNone)
+            {
+                remap[index] = next++;
+            }
+            index = remap[index];
+        }
+
+        Vec<Vertex> vertices(next);
+        for (u64 i = 0; i < mesh.Vertices.size(); ++i)
+        {
+            if (remap[i] != kNone)
+            {
+                vertices[remap[i]] = mesh.Vertices[i];
+            }
+        }
+        mesh.Vertices = std::move(vertices);
+    }
+
+    void OptimizeMesh(Mesh& mesh, const MeshOptimizationSettings& settings)
+    {
+        DeduplicateVertices(mesh);
+
+        const auto vertex_count = static_cast<u32>(mesh.Vertices.size());
+        const auto optimize_range = [&](const Span<u32> indices)
+        {
+            OptimizeVertexCache(indices, vertex_count);
+            if (settings.OptimizeOverdraw)
+            {
+                OptimizeOverdraw(indices, mesh.Vertices, settings.OverdrawThreshold);
+            }
+        };
+        if (mesh.Submeshes.empty())
+        {
+            optimize_range(mesh.Indices);
+        }
+        for (const auto& submesh : mesh.Submeshes)
+        {
+            optimize_range(Span<u32>(mesh.Indices).subspan(submesh.FirstIndex, submesh.IndexCount));
+        }
+
+        OptimizeVertexFetch(mesh);
+    }
+
+    VertexCacheStatistics AnalyzeVertexCache(const Span<const u32> indices, const u32 vertex_count,
+                                             const u32 cache_size)
+    {
+        FifoCache cache(vertex_count, cache_size);
+        u32 misses = 0;
+        for (const u32 index : indices)
+        {
+            misses += cache.Access(index);
+        }
+
+        const u64 triangle_count = indices.size() / 3;
+        return {
+            .ACMR = triangle_count > 0 ? static_cast<f32>(misses) / static_cast<f32>(triangle_count) : 0.0f,
+            .ATVR = vertex_count > 0 ? static_cast<f32>(misses) / static_cast<f32>(vertex_count) : 0.0f,
+            .VerticesTransformed = misses,
+        };
+    }
+
+    VertexFetchStatistics AnalyzeVertexFetch(const Span<const u32> indices, const u32 vertex_count,
+                                             const u32 vertex_size)
+    {
+        // Only vertices missing the post-transform cache are fetched
+        FifoCache vertex_cache(vertex_count, kVertexCacheSize);
+        const u64 buffer_size = static_cast<u64>(vertex_count) * vertex_size;
+        FifoCache line_cache(static_cast<u32>((buffer_size + kCacheLineSize - 1) / kCacheLineSize), kFetchCacheLines);
+        u64 bytes_fetched = 0;
+        for (const u32 index : indices)
+        {
+            if (!vertex_cache.Access(index))
+            {
+                continue;
+            }
+            const u64 begin = static_cast<u64>(index) * vertex_size;
+            for (u64 line = begin / kCacheLineSize; line <= (begin + vertex_size - 1) / kCacheLineSize; ++line)
+            {
+                bytes_fetched += line_cache.Access(static_cast<u32>(line)) ? kCacheLineSize : 0;
+            }
+        }
+
+        return {
+            .Overfetch = buffer_size > 0 ? static_cast<f32>(bytes_fetched) / static_cast<f32>(buffer_size) : 0.0f,
+            .BytesFetched = bytes_fetched,
+        };
+    }
+} // namespace FS
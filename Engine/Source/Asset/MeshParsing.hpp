@@ -0,0 +1,26 @@
+#pragma once
+#include "Asset/Mesh.hpp"
+
+namespace FS
+{
+    class JobSystem;
+}
+
+namespace FS::MeshParsing
+{
+    /// <summary>
+    /// Parse an OBJ file. Polygons are triangulated as fans and the V coordinate is flipped to the top left
+    /// origin the renderer uses. Vertices without a normal get a zero normal.
+    /// </summary>
+    [[nodiscard]] Opt<Mesh> ParseObj(Span<const char> text, std::string_view path, JobSystem& jobs);
+
+    /// <summary>
+    /// Parse a .gltf or .glb file. Vertices without a normal or tangent get zero ones.
+    /// </summary>
+    [[nodiscard]] Opt<Mesh> ParseGltf(std::string_view path);
+
+    /// <summary>
+    /// External buffer files of a .gltf or .glb file, data URIs and the binary chunk are skipped.
+    /// </summary>
+    [[nodiscard]] Vec<std::string> GetGltfBufferPaths(std::string_view path);
+} // namespace FS::MeshParsing
@@ -0,0 +1,649 @@
+#include "Asset/MeshSimplifier.hpp"
+#include "Core/JobSystem.hpp"
+
+namespace
+{
+    constexpr u32 kNone = std::numeric_limits<u32>::max();
+    /// Border edges are held in place by planes along them, weighted above the surface so the outline stays
+    constexpr f32 kBorderWeight = 10.0f;
+    /// Collapses rotating a triangle by more than about 75 degrees are rejected as flips
+    constexpr f32 kMinNormalDot = 0.25f;
+
+    enum class VertexKind : u8
+    {
+        eManifold,
+        /// On an open border, only collapses along it
+        eBorder,
+        /// On a seam, a non-manifold edge or a border corner
+        eLocked,
+    };
+
+    /// <summary>
+    /// Symmetric 4x4 quadric of squared plane distances, weighted by the area of the planes.
+    /// </summary>
+    struct Quadric
+    {
+        f32 A00 = 0.0f, A11 = 0.0f, A22 = 0.0f;
+        f32 A10 = 0.0f, A20 = 0.0f, A21 = 0.0f;
+        f32 B0 = 0.0f, B1 = 0.0f, B2 = 0.0f;
+        f32 C = 0.0f;
+        f32 Weight = 0.0f;
+
+        static Quadric FromPlane(const glm::vec3& normal, const f32 distance, const f32 weight)
+        {
+            return {
+                .A00 = normal.x * normal.x * weight,
+                .A11 = normal.y * normal.y * weight,
+                .A22 = normal.z * normal.z * weight,
+                .A10 = normal.y * normal.x * weight,
+                .A20 = normal.z * normal.x * weight,
+                .A21 = normal.z * normal.y * weight,
+                .B0 = normal.x * distance * weight,
+                .B1 = normal.y * distance * weight,
+                .B2 = normal.z * distance * weight,
+                .C = distance * distance * weight,
+                .Weight = weight,
+            };
+        }
+
+        Quadric& operator+=(const Quadric& other)
+        {
+            A00 += other.A00;
+            A11 += other.A11;
+            A22 += other.A22;
+            A10 += other.A10;
+            A20 += other.A20;
+            A21 += other.A21;
+            B0 += other.B0;
+            B1 += other.B1;
+            B2 += other.B2;
+            C += other.C;
+            Weight += other.Weight;
+            return *this;
+        }
+
+        /// Average squared distance of the point to the planes
+        [[nodiscard]] f32 Evaluate(const glm::vec3& point) const
+        {
+            const f32 x = A00 * point.x + A10 * point.y + A20 * point.z;
+            const f32 y = A10 * point.x + A11 * point.y + A21 * point.z;
+            const f32 z = A20 * point.x + A21 * point.y + A22 * point.z;
+            const f32 error = x * point.x + y * point.y + z * point.z +
+                              2.0f * (B0 * point.x + B1 * point.y + B2 * point.z) + C;
+            return Weight > 0.0f ? std::abs(error) / Weight : 0.0f;
+        }
+    };
+
+    struct Collapse
+    {
+        u32 From = kNone;
+        u32 To = kNone;
+        f32 Error = 0.0f;
+        /// Squared geometric part of the error
+        f32 GeometricError = 0.0f;
+    };
+
+    /// <summary>
+    /// Triangles using every vertex, rebuilt for every pass over the collapses.
+    /// </summary>
+    struct VertexTriangles
+    {
+        FS::Vec<u32> Offsets;
+        FS::Vec<u32> Triangles;
+
+        void Build(const FS::Span<const u32> indices, const u32 vertex_count)
+        {
+            Offsets.assign(vertex_count + 1, 0);
+            for (const u32 index : indices)
+            {
+                ++Offsets[index + 1];
+            }
+            for (u32 vertex = 0; vertex < vertex_count; ++vertex)
+            {
+                Offsets[vertex + 1] += Offsets[vertex];
+            }
+            Triangles.resize(indices.size());
+            FS::Vec<u32> cursors(Offsets.begin(), Offsets.end() - 1);
+            for (u64 i = 0; i < indices.size(); ++i)
+            {
+                Triangles[cursors[indices[i]]++] = static_cast<u32>(i / 3);
+            }
+        }
+
+        [[nodiscard]] FS::Span<const u32> Get(const u32 vertex) const
+        {
+            return FS::Span<const u32>(Triangles).subspan(Offsets[vertex], Offsets[vertex + 1] - Offsets[vertex]);
+        }
+    };
+
+    f32 GetExtent(const FS::Span<const FS::Vertex> vertices)
+    {
+        if (vertices.empty())
+        {
+            return 0.0f;
+        }
+        glm::vec3 min = vertices.front().Position;
+        glm::vec3 max = min;
+        for (const auto& vertex : vertices)
+        {
+            min = glm::min(min, vertex.Position);
+            max = glm::max(max, vertex.Position);
+        }
+        const glm::vec3 size = max - min;
+        return std::max({size.x, size.y, size.z});
+    }
+
+    struct VertexRange
+    {
+        u32 First = 0;
+        u32 Count = 0;
+    };
+
+    /// Vertices the indices reference, submeshes usually own a contiguous range of the vertex buffer
+    VertexRange GetVertexRange(const FS::Span<const u32> indices)
+    {
+        if (indices.empty())
+        {
+            return {};
+        }
+        const auto [min, max] = std::ranges::minmax(indices);
+        return {.First = min, .Count = max - min + 1};
+    }
+
+    u64 GetEdgeKey(const u32 a, const u32 b)
+    {
+        return static_cast<u64>(std::min(a, b)) << 32 | std::max(a, b);
+    }
+
+    class Simplifier
+    {
+    public:
+        /// <summary>
+        /// Only the vertices of the range are welded, classified and collapsed, positions are relative to the
+        /// extent given.
+        /// </summary>
+        Simplifier(const FS::Span<const FS::Vertex> vertices, const VertexRange range,
+                   const FS::Span<const u32> indices, const FS::SimplifySettings& settings, const f32 extent)
+            : m_vertices(vertices.subspan(range.First, range.Count)), m_first_vertex(range.First), m_settings(settings),
+              m_indices(indices.begin(), indices.end())
+        {
+            for (u32& index : m_indices)
+            {
+                index -= m_first_vertex;
+            }
+            const auto vertex_count = range.Count;
+            m_positions.resize(vertex_count);
+            m_kinds.assign(vertex_count, VertexKind::eManifold);
+            m_border_neighbors.assign(vertex_count, {kNone, kNone});
+            m_quadrics.resize(vertex_count);
+            m_remap.resize(vertex_count);
+            std::iota(m_remap.begin(), m_remap.end(), 0);
+
+            // Relative to the extent, so errors don't depend on the scale of the mesh
+            glm::vec3 min = m_vertices.empty() ? glm::vec3(0.0f) : m_vertices.front().Position;
+            for (const auto& vertex : m_vertices)
+            {
+                min = glm::min(min, vertex.Position);
+            }
+            const f32 inverse_extent = extent > 0.0f ? 1.0f / extent : 0.0f;
+            for (u32 i = 0; i < vertex_count; ++i)
+            {
+                m_positions[i] = (m_vertices[i].Position - min) * inverse_extent;
+            }
+
+            Weld();
+            ClassifyVertices();
+            ComputeQuadrics();
+        }
+
+        FS::SimplifyResult Run()
+        {
+            const u64 target_index_count = static_cast<u64>(static_cast<f64>(m_indices.size() / 3) *
+                                                            std::clamp(m_settings.TargetRatio, 0.0f, 1.0f)) * 3;
+            const f32 error_limit = m_settings.TargetError < std::numeric_limits<f32>::max()
+                                        ? m_settings.TargetError * m_settings.TargetError
+                                        : std::numeric_limits<f32>::max();
+            f32 max_error = 0.0f;
+            while (m_indices.size() > target_index_count)
+            {
+                const u64 triangles_to_remove = (m_indices.size() - target_index_count) / 3;
+                const auto [applied, pass_error] = CollapsePass(triangles_to_remove, error_limit);
+                if (applied == 0)
+                {
+                    break;
+                }
+                max_error = std::max(max_error, pass_error);
+            }
+            for (u32& index : m_indices)
+            {
+                index += m_first_vertex;
+            }
+            return {.Indices = std::move(m_indices), .Error = std::sqrt(max_error)};
+        }
+
+    private:
+        /// Vertices at the same position share a welded index, the lowest one
+        void Weld()
+        {
+            const auto vertex_count = static_cast<u32>(m_vertices.size());
+            m_welded.resize(vertex_count);
+            m_seam.assign(vertex_count, 0);
+            std::unordered_map<u64, u32> first_at_position;
+            first_at_position.reserve(vertex_count);
+            for (u32 i = 0; i < vertex_count; ++i)
+            {
+                FS::Array<u32, 3> bits;
+                std::memcpy(bits.data(), &m_vertices[i].Position, sizeof(bits));
+                const u64 hash = (static_cast<u64>(bits[0]) * 0x9E3779B1u ^ bits[1]) * 0x85EBCA77u ^ bits[2];
+                u32 welded = i;
+                // Chain through hash collisions by probing the following keys
+                for (u64 key = hash;; ++key)
+                {
+                    const auto [it, inserted] = first_at_position.try_emplace(key, i);
+                    if (inserted || m_vertices[it->second].Position == m_vertices[i].Position)
+                    {
+                        welded = it->second;
+                        break;
+                    }
+                }
+                m_welded[i] = welded;
+                if (welded != i)
+                {
+                    m_seam[welded] = 1;
+                    m_seam[i] = 1;
+                }
+            }
+        }
+
+        void ClassifyVertices()
+        {
+            FS::Vec<u64> edges;
+            edges.reserve(m_indices.size());
+            for (u64 i = 0; i < m_indices.size(); i += 3)
+            {
+                for (u32 corner = 0; corner < 3; ++corner)
+                {
+                    const u32 a = m_welded[m_indices[i + corner]];
+                    const u32 b = m_welded[m_indices[i + (corner + 1) % 3]];
+                    edges.push_back(GetEdgeKey(a, b));
+                }
+            }
+            std::ranges::sort(edges);
+
+            const auto vertex_count = static_cast<u32>(m_vertices.size());
+            FS::Vec<u8> border_edge_counts(vertex_count, 0);
+            FS::Vec<u8> non_manifold(vertex_count, 0);
+            for (u64 begin = 0; begin < edges.size();)
+            {
+                u64 end = begin + 1;
+                while (end < edges.size() && edges[end] == edges[begin])
+                {
+                    ++end;
+                }
+                const auto a = static_cast<u32>(edges[begin] >> 32);
+                const auto b = static_cast<u32>(edges[begin] & 0xFFFFFFFF);
+                if (end - begin == 1)
+                {
+                    for (const auto& [vertex, neighbor] : {std::pair{a, b}, std::pair{b, a}})
+                    {
+                        auto& neighbors = m_border_neighbors[vertex];
+                        neighbors[std::min<u32>(border_edge_counts[vertex], 1)] = neighbor;
+                        border_edge_counts[vertex] = static_cast<u8>(std::min(border_edge_counts[vertex] + 1, 3));
+                    }
+                }
+                else if (end - begin > 2)
+                {
+                    non_manifold[a] = 1;
+                    non_manifold[b] = 1;
+                }
+                begin = end;
+            }
+
+            for (u32 i = 0; i < vertex_count; ++i)
+            {
+                const u32 welded = m_welded[i];
+                if (m_seam[welded] || non_manifold[welded])
+                {
+                    m_kinds[i] = VertexKind::eLocked;
+                }
+                else if (border_edge_counts[welded] == 2)
+                {
+                    m_kinds[i] = m_settings.LockBorders ? VertexKind::eLocked : VertexKind::eBorder;
+                }
+                else if (border_edge_counts[welded] != 0)
+                {
+                    m_kinds[i] = VertexKind::eLocked;
+                }
+            }
+        }
+
+        void ComputeQuadrics()
+        {
+            for (u64 i = 0; i < m_indices.size(); i += 3)
+            {
+                const FS::Array<u32, 3> corners{m_indices[i], m_indices[i + 1], m_indices[i + 2]};
+                const glm::vec3& p0 = m_positions[corners[0]];
+                glm::vec3 normal = glm::cross(m_positions[corners[1]] - p0, m_positions[corners[2]] - p0);
+                const f32 double_area = glm::length(normal);
+                if (double_area <= 0.0f)
+                {
+                    continue;
+                }
+                normal /= double_area;
+                const auto face = Quadric::FromPlane(normal, -glm::dot(normal, p0), double_area * 0.5f);
+                for (const u32 corner : corners)
+                {
+                    m_quadrics[corner] += face;
+                }
+
+                for (u32 corner = 0; corner < 3; ++corner)
+                {
+                    const u32 a = corners[corner];
+                    const u32 b = corners[(corner + 1) % 3];
+                    if (!IsBorderEdge(a, b))
+                    {
+                        continue;
+                    }
+                    const glm::vec3 edge = m_positions[b] - m_positions[a];
+                    const f32 length = glm::length(edge);
+                    if (length <= 0.0f)
+                    {
+                        continue;
+                    }
+                    const glm::vec3 side = glm::normalize(glm::cross(edge / length, normal));
+                    const auto border = Quadric::FromPlane(side, -glm::dot(side, m_positions[a]),
+                                                           length * length * kBorderWeight);
+                    m_quadrics[a] += border;
+                    m_quadrics[b] += border;
+                }
+            }
+        }
+
+        [[nodiscard]] bool IsBorderEdge(const u32 a, const u32 b) const
+        {
+            const auto& neighbors = m_border_neighbors[m_welded[a]];
+            return neighbors[0] == m_welded[b] || neighbors[1] == m_welded[b];
+        }
+
+        [[nodiscard]] Collapse FindCollapse(const u32 from) const
+        {
+            Collapse best;
+            const VertexKind kind = m_kinds[from];
+            if (kind == VertexKind::eLocked)
+            {
+                return best;
+            }
+            best.Error = std::numeric_limits<f32>::max();
+            const auto& source = m_vertices[from];
+            for (const u32 triangle : m_vertex_triangles.Get(from))
+            {
+                for (u32 corner = 0; corner < 3; ++corner)
+                {
+                    const u32 to = m_indices[triangle * 3 + corner];
+                    if (to == from || (kind == VertexKind::eBorder && !IsBorderEdge(from, to)))
+                    {
+                        continue;
+                    }
+                    const auto& target = m_vertices[to];
+                    const f32 geometric = m_quadrics[from].Evaluate(m_positions[to]);
+                    const glm::vec2 uv_delta(source.UVx - target.UVx, source.UVy - target.UVy);
+                    const glm::vec3 normal_delta = source.Normal - target.Normal;
+                    const f32 error = geometric + m_settings.UVWeight * glm::dot(uv_delta, uv_delta) +
+                                      m_settings.NormalWeight * glm::dot(normal_delta, normal_delta);
+                    if (error < best.Error)
+                    {
+                        best = {.From = from, .To = to, .Error = error, .GeometricError = geometric};
+                    }
+                }
+            }
+            return best;
+        }
+
+        [[nodiscard]] bool FlipsTriangle(const Collapse& collapse) const
+        {
+            const glm::vec3& target = m_positions[collapse.To];
+            for (const u32 triangle : m_vertex_triangles.Get(collapse.From))
+            {
+                const u32* corners = m_indices.data() + triangle * 3;
+                if (corners[0] == collapse.To || corners[1] == collapse.To || corners[2] == collapse.To)
+                {
+                    continue;
+                }
+                FS::Array<glm::vec3, 3> points{
+                    m_positions[corners[0]], m_positions[corners[1]], m_positions[corners[2]]
+                };
+                const glm::vec3 before = glm::cross(points[1] - points[0], points[2] - points[0]);
+                for (u32 corner = 0; corner < 3; ++corner)
+                {
+                    points[corner] = corners[corner] == collapse.From ? target : points[corner];
+                }
+                // Triangles becoming degenerate count as flipped too, already degenerate ones are ignored
+                const glm::vec3 after = glm::cross(points[1] - points[0], points[2] - points[0]);
+                const f32 before_length = glm::length(before);
+                if (before_length > 0.0f &&
+                    glm::dot(before, after) <= kMinNormalDot * before_length * glm::length(after))
+                {
+                    return true;
+                }
+
+                // Small rotations add up over many collapses, so also keep the triangle facing its vertex normals
+                glm::vec3 shading(0.0f);
+                for (u32 corner = 0; corner < 3; ++corner)
+                {
+                    shading += m_vertices[corners[corner] == collapse.From ? collapse.To : corners[corner]].Normal;
+                }
+                if (glm::dot(shading, shading) > 0.0f && glm::dot(after, shading) <= 0.0f)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /// <summary>
+        /// Apply the cheapest collapses that don't share a triangle fan, returns how many were applied and
+        /// their largest squared geometric error.
+        /// </summary>
+        std::pair<u32, f32> CollapsePass(const u64 triangles_to_remove, const f32 error_limit)
+        {
+            const auto vertex_count = static_cast<u32>(m_vertices.size());
+            m_vertex_triangles.Build(m_indices, vertex_count);
+
+            FS::Vec<Collapse> collapses;
+            for (u32 vertex = 0; vertex < vertex_count; ++vertex)
+            {
+                if (const auto collapse = FindCollapse(vertex); collapse.To != kNone)
+                {
+                    collapses.push_back(collapse);
+                }
+            }
+            std::ranges::sort(collapses, {}, &Collapse::Error);
+
+            FS::Vec<u8> touched(vertex_count, 0);
+            u64 removed = 0;
+            u32 applied = 0;
+            f32 max_error = 0.0f;
+            for (const auto& collapse : collapses)
+            {
+                if (removed >= triangles_to_remove || collapse.Error > error_limit)
+                {
+                    break;
+                }
+                if (touched[collapse.From] || touched[collapse.To] || FlipsTriangle(collapse))
+                {
+                    continue;
+                }
+
+                m_remap[collapse.From] = collapse.To;
+                m_quadrics[collapse.To] += m_quadrics[collapse.From];
+                if (m_kinds[collapse.From] == VertexKind::eBorder)
+                {
+                    // The border edge from the removed vertex now starts at the target
+                    const auto& neighbors = m_border_neighbors[collapse.From];
+                    const u32 other = neighbors[0] == m_welded[collapse.To] ? neighbors[1] : neighbors[0];
+                    for (u32& neighbor : m_border_neighbors[m_welded[collapse.To]])
+                    {
+                        neighbor = neighbor == collapse.From ? other : neighbor;
+                    }
+                    for (u32& neighbor : m_border_neighbors[other])
+                    {
+                        neighbor = neighbor == collapse.From ? m_welded[collapse.To] : neighbor;
+                    }
+                }
+
+                // The fans around both vertices change, nothing else in them collapses this pass
+                for (const u32 triangle : m_vertex_triangles.Get(collapse.From))
+                {
+                    const u32* corners = m_indices.data() + triangle * 3;
+                    removed += corners[0] == collapse.To || corners[1] == collapse.To || corners[2] == collapse.To;
+                    touched[corners[0]] = touched[corners[1]] = touched[corners[2]] = 1;
+                }
+                ++applied;
+                max_error = std::max(max_error, collapse.GeometricError);
+            }
+
+            u64 write = 0;
+            for (u64 i = 0; i < m_indices.size(); i += 3)
+            {
+                const u32 a = m_remap[m_indices[i]];
+                const u32 b = m_remap[m_indices[i + 1]];
+                const u32 c = m_remap[m_indices[i + 2]];
+                if (a != b && b != c && a != c)
+                {
+                    m_indices[write++] = a;
+                    m_indices[write++] = b;
+                    m_indices[write++] = c;
+                }
+            }
+            m_indices.resize(write);
+            return {applied, max_error};
+        }
+
+        FS::Span<const FS::Vertex> m_vertices;
+        u32 m_first_vertex = 0;
+        const FS::SimplifySettings& m_settings;
+        FS::Vec<u32> m_indices;
+        FS::Vec<glm::vec3> m_positions;
+        FS::Vec<u32> m_welded;
+        FS::Vec<u8> m_seam;
+        FS::Vec<VertexKind> m_kinds;
+        /// Welded vertices at the other end of the two border edges of a welded border vertex
+        FS::Vec<FS::Array<u32, 2>> m_border_neighbors;
+        FS::Vec<Quadric> m_quadrics;
+        FS::Vec<u32> m_remap;
+        VertexTriangles m_vertex_triangles;
+    };
+}
+
+namespace FS
+{
+    SimplifyResult SimplifyMesh(const Span<const Vertex> vertices, const Span<const u32> indices,
+                                const SimplifySettings& settings)
+    {
+        const auto range = GetVertexRange(indices);
+        return Simplifier(vertices, range, indices, settings, GetExtent(vertices.subspan(range.First, range.Count)))
+            .Run();
+    }
+
+    LodChain GenerateLods(const Mesh& mesh, const LodSettings& settings)
+    {
+        LodChain chain;
+        chain.Indices = mesh.Indices;
+        auto& base = chain.Lods.emplace_back();
+        base.Submeshes = mesh.Submeshes;
+        if (base.Submeshes.empty())
+        {
+            base.Submeshes.push_back({.FirstIndex = 0, .IndexCount = static_cast<u32>(mesh.Indices.size())});
+        }
+
+        // Every submesh only touches its own vertices, its errors are converted from its extent to the mesh's
+        const f32 extent = GetExtent(mesh.Vertices);
+        Vec<Vec<u32>> current;
+        Vec<VertexRange> ranges;
+        Vec<f32> extent_scales;
+        for (const auto& submesh : base.Submeshes)
+        {
+            const auto begin = mesh.Indices.begin() + submesh.FirstIndex;
+            current.emplace_back(begin, begin + submesh.IndexCount);
+            const auto range = GetVertexRange(current.back());
+            ranges.push_back(range);
+            const f32 submesh_extent = GetExtent(Span<const Vertex>(mesh.Vertices).subspan(range.First, range.Count));
+            extent_scales.push_back(extent > 0.0f ? submesh_extent / extent : 0.0f);
+        }
+
+        // Every LOD is simplified from the previous one, so its error is bounded by the sum of the steps
+        f32 error = 0.0f;
+        u64 previous_triangles = mesh.TriangleCount();
+        while (chain.Lods.size() < settings.MaxLods && error < settings.MaxError)
+        {
+            Vec<Vec<u32>> next(current.size());
+            f32 step_error = 0.0f;
+            u64 triangles = 0;
+            for (u64 i = 0; i < current.size(); ++i)
+            {
+                const f32 scale = extent_scales[i];
+                const SimplifySettings simplify_settings{
+                    .TargetRatio = settings.Ratio,
+                    .TargetError = scale > 0.0f ? (settings.MaxError - error) / scale : settings.MaxError - error,
+                    .UVWeight = settings.UVWeight,
+                    .NormalWeight = settings.NormalWeight,
+                    .LockBorders = settings.LockBorders,
+                };
+                auto result = Simplifier(mesh.Vertices, ranges[i], current[i], simplify_settings, scale * extent).Run();
+                step_error = std::max(step_error, result.Error * scale);
+                triangles += result.Indices.size() / 3;
+                next[i] = std::move(result.Indices);
+            }
+            // Stop once the mesh barely simplifies any further, the LOD wouldn't be worth its memory
+            if (triangles < settings.MinTriangles || static_cast<f64>(triangles) > previous_triangles * 0.9)
+            {
+                break;
+            }
+
+            error += step_error;
+            previous_triangles = triangles;
+            current = std::move(next);
+            MeshLod lod{.Error = error * extent};
+            for (u64 i = 0; i < current.size(); ++i)
+            {
+                lod.Submeshes.push_back({
+                    .FirstIndex = static_cast<u32>(chain.Indices.size()),
+                    .IndexCount = static_cast<u32>(current[i].size()),
+                    .Material = chain.Lods.front().Submeshes[i].Material,
+                });
+                chain.Indices.insert(chain.Indices.end(), current[i].begin(), current[i].end());
+            }
+            chain.Lods.push_back(std::move(lod));
+        }
+        return chain;
+    }
+
+    Vec<LodChain> GenerateLods(const Span<const Mesh> meshes, JobSystem& jobs, const LodSettings& settings)
+    {
+        Vec<LodChain> chains(meshes.size());
+        jobs.ParallelFor(static_cast<u32>(meshes.size()), 1, [&](const u32 index)
+        {
+            chains[index] = GenerateLods(meshes[index], settings);
+        });
+        return chains;
+    }
+
+    f32 GetLodProjectionScale(const f32 fov_y, const f32 viewport_height)
+    {
+        return viewport_height / (2.0f * std::tan(fov_y * 0.5f));
+    }
+
+    u32 SelectLod(const Span<const MeshLod> lods, const f32 distance, const f32 projection_scale,
+                  const f32 max_pixel_error)
+    {
+        // The errors grow along the chain, so the first LOD from the end that fits is the coarsest
+        for (u32 lod = static_cast<u32>(lods.size()); lod-- > 1;)
+        {
+            if (lods[lod].Error * projection_scale <= max_pixel_error * distance)
+            {
+                return lod;
+            }
+        }
+        return 0;
+    }
+} // namespace FS
@@ -0,0 +1,369 @@
+#include "Asset/Meshlet.hpp"
+#include "Asset/MeshOptimizer.hpp"
+
+namespace
+{
+    constexpr u32 kNone = std::numeric_limits<u32>::max();
+    /// Normal cones wider than this barely cull anything, so they are disabled to skip the test
+    constexpr f32 kMinConeDot = 0.1f;
+
+    /// <summary>
+    /// Triangles using every vertex from FirstVertex on, the first Remaining entries of each list haven't been
+    /// added to a meshlet.
+    /// </summary>
+    struct TriangleAdjacency
+    {
+        u32 FirstVertex = 0;
+        FS::Vec<u32> Offsets;
+        FS::Vec<u32> Remaining;
+        FS::Vec<u32> Triangles;
+
+        TriangleAdjacency(const FS::Span<const u32> indices, const u32 first_vertex, const u32 vertex_count)
+            : FirstVertex(first_vertex), Offsets(vertex_count + 1, 0), Remaining(vertex_count, 0),
+              Triangles(indices.size())
+        {
+            for (const u32 index : indices)
+            {
+                ++Remaining[index - FirstVertex];
+            }
+            for (u32 vertex = 0; vertex < vertex_count; ++vertex)
+            {
+                Offsets[vertex + 1] = Offsets[vertex] + Remaining[vertex];
+            }
+            FS::Vec<u32> cursors(Offsets.begin(), Offsets.end() - 1);
+            for (u64 i = 0; i < indices.size(); ++i)
+            {
+                Triangles[cursors[indices[i] - FirstVertex]++] = static_cast<u32>(i / 3);
+            }
+        }
+
+        [[nodiscard]] FS::Span<u32> Get(const u32 vertex)
+        {
+            return FS::Span<u32>(Triangles).subspan(Offsets[vertex - FirstVertex], Remaining[vertex - FirstVertex]);
+        }
+
+        void Remove(const u32 vertex, const u32 triangle)
+        {
+            const auto triangles = Get(vertex);
+            const auto it = std::ranges::find(triangles, triangle);
+            if (it != triangles.end())
+            {
+                std::swap(*it, triangles.back());
+                --Remaining[vertex - FirstVertex];
+            }
+        }
+    };
+
+    class MeshletWriter
+    {
+    public:
+        MeshletWriter(FS::MeshletMesh& output, const FS::Span<const FS::Vertex> vertices)
+            : m_output(output), m_vertices(vertices), m_local_indices(vertices.size(), kNone)
+        {
+        }
+
+        [[nodiscard]] u32 GetVertexCount() const { return static_cast<u32>(m_meshlet_vertices.size()); }
+        [[nodiscard]] u32 GetTriangleCount() const { return static_cast<u32>(m_meshlet_indices.size() / 3); }
+        [[nodiscard]] bool IsEmpty() const { return m_meshlet_indices.empty(); }
+        [[nodiscard]] glm::vec3 GetCenter() const { return m_center_sum / static_cast<f32>(GetTriangleCount()); }
+
+        [[nodiscard]] const glm::vec3& GetPosition(const u32 vertex) const { return m_vertices[vertex].Position; }
+
+        [[nodiscard]] u32 CountNewVertices(const u32* triangle) const
+        {
+            return (m_local_indices[triangle[0]] == kNone) + (m_local_indices[triangle[1]] == kNone) +
+                   (m_local_indices[triangle[2]] == kNone);
+        }
+
+        [[nodiscard]] bool Fits(const u32* triangle) const
+        {
+            return GetTriangleCount() < FS::kMeshletMaxTriangles &&
+                   GetVertexCount() + CountNewVertices(triangle) <= FS::kMeshletMaxVertices;
+        }
+
+        void Add(const u32* triangle, const glm::vec3& triangle_center)
+        {
+            for (u32 corner = 0; corner < 3; ++corner)
+            {
+                const u32 vertex = triangle[corner];
+                if (m_local_indices[vertex] == kNone)
+                {
+                    m_local_indices[vertex] = GetVertexCount();
+                    m_meshlet_vertices.push_back(vertex);
+                }
+                m_meshlet_indices.push_back(vertex);
+            }
+            m_center_sum += triangle_center;
+        }
+
+        void Flush()
+        {
+            if (IsEmpty())
+            {
+                return;
+            }
+            m_output.Bounds.push_back(FS::ComputeMeshletBounds(m_vertices, m_meshlet_indices));
+
+            // Reorder the triangles for the cache with meshlet local indices, then number the vertices in the
+            // order the new triangle order first uses them
+            FS::Vec<u32> local(m_meshlet_indices.size());
+            for (u64 i = 0; i < local.size(); ++i)
+            {
+                local[i] = m_local_indices[m_meshlet_indices[i]];
+            }
+            FS::OptimizeVertexCache(local, GetVertexCount());
+
+            FS::Array<u32, FS::kMeshletMaxVertices> remap;
+            remap.fill(kNone);
+            const FS::Meshlet meshlet{
+                .VertexOffset = static_cast<u32>(m_output.VertexIndices.size()),
+                .TriangleOffset = static_cast<u32>(m_output.Triangles.size()),
+                .VertexCount = GetVertexCount(),
+                .TriangleCount = GetTriangleCount(),
+            };
+            for (u32& index : local)
+            {
+                if (remap[index] == kNone)
+                {
+                    remap[index] = static_cast<u32>(m_output.VertexIndices.size()) - meshlet.VertexOffset;
+                    m_output.VertexIndices.push_back(m_meshlet_vertices[index]);
+                }
+                index = remap[index];
+            }
+            for (u64 i = 0; i < local.size(); i += 3)
+            {
+                m_output.Triangles.push_back(FS::PackMeshletTriangle(local[i], local[i + 1], local[i + 2]));
+            }
+            m_output.Meshlets.push_back(meshlet);
+
+            for (const u32 vertex : m_meshlet_vertices)
+            {
+                m_local_indices[vertex] = kNone;
+            }
+            m_meshlet_vertices.clear();
+            m_meshlet_indices.clear();
+            m_center_sum = glm::vec3(0.0f);
+        }
+
+    private:
+        FS::MeshletMesh& m_output;
+        FS::Span<const FS::Vertex> m_vertices;
+        /// Index in the current meshlet of every vertex, kNone when it isn't used yet
+        FS::Vec<u32> m_local_indices;
+        FS::Vec<u32> m_meshlet_vertices;
+        FS::Vec<u32> m_meshlet_indices;
+        glm::vec3 m_center_sum{0.0f};
+    };
+
+    void BuildRange(MeshletWriter& writer, const FS::Span<const u32> indices)
+    {
+        if (indices.empty())
+        {
+            return;
+        }
+        const u32 triangle_count = static_cast<u32>(indices.size() / 3);
+        // Submeshes usually own a contiguous range of the vertex buffer, so the adjacency only covers that
+        const auto [first_vertex, last_vertex] = std::ranges::minmax(indices);
+        TriangleAdjacency adjacency(indices, first_vertex, last_vertex - first_vertex + 1);
+        FS::Vec<u8> added(triangle_count, 0);
+        // Meshlet a triangle was last made a candidate for, so it is listed only once
+        FS::Vec<u32> candidate_of(triangle_count, kNone);
+        FS::Vec<u32> candidates;
+        u32 meshlet_index = 0;
+        u32 next_in_order = 0;
+        FS::Vec<glm::vec3> centers(triangle_count);
+        for (u32 triangle = 0; triangle < triangle_count; ++triangle)
+        {
+            const u32* corners = indices.data() + triangle * 3;
+            centers[triangle] = (writer.GetPosition(corners[0]) + writer.GetPosition(corners[1]) +
+                                 writer.GetPosition(corners[2])) / 3.0f;
+        }
+
+        const auto add = [&](const u32 triangle)
+        {
+            const u32* corners = indices.data() + triangle * 3;
+            writer.Add(corners, centers[triangle]);
+            added[triangle] = 1;
+            for (u32 corner = 0; corner < 3; ++corner)
+            {
+                adjacency.Remove(corners[corner], triangle);
+            }
+            for (u32 corner = 0; corner < 3; ++corner)
+            {
+                for (const u32 neighbor : adjacency.Get(corners[corner]))
+                {
+                    if (candidate_of[neighbor] != meshlet_index)
+                    {
+                        candidate_of[neighbor] = meshlet_index;
+                        candidates.push_back(neighbor);
+                    }
+                }
+            }
+        };
+        const auto flush = [&]
+        {
+            writer.Flush();
+            candidates.clear();
+            ++meshlet_index;
+        };
+
+        for (u32 remaining = triangle_count; remaining > 0; --remaining)
+        {
+            // Prefer triangles adding the fewest vertices, then the closest to the meshlet
+            u32 best = kNone;
+            u32 best_new_vertices = kNone;
+            f32 best_distance = std::numeric_limits<f32>::max();
+            const glm::vec3 center = writer.IsEmpty() ? glm::vec3(0.0f) : writer.GetCenter();
+            for (u64 i = 0; i < candidates.size();)
+            {
+                const u32 candidate = candidates[i];
+                if (added[candidate])
+                {
+                    candidates[i] = candidates.back();
+                    candidates.pop_back();
+                    continue;
+                }
+                ++i;
+
+                const u32* corners = indices.data() + candidate * 3;
+                if (!writer.Fits(corners))
+                {
+                    continue;
+                }
+                const u32 new_vertices = writer.CountNewVertices(corners);
+                const glm::vec3 offset = centers[candidate] - center;
+                const f32 distance = glm::dot(offset, offset);
+                if (new_vertices < best_new_vertices || (new_vertices == best_new_vertices && distance < best_distance))
+                {
+                    best = candidate;
+                    best_new_vertices = new_vertices;
+                    best_distance = distance;
+                }
+            }
+
+            if (best == kNone)
+            {
+                if (!candidates.empty())
+                {
+                    // Connected triangles are left but the meshlet is full
+                    flush();
+                }
+                // Nothing connected, continue with the input order which the cache optimization made local
+                while (added[next_in_order])
+                {
+                    ++next_in_order;
+                }
+                best = next_in_order;
+                if (!writer.Fits(indices.data() + best * 3))
+                {
+                    flush();
+                }
+            }
+            add(best);
+        }
+        flush();
+    }
+}
+
+namespace FS
+{
+    MeshletMesh BuildMeshlets(const Mesh& mesh)
+    {
+        MeshletMesh output;
+        MeshletWriter writer(output, mesh.Vertices);
+        const auto build = [&](const Span<const u32> indices)
+        {
+            const auto first_meshlet = static_cast<u32>(output.Meshlets.size());
+            BuildRange(writer, indices);
+            output.Ranges.push_back({
+                .FirstMeshlet = first_meshlet,
+                .MeshletCount = static_cast<u32>(output.Meshlets.size()) - first_meshlet,
+            });
+        };
+
+        if (mesh.Submeshes.empty())
+        {
+            build(mesh.Indices);
+        }
+        for (const auto& submesh : mesh.Submeshes)
+        {
+            build(Span<const u32>(mesh.Indices).subspan(submesh.FirstIndex, submesh.IndexCount));
+        }
+        return output;
+    }
+
+    MeshletBounds ComputeMeshletBounds(const Span<const Vertex> vertices, const Span<const u32> indices)
+    {
+        MeshletBounds bounds;
+        if (indices.empty())
+        {
+            return bounds;
+        }
+
+        // Ritter's sphere: start from two far apart points and grow the sphere over the ones outside
+        const auto position = [&](const u32 index) { return vertices[index].Position; };
+        const auto farthest_from = [&](const glm::vec3 point)
+        {
+            glm::vec3 farthest = point;
+            f32 max_distance = 0.0f;
+            for (const u32 index : indices)
+            {
+                const glm::vec3 offset = position(index) - point;
+                if (glm::dot(offset, offset) > max_distance)
+                {
+                    max_distance = glm::dot(offset, offset);
+                    farthest = position(index);
+                }
+            }
+            return farthest;
+        };
+        const glm::vec3 a = farthest_from(position(indices[0]));
+        const glm::vec3 b = farthest_from(a);
+        glm::vec3 center = (a + b) * 0.5f;
+        f32 radius = glm::length(b - a) * 0.5f;
+        for (const u32 index : indices)
+        {
+            const f32 distance = glm::length(position(index) - center);
+            if (distance > radius)
+            {
+                const f32 grown = (radius + distance) * 0.5f;
+                center += (position(index) - center) * ((grown - radius) / distance);
+                radius = grown;
+            }
+        }
+        bounds.Center = center;
+        bounds.Radius = radius;
+
+        Vec<glm::vec3> normals;
+        normals.reserve(indices.size() / 3);
+        glm::vec3 axis(0.0f);
+        for (u64 i = 0; i + 2 < indices.size(); i += 3)
+        {
+            const glm::vec3 p0 = position(indices[i]);
+            const glm::vec3 normal = glm::cross(position(indices[i + 1]) - p0, position(indices[i + 2]) - p0);
+            const f32 length = glm::length(normal);
+            if (length > 0.0f)
+            {
+                normals.push_back(normal / length);
+                axis += normals.back();
+            }
+        }
+        const f32 axis_length = glm::length(axis);
+        if (axis_length <= 0.0f)
+        {
+            return bounds;
+        }
+        axis /= axis_length;
+
+        f32 min_dot = 1.0f;
+        for (const auto& normal : normals)
+        {
+            min_dot = std::min(min_dot, glm::dot(axis, normal));
+        }
+        bounds.ConeAxis = axis;
+        // Every triangle faces away once the view direction is within 90 degrees minus the cone half angle of
+        // the axis, whose cosine is the sine of the half angle
+        bounds.ConeCutoff = min_dot < kMinConeDot ? 1.0f : std::sqrt(1.0f - min_dot * min_dot);
+        return bounds;
+    }
+} // namespace FS
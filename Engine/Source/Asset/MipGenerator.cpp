@@ -0,0 +1,463 @@
+#include "Asset/MipGenerator.hpp"
+#include "Core/JobSystem.hpp"
+
+namespace
+{
+    // Rows per job, small levels are filtered by a single job
+    constexpr u32 kRowsPerJob = 8;
+
+    // RGBA floats, 16 bytes per pixel so a pixel is one SSE register
+    struct LinearImage
+    {
+        u32 Width = 0;
+        u32 Height = 0;
+        FS::Vec<f32> Pixels;
+
+        static LinearImage Create(const u32 width, const u32 height)
+        {
+            return {.Width = width, .Height = height, .Pixels = FS::Vec<f32>(static_cast<u64>(width) * height * 4)};
+        }
+
+        f32* Row(const u32 y) { return Pixels.data() + static_cast<u64>(y) * Width * 4; }
+        const f32* Row(const u32 y) const { return Pixels.data() + static_cast<u64>(y) * Width * 4; }
+    };
+
+    // Weights of every output pixel along one axis, each output reads TapCount clamped input pixels
+    struct FilterTable
+    {
+        u32 TapCount = 0;
+        FS::Vec<u32> Indices;
+        FS::Vec<f32> Weights;
+    };
+
+    f32 Sinc(const f32 x)
+    {
+        if (std::abs(x) < 1e-5f)
+        {
+            return 1.0f;
+        }
+        const f32 pi_x = std::numbers::pi_v<f32> * x;
+        return std::sin(pi_x) / pi_x;
+    }
+
+    f32 BesselI0(const f32 x)
+    {
+        f32 sum = 1.0f;
+        f32 term = 1.0f;
+        const f32 half_squared = x * x * 0.25f;
+        for (u32 k = 1; k < 32 && term > sum * 1e-8f; ++k)
+        {
+            term *= half_squared / static_cast<f32>(k * k);
+            sum += term;
+        }
+        return sum;
+    }
+
+    f32 GetFilterSupport(const FS::MipFilter filter)
+    {
+        switch (filter)
+        {
+        case FS::MipFilter::eBox:
+            return 0.5f;
+        case FS::MipFilter::eKaiser:
+        case FS::MipFilter::eLanczos:
+            return 3.0f;
+        }
+        return 0.5f;
+    }
+
+    f32 EvaluateFilter(const FS::MipFilter filter, const f32 x)
+    {
+        constexpr f32 kKaiserAlpha = 4.0f;
+        const f32 support = GetFilterSupport(filter);
+        if (std::abs(x) >= support)
+        {
+            return 0.0f;
+        }
+        switch (filter)
+        {
+        case FS::MipFilter::eBox:
+            return 1.0f;
+        case FS::MipFilter::eKaiser:
+            {
+                const f32 t = x / support;
+                return Sinc(x) * BesselI0(kKaiserAlpha * std::sqrt(1.0f - t * t)) / BesselI0(kKaiserAlpha);
+            }
+        case FS::MipFilter::eLanczos:
+            return Sinc(x) * Sinc(x / support);
+        }
+        return 0.0f;
+    }
+
+    FilterTable CreateFilterTable(const u32 source_size, const u32 size, const FS::MipFilter filter)
+    {
+        const f32 scale = static_cast<f32>(source_size) / static_cast<f32>(size);
+        const f32 support = GetFilterSupport(filter) * scale;
+        FilterTable table{.TapCount = static_cast<u32>(std::ceil(support * 2.0f)) + 1};
+        table.Indices.resize(static_cast<u64>(size) * table.TapCount);
+        table.Weights.resize(static_cast<u64>(size) * table.TapCount);
+        for (u32 i = 0; i < size; ++i)
+        {
+            const f32 center = (static_cast<f32>(i) + 0.5f) * scale;
+            const i32 first = static_cast<i32>(std::floor(center - support));
+            f32 total = 0.0f;
+            for (u32 tap = 0; tap < table.TapCount; ++tap)
+            {
+                const i32 source = first + static_cast<i32>(tap);
+                const f32 weight = EvaluateFilter(filter, (static_cast<f32>(source) + 0.5f - center) / scale);
+                table.Indices[i * table.TapCount + tap] = std::clamp(source, 0, static_cast<i32>(source_size) - 1);
+                table.Weights[i * table.TapCount + tap] = weight;
+                total += weight;
+            }
+            for (u32 tap = 0; tap < table.TapCount; ++tap)
+            {
+                table.Weights[i * table.TapCount + tap] /= total;
+            }
+        }
+        return table;
+    }
+
+    // Vertical pass, row += weight * source over the whole row
+    void AccumulateRow(f32* row, const f32* source, const f32 weight, const u32 count)
+    {
+        u32 i = 0;
+#ifdef __AVX2__
+        const __m256 weights = _mm256_set1_ps(weight);
+        for (; i + 8 <= count; i += 8)
+        {
+            _mm256_storeu_ps(row + i, _mm256_fmadd_ps(_mm256_loadu_ps(source + i), weights, _mm256_loadu_ps(row + i)));
+        }
+#endif
+        const __m128 weights4 = _mm_set1_ps(weight);
+        for (; i < count; i += 4)
+        {
+            _mm_storeu_ps(row + i, _mm_add_ps(_mm_loadu_ps(row + i), _mm_mul_ps(_mm_loadu_ps(source + i), weights4)));
+        }
+    }
+
+    // Horizontal pass, every output pixel is a weighted sum of TapCount RGBA pixels
+    void FilterRow(f32* row, const f32* source, const FilterTable& table, const u32 width)
+    {
+        const u32 taps = table.TapCount;
+        u32 x = 0;
+#ifdef __AVX2__
+        for (; x + 2 <= width; x += 2)
+        {
+            const u32* indices = table.Indices.data() + static_cast<u64>(x) * taps;
+            const f32* weights = table.Weights.data() + static_cast<u64>(x) * taps;
+            __m256 sum = _mm256_setzero_ps();
+            for (u32 tap = 0; tap < taps; ++tap)
+            {
+                const __m256 pixels = _mm256_insertf128_ps(
+                    _mm256_castps128_ps256(_mm_loadu_ps(source + indices[tap] * 4)),
+                    _mm_loadu_ps(source + indices[taps + tap] * 4), 1);
+                const __m256 weight = _mm256_insertf128_ps(_mm256_set1_ps(weights[tap]),
+                                                           _mm_set1_ps(weights[taps + tap]), 1);
+                sum = _mm256_fmadd_ps(pixels, weight, sum);
+            }
+            _mm256_storeu_ps(row + x * 4, sum);
+        }
+#endif
+        for (; x < width; ++x)
+        {
+            const u32* indices = table.Indices.data() + static_cast<u64>(x) * taps;
+            const f32* weights = table.Weights.data() + static_cast<u64>(x) * taps;
+            __m128 sum = _mm_setzero_ps();
+            for (u32 tap = 0; tap < taps; ++tap)
+            {
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(source + indices[tap] * 4), _mm_set1_ps(weights[tap])));
+            }
+            _mm_storeu_ps(row + x * 4, sum);
+        }
+    }
+
+    void NormalizeRow(f32* row, const u32 width)
+    {
+        for (u32 x = 0; x < width; ++x)
+        {
+            f32* pixel = row + x * 4;
+            const __m128 value = _mm_loadu_ps(pixel);
+            const f32 length_squared = _mm_cvtss_f32(_mm_dp_ps(value, value, 0x71));
+            if (length_squared > 1e-12f)
+            {
+                const __m128 normalized = _mm_mul_ps(value, _mm_set1_ps(1.0f / std::sqrt(length_squared)));
+                _mm_storeu_ps(pixel, _mm_blend_ps(normalized, value, 0b1000));
+            }
+        }
+    }
+
+    void ForEachRowBatch(FS::JobSystem* jobs, const u32 rows, const auto& func)
+    {
+        const u32 batches = (rows + kRowsPerJob - 1) / kRowsPerJob;
+        const auto run_batch = [&](const u32 batch)
+        {
+            const u32 end = std::min(rows, (batch + 1) * kRowsPerJob);
+            for (u32 y = batch * kRowsPerJob; y < end; ++y)
+            {
+                func(y);
+            }
+        };
+        if (jobs)
+        {
+            jobs->ParallelFor(batches, 1, run_batch);
+        }
+        else
+        {
+            for (u32 batch = 0; batch < batches; ++batch)
+            {
+                run_batch(batch);
+            }
+        }
+    }
+
+    LinearImage Downsample(const LinearImage& source, const FS::MipGenerationSettings& settings, FS::JobSystem* jobs)
+    {
+        auto result = LinearImage::Create(std::max(source.Width / 2, 1u), std::max(source.Height / 2, 1u));
+        const auto horizontal = CreateFilterTable(source.Width, result.Width, settings.Filter);
+        const auto vertical = CreateFilterTable(source.Height, result.Height, settings.Filter);
+        ForEachRowBatch(jobs, result.Height, [&](const u32 y)
+        {
+            thread_local FS::Vec<f32> scratch;
+            scratch.assign(static_cast<u64>(source.Width) * 4, 0.0f);
+            for (u32 tap = 0; tap < vertical.TapCount; ++tap)
+            {
+                const f32 weight = vertical.Weights[y * vertical.TapCount + tap];
+                if (weight != 0.0f)
+                {
+                    AccumulateRow(scratch.data(), source.Row(vertical.Indices[y * vertical.TapCount + tap]), weight,
+                                  source.Width * 4);
+                }
+            }
+            FilterRow(result.Row(y), scratch.data(), horizontal, result.Width);
+            if (settings.NormalMap)
+            {
+                NormalizeRow(result.Row(y), result.Width);
+            }
+        });
+        return result;
+    }
+
+    const FS::Array<f32, 256>& GetSRGBToLinearTable()
+    {
+        static const auto table = []
+        {
+            FS::Array<f32, 256> values{};
+            for (u32 i = 0; i < values.size(); ++i)
+            {
+                const f32 value = static_cast<f32>(i) / 255.0f;
+                values[i] = value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+            }
+            return values;
+        }();
+        return table;
+    }
+
+    // Linear value halfway between two consecutive sRGB bytes, the last entry is never passed
+    const FS::Array<f32, 256>& GetLinearToSRGBTable()
+    {
+        static const auto table = []
+        {
+            FS::Array<f32, 256> thresholds{};
+            for (u32 i = 0; i < 255; ++i)
+            {
+                const f32 value = (static_cast<f32>(i) + 0.5f) / 255.0f;
+                thresholds[i] = value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+            }
+            thresholds[255] = std::numeric_limits<f32>::infinity();
+            return thresholds;
+        }();
+        return table;
+    }
+
+    u8 LinearToSRGB(const FS::Array<f32, 256>& thresholds, const f32 value)
+    {
+        u32 index = 0;
+        for (u32 step = 128; step > 0; step >>= 1)
+        {
+            index += thresholds[index + step - 1] < value ? step : 0;
+        }
+        return static_cast<u8>(index);
+    }
+
+    bool IsSRGB8(const FS::Format format)
+    {
+        return format == FS::Format::eR8G8B8A8_UNORM_SRGB || format == FS::Format::eB8G8R8A8_UNORM_SRGB;
+    }
+
+    // Normal maps in unsigned formats are stored as n * 0.5 + 0.5
+    bool IsUnorm(const FS::Format format)
+    {
+        switch (format)
+        {
+        case FS::Format::eR8_UNORM:
+        case FS::Format::eR8G8_UNORM:
+        case FS::Format::eR8G8B8A8_UNORM:
+        case FS::Format::eR8G8B8A8_UNORM_SRGB:
+        case FS::Format::eB8G8R8A8_UNORM:
+        case FS::Format::eB8G8R8A8_UNORM_SRGB:
+        case FS::Format::eR16_UNORM:
+        case FS::Format::eR16G16_UNORM:
+        case FS::Format::eR16G16B16A16_UNORM:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    LinearImage ToLinear(const FS::Image& image, const bool normal_map, FS::JobSystem* jobs)
+    {
+        auto result = LinearImage::Create(image.Width, image.Height);
+        const bool srgb = IsSRGB8(image.Format);
+        const bool swizzle = image.Format == FS::Format::eB8G8R8A8_UNORM_SRGB;
+        const bool unorm = IsUnorm(image.Format);
+        const auto& to_linear = GetSRGBToLinearTable();
+        const u32 pixel_size = image.PixelSize();
+        ForEachRowBatch(jobs, image.Height, [&](const u32 y)
+        {
+            const u8* source = image.Row(y);
+            f32* destination = result.Row(y);
+            for (u32 x = 0; x < image.Width; ++x)
+            {
+                const u8* pixel = source + x * pixel_size;
+                f32* value = destination + x * 4;
+                if (srgb)
+                {
+                    value[0] = to_linear[pixel[swizzle ? 2 : 0]];
+                    value[1] = to_linear[pixel[1]];
+                    value[2] = to_linear[pixel[swizzle ? 0 : 2]];
+                    value[3] = static_cast<f32>(pixel[3]) / 255.0f;
+                    continue;
+                }
+                auto loaded = FS::LoadPixel(image.Format, pixel);
+                if (normal_map && unorm)
+                {
+                    loaded = glm::vec4(glm::vec3(loaded) * 2.0f - 1.0f, loaded.w);
+                }
+                std::memcpy(value, &loaded, sizeof(loaded));
+            }
+        });
+        return result;
+    }
+
+    // Fraction of pixels passing the alpha test
+    f32 GetAlphaCoverage(const LinearImage& image, const f32 reference)
+    {
+        const u64 count = static_cast<u64>(image.Width) * image.Height;
+        u64 covered = 0;
+        for (u64 i = 0; i < count; ++i)
+        {
+            covered += image.Pixels[i * 4 + 3] >= reference;
+        }
+        return static_cast<f32>(covered) / static_cast<f32>(count);
+    }
+
+    // Alpha scale that makes the same fraction of pixels pass the alpha test, found by selecting the
+    // alpha of the last pixel that should pass
+    f32 GetAlphaCoverageScale(const LinearImage& image, const f32 reference, const f32 coverage)
+    {
+        const u64 count = static_cast<u64>(image.Width) * image.Height;
+        const u64 covered = static_cast<u64>(std::round(coverage * static_cast<f32>(count)));
+        if (covered == 0)
+        {
+            return 1.0f;
+        }
+        FS::Vec<f32> alphas(count);
+        for (u64 i = 0; i < count; ++i)
+        {
+            alphas[i] = image.Pixels[i * 4 + 3];
+        }
+        const auto nth = alphas.begin() + static_cast<i64>(covered - 1);
+        std::nth_element(alphas.begin(), nth, alphas.end(), std::greater{});
+        return *nth > 0.0f ? reference / *nth : 1.0f;
+    }
+
+    FS::Image ToImage(const LinearImage& image, const FS::Format format, const bool normal_map, const f32 alpha_scale)
+    {
+        auto result = FS::Image::Create(image.Width, image.Height, format);
+        const bool srgb = IsSRGB8(format);
+        const bool swizzle = format == FS::Format::eB8G8R8A8_UNORM_SRGB;
+        const bool unorm = IsUnorm(format);
+        const auto& to_srgb = GetLinearToSRGBTable();
+        const u32 pixel_size = result.PixelSize();
+        for (u32 y = 0; y < image.Height; ++y)
+        {
+            const f32* source = image.Row(y);
+            u8* destination = result.Row(y);
+            for (u32 x = 0; x < image.Width; ++x)
+            {
+                const f32* value = source + x * 4;
+                u8* pixel = destination + x * pixel_size;
+                const f32 alpha = std::min(value[3] * alpha_scale, 1.0f);
+                if (srgb)
+                {
+                    pixel[swizzle ? 2 : 0] = LinearToSRGB(to_srgb, value[0]);
+                    pixel[1] = LinearToSRGB(to_srgb, value[1]);
+                    pixel[swizzle ? 0 : 2] = LinearToSRGB(to_srgb, value[2]);
+                    pixel[3] = static_cast<u8>(std::clamp(alpha, 0.0f, 1.0f) * 255.0f + 0.5f);
+                    continue;
+                }
+                glm::vec4 stored(value[0], value[1], value[2], alpha);
+                if (normal_map && unorm)
+                {
+                    stored = glm::vec4(glm::vec3(stored) * 0.5f + 0.5f, stored.w);
+                }
+                FS::StorePixel(format, pixel, stored);
+            }
+        }
+        return result;
+    }
+}
+
+namespace FS
+{
+    Vec<Image> GenerateMips(const Image& base, const MipGenerationSettings& settings, JobSystem* jobs)
+    {
+        Vec<Image> mips;
+        if (!IsPixelFormatSupported(base.Format))
+        {
+            Log::Error("GenerateMips Unsupported format {}", static_cast<u32>(base.Format));
+            return mips;
+        }
+
+        const u16 mip_count = GetMipCount({base.Width, base.Height});
+        if (mip_count <= 1)
+        {
+            return mips;
+        }
+
+        // Every level is kept until its conversion job has finished with it
+        Vec<LinearImage> levels;
+        levels.reserve(mip_count);
+        levels.push_back(ToLinear(base, settings.NormalMap, jobs));
+        const f32 coverage = settings.PreserveAlphaCoverage
+                                 ? GetAlphaCoverage(levels.front(), settings.AlphaReference)
+                                 : 0.0f;
+
+        mips.resize(mip_count - 1);
+        JobCounter counter;
+        for (u16 mip = 1; mip < mip_count; ++mip)
+        {
+            const auto& level = levels.emplace_back(Downsample(levels.back(), settings, jobs));
+            const auto store = [&, mip]
+            {
+                const f32 alpha_scale = settings.PreserveAlphaCoverage
+                                            ? GetAlphaCoverageScale(level, settings.AlphaReference, coverage)
+                                            : 1.0f;
+                mips[mip - 1] = ToImage(level, base.Format, settings.NormalMap, alpha_scale);
+            };
+            if (jobs)
+            {
+                jobs->Submit(store, &counter);
+            }
+            else
+            {
+                store();
+            }
+        }
+        if (jobs)
+        {
+            jobs->Wait(counter);
+        }
+        return mips;
+    }
+} // namespace FS
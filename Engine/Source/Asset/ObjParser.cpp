@@ -0,0 +1,486 @@
+#include "MeshParsing.hpp"
+#include "Core/JobSystem.hpp"
+
+namespace
+{
+    constexpr u32 kMissing = std::numeric_limits<u32>::max();
+    /// Bytes of text parsed by one job
+    constexpr u64 kChunkSize = 1ull << 20;
+
+    constexpr FS::Array<f64, 23> kPowersOfTen{
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    };
+
+    /// <summary>
+    /// One corner of a face. Negative OBJ indices count back from the end of the elements read so far, which
+    /// is only known within the chunk, so they're stored relative to the start of the chunk and flagged.
+    /// </summary>
+    struct Corner
+    {
+        FS::Array<u32, 3> Indices{kMissing, kMissing, kMissing};
+        u8 RelativeMask = 0;
+    };
+
+    struct VertexKey
+    {
+        FS::Array<u32, 3> Indices{};
+
+        bool operator==(const VertexKey&) const = default;
+    };
+
+    struct MaterialChange
+    {
+        u64 FirstCorner = 0;
+        std::string Name;
+    };
+
+    struct Chunk
+    {
+        FS::Span<const char> Text;
+        FS::Vec<glm::vec3> Positions;
+        FS::Vec<glm::vec2> TexCoords;
+        FS::Vec<glm::vec3> Normals;
+        /// Triangulated, three per triangle
+        FS::Vec<Corner> Corners;
+        FS::Vec<MaterialChange> Materials;
+        FS::Array<u32, 3> Bases{};
+
+        FS::Vec<FS::Vertex> Vertices;
+        FS::Vec<u32> Indices;
+        bool Failed = false;
+    };
+
+    bool IsDigit(const char c)
+    {
+        return static_cast<u8>(c - '0') < 10;
+    }
+
+    bool IsSpace(const char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    void SkipSpaces(const char*& p, const char* end)
+    {
+        while (p < end && IsSpace(*p))
+        {
+            ++p;
+        }
+    }
+
+    u64 LoadEightBytes(const char* p)
+    {
+        u64 value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    /// SWAR check that all eight bytes are ASCII digits
+    bool IsEightDigits(const u64 value)
+    {
+        return ((value & 0xF0F0F0F0F0F0F0F0ull) |
+                ((value + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4) == 0x3333333333333333ull;
+    }
+
+    /// Eight ASCII digits to their value with three multiplies instead of eight
+    u32 ParseEightDigits(u64 value)
+    {
+        constexpr u64 kMask = 0x000000FF000000FFull;
+        constexpr u64 kMultiplier1 = 0x000F424000000064ull; // 100 + (1000000 << 32)
+        constexpr u64 kMultiplier2 = 0x0000271000000001ull; // 1 + (10000 << 32)
+        value -= 0x3030303030303030ull;
+        value = value * 10 + (value >> 8);
+        value = ((value & kMask) * kMultiplier1 + (value >> 16 & kMask) * kMultiplier2) >> 32;
+        return static_cast<u32>(value);
+    }
+
+    /// Digits accumulated into the mantissa, returns the number of digits
+    u32 ParseDigits(const char*& p, const char* end, u64& mantissa)
+    {
+        const char* begin = p;
+        while (end - p >= 8 && IsEightDigits(LoadEightBytes(p)))
+        {
+            mantissa = mantissa * 100000000 + ParseEightDigits(LoadEightBytes(p));
+            p += 8;
+        }
+        while (p < end && IsDigit(*p))
+        {
+            mantissa = mantissa * 10 + static_cast<u64>(*p - '0');
+            ++p;
+        }
+        return static_cast<u32>(p - begin);
+    }
+
+    /// <summary>
+    /// Decimal to float. Numbers with up to 15 significant digits and a small exponent, which is every number
+    /// exporters write, are exact in double and take one multiply or divide. Anything else falls back to
+    /// from_chars.
+    /// </summary>
+    bool ParseFloat(const char*& p, const char* end, f32& value)
+    {
+        if (p < end && *p == '+')
+        {
+            ++p;
+        }
+        const char* start = p;
+        const bool negative = p < end && *p == '-';
+        p += negative;
+
+        u64 mantissa = 0;
+        u32 digits = ParseDigits(p, end, mantissa);
+        i32 exponent = 0;
+        if (p < end && *p == '.')
+        {
+            ++p;
+            const u32 fraction_digits = ParseDigits(p, end, mantissa);
+            digits += fraction_digits;
+            exponent = -static_cast<i32>(fraction_digits);
+        }
+        if (digits > 0 && p < end && (*p == 'e' || *p == 'E'))
+        {
+            const char* exponent_start = p++;
+            const bool negative_exponent = p < end && *p == '-';
+            p += p < end && (*p == '-' || *p == '+');
+            i32 value_exponent = 0;
+            if (p == end || !IsDigit(*p))
+            {
+                p = exponent_start; // Not an exponent, the number ends at the e
+            }
+            for (; p < end && IsDigit(*p); ++p)
+            {
+                value_exponent = std::min(value_exponent * 10 + (*p - '0'), 100000);
+            }
+            exponent += negative_exponent ? -value_exponent : value_exponent;
+        }
+
+        if (digits > 0 && digits <= 15 && exponent >= -22 && exponent <= 22)
+        {
+            f64 result = static_cast<f64>(mantissa);
+            result = exponent < 0 ? result / kPowersOfTen[-exponent] : result * kPowersOfTen[exponent];
+            value = static_cast<f32>(negative ? -result : result);
+            return true;
+        }
+
+        const auto [ptr, error] = std::from_chars(start, end, value);
+        if (error != std::errc() && error != std::errc::result_out_of_range)
+        {
+            return false;
+        }
+        p = ptr;
+        return true;
+    }
+
+    bool ParseIndex(const char*& p, const char* end, i64& index)
+    {
+        const bool negative = p < end && *p == '-';
+        p += negative;
+        if (p == end || !IsDigit(*p))
+        {
+            return false;
+        }
+        u64 value = 0;
+        ParseDigits(p, end, value);
+        index = negative ? -static_cast<i64>(value) : static_cast<i64>(value);
+        return true;
+    }
+
+    bool StartsWith(const char* p, const char* end, const std::string_view prefix)
+    {
+        return static_cast<u64>(end - p) > prefix.size() && std::string_view(p, prefix.size()) == prefix &&
+               IsSpace(p[prefix.size()]);
+    }
+
+    bool ParseFloats(const char*& p, const char* end, f32* values, const u32 count)
+    {
+        for (u32 i = 0; i < count; ++i)
+        {
+            SkipSpaces(p, end);
+            if (!ParseFloat(p, end, values[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool ParseCorner(const char*& p, const char* end, const Chunk& chunk, Corner& corner)
+    {
+        const FS::Array<u64, 3> counts{chunk.Positions.size(), chunk.TexCoords.size(), chunk.Normals.size()};
+        for (u32 attribute = 0; attribute < 3; ++attribute)
+        {
+            if (attribute > 0)
+            {
+                // v, v/vt, v//vn and v/vt/vn
+                if (p == end || *p != '/')
+                {
+                    break;
+                }
+                ++p;
+                if (p < end && *p == '/')
+                {
+                    continue;
+                }
+            }
+
+            i64 index;
+            if (!ParseIndex(p, end, index) || index == 0)
+            {
+                return false;
+            }
+            if (index > 0)
+            {
+                corner.Indices[attribute] = static_cast<u32>(index - 1);
+            }
+            else
+            {
+                corner.Indices[attribute] = static_cast<u32>(static_cast<i64>(counts[attribute]) + index);
+                corner.RelativeMask |= 1 << attribute;
+            }
+        }
+        return p == end || IsSpace(*p);
+    }
+
+    void ParseChunk(Chunk& chunk)
+    {
+        const char* p = chunk.Text.data();
+        const char* const text_end = p + chunk.Text.size();
+        FS::Vec<Corner> polygon;
+        while (p < text_end && !chunk.Failed)
+        {
+            const auto* line_end = static_cast<const char*>(std::memchr(p, '\n', text_end - p));
+            if (!line_end)
+            {
+                line_end = text_end;
+            }
+            SkipSpaces(p, line_end);
+
+            if (StartsWith(p, line_end, "v"))
+            {
+                p += 1;
+                glm::vec3 position;
+                chunk.Failed = !ParseFloats(p, line_end, &position.x, 3);
+                chunk.Positions.push_back(position);
+            }
+            else if (StartsWith(p, line_end, "vt"))
+            {
+                p += 2;
+                // V is optional for 1D textures
+                glm::vec2 tex_coord(0.0f);
+                chunk.Failed = !ParseFloats(p, line_end, &tex_coord.x, 1);
+                SkipSpaces(p, line_end);
+                if (!chunk.Failed && p < line_end && *p != '#')
+                {
+                    chunk.Failed = !ParseFloat(p, line_end, tex_coord.y);
+                }
+                chunk.TexCoords.emplace_back(tex_coord.x, 1.0f - tex_coord.y);
+            }
+            else if (StartsWith(p, line_end, "vn"))
+            {
+                p += 2;
+                glm::vec3 normal;
+                chunk.Failed = !ParseFloats(p, line_end, &normal.x, 3);
+                chunk.Normals.push_back(normal);
+            }
+            else if (StartsWith(p, line_end, "f"))
+            {
+                p += 1;
+                polygon.clear();
+                SkipSpaces(p, line_end);
+                while (p < line_end && *p != '#')
+                {
+                    Corner corner;
+                    if (!ParseCorner(p, line_end, chunk, corner))
+                    {
+                        chunk.Failed = true;
+                        break;
+                    }
+                    polygon.push_back(corner);
+                    SkipSpaces(p, line_end);
+                }
+                for (u64 i = 2; i < polygon.size(); ++i)
+                {
+                    chunk.Corners.push_back(polygon[0]);
+                    chunk.Corners.push_back(polygon[i - 1]);
+                    chunk.Corners.push_back(polygon[i]);
+                }
+            }
+            else if (StartsWith(p, line_end, "usemtl"))
+            {
+                p += 6;
+                SkipSpaces(p, line_end);
+                const char* name_end = line_end;
+                while (name_end > p && IsSpace(name_end[-1]))
+                {
+                    --name_end;
+                }
+                chunk.Materials.push_back({.FirstCorner = chunk.Corners.size(), .Name = std::string(p, name_end)});
+            }
+            // Everything else, comments, groups, smoothing groups and material libraries, is skipped
+
+            p = line_end + 1;
+        }
+    }
+
+    u64 HashVertexKey(const VertexKey& key)
+    {
+        const u64 hash = key.Indices[0] * 0x9E3779B97F4A7C15ull ^ key.Indices[1] * 0xC2B2AE3D27D4EB4Full ^
+                         key.Indices[2] * 0x165667B19E3779F9ull;
+        return hash ^ hash >> 29;
+    }
+
+    /// <summary>
+    /// Turn the corners into global attribute indices and weld identical ones into vertices with an open
+    /// addressing table. Welding only happens within the chunk, the few duplicates across chunk borders are
+    /// cheaper than a shared table.
+    /// </summary>
+    bool ResolveChunk(Chunk& chunk, const FS::Array<u64, 3>& counts, const FS::Vec<glm::vec3>& positions,
+                      const FS::Vec<glm::vec2>& tex_coords, const FS::Vec<glm::vec3>& normals)
+    {
+        const u64 capacity = std::bit_ceil(std::max<u64>(chunk.Corners.size() * 2, 16));
+        FS::Vec<u32> table(capacity, kMissing);
+        FS::Vec<VertexKey> keys;
+        chunk.Indices.reserve(chunk.Corners.size());
+
+        for (const auto& corner : chunk.Corners)
+        {
+            VertexKey key;
+            for (u32 attribute = 0; attribute < 3; ++attribute)
+            {
+                u32 index = corner.Indices[attribute];
+                if (corner.RelativeMask & 1 << attribute)
+                {
+                    index += chunk.Bases[attribute];
+                }
+                if (index != kMissing && index >= counts[attribute])
+                {
+                    return false;
+                }
+                key.Indices[attribute] = index;
+            }
+
+            u64 slot = HashVertexKey(key) & (capacity - 1);
+            while (table[slot] != kMissing && keys[table[slot]] != key)
+            {
+                slot = (slot + 1) & (capacity - 1);
+            }
+            if (table[slot] == kMissing)
+            {
+                table[slot] = static_cast<u32>(keys.size());
+                keys.push_back(key);
+
+                const auto& [position, tex_coord, normal] = key.Indices;
+                const glm::vec2 uv = tex_coord != kMissing ? tex_coords[tex_coord] : glm::vec2(0.0f);
+                chunk.Vertices.push_back({
+                    .Position = positions[position],
+                    .UVx = uv.x,
+                    .Normal = normal != kMissing ? normals[normal] : glm::vec3(0.0f),
+                    .UVy = uv.y,
+                    .Tangent = glm::vec4(0.0f),
+                });
+            }
+            chunk.Indices.push_back(table[slot]);
+        }
+        return true;
+    }
+
+    template <typename T>
+    void Append(FS::Vec<T>& destination, const FS::Vec<T>& source)
+    {
+        destination.insert(destination.end(), source.begin(), source.end());
+    }
+}
+
+namespace FS::MeshParsing
+{
+    Opt<Mesh> ParseObj(const Span<const char> text, const std::string_view path, JobSystem& jobs)
+    {
+        // Chunks end after a line break, so no line is split between two jobs
+        Vec<Chunk> chunks;
+        for (u64 begin = 0; begin < text.size();)
+        {
+            u64 end = std::min(begin + kChunkSize, text.size());
+            if (end < text.size())
+            {
+                const auto* line_end = static_cast<const char*>(std::memchr(text.data() + end, '\n',
+                                                                            text.size() - end));
+                end = line_end ? static_cast<u64>(line_end - text.data()) + 1 : text.size();
+            }
+            chunks.push_back({.Text = text.subspan(begin, end - begin)});
+            begin = end;
+        }
+
+        jobs.ParallelFor(static_cast<u32>(chunks.size()), 1, [&](const u32 index)
+        {
+            ParseChunk(chunks[index]);
+        });
+
+        Vec<glm::vec3> positions;
+        Vec<glm::vec2> tex_coords;
+        Vec<glm::vec3> normals;
+        for (auto& chunk : chunks)
+        {
+            if (chunk.Failed)
+            {
+                Log::Error("ObjParser {} has a malformed line", path);
+                return std::nullopt;
+            }
+            chunk.Bases = {
+                static_cast<u32>(positions.size()), static_cast<u32>(tex_coords.size()),
+                static_cast<u32>(normals.size())
+            };
+            Append(positions, chunk.Positions);
+            Append(tex_coords, chunk.TexCoords);
+            Append(normals, chunk.Normals);
+        }
+
+        const Array<u64, 3> counts{positions.size(), tex_coords.size(), normals.size()};
+        std::atomic<bool> valid = true;
+        jobs.ParallelFor(static_cast<u32>(chunks.size()), 1, [&](const u32 index)
+        {
+            if (!ResolveChunk(chunks[index], counts, positions, tex_coords, normals))
+            {
+                valid.store(false, std::memory_order_relaxed);
+            }
+        });
+        if (!valid.load())
+        {
+            Log::Error("ObjParser {} references a vertex that doesn't exist", path);
+            return std::nullopt;
+        }
+
+        // Faces before the first usemtl get an unnamed material
+        Mesh mesh;
+        mesh.Submeshes.push_back({});
+        for (auto& chunk : chunks)
+        {
+            const auto base_vertex = static_cast<u32>(mesh.Vertices.size());
+            const auto first_index = static_cast<u32>(mesh.Indices.size());
+            Append(mesh.Vertices, chunk.Vertices);
+            for (const u32 index : chunk.Indices)
+            {
+                mesh.Indices.push_back(base_vertex + index);
+            }
+
+            // A chunk continues the material of the previous one until its first usemtl
+            for (const auto& change : chunk.Materials)
+            {
+                const auto index = first_index + static_cast<u32>(change.FirstCorner);
+                if (mesh.Submeshes.back().FirstIndex != index)
+                {
+                    mesh.Submeshes.push_back({.FirstIndex = index});
+                }
+                mesh.Submeshes.back().Material = change.Name;
+            }
+            chunk = {};
+        }
+
+        for (u64 i = 0; i < mesh.Submeshes.size(); ++i)
+        {
+            const u64 end = i + 1 < mesh.Submeshes.size() ? mesh.Submeshes[i + 1].FirstIndex : mesh.Indices.size();
+            mesh.Submeshes[i].IndexCount = static_cast<u32>(end - mesh.Submeshes[i].FirstIndex);
+        }
+        std::erase_if(mesh.Submeshes, [](const Submesh& submesh) { return submesh.IndexCount == 0; });
+        return mesh;
+    }
+} // namespace FS::MeshParsing
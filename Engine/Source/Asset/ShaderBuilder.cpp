@@ -0,0 +1,458 @@
+#include "Asset/ShaderBuilder.hpp"
+#include "Asset/CookedShader.hpp"
+#include "Asset/ShaderLibrary.hpp"
+#include "Core/JobSystem.hpp"
+#include "Core/Serializer.hpp"
+#include "Tools/ContentHash.hpp"
+
+namespace
+{
+    constexpr auto kStatusCompiled = "Compiled";
+    constexpr auto kStatusUpToDate = "UpToDate";
+    constexpr auto kStatusFailed = "Failed";
+    constexpr auto kPermutationFolder = "Permutations";
+    constexpr std::string_view kFeaturePrefix = "Feature:";
+
+    struct ShaderCacheEntry
+    {
+        std::string Output;
+        u64 Key = 0;
+    };
+
+    struct ShaderCache
+    {
+        FS::Vec<ShaderCacheEntry> Entries;
+    };
+
+    // Name of an #include directive on the line, with whether it is quoted. Directives in comments or disabled
+    // branches are found too, which at worst makes a shader depend on a file it doesn't use.
+    FS::Opt<std::pair<std::string, bool>> ParseInclude(std::string_view line)
+    {
+        const auto skip_spaces = [&line]
+        {
+            line.remove_prefix(std::min(line.find_first_not_of(" \t"), line.size()));
+        };
+        skip_spaces();
+        if (!line.starts_with('#'))
+        {
+            return std::nullopt;
+        }
+        line.remove_prefix(1);
+        skip_spaces();
+        if (!line.starts_with("include"))
+        {
+            return std::nullopt;
+        }
+        line.remove_prefix(7);
+        skip_spaces();
+        if (line.empty() || (line.front() != '"' && line.front() != '<'))
+        {
+            return std::nullopt;
+        }
+        const bool quoted = line.front() == '"';
+        const auto end = line.find(quoted ? '"' : '>', 1);
+        if (end == std::string_view::npos)
+        {
+            return std::nullopt;
+        }
+        return std::pair{std::string(line.substr(1, end - 1)), quoted};
+    }
+
+    // Name of a "// Feature: NAME" declaration on the line
+    FS::Opt<std::string> ParseFeature(std::string_view line)
+    {
+        const auto skip_spaces = [&line]
+        {
+            line.remove_prefix(std::min(line.find_first_not_of(" \t"), line.size()));
+        };
+        skip_spaces();
+        if (!line.starts_with("//"))
+        {
+            return std::nullopt;
+        }
+        line.remove_prefix(2);
+        skip_spaces();
+        if (!line.starts_with(kFeaturePrefix))
+        {
+            return std::nullopt;
+        }
+        line.remove_prefix(kFeaturePrefix.size());
+        skip_spaces();
+        const auto name = line.substr(0, line.find_first_of(" \t\r"));
+        return name.empty() ? std::nullopt : FS::Opt<std::string>(name);
+    }
+
+    // Whether the cooked table of the shader exists and holds exactly the permutations it should
+    bool IsTableCurrent(const FS::ShaderSource& shader)
+    {
+        const auto file = FS::FileIO::ReadBinaryFile(shader.OutputPath);
+        const auto view = FS::CookedShaderView::FromMemory(file);
+        if (!view || view->Features.size() != shader.Features.size())
+        {
+            return false;
+        }
+        for (u32 i = 0; i < view->Features.size(); ++i)
+        {
+            if (view->GetFeature(view->Features[i]) != shader.Features[i])
+            {
+                return false;
+            }
+        }
+        for (u32 key = 0; key < view->Table.size(); ++key)
+        {
+            const bool used = std::ranges::find(shader.Keys, key) != shader.Keys.end();
+            if (used == (view->Table[key] == FS::kStrippedPermutation))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+namespace FS
+{
+    ShaderBuilder::ShaderBuilder(IShaderCompiler& compiler, JobSystem& jobs) : m_compiler(compiler), m_jobs(jobs)
+    {
+    }
+
+    Vec<ShaderSource> ShaderBuilder::FindShaders(const std::string_view source_directory,
+                                                 const std::string_view output_directory,
+                                                 const Span<const ShaderPermutationUsage> usage)
+    {
+        std::error_code ec;
+        Vec<std::filesystem::path> sources;
+        for (std::filesystem::recursive_directory_iterator it(source_directory, ec), end; it != end; it.increment(ec))
+        {
+            if (it->is_regular_file(ec) && it->path().extension() == ".hlsl")
+            {
+                sources.push_back(it->path());
+            }
+        }
+        std::ranges::sort(sources);
+
+        Vec<ShaderSource> shaders;
+        for (const auto& source : sources)
+        {
+            const auto stem = source.stem().string();
+            ShaderSource shader{
+                .Path = source.generic_string(),
+                .OutputPath = (std::filesystem::path(output_directory) / stem).concat(".fsshader").generic_string(),
+                .Profile = GetShaderProfile(stem),
+            };
+            if (shader.Profile.empty())
+            {
+                Log::Warn("ShaderBuilder Skipping {}, the last two characters of the name should be the stage",
+                          shader.Path);
+                continue;
+            }
+            const auto text = FileIO::ReadTextFile(shader.Path);
+            for (const auto line : std::views::split(std::string_view(text), '\n'))
+            {
+                if (auto feature = ParseFeature(std::string_view(line.begin(), line.end())))
+                {
+                    shader.Features.push_back(std::move(*feature));
+                }
+            }
+            if (shader.Features.size() > kMaxShaderFeatures)
+            {
+                Log::Warn("ShaderBuilder Skipping {}, it declares more than {} features", shader.Path,
+                          kMaxShaderFeatures);
+                continue;
+            }
+
+            const u32 permutation_count = 1u << shader.Features.size();
+            const auto used = std::ranges::find(usage, std::string_view(stem), &ShaderPermutationUsage::Shader);
+            for (u32 key = 0; key < permutation_count; ++key)
+            {
+                if (used == usage.end() || std::ranges::find(used->Keys, key) != used->Keys.end())
+                {
+                    shader.Keys.push_back(key);
+                }
+            }
+            shaders.push_back(std::move(shader));
+        }
+        return shaders;
+    }
+
+    ShaderBuildReport ShaderBuilder::Build(const Span<const ShaderCompileRequest> requests,
+                                           const ShaderBuildSettings& settings)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        m_sources.clear();
+        ShaderCache cache;
+        if (!settings.CachePath.empty() && FileIO::Exists(settings.CachePath) &&
+            !Serializer::Read(cache, settings.CachePath))
+        {
+            Log::Warn("ShaderBuilder Failed to read the cache {}", settings.CachePath);
+            cache.Entries.clear();
+        }
+        std::unordered_map<std::string_view, u64> cached_keys;
+        for (const auto& entry : cache.Entries)
+        {
+            cached_keys.emplace(entry.Output, entry.Key);
+        }
+
+        // Keys are cheap to compute, only the compiler invocations go wide
+        ShaderBuildReport report;
+        report.Shaders.resize(requests.size());
+        Vec<u64> keys(requests.size());
+        Vec<u32> dirty;
+        for (u32 i = 0; i < requests.size(); ++i)
+        {
+            keys[i] = GetKey(requests[i]);
+            report.Shaders[i].Output = requests[i].OutputPath;
+            const auto cached = cached_keys.find(requests[i].OutputPath);
+            if (!settings.Force && cached != cached_keys.end() && cached->second == keys[i] &&
+                FileIO::Exists(requests[i].OutputPath))
+            {
+                report.Shaders[i].Status = kStatusUpToDate;
+            }
+            else
+            {
+                dirty.push_back(i);
+            }
+        }
+
+        m_jobs.ParallelFor(static_cast<u32>(dirty.size()), 1, [&](const u32 dirty_index)
+        {
+            const auto compile_start = std::chrono::steady_clock::now();
+            const auto& request = requests[dirty[dirty_index]];
+            auto& shader = report.Shaders[dirty[dirty_index]];
+            const auto result = m_compiler.Compile(request);
+            std::error_code ec;
+            std::filesystem::create_directories(std::filesystem::path(request.OutputPath).parent_path(), ec);
+            if (!result.Success)
+            {
+                Log::Error("ShaderBuilder Failed to compile {}\n{}", request.SourcePath, result.Messages);
+                shader.Status = kStatusFailed;
+            }
+            else if (!FileIO::WriteBinaryFile(request.OutputPath, result.Bytecode))
+            {
+                Log::Error("ShaderBuilder Failed to write {}", request.OutputPath);
+                shader.Status = kStatusFailed;
+            }
+            else
+            {
+                if (!result.Messages.empty())
+                {
+                    Log::Warn("ShaderBuilder {}\n{}", request.SourcePath, result.Messages);
+                }
+                shader.Status = kStatusCompiled;
+            }
+            shader.Milliseconds =
+                std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - compile_start).count();
+        });
+
+        // Shaders not part of this build keep their entries, a failed shader loses its entry so it compiles again
+        ShaderCache updated;
+        for (u32 i = 0; i < requests.size(); ++i)
+        {
+            const auto& status = report.Shaders[i].Status;
+            report.CompiledCount += status == kStatusCompiled;
+            report.UpToDateCount += status == kStatusUpToDate;
+            report.FailedCount += status == kStatusFailed;
+            cached_keys.erase(requests[i].OutputPath);
+            if (status != kStatusFailed)
+            {
+                updated.Entries.push_back({.Output = requests[i].OutputPath, .Key = keys[i]});
+            }
+        }
+        for (const auto& [output, key] : cached_keys)
+        {
+            updated.Entries.push_back({.Output = std::string(output), .Key = key});
+        }
+        if (!settings.CachePath.empty() && !Serializer::Write(updated, settings.CachePath, SerializeFormat::eBinary))
+        {
+            Log::Warn("ShaderBuilder Failed to write the cache {}", settings.CachePath);
+        }
+
+        report.Milliseconds =
+            std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start).count();
+        Log::Info("ShaderBuilder {} compiled, {} up to date, {} failed in {:.1f} ms", report.CompiledCount,
+                  report.UpToDateCount, report.FailedCount, report.Milliseconds);
+        return report;
+    }
+
+    ShaderBuildReport ShaderBuilder::Cook(const Span<const ShaderSource> shaders, const ShaderBuildSettings& settings)
+    {
+        Vec<ShaderCompileRequest> requests;
+        Vec<u32> first_requests;
+        for (const auto& shader : shaders)
+        {
+            first_requests.push_back(static_cast<u32>(requests.size()));
+            const auto folder = std::filesystem::path(shader.OutputPath).parent_path() / kPermutationFolder;
+            const auto stem = std::filesystem::path(shader.Path).stem().string();
+            for (const u32 key : shader.Keys)
+            {
+                ShaderCompileRequest request{
+                    .SourcePath = shader.Path,
+                    .OutputPath = (folder / (stem + "." + std::to_string(key) + ".cso")).generic_string(),
+                    .Profile = shader.Profile,
+                };
+                for (u32 i = 0; i < shader.Features.size(); ++i)
+                {
+                    request.Defines.push_back(shader.Features[i] + ((key >> i & 1) != 0 ? "=1" : "=0"));
+                }
+                requests.push_back(std::move(request));
+            }
+        }
+        auto report = Build(requests, settings);
+
+        // A table is only written once all its permutations compiled, until then the previous one stays
+        bool library_changed = settings.Force || !FileIO::Exists(settings.LibraryPath);
+        for (u32 i = 0; i < shaders.size(); ++i)
+        {
+            const auto& shader = shaders[i];
+            const auto permutations =
+                Span<ShaderBuildReportShader>(report.Shaders).subspan(first_requests[i], shader.Keys.size());
+            const auto has_status = [&](const std::string_view status)
+            {
+                return std::ranges::find(permutations, status, &ShaderBuildReportShader::Status) != permutations.end();
+            };
+            const bool changed = settings.Force || has_status(kStatusCompiled) || !IsTableCurrent(shader);
+            if (has_status(kStatusFailed) || !changed)
+            {
+                continue;
+            }
+
+            library_changed = true;
+            auto cooked = CookedShader::Create(shader.Features);
+            bool written = true;
+            for (u32 j = 0; j < shader.Keys.size() && written; ++j)
+            {
+                const auto bytecode = FileIO::ReadBinaryFile(requests[first_requests[i] + j].OutputPath);
+                written = !bytecode.empty();
+                cooked.AddPermutation(shader.Keys[j], bytecode);
+            }
+            if (!written || !cooked.Write(shader.OutputPath))
+            {
+                Log::Error("ShaderBuilder Failed to write {}", shader.OutputPath);
+                for (auto& permutation : permutations)
+                {
+                    report.CompiledCount -= permutation.Status == kStatusCompiled;
+                    report.UpToDateCount -= permutation.Status == kStatusUpToDate;
+                    ++report.FailedCount;
+                    permutation.Status = kStatusFailed;
+                }
+            }
+        }
+        if (!settings.LibraryPath.empty() && library_changed && !WriteLibrary(shaders, settings.LibraryPath))
+        {
+            Log::Error("ShaderBuilder Failed to write the shader library {}", settings.LibraryPath);
+            ++report.FailedCount;
+        }
+        return report;
+    }
+
+    bool ShaderBuilder::WriteLibrary(const Span<const ShaderSource> shaders, const std::string_view path)
+    {
+        ShaderLibrary library;
+        for (const auto& shader : shaders)
+        {
+            const auto file = FileIO::ReadBinaryFile(shader.OutputPath);
+            const auto view = CookedShaderView::FromMemory(file);
+            if (!view)
+            {
+                return false;
+            }
+            library.AddShader(std::filesystem::path(shader.Path).stem().string(), *view);
+        }
+        return library.Write(path);
+    }
+
+    Vec<std::string> ShaderBuilder::GetIncludes(const ShaderCompileRequest& request)
+    {
+        Vec<std::string> includes;
+        Vec<std::string> pending = {request.SourcePath};
+        while (!pending.empty())
+        {
+            const auto path = std::move(pending.back());
+            pending.pop_back();
+            const auto directory = std::filesystem::path(path).parent_path();
+            for (const auto& [name, quoted] : ReadSource(path).Includes)
+            {
+                Vec<std::filesystem::path> candidates;
+                if (quoted)
+                {
+                    candidates.push_back(directory / name);
+                }
+                for (const auto& include_directory : request.IncludeDirectories)
+                {
+                    candidates.push_back(std::filesystem::path(include_directory) / name);
+                }
+
+                // An include that isn't found is kept by name, the shader builds again once it shows up
+                auto resolved = name;
+                for (const auto& candidate : candidates)
+                {
+                    auto candidate_path = candidate.lexically_normal().generic_string();
+                    if (ReadSource(candidate_path).Exists)
+                    {
+                        resolved = std::move(candidate_path);
+                        break;
+                    }
+                }
+                if (std::ranges::find(includes, resolved) == includes.end())
+                {
+                    includes.push_back(resolved);
+                    pending.push_back(std::move(resolved));
+                }
+            }
+        }
+        std::ranges::sort(includes);
+        return includes;
+    }
+
+    const ShaderBuilder::SourceFile& ShaderBuilder::ReadSource(const std::string& path)
+    {
+        if (const auto it = m_sources.find(path); it != m_sources.end())
+        {
+            return it->second;
+        }
+
+        SourceFile source;
+        if (FileIO::Exists(path))
+        {
+            const auto text = FileIO::ReadTextFile(path);
+            source.Exists = true;
+            source.Hash = HashContent(text.data(), text.size());
+            for (const auto line : std::views::split(std::string_view(text), '\n'))
+            {
+                if (auto include = ParseInclude(std::string_view(line.begin(), line.end())))
+                {
+                    source.Includes.push_back(std::move(*include));
+                }
+            }
+        }
+        return m_sources.emplace(path, std::move(source)).first->second;
+    }
+
+    u64 ShaderBuilder::GetKey(const ShaderCompileRequest& request)
+    {
+        auto defines = request.Defines;
+        std::ranges::sort(defines);
+
+        ContentHasher hasher;
+        hasher.Update(m_compiler.GetVersion());
+        hasher.Update(std::string_view(request.Profile));
+        hasher.Update(std::string_view(request.EntryPoint));
+        hasher.Update(static_cast<u64>(defines.size()));
+        for (const auto& define : defines)
+        {
+            hasher.Update(std::string_view(define));
+        }
+        hasher.Update(static_cast<u64>(request.IncludeDirectories.size()));
+        for (const auto& directory : request.IncludeDirectories)
+        {
+            hasher.Update(std::string_view(directory));
+        }
+        hasher.Update(ReadSource(request.SourcePath).Hash);
+        for (const auto& include : GetIncludes(request))
+        {
+            hasher.Update(std::string_view(include));
+            hasher.Update(ReadSource(include).Hash);
+        }
+        return hasher.Finalize();
+    }
+} // namespace FS
@@ -0,0 +1,139 @@
+#include "Asset/ShaderCompiler.hpp"
+
+namespace
+{
+    template <typename T>
+    struct ComPointer
+    {
+        T* Pointer = nullptr;
+
+        ComPointer() = default;
+        ComPointer(const ComPointer&) = delete;
+        ComPointer& operator=(const ComPointer&) = delete;
+        ~ComPointer()
+        {
+            if (Pointer)
+            {
+                Pointer->Release();
+            }
+        }
+
+        T* operator->() const { return Pointer; }
+    };
+
+    std::wstring Widen(const std::string_view string)
+    {
+        const int size = MultiByteToWideChar(CP_UTF8, 0, string.data(), static_cast<int>(string.size()), nullptr, 0);
+        std::wstring wide(size, L'\0');
+        MultiByteToWideChar(CP_UTF8, 0, string.data(), static_cast<int>(string.size()), wide.data(), size);
+        return wide;
+    }
+}
+
+namespace FS
+{
+    std::string_view DxcShaderCompiler::GetVersion() const
+    {
+        static const std::string version = []
+        {
+            ComPointer<IDxcCompiler3> compiler;
+            ComPointer<IDxcVersionInfo> version_info;
+            u32 major = 0;
+            u32 minor = 0;
+            if (SUCCEEDED(DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&compiler.Pointer))) &&
+                SUCCEEDED(compiler->QueryInterface(IID_PPV_ARGS(&version_info.Pointer))))
+            {
+                version_info->GetVersion(&major, &minor);
+            }
+            return std::format("DXC {}.{}", major, minor);
+        }();
+        return version;
+    }
+
+    ShaderCompileResult DxcShaderCompiler::Compile(const ShaderCompileRequest& request)
+    {
+        ShaderCompileResult result;
+        ComPointer<IDxcUtils> utils;
+        ComPointer<IDxcCompiler3> compiler;
+        ComPointer<IDxcIncludeHandler> include_handler;
+        if (FAILED(DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&utils.Pointer))) ||
+            FAILED(DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&compiler.Pointer))) ||
+            FAILED(utils->CreateDefaultIncludeHandler(&include_handler.Pointer)))
+        {
+            result.Messages = "Failed to create the DXC compiler";
+            return result;
+        }
+
+        const auto source_path = Widen(request.SourcePath);
+        ComPointer<IDxcBlobEncoding> source;
+        if (FAILED(utils->LoadFile(source_path.c_str(), nullptr, &source.Pointer)))
+        {
+            result.Messages = std::format("Failed to read {}", request.SourcePath);
+            return result;
+        }
+
+        Vec<std::wstring> arguments = {source_path, L"-E", Widen(request.EntryPoint), L"-T", Widen(request.Profile)};
+        for (const auto& define : request.Defines)
+        {
+            arguments.insert(arguments.end(), {L"-D", Widen(define)});
+        }
+        for (const auto& directory : request.IncludeDirectories)
+        {
+            arguments.insert(arguments.end(), {L"-I", Widen(directory)});
+        }
+        Vec<LPCWSTR> argument_pointers;
+        for (const auto& argument : arguments)
+        {
+            argument_pointers.push_back(argument.c_str());
+        }
+
+        const DxcBuffer buffer{
+            .Ptr = source->GetBufferPointer(),
+            .Size = source->GetBufferSize(),
+            .Encoding = DXC_CP_ACP,
+        };
+        ComPointer<IDxcResult> compile_result;
+        if (FAILED(compiler->Compile(&buffer, argument_pointers.data(), static_cast<u32>(argument_pointers.size()),
+                                     include_handler.Pointer, IID_PPV_ARGS(&compile_result.Pointer))))
+        {
+            result.Messages = std::format("DXC failed to run on {}", request.SourcePath);
+            return result;
+        }
+
+        ComPointer<IDxcBlobUtf8> errors;
+        if (SUCCEEDED(compile_result->GetOutput(DXC_OUT_ERRORS, IID_PPV_ARGS(&errors.Pointer), nullptr)) &&
+            errors.Pointer && errors->GetStringLength() > 0)
+        {
+            result.Messages.assign(errors->GetStringPointer(), errors->GetStringLength());
+        }
+        HRESULT status = E_FAIL;
+        compile_result->GetStatus(&status);
+        ComPointer<IDxcBlob> object;
+        if (FAILED(status) ||
+            FAILED(compile_result->GetOutput(DXC_OUT_OBJECT, IID_PPV_ARGS(&object.Pointer), nullptr)) ||
+            !object.Pointer)
+        {
+            return result;
+        }
+
+        const auto* bytecode = static_cast<const char*>(object->GetBufferPointer());
+        result.Bytecode.assign(bytecode, bytecode + object->GetBufferSize());
+        result.Success = true;
+        return result;
+    }
+
+    std::string GetShaderProfile(const std::string_view path)
+    {
+        static constexpr std::array<std::pair<std::string_view, std::string_view>, 5> kStages = {{
+            {"VS", "vs_6_6"}, {"PS", "ps_6_6"}, {"CS", "cs_6_6"}, {"MS", "ms_6_6"}, {"AS", "as_6_6"},
+        }};
+        const auto stem = std::filesystem::path(path).stem().string();
+        if (stem.size() <= 2)
+        {
+            return {};
+        }
+        const auto stage = std::ranges::find(kStages, std::string_view(stem).substr(stem.size() - 2),
+                                             &std::pair<std::string_view, std::string_view>::first);
+        return stage != kStages.end() ? std::string(stage->second) : std::string();
+    }
+} // namespace FS
@@ -0,0 +1,201 @@
+#include "Asset/ShaderLibrary.hpp"
+#include "Asset/CookedShader.hpp"
+#include "Core/FileWriter.hpp"
+#include "Tools/ContentHash.hpp"
+
+namespace
+{
+    constexpr u64 kSectionAlignment = 16;
+
+    bool IsSectionValid(const FS::Span<const char> memory, const u64 offset, const u64 size)
+    {
+        return offset >= sizeof(FS::ShaderLibraryHeader) && offset <= memory.size() && size <= memory.size() - offset;
+    }
+
+    u64 HashName(const std::string_view name)
+    {
+        return FS::HashContent(name.data(), name.size());
+    }
+}
+
+namespace FS
+{
+    void ShaderLibrary::AddShader(const std::string_view name, const CookedShaderView& shader)
+    {
+        Shaders.push_back({
+            .NameHash = HashName(name),
+            .NameOffset = static_cast<u32>(Names.size()),
+            .NameSize = static_cast<u32>(name.size()),
+            .FeatureCount = shader.Header->FeatureCount,
+            .FirstPermutation = static_cast<u32>(Permutations.size()),
+        });
+        Names.insert(Names.end(), name.begin(), name.end());
+
+        // Blobs are found by content hash, the bytes are still compared so a collision can't swap shaders
+        Vec<u32> variant_blobs;
+        for (const auto& variant : shader.Variants)
+        {
+            const auto bytecode = shader.Bytecode.subspan(variant.BytecodeOffset, variant.BytecodeSize);
+            const u64 hash = HashContent(bytecode);
+            const auto blob = std::ranges::find_if(Blobs, [&](const ShaderLibraryBlob& candidate)
+            {
+                return candidate.Hash == hash && std::ranges::equal(
+                    Span<const char>(Bytecode).subspan(candidate.BytecodeOffset, candidate.BytecodeSize), bytecode);
+            });
+            variant_blobs.push_back(static_cast<u32>(blob - Blobs.begin()));
+            if (blob == Blobs.end())
+            {
+                Blobs.push_back({.Hash = hash, .BytecodeOffset = Bytecode.size(), .BytecodeSize = bytecode.size()});
+                Bytecode.insert(Bytecode.end(), bytecode.begin(), bytecode.end());
+                Bytecode.resize(Align(Bytecode.size(), 4));
+            }
+        }
+        for (const u16 variant : shader.Table)
+        {
+            Permutations.push_back(variant == kStrippedPermutation ? kStrippedShaderBlob : variant_blobs[variant]);
+        }
+
+        Header.ShaderCount = static_cast<u32>(Shaders.size());
+        Header.PermutationCount = static_cast<u32>(Permutations.size());
+        Header.BlobCount = static_cast<u32>(Blobs.size());
+        Header.NamesSize = static_cast<u32>(Names.size());
+    }
+
+    bool ShaderLibrary::Write(const std::string_view path) const
+    {
+        auto header = Header;
+        auto shaders = Shaders;
+        std::ranges::sort(shaders, {}, &ShaderLibraryShader::NameHash);
+
+        u64 offset = sizeof(ShaderLibraryHeader);
+        const auto place_section = [&](const u64 size)
+        {
+            const u64 section_offset = Align(offset, kSectionAlignment);
+            offset = section_offset + size;
+            return section_offset;
+        };
+        header.ShadersOffset = place_section(shaders.size() * sizeof(ShaderLibraryShader));
+        header.NamesOffset = place_section(Names.size());
+        header.PermutationsOffset = place_section(Permutations.size() * sizeof(u32));
+        header.BlobsOffset = place_section(Blobs.size() * sizeof(ShaderLibraryBlob));
+        header.BytecodeOffset = place_section(Bytecode.size());
+        header.BytecodeSize = Bytecode.size();
+        header.FileSize = offset;
+
+        constexpr Array<char, kSectionAlignment> padding{};
+        FileWriter writer;
+        if (!writer.Open(path))
+        {
+            return false;
+        }
+        const auto write_section = [&](const u64 section_offset, const void* data, const u64 size)
+        {
+            writer.Write(padding.data(), section_offset - writer.BytesWritten());
+            writer.Write(data, size);
+        };
+        writer.Write(&header, sizeof(header));
+        write_section(header.ShadersOffset, shaders.data(), shaders.size() * sizeof(ShaderLibraryShader));
+        write_section(header.NamesOffset, Names.data(), Names.size());
+        write_section(header.PermutationsOffset, Permutations.data(), Permutations.size() * sizeof(u32));
+        write_section(header.BlobsOffset, Blobs.data(), Blobs.size() * sizeof(ShaderLibraryBlob));
+        write_section(header.BytecodeOffset, Bytecode.data(), Bytecode.size());
+        return writer.Commit();
+    }
+
+    Opt<ShaderLibraryView> ShaderLibraryView::FromMemory(const Span<const char> memory)
+    {
+        if (memory.size() < sizeof(ShaderLibraryHeader))
+        {
+            return std::nullopt;
+        }
+        const auto* header = reinterpret_cast<const ShaderLibraryHeader*>(memory.data());
+        if (header->Magic != ShaderLibraryHeader::kMagic || header->Version != ShaderLibraryHeader::kVersion ||
+            header->FileSize > memory.size() || header->ShadersOffset % alignof(ShaderLibraryShader) != 0 ||
+            header->PermutationsOffset % alignof(u32) != 0 || header->BlobsOffset % alignof(ShaderLibraryBlob) != 0 ||
+            !IsSectionValid(memory, header->ShadersOffset, header->ShaderCount * sizeof(ShaderLibraryShader)) ||
+            !IsSectionValid(memory, header->NamesOffset, header->NamesSize) ||
+            !IsSectionValid(memory, header->PermutationsOffset, header->PermutationCount * sizeof(u32)) ||
+            !IsSectionValid(memory, header->BlobsOffset, header->BlobCount * sizeof(ShaderLibraryBlob)) ||
+            !IsSectionValid(memory, header->BytecodeOffset, header->BytecodeSize))
+        {
+            Log::Error("ShaderLibraryView::FromMemory Invalid shader library");
+            return std::nullopt;
+        }
+
+        const auto* data = memory.data();
+        ShaderLibraryView view{
+            .Header = header,
+            .Shaders = Span<const ShaderLibraryShader>(
+                reinterpret_cast<const ShaderLibraryShader*>(data + header->ShadersOffset), header->ShaderCount),
+            .Names = memory.subspan(header->NamesOffset, header->NamesSize),
+            .Permutations = Span<const u32>(reinterpret_cast<const u32*>(data + header->PermutationsOffset),
+                                            header->PermutationCount),
+            .Blobs = Span<const ShaderLibraryBlob>(
+                reinterpret_cast<const ShaderLibraryBlob*>(data + header->BlobsOffset), header->BlobCount),
+            .Bytecode = memory.subspan(header->BytecodeOffset, header->BytecodeSize),
+        };
+        const bool valid =
+            std::ranges::all_of(view.Shaders, [&](const ShaderLibraryShader& shader)
+            {
+                return shader.NameOffset <= view.Names.size() &&
+                       shader.NameSize <= view.Names.size() - shader.NameOffset && shader.FeatureCount < 32 &&
+                       shader.FirstPermutation <= view.Permutations.size() &&
+                       (1ull << shader.FeatureCount) <= view.Permutations.size() - shader.FirstPermutation;
+            }) &&
+            std::ranges::all_of(view.Blobs, [&](const ShaderLibraryBlob& blob)
+            {
+                return blob.BytecodeOffset <= view.Bytecode.size() &&
+                       blob.BytecodeSize <= view.Bytecode.size() - blob.BytecodeOffset;
+            }) &&
+            std::ranges::all_of(view.Permutations, [&](const u32 blob)
+            {
+                return blob == kStrippedShaderBlob || blob < view.Blobs.size();
+            });
+        if (!valid)
+        {
+            Log::Error("ShaderLibraryView::FromMemory Invalid shader, blob or permutation");
+            return std::nullopt;
+        }
+        return view;
+    }
+
+    const ShaderLibraryShader* ShaderLibraryView::FindShader(const std::string_view name) const
+    {
+        const u64 hash = HashName(name);
+        const auto [first, last] = std::ranges::equal_range(Shaders, hash, {}, &ShaderLibraryShader::NameHash);
+        const auto shader = std::ranges::find_if(first, last, [&](const ShaderLibraryShader& candidate)
+        {
+            return GetName(candidate) == name;
+        });
+        return shader != last ? &*shader : nullptr;
+    }
+
+    std::string_view ShaderLibraryView::GetName(const ShaderLibraryShader& shader) const
+    {
+        return {Names.data() + shader.NameOffset, shader.NameSize};
+    }
+
+    Span<const char> ShaderLibraryView::GetPermutation(const ShaderLibraryShader& shader, const u32 key) const
+    {
+        if (key >= (1u << shader.FeatureCount))
+        {
+            return {};
+        }
+        const u32 blob = Permutations[shader.FirstPermutation + key];
+        if (blob == kStrippedShaderBlob)
+        {
+            return {};
+        }
+        return Bytecode.subspan(Blobs[blob].BytecodeOffset, Blobs[blob].BytecodeSize);
+    }
+
+    u64 ShaderLibraryView::GetPermutationHash(const ShaderLibraryShader& shader, const u32 key) const
+    {
+        if (key >= (1u << shader.FeatureCount))
+        {
+            return 0;
+        }
+        const u32 blob = Permutations[shader.FirstPermutation + key];
+        return blob == kStrippedShaderBlob ? 0 : Blobs[blob].Hash;
+    }
+} // namespace FS
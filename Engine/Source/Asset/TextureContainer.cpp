@@ -0,0 +1,505 @@
+#include "Asset/TextureContainer.hpp"
+#include "Tools/Log.hpp"
+
+namespace
+{
+    constexpr u32 MakeFourCC(const char a, const char b, const char c, const char d)
+    {
+        return static_cast<u32>(static_cast<u8>(a)) | static_cast<u32>(static_cast<u8>(b)) << 8 |
+            static_cast<u32>(static_cast<u8>(c)) << 16 | static_cast<u32>(static_cast<u8>(d)) << 24;
+    }
+
+    constexpr u32 kDDSMagic = MakeFourCC('D', 'D', 'S', ' ');
+    constexpr u32 kDDSMipMapCount = 0x20000;
+    constexpr u32 kDDSFourCC = 0x4;
+    constexpr u32 kDDSRGB = 0x40;
+    constexpr u32 kDDSLuminance = 0x20000;
+    constexpr u32 kDDSCubeMap = 0x200;
+    constexpr u32 kDDSVolume = 0x200000;
+    constexpr u32 kDX10Texture2D = 3;
+    constexpr u32 kDX10TextureCube = 0x4;
+
+    struct DDSPixelFormat
+    {
+        u32 Size = 0;
+        u32 Flags = 0;
+        u32 FourCC = 0;
+        u32 RGBBitCount = 0;
+        u32 RBitMask = 0;
+        u32 GBitMask = 0;
+        u32 BBitMask = 0;
+        u32 ABitMask = 0;
+    };
+
+    struct DDSHeader
+    {
+        u32 Size = 0;
+        u32 Flags = 0;
+        u32 Height = 0;
+        u32 Width = 0;
+        u32 PitchOrLinearSize = 0;
+        u32 Depth = 0;
+        u32 MipMapCount = 0;
+        FS::Array<u32, 11> Reserved1{};
+        DDSPixelFormat PixelFormat;
+        u32 Caps = 0;
+        u32 Caps2 = 0;
+        u32 Caps3 = 0;
+        u32 Caps4 = 0;
+        u32 Reserved2 = 0;
+    };
+    static_assert(sizeof(DDSHeader) == 124);
+
+    struct DDSHeaderDX10
+    {
+        u32 DXGIFormat = 0;
+        u32 ResourceDimension = 0;
+        u32 MiscFlag = 0;
+        u32 ArraySize = 0;
+        u32 MiscFlags2 = 0;
+    };
+    static_assert(sizeof(DDSHeaderDX10) == 20);
+
+    constexpr FS::Array<u8, 12> kKTX2Identifier{
+        0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A,
+    };
+
+    struct KTX2Header
+    {
+        FS::Array<u8, 12> Identifier{};
+        u32 VkFormat = 0;
+        u32 TypeSize = 0;
+        u32 PixelWidth = 0;
+        u32 PixelHeight = 0;
+        u32 PixelDepth = 0;
+        u32 LayerCount = 0;
+        u32 FaceCount = 0;
+        u32 LevelCount = 0;
+        u32 SupercompressionScheme = 0;
+        u32 DfdByteOffset = 0;
+        u32 DfdByteLength = 0;
+        u32 KvdByteOffset = 0;
+        u32 KvdByteLength = 0;
+        u64 SgdByteOffset = 0;
+        u64 SgdByteLength = 0;
+    };
+    static_assert(sizeof(KTX2Header) == 80);
+
+    struct KTX2Level
+    {
+        u64 ByteOffset = 0;
+        u64 ByteLength = 0;
+        u64 UncompressedByteLength = 0;
+    };
+
+    // VkFormat values of the formats FS::Format can represent
+    constexpr FS::Array<std::pair<u32, FS::Format>, 67> kVkFormats{{
+        // Packed Vulkan formats name their channels from the most significant bit, DXGI from the least
+        {4, FS::Format::eB5G6R5_UNORM},
+        {8, FS::Format::eB5G5R5A1_UNORM},
+        {9, FS::Format::eR8_UNORM},
+        {10, FS::Format::eR8_SNORM},
+        {13, FS::Format::eR8_UINT},
+        {14, FS::Format::eR8_SINT},
+        {16, FS::Format::eR8G8_UNORM},
+        {17, FS::Format::eR8G8_SNORM},
+        {20, FS::Format::eR8G8_UINT},
+        {21, FS::Format::eR8G8_SINT},
+        {37, FS::Format::eR8G8B8A8_UNORM},
+        {38, FS::Format::eR8G8B8A8_SNORM},
+        {41, FS::Format::eR8G8B8A8_UINT},
+        {42, FS::Format::eR8G8B8A8_SINT},
+        {43, FS::Format::eR8G8B8A8_UNORM_SRGB},
+        {44, FS::Format::eB8G8R8A8_UNORM},
+        {50, FS::Format::eB8G8R8A8_UNORM_SRGB},
+        {64, FS::Format::eR10G10B10A2_UNORM},
+        {68, FS::Format::eR10G10B10A2_UINT},
+        {70, FS::Format::eR16_UNORM},
+        {71, FS::Format::eR16_SNORM},
+        {74, FS::Format::eR16_UINT},
+        {75, FS::Format::eR16_SINT},
+        {76, FS::Format::eR16_FLOAT},
+        {77, FS::Format::eR16G16_UNORM},
+        {78, FS::Format::eR16G16_SNORM},
+        {81, FS::Format::eR16G16_UINT},
+        {82, FS::Format::eR16G16_SINT},
+        {83, FS::Format::eR16G16_FLOAT},
+        {91, FS::Format::eR16G16B16A16_UNORM},
+        {92, FS::Format::eR16G16B16A16_SNORM},
+        {95, FS::Format::eR16G16B16A16_UINT},
+        {96, FS::Format::eR16G16B16A16_SINT},
+        {97, FS::Format::eR16G16B16A16_FLOAT},
+        {98, FS::Format::eR32_UINT},
+        {99, FS::Format::eR32_SINT},
+        {100, FS::Format::eR32_FLOAT},
+        {101, FS::Format::eR32G32_UINT},
+        {102, FS::Format::eR32G32_SINT},
+        {103, FS::Format::eR32G32_FLOAT},
+        {104, FS::Format::eR32G32B32_UINT},
+        {105, FS::Format::eR32G32B32_SINT},
+        {106, FS::Format::eR32G32B32_FLOAT},
+        {107, FS::Format::eR32G32B32A32_UINT},
+        {108, FS::Format::eR32G32B32A32_SINT},
+        {109, FS::Format::eR32G32B32A32_FLOAT},
+        {122, FS::Format::eR11G11B10_FLOAT},
+        {124, FS::Format::eD16_UNORM},
+        {126, FS::Format::eD32_FLOAT},
+        {129, FS::Format::eD24_UNORM_S8_UINT},
+        {131, FS::Format::eBC1_UNORM},
+        {132, FS::Format::eBC1_UNORM_SRGB},
+        {133, FS::Format::eBC1_UNORM},
+        {134, FS::Format::eBC1_UNORM_SRGB},
+        {135, FS::Format::eBC2_UNORM},
+        {136, FS::Format::eBC2_UNORM_SRGB},
+        {137, FS::Format::eBC3_UNORM},
+        {138, FS::Format::eBC3_UNORM_SRGB},
+        {139, FS::Format::eBC4_UNORM},
+        {140, FS::Format::eBC4_SNORM},
+        {141, FS::Format::eBC5_UNORM},
+        {142, FS::Format::eBC5_SNORM},
+        {143, FS::Format::eBC6H_UF16},
+        {144, FS::Format::eBC6H_SF16},
+        {145, FS::Format::eBC7_UNORM},
+        {146, FS::Format::eBC7_UNORM_SRGB},
+        {1000470001, FS::Format::eA8_UNORM},
+    }};
+
+    FS::Format GetFormatFromVk(const u32 vk_format)
+    {
+        const auto it = std::ranges::find(kVkFormats, vk_format, &std::pair<u32, FS::Format>::first);
+        return it != kVkFormats.end() ? it->second : FS::Format::eUnknown;
+    }
+
+    FS::Format GetLegacyDDSFormat(const DDSPixelFormat& pixel_format)
+    {
+        if (pixel_format.Flags & kDDSFourCC)
+        {
+            switch (pixel_format.FourCC)
+            {
+            case MakeFourCC('D', 'X', 'T', '1'):
+                return FS::Format::eBC1_UNORM;
+            case MakeFourCC('D', 'X', 'T', '2'):
+            case MakeFourCC('D', 'X', 'T', '3'):
+                return FS::Format::eBC2_UNORM;
+            case MakeFourCC('D', 'X', 'T', '4'):
+            case MakeFourCC('D', 'X', 'T', '5'):
+                return FS::Format::eBC3_UNORM;
+            case MakeFourCC('A', 'T', 'I', '1'):
+            case MakeFourCC('B', 'C', '4', 'U'):
+                return FS::Format::eBC4_UNORM;
+            case MakeFourCC('B', 'C', '4', 'S'):
+                return FS::Format::eBC4_SNORM;
+            case MakeFourCC('A', 'T', 'I', '2'):
+            case MakeFourCC('B', 'C', '5', 'U'):
+                return FS::Format::eBC5_UNORM;
+            case MakeFourCC('B', 'C', '5', 'S'):
+                return FS::Format::eBC5_SNORM;
+            // D3DFORMAT values stored in the FourCC
+            case 36:
+                return FS::Format::eR16G16B16A16_UNORM;
+            case 110:
+                return FS::Format::eR16G16B16A16_SNORM;
+            case 111:
+                return FS::Format::eR16_FLOAT;
+            case 112:
+                return FS::Format::eR16G16_FLOAT;
+            case 113:
+                return FS::Format::eR16G16B16A16_FLOAT;
+            case 114:
+                return FS::Format::eR32_FLOAT;
+            case 115:
+                return FS::Format::eR32G32_FLOAT;
+            case 116:
+                return FS::Format::eR32G32B32A32_FLOAT;
+            default:
+                return FS::Format::eUnknown;
+            }
+        }
+
+        const auto masks = std::tuple{pixel_format.RBitMask, pixel_format.GBitMask, pixel_format.BBitMask};
+        if (pixel_format.Flags & kDDSRGB && pixel_format.RGBBitCount == 32)
+        {
+            if (masks == std::tuple{0xFFu, 0xFF00u, 0xFF0000u})
+            {
+                return FS::Format::eR8G8B8A8_UNORM;
+            }
+            if (masks == std::tuple{0xFF0000u, 0xFF00u, 0xFFu})
+            {
+                return FS::Format::eB8G8R8A8_UNORM;
+            }
+            if (masks == std::tuple{0xFFFFu, 0xFFFF0000u, 0u})
+            {
+                return FS::Format::eR16G16_UNORM;
+            }
+        }
+        if (pixel_format.Flags & kDDSRGB && pixel_format.RGBBitCount == 16 &&
+            masks == std::tuple{0xF800u, 0x7E0u, 0x1Fu})
+        {
+            return FS::Format::eB5G6R5_UNORM;
+        }
+        if (pixel_format.Flags & kDDSLuminance && pixel_format.RGBBitCount == 8)
+        {
+            return FS::Format::eR8_UNORM;
+        }
+        return FS::Format::eUnknown;
+    }
+
+    /// <summary>
+    /// Common checks of the parsed dimensions. Mip counts past the full chain are clamped.
+    /// </summary>
+    bool ValidateInfo(FS::TextureContainerInfo& info, const u64 mip_levels, const u64 array_size,
+                      const std::string_view parser)
+    {
+        const auto format_info = FS::GetFormatInfo(info.Format);
+        if (format_info.BytesPerBlock == 0)
+        {
+            FS::Log::Error("{} Unsupported format", parser);
+            return false;
+        }
+        if (info.Width == 0 || info.Height == 0 || array_size == 0 ||
+            array_size > std::numeric_limits<u16>::max())
+        {
+            FS::Log::Error("{} Invalid dimensions {}x{}x{}", parser, info.Width, info.Height, array_size);
+            return false;
+        }
+        const u64 max_mip_levels = FS::GetMipCount({info.Width, info.Height});
+        info.MipLevels = static_cast<u16>(std::clamp<u64>(mip_levels, 1, max_mip_levels));
+        info.ArraySize = static_cast<u16>(array_size);
+        return true;
+    }
+
+    FS::TextureSubresource GetSubresource(const FS::TextureContainerInfo& info, const u32 mip, const u64 offset)
+    {
+        const u32 width = std::max(info.Width >> mip, 1u);
+        const u32 height = std::max(info.Height >> mip, 1u);
+        return {
+            .Offset = offset,
+            .Width = width,
+            .Height = height,
+            .RowPitch = FS::GetRowPitch(info.Format, width),
+            .RowCount = FS::GetRowCount(info.Format, height),
+        };
+    }
+
+    u64 GetSize(const FS::TextureSubresource& subresource)
+    {
+        return static_cast<u64>(subresource.RowPitch) * subresource.RowCount;
+    }
+
+    bool FinishLayout(FS::TextureContainerInfo& info, const u64 file_size, const std::string_view parser)
+    {
+        u64 begin = std::numeric_limits<u64>::max();
+        u64 end = 0;
+        for (const auto& subresource : info.Subresources)
+        {
+            begin = std::min(begin, subresource.Offset);
+            end = std::max(end, subresource.Offset + GetSize(subresource));
+        }
+        if (end > file_size)
+        {
+            FS::Log::Error("{} File is truncated, needs {} bytes but has {}", parser, end, file_size);
+            return false;
+        }
+        info.DataOffset = begin;
+        info.DataSize = end - begin;
+        return true;
+    }
+}
+
+namespace FS
+{
+    Opt<TextureContainerInfo> ParseDDS(const Span<const char> memory)
+    {
+        constexpr u64 header_end = sizeof(u32) + sizeof(DDSHeader);
+        if (memory.size() < header_end || *reinterpret_cast<const u32*>(memory.data()) != kDDSMagic)
+        {
+            Log::Error("ParseDDS Not a DDS file");
+            return std::nullopt;
+        }
+        const auto* header = reinterpret_cast<const DDSHeader*>(memory.data() + sizeof(u32));
+        if (header->Size != sizeof(DDSHeader) || header->PixelFormat.Size != sizeof(DDSPixelFormat))
+        {
+            Log::Error("ParseDDS Invalid header");
+            return std::nullopt;
+        }
+
+        TextureContainerInfo info{.Width = header->Width, .Height = header->Height};
+        u64 data_offset = header_end;
+        u64 array_size = 1;
+        if (header->PixelFormat.Flags & kDDSFourCC && header->PixelFormat.FourCC == MakeFourCC('D', 'X', '1', '0'))
+        {
+            if (memory.size() < header_end + sizeof(DDSHeaderDX10))
+            {
+                Log::Error("ParseDDS Truncated DX10 header");
+                return std::nullopt;
+            }
+            const auto* dx10 = reinterpret_cast<const DDSHeaderDX10*>(memory.data() + header_end);
+            if (dx10->ResourceDimension != kDX10Texture2D)
+            {
+                Log::Error("ParseDDS Only 2D textures are supported");
+                return std::nullopt;
+            }
+            // FS::Format uses the DXGI values, anything without format info is rejected below
+            info.Format = dx10->DXGIFormat <= std::numeric_limits<u8>::max() ? static_cast<Format>(dx10->DXGIFormat)
+                                                                              : Format::eUnknown;
+            info.CubeMap = dx10->MiscFlag & kDX10TextureCube;
+            array_size = static_cast<u64>(std::max(dx10->ArraySize, 1u)) * (info.CubeMap ? 6 : 1);
+            data_offset += sizeof(DDSHeaderDX10);
+        }
+        else
+        {
+            if (header->Caps2 & kDDSVolume)
+            {
+                Log::Error("ParseDDS Volume textures aren't supported");
+                return std::nullopt;
+            }
+            info.Format = GetLegacyDDSFormat(header->PixelFormat);
+            info.CubeMap = header->Caps2 & kDDSCubeMap;
+            array_size = info.CubeMap ? 6 : 1;
+        }
+
+        const u64 mip_levels = header->Flags & kDDSMipMapCount ? header->MipMapCount : 1;
+        if (!ValidateInfo(info, mip_levels, array_size, "ParseDDS"))
+        {
+            return std::nullopt;
+        }
+
+        // Every slice stores its whole mip chain before the next slice, which is the D3D12 subresource order
+        u64 offset = data_offset;
+        info.Subresources.reserve(static_cast<u64>(info.ArraySize) * info.MipLevels);
+        for (u32 slice = 0; slice < info.ArraySize; ++slice)
+        {
+            for (u32 mip = 0; mip < info.MipLevels; ++mip)
+            {
+                info.Subresources.push_back(GetSubresource(info, mip, offset));
+                offset += GetSize(info.Subresources.back());
+            }
+        }
+        if (!FinishLayout(info, memory.size(), "ParseDDS"))
+        {
+            return std::nullopt;
+        }
+        return info;
+    }
+
+    Opt<TextureContainerInfo> ParseKTX2(const Span<const char> memory)
+    {
+        const auto* header = reinterpret_cast<const KTX2Header*>(memory.data());
+        if (memory.size() < sizeof(KTX2Header) || header->Identifier != kKTX2Identifier)
+        {
+            Log::Error("ParseKTX2 Not a KTX2 file");
+            return std::nullopt;
+        }
+        if (header->SupercompressionScheme != 0 || header->VkFormat == 0)
+        {
+            Log::Error("ParseKTX2 Supercompressed and Basis Universal textures need transcoding");
+            return std::nullopt;
+        }
+        if (header->PixelDepth > 1)
+        {
+            Log::Error("ParseKTX2 Volume textures aren't supported");
+            return std::nullopt;
+        }
+
+        TextureContainerInfo info{
+            .Width = header->PixelWidth,
+            .Height = std::max(header->PixelHeight, 1u),
+            .Format = GetFormatFromVk(header->VkFormat),
+            .CubeMap = header->FaceCount == 6,
+        };
+        const u64 layers = std::max(header->LayerCount, 1u);
+        const u64 faces = std::max(header->FaceCount, 1u);
+        // A level count of 0 asks the loader to generate the mips, the file only has the base level
+        const u32 level_count = std::max(header->LevelCount, 1u);
+        if (!ValidateInfo(info, level_count, layers * faces, "ParseKTX2"))
+        {
+            return std::nullopt;
+        }
+
+        const u64 index_end = sizeof(KTX2Header) + static_cast<u64>(level_count) * sizeof(KTX2Level);
+        if (memory.size() < index_end)
+        {
+            Log::Error("ParseKTX2 Truncated level index");
+            return std::nullopt;
+        }
+        const auto* levels = reinterpret_cast<const KTX2Level*>(memory.data() + sizeof(KTX2Header));
+
+        // Levels hold every layer and face of one mip, so slices are gathered across the levels
+        info.Subresources.resize(static_cast<u64>(info.ArraySize) * info.MipLevels);
+        for (u32 mip = 0; mip < info.MipLevels; ++mip)
+        {
+            const u64 image_size = GetSize(GetSubresource(info, mip, 0));
+            if (levels[mip].ByteLength < image_size * info.ArraySize)
+            {
+                Log::Error("ParseKTX2 Level {} is {} bytes, expected {}", mip, levels[mip].ByteLength,
+                           image_size * info.ArraySize);
+                return std::nullopt;
+            }
+            for (u32 slice = 0; slice < info.ArraySize; ++slice)
+            {
+                info.Subresources[static_cast<u64>(slice) * info.MipLevels + mip] =
+                    GetSubresource(info, mip, levels[mip].ByteOffset + slice * image_size);
+            }
+        }
+        if (!FinishLayout(info, memory.size(), "ParseKTX2"))
+        {
+            return std::nullopt;
+        }
+        return info;
+    }
+
+    Opt<TextureContainerInfo> ParseTextureContainer(const Span<const char> memory)
+    {
+        if (memory.size() >= sizeof(u32) && *reinterpret_cast<const u32*>(memory.data()) == kDDSMagic)
+        {
+            return ParseDDS(memory);
+        }
+        if (memory.size() >= kKTX2Identifier.size() &&
+            std::memcmp(memory.data(), kKTX2Identifier.data(), kKTX2Identifier.size()) == 0)
+        {
+            return ParseKTX2(memory);
+        }
+        Log::Error("ParseTextureContainer Unknown texture container");
+        return std::nullopt;
+    }
+
+    bool TextureContainer::Open(const std::string_view path)
+    {
+        Close();
+        if (!m_file.Open(path))
+        {
+            return false;
+        }
+        auto info = ParseTextureContainer(m_file.GetSpan());
+        if (!info)
+        {
+            Log::Error("TextureContainer::Open Failed to parse {}", path);
+            m_file.Close();
+            return false;
+        }
+        m_info = std::move(*info);
+
+        // The upload reads the whole payload right after, so start reading it in large requests now
+        m_file.Prefetch(m_info.DataOffset, m_info.DataSize);
+        return true;
+    }
+
+    void TextureContainer::Close()
+    {
+        m_file.Close();
+        m_info = {};
+    }
+
+    TextureCreateInfo TextureContainer::GetCreateInfo() const
+    {
+        return {
+            .Dimensions = {m_info.Width, m_info.Height},
+            .Depth = m_info.ArraySize,
+            .MipLevels = m_info.MipLevels,
+            .Format = m_info.Format,
+            .ViewType = m_info.ArraySize > 1 ? ViewType::eTexture2DArray : ViewType::eTexture2D,
+            .TextureFlags = TextureFlags::eShaderResource,
+            .UploadInfo = {.Data = m_file.Data(), .Subresources = m_info.Subresources},
+        };
+    }
+} // namespace FS
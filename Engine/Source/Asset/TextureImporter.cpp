@@ -0,0 +1,192 @@
+#include "Asset/TextureImporter.hpp"
+#include "Core/JobSystem.hpp"
+#include "Core/MappedFile.hpp"
+#include "stb_image.h"
+
+namespace
+{
+    struct DecodedImage
+    {
+        FS::Image Image;
+        bool HDR = false;
+    };
+
+    FS::Opt<DecodedImage> Decode(const FS::Span<const char> memory, const std::string_view path, const bool srgb)
+    {
+        const auto* buffer = reinterpret_cast<const stbi_uc*>(memory.data());
+        const int size = static_cast<int>(memory.size());
+        int width, height, channels;
+        void* pixels;
+        DecodedImage decoded;
+        FS::Format format;
+        if (stbi_is_hdr_from_memory(buffer, size))
+        {
+            pixels = stbi_loadf_from_memory(buffer, size, &width, &height, &channels, 4);
+            format = FS::Format::eR32G32B32A32_FLOAT;
+            decoded.HDR = true;
+        }
+        else if (stbi_is_16_bit_from_memory(buffer, size))
+        {
+            pixels = stbi_load_16_from_memory(buffer, size, &width, &height, &channels, 4);
+            format = FS::Format::eR16G16B16A16_UNORM;
+        }
+        else
+        {
+            pixels = stbi_load_from_memory(buffer, size, &width, &height, &channels, 4);
+            format = srgb ? FS::Format::eR8G8B8A8_UNORM_SRGB : FS::Format::eR8G8B8A8_UNORM;
+        }
+        if (!pixels)
+        {
+            FS::Log::Error("TextureImporter Failed to decode {}: {}", path, stbi_failure_reason());
+            return std::nullopt;
+        }
+
+        decoded.Image = FS::Image::Create(width, height, format);
+        std::memcpy(decoded.Image.Pixels.data(), pixels, decoded.Image.Pixels.size());
+        stbi_image_free(pixels);
+        return decoded;
+    }
+}
+
+namespace FS
+{
+    TextureImporter::TextureImporter(JobSystem& jobs, const u64 memory_budget)
+        : m_jobs(jobs), m_memory_budget(memory_budget)
+    {
+    }
+
+    Opt<CookedTexture> TextureImporter::Import(const std::string_view path, const TextureImportSettings& settings)
+    {
+        MappedFile file;
+        if (!file.Open(path))
+        {
+            return std::nullopt;
+        }
+        return Import(file.GetSpan(), path, settings, &m_jobs);
+    }
+
+    u32 TextureImporter::ImportBatch(const Span<const TextureImportRequest> requests)
+    {
+        std::atomic<u32> imported = 0;
+        JobCounter batch;
+        for (const auto& request : requests)
+        {
+            auto file = MakeRef<MappedFile>();
+            if (!file->Open(request.SourcePath))
+            {
+                continue;
+            }
+
+            // Reserved here rather than in the job, a job blocking on the budget could be picked up by a thread
+            // waiting on jobs while an outer job of the same thread holds that budget. When the budget is full
+            // this thread helps with the queued imports, which never block, until one of them frees enough.
+            const u64 memory = EstimateMemory(file->GetSpan(), request.Settings);
+            m_jobs.WaitUntil([this, memory] { return TryAcquireMemory(memory); });
+            m_jobs.Submit([this, &request, &imported, file = std::move(file), memory]
+            {
+                // Each image imports single threaded, the batch already keeps every worker busy
+                const auto texture = Import(file->GetSpan(), request.SourcePath, request.Settings, nullptr);
+                if (texture && texture->Write(request.CookedPath))
+                {
+                    imported.fetch_add(1, std::memory_order_relaxed);
+                }
+                ReleaseMemory(memory);
+            }, &batch);
+        }
+        m_jobs.Wait(batch);
+        return imported.load();
+    }
+
+    Opt<CookedTexture> TextureImporter::Import(const Span<const char> memory, const std::string_view path,
+                                               const TextureImportSettings& settings, JobSystem* jobs)
+    {
+        auto decoded = Decode(memory, path, settings.SRGB);
+        if (!decoded)
+        {
+            return std::nullopt;
+        }
+
+        auto format = settings.Format;
+        if (format == Format::eUnknown)
+        {
+            format = decoded->HDR ? Format::eR16G16B16A16_FLOAT : decoded->Image.Format;
+        }
+        const bool compressed = IsBlockCompressionSupported(format);
+        if (!compressed && !IsPixelFormatSupported(format))
+        {
+            Log::Error("TextureImporter Can't cook {} to format {}", path, static_cast<u32>(format));
+            return std::nullopt;
+        }
+
+        // Block compressed textures are filtered in the encoder's source format and every level is compressed
+        // afterwards
+        const auto pixel_format = compressed ? GetBlockCompressionSourceFormat(format) : format;
+        auto image = std::move(decoded->Image);
+        if (pixel_format != image.Format)
+        {
+            image = ConvertImage(image, pixel_format);
+        }
+
+        Vec<Image> mips;
+        if (settings.GenerateMips)
+        {
+            mips = GenerateMips(image, settings.MipSettings, jobs);
+        }
+        if (compressed)
+        {
+            const BlockCompressionSettings compression{
+                .Quality = settings.Compression,
+                .NormalMap = settings.MipSettings.NormalMap,
+            };
+            image = CompressImage(image, format, compression, jobs);
+            for (auto& mip : mips)
+            {
+                mip = CompressImage(mip, format, compression, jobs);
+            }
+        }
+
+        Vec<const Image*> levels{&image};
+        for (const auto& mip : mips)
+        {
+            levels.push_back(&mip);
+        }
+        return CookedTexture::Create(levels);
+    }
+
+    u64 TextureImporter::EstimateMemory(const Span<const char> memory, const TextureImportSettings& settings) const
+    {
+        const auto* buffer = reinterpret_cast<const stbi_uc*>(memory.data());
+        const int size = static_cast<int>(memory.size());
+        int width, height, channels;
+        if (!stbi_info_from_memory(buffer, size, &width, &height, &channels))
+        {
+            return 0;
+        }
+
+        // Decoded RGBA, the converted copy and the cooked blob with a third extra for the mips
+        const u64 pixels = static_cast<u64>(width) * height;
+        const u64 decoded_size = pixels * (stbi_is_hdr_from_memory(buffer, size) ? 16 : 8);
+        const u32 pixel_size = settings.Format == Format::eUnknown || IsBlockCompressionSupported(settings.Format)
+                                   ? 8
+                                   : GetFormatInfo(settings.Format).BytesPerBlock;
+        const u64 cooked_size = pixels * pixel_size * (settings.GenerateMips ? 4 : 3) / 3;
+        return std::min(decoded_size + cooked_size * 2, m_memory_budget);
+    }
+
+    bool TextureImporter::TryAcquireMemory(const u64 size)
+    {
+        std::scoped_lock lock(m_memory_mutex);
+        if (m_memory_used + size > m_memory_budget)
+        {
+            return false;
+        }
+        m_memory_used += size;
+        return true;
+    }
+
+    void TextureImporter::ReleaseMemory(const u64 size)
+    {
+        std::scoped_lock lock(m_memory_mutex);
+        m_memory_used -= size;
+    }
+} // namespace FS
@@ -0,0 +1,259 @@
+#include "Asset/VertexPacking.hpp"
+#include "glm/gtc/packing.hpp"
+
+namespace
+{
+    constexpr f32 kUnorm16Max = 65535.0f;
+    constexpr f32 kSnorm16Max = 32767.0f;
+    constexpr u32 kTangentSignBit = 1u << 16;
+
+    glm::vec3 GetInverseScale(const FS::VertexQuantization& quantization)
+    {
+        const auto inverse = [](const f32 scale) { return scale > 0.0f ? 1.0f / scale : 0.0f; };
+        return {
+            inverse(quantization.PositionScale.x), inverse(quantization.PositionScale.y),
+            inverse(quantization.PositionScale.z)
+        };
+    }
+
+    // Rounds to nearest even like cvtps_epi32, so the scalar and SIMD paths agree bit for bit
+    u32 QuantizeUnorm16(const f32 value)
+    {
+        return static_cast<u32>(std::nearbyint(std::clamp(value, 0.0f, kUnorm16Max)));
+    }
+
+    u32 QuantizeSnorm16(const f32 value)
+    {
+        return static_cast<u32>(static_cast<i32>(std::nearbyint(std::clamp(value, -1.0f, 1.0f) * kSnorm16Max))) &
+               0xFFFF;
+    }
+
+    f32 DequantizeSnorm16(const u32 value)
+    {
+        return std::max(static_cast<f32>(static_cast<i16>(value)) / kSnorm16Max, -1.0f);
+    }
+
+    u32 PackSnorm16x2(const glm::vec2& value)
+    {
+        return QuantizeSnorm16(value.x) | QuantizeSnorm16(value.y) << 16;
+    }
+
+    glm::vec2 UnpackSnorm16x2(const u32 value)
+    {
+        return {DequantizeSnorm16(value & 0xFFFF), DequantizeSnorm16(value >> 16)};
+    }
+
+    u32 FloatToHalf(const f32 value)
+    {
+#ifdef __AVX2__
+        return _cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT);
+#else
+        return glm::packHalf1x16(value);
+#endif
+    }
+
+    f32 AngleBetween(const glm::vec3& a, const glm::vec3& b)
+    {
+        const f32 lengths = glm::length(a) * glm::length(b);
+        if (lengths <= 0.0f)
+        {
+            return 0.0f;
+        }
+        return glm::degrees(std::acos(std::clamp(glm::dot(a, b) / lengths, -1.0f, 1.0f)));
+    }
+
+#ifdef __AVX2__
+    /// Octahedral encode of eight directions, the same operations as EncodeOctahedral
+    void EncodeOctahedral8(const __m256 x, const __m256 y, const __m256 z, __m256& out_x, __m256& out_y)
+    {
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+        const __m256 sum = _mm256_add_ps(_mm256_add_ps(_mm256_and_ps(x, abs_mask), _mm256_and_ps(y, abs_mask)),
+                                         _mm256_and_ps(z, abs_mask));
+        const __m256 valid = _mm256_cmp_ps(sum, zero, _CMP_GT_OQ);
+        const __m256 safe_sum = _mm256_blendv_ps(one, sum, valid);
+        const __m256 px = _mm256_and_ps(_mm256_div_ps(x, safe_sum), valid);
+        const __m256 py = _mm256_and_ps(_mm256_div_ps(y, safe_sum), valid);
+
+        const __m256 sign_x = _mm256_blendv_ps(_mm256_set1_ps(-1.0f), one, _mm256_cmp_ps(px, zero, _CMP_GE_OQ));
+        const __m256 sign_y = _mm256_blendv_ps(_mm256_set1_ps(-1.0f), one, _mm256_cmp_ps(py, zero, _CMP_GE_OQ));
+        const __m256 folded_x = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_and_ps(py, abs_mask)), sign_x);
+        const __m256 folded_y = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_and_ps(px, abs_mask)), sign_y);
+        const __m256 lower = _mm256_and_ps(_mm256_cmp_ps(z, zero, _CMP_LT_OQ), valid);
+        out_x = _mm256_blendv_ps(px, folded_x, lower);
+        out_y = _mm256_blendv_ps(py, folded_y, lower);
+    }
+
+    __m256i QuantizeSnorm16x2(const __m256 x, const __m256 y)
+    {
+        const __m256 scale = _mm256_set1_ps(kSnorm16Max);
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 minus_one = _mm256_set1_ps(-1.0f);
+        const __m256i qx = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(x, minus_one), one), scale));
+        const __m256i qy = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(y, minus_one), one), scale));
+        return _mm256_or_si256(_mm256_and_si256(qx, _mm256_set1_epi32(0xFFFF)), _mm256_slli_epi32(qy, 16));
+    }
+
+    __m256i QuantizeUnorm16(const __m256 value, const __m256 min, const __m256 inverse_scale)
+    {
+        const __m256 scaled = _mm256_mul_ps(_mm256_sub_ps(value, min), inverse_scale);
+        return _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(scaled, _mm256_setzero_ps()),
+                                                _mm256_set1_ps(kUnorm16Max)));
+    }
+#endif
+}
+
+namespace FS
+{
+    VertexQuantization ComputeVertexQuantization(const Span<const Vertex> vertices)
+    {
+        if (vertices.empty())
+        {
+            return {};
+        }
+        glm::vec3 min = vertices.front().Position;
+        glm::vec3 max = min;
+        for (const auto& vertex : vertices)
+        {
+            min = glm::min(min, vertex.Position);
+            max = glm::max(max, vertex.Position);
+        }
+        return {.PositionMin = min, .PositionScale = (max - min) / kUnorm16Max};
+    }
+
+    glm::vec2 EncodeOctahedral(const glm::vec3& direction)
+    {
+        const f32 sum = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+        if (!(sum > 0.0f))
+        {
+            return glm::vec2(0.0f);
+        }
+        const glm::vec2 projected(direction.x / sum, direction.y / sum);
+        if (direction.z >= 0.0f)
+        {
+            return projected;
+        }
+        const auto sign = [](const f32 value) { return value >= 0.0f ? 1.0f : -1.0f; };
+        return {
+            (1.0f - std::abs(projected.y)) * sign(projected.x),
+            (1.0f - std::abs(projected.x)) * sign(projected.y)
+        };
+    }
+
+    glm::vec3 DecodeOctahedral(const glm::vec2& encoded)
+    {
+        glm::vec3 direction(encoded.x, encoded.y, 1.0f - std::abs(encoded.x) - std::abs(encoded.y));
+        const f32 fold = std::max(-direction.z, 0.0f);
+        direction.x += direction.x >= 0.0f ? -fold : fold;
+        direction.y += direction.y >= 0.0f ? -fold : fold;
+        return glm::normalize(direction);
+    }
+
+    PackedVertex PackVertex(const Vertex& vertex, const VertexQuantization& quantization)
+    {
+        const glm::vec3 scaled = (vertex.Position - quantization.PositionMin) * GetInverseScale(quantization);
+        return {
+            .PositionXY = QuantizeUnorm16(scaled.x) | QuantizeUnorm16(scaled.y) << 16,
+            .PositionZFlags = QuantizeUnorm16(scaled.z) | (vertex.Tangent.w < 0.0f ? kTangentSignBit : 0),
+            .Normal = PackSnorm16x2(EncodeOctahedral(vertex.Normal)),
+            .Tangent = PackSnorm16x2(EncodeOctahedral(glm::vec3(vertex.Tangent))),
+            .UV = FloatToHalf(vertex.UVx) | FloatToHalf(vertex.UVy) << 16,
+        };
+    }
+
+    Vertex UnpackVertex(const PackedVertex& vertex, const VertexQuantization& quantization)
+    {
+        const glm::vec3 quantized(static_cast<f32>(vertex.PositionXY & 0xFFFF),
+                                  static_cast<f32>(vertex.PositionXY >> 16),
+                                  static_cast<f32>(vertex.PositionZFlags & 0xFFFF));
+        return {
+            .Position = quantization.PositionMin + quantized * quantization.PositionScale,
+            .UVx = glm::unpackHalf1x16(static_cast<u16>(vertex.UV & 0xFFFF)),
+            .Normal = DecodeOctahedral(UnpackSnorm16x2(vertex.Normal)),
+            .UVy = glm::unpackHalf1x16(static_cast<u16>(vertex.UV >> 16)),
+            .Tangent = glm::vec4(DecodeOctahedral(UnpackSnorm16x2(vertex.Tangent)),
+                                 vertex.PositionZFlags & kTangentSignBit ? -1.0f : 1.0f),
+        };
+    }
+
+    void PackVertices(const Span<const Vertex> vertices, const VertexQuantization& quantization,
+                      const Span<PackedVertex> output)
+    {
+        u64 i = 0;
+#ifdef __AVX2__
+        constexpr u32 kStride = sizeof(Vertex) / sizeof(f32);
+        const __m256i offsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                                   _mm256_set1_epi32(kStride));
+        const glm::vec3 inverse_scale = GetInverseScale(quantization);
+        const __m256 min[3] = {
+            _mm256_set1_ps(quantization.PositionMin.x), _mm256_set1_ps(quantization.PositionMin.y),
+            _mm256_set1_ps(quantization.PositionMin.z)
+        };
+        const __m256 inverse[3] = {
+            _mm256_set1_ps(inverse_scale.x), _mm256_set1_ps(inverse_scale.y), _mm256_set1_ps(inverse_scale.z)
+        };
+
+        alignas(32) Array<Array<u32, 8>, 5> lanes;
+        for (; i + 8 <= vertices.size(); i += 8)
+        {
+            // Gathering transposes eight vertices into one register per field
+            const f32* base = &vertices[i].Position.x;
+            const auto gather = [&](const u32 field) { return _mm256_i32gather_ps(base + field, offsets, 4); };
+            const __m256 tangent_w = gather(11);
+
+            __m256 normal_x, normal_y, tangent_x, tangent_y;
+            EncodeOctahedral8(gather(4), gather(5), gather(6), normal_x, normal_y);
+            EncodeOctahedral8(gather(8), gather(9), gather(10), tangent_x, tangent_y);
+
+            const __m256i position_x = QuantizeUnorm16(gather(0), min[0], inverse[0]);
+            const __m256i position_y = QuantizeUnorm16(gather(1), min[1], inverse[1]);
+            const __m256i position_z = QuantizeUnorm16(gather(2), min[2], inverse[2]);
+            const __m256i sign = _mm256_and_si256(
+                _mm256_castps_si256(_mm256_cmp_ps(tangent_w, _mm256_setzero_ps(), _CMP_LT_OQ)),
+                _mm256_set1_epi32(kTangentSignBit));
+            const __m128i uv_x = _mm256_cvtps_ph(gather(3), _MM_FROUND_TO_NEAREST_INT);
+            const __m128i uv_y = _mm256_cvtps_ph(gather(7), _MM_FROUND_TO_NEAREST_INT);
+
+            const auto store = [&](const u32 lane, const __m256i value)
+            {
+                _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[lane].data()), value);
+            };
+            store(0, _mm256_or_si256(position_x, _mm256_slli_epi32(position_y, 16)));
+            store(1, _mm256_or_si256(position_z, sign));
+            store(2, QuantizeSnorm16x2(normal_x, normal_y));
+            store(3, QuantizeSnorm16x2(tangent_x, tangent_y));
+            store(4, _mm256_set_m128i(_mm_unpackhi_epi16(uv_x, uv_y), _mm_unpacklo_epi16(uv_x, uv_y)));
+            for (u32 lane = 0; lane < 8; ++lane)
+            {
+                output[i + lane] = {lanes[0][lane], lanes[1][lane], lanes[2][lane], lanes[3][lane], lanes[4][lane]};
+            }
+        }
+#endif
+        for (; i < vertices.size(); ++i)
+        {
+            output[i] = PackVertex(vertices[i], quantization);
+        }
+    }
+
+    VertexPackingError MeasurePackingError(const Span<const Vertex> vertices, const Span<const PackedVertex> packed,
+                                           const VertexQuantization& quantization)
+    {
+        VertexPackingError error;
+        for (u64 i = 0; i < vertices.size(); ++i)
+        {
+            const auto& original = vertices[i];
+            const auto decoded = UnpackVertex(packed[i], quantization);
+            error.MaxPositionError = std::max(error.MaxPositionError,
+                                              glm::length(decoded.Position - original.Position));
+            error.MaxNormalAngle = std::max(error.MaxNormalAngle, AngleBetween(decoded.Normal, original.Normal));
+            error.MaxTangentAngle = std::max(error.MaxTangentAngle, AngleBetween(glm::vec3(decoded.Tangent),
+                                                                                 glm::vec3(original.Tangent)));
+            error.MaxUVError = std::max({
+                error.MaxUVError, std::abs(decoded.UVx - original.UVx), std::abs(decoded.UVy - original.UVy)
+            });
+            error.HandednessMismatches += (decoded.Tangent.w < 0.0f) != (original.Tangent.w < 0.0f);
+        }
+        return error;
+    }
+} // namespace FS
@@ -3,11 +3,14 @@
 #include "Core/Renderer.hpp"
 #include "Core/Project.hpp"
 #include "Core/Events.hpp"
+#include "Core/JobSystem.hpp"
 #include "Tools/Log.hpp"
 
 void FS::Engine::Init()
 {
     m_events = MakeRef<FS::Events>();
+    m_jobs = MakeRef<JobSystem>();
+    m_jobs->Init();
     m_project = MakeRef<FS::Project>();
     
     AddSystem<FS::Window>();
@@ -32,5 +35,6 @@ void FS::Engine::Shutdown()
         system->Shutdown();
     });
     m_systems.clear();
+    m_jobs->Shutdown();
     Log::Info("Engine Shutdown");
 }
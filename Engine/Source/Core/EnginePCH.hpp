@@ -14,6 +14,7 @@
 #include "directx/d3dx12.h"
 #include "dxgi1_6.h"
 #include "dxcapi.h"
+#include "immintrin.h"
 
 #include "glm/glm.hpp"
 #include "glm/gtc/type_ptr.hpp"
@@ -21,6 +22,7 @@
 #include "expected"
 #include "optional"
 #include "memory"
+#include "utility"
 #include "algorithm"
 #include "vector"
 #include "span"
@@ -31,6 +33,13 @@
 #include "filesystem"
 #include "unordered_map"
 #include "functional"
+#include "bit"
+#include "charconv"
+#include "atomic"
+#include "thread"
+#include "mutex"
+#include "condition_variable"
+#include "deque"
 
 using u8 = uint8_t;
 using u16 = uint16_t;
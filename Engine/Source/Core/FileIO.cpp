@@ -1,4 +1,5 @@
 #include "Core/FileIO.hpp"
+#include "Core/FileWriter.hpp"
 #include "Core/Engine.hpp"
 #include "Core/Project.hpp"
 #include "Tools/Log.hpp"
@@ -37,15 +38,7 @@ namespace FS
 
     bool FileIO::WriteTextFile(const std::string_view path, const std::string_view content)
     {
-        std::ofstream file(path.data());
-        if (!file.is_open())
-        {
-            Log::Error("File {} was not found!", path);
-            return false;
-        }
-        file << content;
-        file.close();
-        return true;
+        return WriteBinaryFile(path, Span(content.data(), content.size()));
     }
 
     std::vector<char> FileIO::ReadBinaryFile(const std::string_view path)
@@ -65,23 +58,37 @@ namespace FS
         return {};
     }
 
-    bool FileIO::WriteBinaryFile(const std::string_view path, const std::vector<char>& content)
+    bool FileIO::ReadFileRange(const std::string_view path, const u64 offset, const Span<char> destination)
     {
-        std::ofstream file(path.data(), std::ios::binary);
+        std::ifstream file(path.data(), std::ios::binary);
         if (!file.is_open())
         {
             Log::Error("File {} was not found!", path);
             return false;
         }
-        file.write(content.data(), static_cast<int64_t>(content.size()));
-        file.close();
+        file.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+        if (!file.read(destination.data(), static_cast<std::streamsize>(destination.size())))
+        {
+            Log::Error("FileIO::ReadFileRange Failed to read {} bytes at {} from {}", destination.size(), offset, path);
+            return false;
+        }
         return true;
     }
 
-    bool FileIO::Exists(const std::string_view path)
+    bool FileIO::WriteBinaryFile(const std::string_view path, const Span<const char> content)
     {
+        FileWriter writer;
+        if (!writer.Open(path, {.SizeHint = content.size()}))
+        {
+            return false;
+        }
+        writer.Write(content);
+        return writer.Commit();
+    }
 
-        return !std::filesystem::exists(path);
+    bool FileIO::Exists(const std::string_view path)
+    {
+        return std::filesystem::exists(path);
     }
 
     uint64_t FileIO::LastModified(const std::string_view path)
@@ -0,0 +1,257 @@
+#include "Core/FileWriter.hpp"
+#include "Tools/Log.hpp"
+
+namespace FS
+{
+    FileWriter::~FileWriter()
+    {
+        Abort();
+    }
+
+    bool FileWriter::Open(const std::string_view path, const FileWriterCreateInfo& create_info)
+    {
+        if (IsOpen())
+        {
+            Log::Error("FileWriter::Open File {} is already open", m_path);
+            return false;
+        }
+
+        m_create_info = create_info;
+        m_create_info.BufferSize = static_cast<u32>(Align(std::max(m_create_info.BufferSize, kFileWriterAlignment),
+                                                          kFileWriterAlignment));
+        m_create_info.BufferCount = std::max(m_create_info.BufferCount, 2u);
+        m_synchronous = false;
+        if (const auto size_hint = m_create_info.SizeHint)
+        {
+            // A thread and a ring of buffers only pay off when writing overlaps filling the next buffer
+            m_synchronous = *size_hint <= m_create_info.BufferSize;
+            if (m_synchronous)
+            {
+                m_create_info.BufferSize =
+                    static_cast<u32>(Align(std::max<u64>(*size_hint, 1), kFileWriterAlignment));
+                m_create_info.BufferCount = 1;
+            }
+            else
+            {
+                const u64 buffers_needed = (*size_hint + m_create_info.BufferSize - 1) / m_create_info.BufferSize;
+                m_create_info.BufferCount =
+                    static_cast<u32>(std::clamp<u64>(buffers_needed, 2, m_create_info.BufferCount));
+            }
+        }
+        m_path = path;
+        m_write_path = m_create_info.Atomic ? m_path + ".tmp" : m_path;
+
+        DWORD flags = FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN;
+        if (m_create_info.Unbuffered)
+        {
+            // Unbuffered writes need sector aligned sizes and addresses, which the staging buffers guarantee
+            flags |= FILE_FLAG_NO_BUFFERING | FILE_FLAG_WRITE_THROUGH;
+        }
+        m_file = CreateFile(m_write_path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, flags, nullptr);
+        if (m_file == INVALID_HANDLE_VALUE)
+        {
+            Log::Error("FileWriter::Open Failed to open {}", m_write_path);
+            return false;
+        }
+
+        const u64 buffer_size = static_cast<u64>(m_create_info.BufferSize) * m_create_info.BufferCount;
+        m_buffer = static_cast<char*>(::operator new(buffer_size, std::align_val_t{kFileWriterAlignment}));
+        m_buffer_sizes.assign(m_create_info.BufferCount, 0);
+        m_head = 0;
+        m_tail = 0;
+        m_pending = 0;
+        m_fill = 0;
+        m_bytes_written = 0;
+        m_failed = false;
+        if (!m_synchronous)
+        {
+            m_thread = std::jthread([this](const std::stop_token& stop_token) { FlushThread(stop_token); });
+        }
+        return true;
+    }
+
+    bool FileWriter::Write(const void* data, const u64 size)
+    {
+        if (!IsOpen())
+        {
+            Log::Error("FileWriter::Write No file is open");
+            return false;
+        }
+
+        auto source = static_cast<const char*>(data);
+        u64 remaining = size;
+        while (remaining > 0)
+        {
+            const u64 count = std::min<u64>(m_create_info.BufferSize - m_fill, remaining);
+            char* destination = m_buffer + static_cast<u64>(m_head) * m_create_info.BufferSize + m_fill;
+            std::memcpy(destination, source, count);
+            m_fill += static_cast<u32>(count);
+            source += count;
+            remaining -= count;
+            if (m_fill == m_create_info.BufferSize)
+            {
+                SubmitBuffer();
+            }
+        }
+        m_bytes_written += size;
+        return !m_failed;
+    }
+
+    bool FileWriter::Commit()
+    {
+        if (!IsOpen())
+        {
+            Log::Error("FileWriter::Commit No file is open");
+            return false;
+        }
+
+        if (m_fill > 0)
+        {
+            SubmitBuffer();
+        }
+        if (m_thread.joinable())
+        {
+            {
+                std::unique_lock lock(m_mutex);
+                m_drained.wait(lock, [this] { return m_pending == 0; });
+            }
+            m_thread.request_stop();
+            m_thread.join();
+        }
+
+        bool success = !m_failed;
+        if (success && m_create_info.Unbuffered)
+        {
+            // The last buffer was padded to the sector size, so cut the file back to the real size
+            FILE_END_OF_FILE_INFO end_of_file{};
+            end_of_file.EndOfFile.QuadPart = static_cast<LONGLONG>(m_bytes_written);
+            success = SetFileInformationByHandle(m_file, FileEndOfFileInfo, &end_of_file, sizeof(end_of_file));
+        }
+        if (success)
+        {
+            success = FlushFileBuffers(m_file);
+        }
+        Close();
+
+        if (success && m_create_info.Atomic)
+        {
+            success = MoveFileEx(m_write_path.c_str(), m_path.c_str(),
+                                 MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+        }
+        if (!success)
+        {
+            Log::Error("FileWriter::Commit Failed to write {}", m_path);
+            if (m_create_info.Atomic)
+            {
+                DeleteFile(m_write_path.c_str());
+            }
+        }
+        return success;
+    }
+
+    void FileWriter::Abort()
+    {
+        if (!IsOpen())
+        {
+            return;
+        }
+
+        m_failed = true;
+        if (m_thread.joinable())
+        {
+            m_thread.request_stop();
+            m_thread.join();
+        }
+        Close();
+        if (m_create_info.Atomic)
+        {
+            DeleteFile(m_write_path.c_str());
+        }
+    }
+
+    void FileWriter::FlushThread(const std::stop_token& stop_token)
+    {
+        while (true)
+        {
+            std::unique_lock lock(m_mutex);
+            if (!m_submitted.wait(lock, stop_token, [this] { return m_pending > 0; }))
+            {
+                break;
+            }
+
+            // Every queued buffer up to the end of the ring is contiguous, so they go out in one write
+            const u32 start = m_tail;
+            const u32 count = std::min(m_pending, m_create_info.BufferCount - start);
+            u64 size = 0;
+            for (u32 i = start; i < start + count; ++i)
+            {
+                size += m_buffer_sizes[i];
+            }
+            lock.unlock();
+
+            if (!m_failed && !WriteToFile(m_buffer + static_cast<u64>(start) * m_create_info.BufferSize, size))
+            {
+                m_failed = true;
+            }
+
+            lock.lock();
+            m_tail = (start + count) % m_create_info.BufferCount;
+            m_pending -= count;
+            m_drained.notify_all();
+        }
+    }
+
+    void FileWriter::SubmitBuffer()
+    {
+        char* buffer = m_buffer + static_cast<u64>(m_head) * m_create_info.BufferSize;
+        u32 size = m_fill;
+        if (m_create_info.Unbuffered)
+        {
+            size = static_cast<u32>(Align(m_fill, kFileWriterAlignment));
+            std::memset(buffer + m_fill, 0, size - m_fill);
+        }
+        if (m_synchronous)
+        {
+            if (!m_failed && !WriteToFile(buffer, size))
+            {
+                m_failed = true;
+            }
+            m_fill = 0;
+            return;
+        }
+
+        std::unique_lock lock(m_mutex);
+        m_buffer_sizes[m_head] = size;
+        m_head = (m_head + 1) % m_create_info.BufferCount;
+        m_pending++;
+        m_fill = 0;
+        m_submitted.notify_one();
+        m_drained.wait(lock, [this] { return m_pending < m_create_info.BufferCount; });
+    }
+
+    bool FileWriter::WriteToFile(const char* data, u64 size)
+    {
+        while (size > 0)
+        {
+            constexpr u64 max_chunk = 1024 * 1024 * 1024;
+            const auto chunk = static_cast<DWORD>(std::min(size, max_chunk));
+            DWORD written = 0;
+            if (!WriteFile(m_file, data, chunk, &written, nullptr) || written != chunk)
+            {
+                return false;
+            }
+            data += written;
+            size -= written;
+        }
+        return true;
+    }
+
+    void FileWriter::Close()
+    {
+        CloseHandle(m_file);
+        m_file = INVALID_HANDLE_VALUE;
+        ::operator delete(m_buffer, std::align_val_t{kFileWriterAlignment});
+        m_buffer = nullptr;
+        m_buffer_sizes.clear();
+    }
+} // namespace FS
@@ -0,0 +1,106 @@
+#include "Core/JobSystem.hpp"
+
+namespace FS
+{
+    JobSystem::~JobSystem()
+    {
+        Shutdown();
+    }
+
+    void JobSystem::Init(u32 worker_count)
+    {
+        if (worker_count == 0)
+        {
+            worker_count = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+        }
+        m_workers.reserve(worker_count);
+        for (u32 i = 0; i < worker_count; ++i)
+        {
+            m_workers.emplace_back([this](const std::stop_token& stop_token) { WorkerThread(stop_token); });
+        }
+        Log::Info("Job System Initialized with {} workers", worker_count);
+    }
+
+    void JobSystem::Shutdown()
+    {
+        for (auto& worker : m_workers)
+        {
+            worker.request_stop();
+        }
+        m_job_available.notify_all();
+        m_workers.clear();
+
+        // Anything still queued has someone waiting on it
+        while (RunPendingJob())
+        {
+        }
+    }
+
+    void JobSystem::Submit(std::function<void()> job, JobCounter* counter)
+    {
+        if (counter)
+        {
+            counter->Pending.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Job queued{.Function = std::move(job), .Counter = counter};
+        if (m_workers.empty())
+        {
+            Run(queued);
+            return;
+        }
+        {
+            std::lock_guard lock(m_mutex);
+            m_jobs.push_back(std::move(queued));
+        }
+        m_job_available.notify_one();
+    }
+
+    void JobSystem::Wait(JobCounter& counter)
+    {
+        WaitUntil([&counter] { return counter.IsDone(); });
+    }
+
+    void JobSystem::WorkerThread(const std::stop_token& stop_token)
+    {
+        while (true)
+        {
+            Job job;
+            {
+                std::unique_lock lock(m_mutex);
+                if (!m_job_available.wait(lock, stop_token, [this] { return !m_jobs.empty(); }))
+                {
+                    return;
+                }
+                job = std::move(m_jobs.front());
+                m_jobs.pop_front();
+            }
+            Run(job);
+        }
+    }
+
+    bool JobSystem::RunPendingJob()
+    {
+        Job job;
+        {
+            std::lock_guard lock(m_mutex);
+            if (m_jobs.empty())
+            {
+                return false;
+            }
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+        Run(job);
+        return true;
+    }
+
+    void JobSystem::Run(Job& job)
+    {
+        job.Function();
+        if (job.Counter)
+        {
+            job.Counter->Pending.fetch_sub(1, std::memory_order_release);
+        }
+    }
+} // namespace FS
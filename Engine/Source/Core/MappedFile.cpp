@@ -0,0 +1,102 @@
+#include "Core/MappedFile.hpp"
+#include "Tools/Log.hpp"
+
+namespace FS
+{
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Close();
+            m_file = std::exchange(other.m_file, INVALID_HANDLE_VALUE);
+            m_mapping = std::exchange(other.m_mapping, nullptr);
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+        }
+        return *this;
+    }
+
+    bool MappedFile::Open(const std::string_view path)
+    {
+        Close();
+        const std::string path_string(path);
+        // Sharing delete lets the file be renamed or deleted while it is mapped, writing it fails until it's closed
+        m_file = CreateFile(path_string.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+        if (m_file == INVALID_HANDLE_VALUE)
+        {
+            Log::Error("File {} was not found!", path);
+            return false;
+        }
+
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(m_file, &size))
+        {
+            Log::Error("MappedFile::Open Failed to get the size of {}", path);
+            Close();
+            return false;
+        }
+        m_size = static_cast<u64>(size.QuadPart);
+        if (m_size == 0)
+        {
+            // Empty files can't be mapped, but they are still valid files
+            return true;
+        }
+
+        m_mapping = CreateFileMapping(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (m_mapping)
+        {
+            m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+        }
+        if (!m_data)
+        {
+            Log::Error("MappedFile::Open Failed to map {}", path);
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    void MappedFile::Prefetch(const u64 offset, const u64 size) const
+    {
+        if (!m_data || offset >= m_size)
+        {
+            return;
+        }
+        WIN32_MEMORY_RANGE_ENTRY range{
+            .VirtualAddress = const_cast<char*>(m_data + offset),
+            .NumberOfBytes = std::min(size, m_size - offset),
+        };
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_data)
+        {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping)
+        {
+            CloseHandle(m_mapping);
+        }
+        if (m_file != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(m_file);
+        }
+        m_file = INVALID_HANDLE_VALUE;
+        m_mapping = nullptr;
+        m_data = nullptr;
+        m_size = 0;
+    }
+} // namespace FS
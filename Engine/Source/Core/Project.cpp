@@ -1,21 +1,17 @@
 #include "Core/Project.hpp"
-#include "glaze/glaze.hpp"
+#include "Core/Serializer.hpp"
 
 namespace FS
 {
     bool Project::LoadProject(const std::filesystem::path& projectPath)
     {
-        const auto ec = glz::read_file_json(mProjectData.Info, projectPath.generic_string(), std::string{}).ec;
-        if (ec != glz::error_code::none)
+        if (!Serializer::ReadCooked(mProjectData.Info, projectPath.generic_string()))
         {
             Log::Error("Failed to load project");
             return false;
         }
 
-        mProjectData = ProjectData
-        {
-            .Path = projectPath.parent_path().string(),
-        };
+        mProjectData.Path = projectPath.parent_path().string();
         Log::Info("Loaded project: {}", mProjectData.Path);
         return true;
     }
@@ -29,8 +25,6 @@ namespace FS
 
         const std::string filePath = projectPath.string() + "/" + projectInfo.Name + ".proj";
 
-        const auto result = glz::write_file_json(projectInfo, filePath, std::string{});
-        return result.ec == glz::error_code::none;
+        return Serializer::Write(projectInfo, filePath, SerializeFormat::eJson);
     }
 }
-
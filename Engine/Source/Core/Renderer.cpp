@@ -1,7 +1,6 @@
 #include "Core/Renderer.hpp"
 #include "Core/Engine.hpp"
 #include "Core/Events.hpp"
-#include "Core/FileIO.hpp"
 #include "Core/Window.hpp"
 #include "Render/DX12/RenderBackendDX12.hpp"
 
@@ -9,10 +8,29 @@ void FS::Renderer::Init()
 {
     m_context = MakeScoped<RenderBackendDX12>();
     m_context->Init();
-
+    m_texture_streaming.Init(*m_context);
+
+    m_pipelines.Init(*m_context, "PipelineCache.bin");
+    m_pipeline_compiler.Init(m_pipelines, GEngine.Events());
+#ifdef FS_SHADER_SOURCE_DIR
+    // Only where the engine was built, the sources don't ship
+    m_hot_reload = std::filesystem::is_directory(FS_SHADER_SOURCE_DIR);
+    if (m_hot_reload)
+    {
+        m_shader_hot_reload.Init(m_pipeline_compiler, {
+            .SourceDirectory = FS_SHADER_SOURCE_DIR,
+            .OutputDirectory = "Shaders",
+        });
+    }
+#endif
+
+    // Pipelines compile in the background, draws using them are skipped until they are ready
+    if (m_shader_preloader.Init("Shaders/Shaders.fslib", m_hot_reload))
+    {
+        CreateTriangleShader();
+    }
     CreateRenderTextures();
     CreateMeshBuffers();
-    CreateTriangleShader();
 
     m_window_resize_listener = GEngine.Events().Subscribe<WindowResizeEvent>([this](const WindowResizeEvent&)
     {
@@ -26,32 +44,56 @@ void FS::Renderer::Init()
 
 void FS::Renderer::Update(float)
 {
+    m_texture_streaming.Update();
+    if (m_hot_reload)
+    {
+        m_shader_hot_reload.Update();
+    }
+    m_pipeline_compiler.Update();
+
     auto& [command, render_target, fenceValue] = m_context->GetFrameData();
 
     m_context->BeginCommand(command);
-    m_context->BindShader(command, m_triangle_shader);
+    constexpr VertexFormat vertex_format = VertexFormat::eFull;
+    constexpr auto permutation =
+        PermutationKey<GeomFeature>().With(GeomFeature::ePackedVertices, vertex_format == VertexFormat::ePacked);
+    const auto triangle_shader = m_pipeline_compiler.GetShader(m_triangle_shaders.Get(permutation));
     m_context->SetPrimitiveTopology(command, PrimitiveTopology::eTriangle);
     const Viewport viewport{.Dimensions = Window::GetWindowSize()};
     m_context->SetViewport(command, viewport);
     const Scissor scissor{.Max = Window::GetWindowSize()};
     m_context->SetScissor(command, scissor);
 
-    const RenderPassInfo renderPassInfo{
-        .RenderTargets = {render_target},
-        .ClearColor = glm::vec4(0.392f, 0.584f, 0.929f, 1.0f),
-    };
-    m_context->BeginRenderPass(command, renderPassInfo);
-    const struct PushConstant
+    m_render_graph.Reset();
+    const auto backbuffer =
+        m_render_graph.ImportTexture("Backbuffer", render_target, ResourceState::ePresent, ResourceState::ePresent);
+    m_render_graph.AddPass("Triangle", [&](const RenderGraphContext& context)
     {
-        u32 index = 0;
-    } pc{
-            .index = m_context->GetGPUAddress(m_vertex_buffer),
+        const RenderPassInfo renderPassInfo{
+            .RenderTargets = {context.Graph.GetTexture(backbuffer)},
+            .ClearColor = glm::vec4(0.392f, 0.584f, 0.929f, 1.0f),
         };
-    m_context->PushConstant(command, 1, &pc);
-
-    m_context->Draw(command, 3, 1, 0, 0);
-
-    m_context->EndRenderPass(command);
+        context.Backend.BeginRenderPass(context.Command, renderPassInfo);
+        if (triangle_shader != ShaderHandle::eNull)
+        {
+            context.Backend.BindShader(context.Command, triangle_shader);
+            // Laid out like PerDrawConstants in GeomVS, the quantization is only read by the packed vertex permutation
+            const struct PushConstant
+            {
+                glm::vec3 position_min = glm::vec3(0.0f);
+                u32 index = 0;
+                glm::vec3 position_scale = glm::vec3(0.0f);
+            } pc{
+                    .index = context.Backend.GetGPUAddress(m_vertex_buffer),
+                };
+            context.Backend.PushConstant(context.Command, sizeof(pc) / sizeof(u32), &pc);
+
+            context.Backend.Draw(context.Command, 3, 1, 0, 0);
+        }
+        context.Backend.EndRenderPass(context.Command);
+    }).Write(backbuffer);
+    m_render_graph.Compile();
+    m_render_graph.Execute(*m_context, command);
 
     m_context->EndCommand(command);
 
@@ -62,6 +104,16 @@ void FS::Renderer::Update(float)
 void FS::Renderer::Shutdown()
 {
     GEngine.Events().Unsubscribe<WindowResizeEvent>(m_window_resize_listener);
+    m_context->WaitForGPU();
+    m_texture_streaming.Shutdown();
+    m_render_graph.Shutdown(*m_context);
+    m_pipeline_compiler.Shutdown();
+    if (m_hot_reload)
+    {
+        m_shader_hot_reload.Shutdown();
+    }
+    m_shader_preloader.Shutdown();
+    m_pipelines.Shutdown();
     m_context->Shutdown();
 }
 
@@ -119,13 +171,27 @@ void FS::Renderer::CreateRenderTextures()
 
 void FS::Renderer::CreateTriangleShader()
 {
-    const GraphicsShaderCreateInfo shaderCreateInfo{
-        .VertexCode = FileIO::ReadBinaryFile("Shaders/GeomVS.cso"),
-        .FragmentCode = FileIO::ReadBinaryFile("Shaders/GeomPS.cso"),
-        .PrimitiveTopology = PrimitiveTopology::eTriangle,
-        .RenderTargetFormats = {Format::eB8G8R8A8_UNORM},
-        .NumRenderTargets = 1,
-        .DepthStencilFormat = Format::eUnknown,
-    };
-    m_triangle_shader = m_context->CreateShader(shaderCreateInfo, "Triangle Shader");
+    const auto pixel_code = m_shader_preloader.GetBytecode("GeomPS");
+    for (u32 key = 0; key < m_triangle_shaders.Count(); ++key)
+    {
+        const auto vertex_code = m_shader_preloader.GetBytecode("GeomVS", key);
+        if (vertex_code.empty() || pixel_code.empty())
+        {
+            continue;
+        }
+        const GraphicsShaderCreateInfo shaderCreateInfo{
+            .VertexCode = vertex_code,
+            .FragmentCode = pixel_code,
+            .PrimitiveTopology = PrimitiveTopology::eTriangle,
+            .RenderTargetFormats = {Format::eB8G8R8A8_UNORM},
+            .NumRenderTargets = 1,
+            .DepthStencilFormat = Format::eUnknown,
+        };
+        m_triangle_shaders[key] = m_pipeline_compiler.CreateShaderAsync(shaderCreateInfo, "Triangle Shader");
+        if (m_hot_reload)
+        {
+            m_shader_hot_reload.Track(m_triangle_shaders[key], shaderCreateInfo, "Triangle Shader",
+                                      {.Shader = "GeomVS", .Key = key}, {.Shader = "GeomPS"});
+        }
+    }
 }
@@ -0,0 +1,64 @@
+#include "Core/Serializer.hpp"
+#include "Core/FileWriter.hpp"
+
+namespace FS
+{
+    std::string Serializer::GetCookedPath(const std::string_view source_path)
+    {
+        return std::string(source_path) + ".bin";
+    }
+
+    Opt<SerializeHeader> Serializer::ReadHeader(const std::string_view buffer)
+    {
+        if (buffer.size() < sizeof(SerializeHeader))
+        {
+            return std::nullopt;
+        }
+        SerializeHeader header;
+        std::memcpy(&header, buffer.data(), sizeof(SerializeHeader));
+        if (header.Magic != SerializeHeader::kMagic)
+        {
+            return std::nullopt;
+        }
+        return header;
+    }
+
+    bool Serializer::IsCookedUpToDate(const std::string_view source_path, const std::string_view cooked_path,
+                                      const u32 version)
+    {
+        if (!FileIO::Exists(cooked_path))
+        {
+            return false;
+        }
+        // Shipped builds may only contain the cooked copy
+        if (FileIO::Exists(source_path) && FileIO::LastModified(cooked_path) < FileIO::LastModified(source_path))
+        {
+            return false;
+        }
+
+        std::ifstream file(cooked_path.data(), std::ios::binary);
+        std::array<char, sizeof(SerializeHeader)> buffer{};
+        if (!file.read(buffer.data(), buffer.size()))
+        {
+            return false;
+        }
+        const auto header = ReadHeader(std::string_view(buffer.data(), buffer.size()));
+        return header && header->Version == version;
+    }
+
+    bool Serializer::WriteFile(const std::string_view path, const SerializeHeader* header,
+                               const std::string_view payload)
+    {
+        FileWriter writer;
+        if (!writer.Open(path))
+        {
+            return false;
+        }
+        if (header)
+        {
+            writer.Write(header, sizeof(SerializeHeader));
+        }
+        writer.Write(payload);
+        return writer.Commit();
+    }
+} // namespace FS
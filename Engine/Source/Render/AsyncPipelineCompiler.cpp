@@ -0,0 +1,245 @@
+#include "Render/AsyncPipelineCompiler.hpp"
+#include "Core/Events.hpp"
+
+namespace FS
+{
+    void AsyncPipelineCompiler::Init(IPipelineCache& pipelines, Events& events, const u32 worker_count)
+    {
+        m_pipelines = &pipelines;
+        m_events = &events;
+        // Without workers the job system runs jobs inline, which would block the caller again
+        m_jobs.Init(std::max(worker_count, 1u));
+    }
+
+    void AsyncPipelineCompiler::Shutdown()
+    {
+        m_jobs.Wait(m_in_flight);
+        m_jobs.Shutdown();
+        Update();
+        for (const auto& pipeline : m_slots)
+        {
+            if (pipeline.State == PipelineState::eReady && !pipeline.Destroyed)
+            {
+                m_pipelines->Release(pipeline.Shader);
+            }
+        }
+        m_slots.clear();
+        m_free_slots.clear();
+        m_pending_count = 0;
+    }
+
+    PipelineHandle AsyncPipelineCompiler::CreateShaderAsync(const GraphicsShaderCreateInfo& create_info,
+                                                            std::string debug_name, const ShaderHandle fallback)
+    {
+        return Enqueue(create_info, std::move(debug_name), fallback);
+    }
+
+    PipelineHandle AsyncPipelineCompiler::CreateShaderAsync(const ComputeShaderCreateInfo& create_info,
+                                                            std::string debug_name, const ShaderHandle fallback)
+    {
+        return Enqueue(create_info, std::move(debug_name), fallback);
+    }
+
+    void AsyncPipelineCompiler::Reload(const PipelineHandle pipeline, const GraphicsShaderCreateInfo& create_info,
+                                       std::string debug_name)
+    {
+        ReloadPipeline(pipeline, create_info, std::move(debug_name));
+    }
+
+    void AsyncPipelineCompiler::Reload(const PipelineHandle pipeline, const ComputeShaderCreateInfo& create_info,
+                                       std::string debug_name)
+    {
+        ReloadPipeline(pipeline, create_info, std::move(debug_name));
+    }
+
+    void AsyncPipelineCompiler::Destroy(const PipelineHandle pipeline)
+    {
+        auto* slot = Find(pipeline);
+        if (!slot)
+        {
+            Log::Error("AsyncPipelineCompiler::Destroy Unknown pipeline {}", static_cast<u32>(pipeline));
+            return;
+        }
+        if (slot->State == PipelineState::eReady)
+        {
+            m_pipelines->Release(slot->Shader);
+        }
+        // Compiles still running for the slot finish with an older version and are dropped
+        ++slot->Version;
+        slot->Destroyed = true;
+        m_free_slots.push_back(static_cast<u32>(pipeline));
+    }
+
+    void AsyncPipelineCompiler::Update()
+    {
+        Vec<Completion> completed;
+        {
+            std::lock_guard lock(m_completed_mutex);
+            completed.swap(m_completed);
+        }
+
+        for (const auto& [handle, version, shader, reload, milliseconds] : completed)
+        {
+            --m_pending_count;
+            auto& slot = m_slots[static_cast<u32>(handle)];
+            const bool current = version == slot.Version;
+            if (reload)
+            {
+                if (!current)
+                {
+                    m_pipelines->CancelReload(*reload);
+                    continue;
+                }
+                const bool success = reload->Replacement != ShaderHandle::eNull;
+                if (!success)
+                {
+                    Log::Warn("AsyncPipelineCompiler::Update Pipeline {} failed to reload, keeping the previous one",
+                              static_cast<u32>(handle));
+                }
+                m_pipelines->CommitReload(*reload);
+                m_events->Broadcast(PipelineCompiledEvent{
+                    .Pipeline = handle,
+                    .Success = success,
+                    .Reloaded = true,
+                    .Milliseconds = milliseconds,
+                });
+                continue;
+            }
+
+            if (!current)
+            {
+                if (shader != ShaderHandle::eNull)
+                {
+                    m_pipelines->Release(shader);
+                }
+                continue;
+            }
+            const bool success = shader != ShaderHandle::eNull;
+            slot.Shader = shader;
+            slot.State = success ? PipelineState::eReady : PipelineState::eFailed;
+            if (!success)
+            {
+                Log::Warn("AsyncPipelineCompiler::Update Pipeline {} failed to compile", static_cast<u32>(handle));
+            }
+            m_events->Broadcast(PipelineCompiledEvent{
+                .Pipeline = handle,
+                .Success = success,
+                .Milliseconds = milliseconds,
+            });
+        }
+    }
+
+    ShaderHandle AsyncPipelineCompiler::GetShader(const PipelineHandle pipeline) const
+    {
+        const auto* slot = Find(pipeline);
+        if (!slot)
+        {
+            return ShaderHandle::eNull;
+        }
+        return slot->State == PipelineState::eReady ? slot->Shader : slot->Fallback;
+    }
+
+    PipelineState AsyncPipelineCompiler::GetState(const PipelineHandle pipeline) const
+    {
+        const auto* slot = Find(pipeline);
+        return slot ? slot->State : PipelineState::eFailed;
+    }
+
+    template <typename CreateInfo>
+    PipelineHandle AsyncPipelineCompiler::Enqueue(const CreateInfo& create_info, std::string debug_name,
+                                                  const ShaderHandle fallback)
+    {
+        u32 index;
+        if (m_free_slots.empty())
+        {
+            index = static_cast<u32>(m_slots.size());
+            m_slots.emplace_back();
+        }
+        else
+        {
+            index = m_free_slots.back();
+            m_free_slots.pop_back();
+        }
+        m_slots[index] = Pipeline{.Fallback = fallback, .Version = m_slots[index].Version};
+
+        const auto handle = static_cast<PipelineHandle>(index);
+        Compile(handle, create_info, std::move(debug_name));
+        return handle;
+    }
+
+    template <typename CreateInfo>
+    void AsyncPipelineCompiler::Compile(const PipelineHandle pipeline, const CreateInfo& create_info,
+                                        std::string debug_name)
+    {
+        const u32 version = ++m_slots[static_cast<u32>(pipeline)].Version;
+        ++m_pending_count;
+        m_jobs.Submit([this, pipeline, version, create_info, debug_name = std::move(debug_name)]
+        {
+            const auto start = std::chrono::steady_clock::now();
+            Complete({
+                .Pipeline = pipeline,
+                .Version = version,
+                .Shader = m_pipelines->Acquire(create_info, debug_name),
+            }, start);
+        }, &m_in_flight);
+    }
+
+    template <typename CreateInfo>
+    void AsyncPipelineCompiler::ReloadPipeline(const PipelineHandle pipeline, const CreateInfo& create_info,
+                                               std::string debug_name)
+    {
+        auto* slot = Find(pipeline);
+        if (!slot)
+        {
+            Log::Error("AsyncPipelineCompiler::Reload Unknown pipeline {}", static_cast<u32>(pipeline));
+            return;
+        }
+        if (slot->State != PipelineState::eReady)
+        {
+            // Nothing to swap yet, the compile of the previous create info is dropped
+            slot->State = PipelineState::ePending;
+            Compile(pipeline, create_info, std::move(debug_name));
+            return;
+        }
+
+        const u32 version = ++slot->Version;
+        ++m_pending_count;
+        m_jobs.Submit([this, pipeline, version, shader = slot->Shader, create_info, debug_name = std::move(debug_name)]
+        {
+            const auto start = std::chrono::steady_clock::now();
+            Complete({
+                .Pipeline = pipeline,
+                .Version = version,
+                .Reload = m_pipelines->PrepareReload(shader, create_info, debug_name),
+            }, start);
+        }, &m_in_flight);
+    }
+
+    void AsyncPipelineCompiler::Complete(Completion completion, const std::chrono::steady_clock::time_point start)
+    {
+        completion.Milliseconds =
+            std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::lock_guard lock(m_completed_mutex);
+        m_completed.push_back(std::move(completion));
+    }
+
+    AsyncPipelineCompiler::Pipeline* AsyncPipelineCompiler::Find(const PipelineHandle pipeline)
+    {
+        const auto index = static_cast<u32>(pipeline);
+        if (index >= m_slots.size() || m_slots[index].Destroyed)
+        {
+            return nullptr;
+        }
+        return &m_slots[index];
+    }
+
+    const AsyncPipelineCompiler::Pipeline* AsyncPipelineCompiler::Find(const PipelineHandle pipeline) const
+    {
+        const auto index = static_cast<u32>(pipeline);
+        if (index >= m_slots.size() || m_slots[index].Destroyed)
+        {
+            return nullptr;
+        }
+        return &m_slots[index];
+    }
+} // namespace FS
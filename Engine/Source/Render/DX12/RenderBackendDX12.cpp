@@ -21,6 +21,9 @@ void FS::RenderBackendDX12::Init()
 void FS::RenderBackendDX12::Shutdown()
 {
     WaitForGPU();
+    ReleaseRetiredPipelines(true);
+    ReleasePipelineLibraries();
+    ReleaseUploads();
 }
 
 void FS::RenderBackendDX12::Present()
@@ -39,6 +42,7 @@ void FS::RenderBackendDX12::Present()
     }
     m_frame_index = m_swap_chain->GetCurrentBackBufferIndex();
     GetFrameData().FenceValue++;
+    ReleaseRetiredPipelines(false);
 }
 
 void FS::RenderBackendDX12::WaitForGPU()
@@ -233,8 +237,9 @@ void FS::RenderBackendDX12::EndRenderPass(CommandHandle commandHandle)
 void FS::RenderBackendDX12::BindShader(CommandHandle commandHandle, ShaderHandle shaderHandle)
 {
     const auto& commandList = m_commands.at(static_cast<u32>(commandHandle)).CommandList;
-    const auto& shader = m_shaders.at(static_cast<u32>(shaderHandle));
-    commandList->SetPipelineState(shader);
+    // Compile threads may grow m_shaders meanwhile
+    std::lock_guard lock(m_shader_mutex);
+    commandList->SetPipelineState(m_shaders.at(static_cast<u32>(shaderHandle)));
 }
 
 void FS::RenderBackendDX12::ClearRenderTarget(CommandHandle command_handle, TextureHandle render_target_handle,
@@ -284,6 +289,14 @@ FS::TextureHandle FS::RenderBackendDX12::CreateTexture(const TextureCreateInfo c
     if (texture.ResourceHandle == ResourceHandle::eNull)
     {
         texture.ResourceHandle = CreateResource(m_texture_heap, create_info, debug_name);
+        if (texture.ResourceHandle == ResourceHandle::eNull)
+        {
+            return TextureHandle::eNull;
+        }
+        if (create_info.UploadInfo.Data)
+        {
+            UploadToTexture(texture.ResourceHandle, create_info.UploadInfo);
+        }
     }
     if (create_info.TextureFlags & TextureFlags::eRenderTexture)
     {
@@ -355,23 +368,34 @@ FS::BufferHandle FS::RenderBackendDX12::CreateBuffer(const BufferCreateInfo& cre
     buffer.ResourceHandle = create_info.ResourceHandle;
     if (create_info.ResourceHandle == ResourceHandle::eNull)
     {
-        DX12::Heap heap;
+        // Placing advances the offset of the heap itself, a copy would place every buffer at the same offset
+        DX12::Heap* heap = nullptr;
         switch (create_info.Type)
         {
         case BufferType::eStorage:
         case BufferType::eIndex:
-            heap = m_buffer_heap;
+            heap = &m_buffer_heap;
             break;
         case BufferType::eUniform:
             break;
         case BufferType::eStaging:
-            heap = m_upload_heap;
+            heap = &m_upload_heap;
             break;
         case BufferType::eReadback:
-            heap = m_readback_heap;
+            heap = &m_readback_heap;
             break;
         }
-        buffer.ResourceHandle = CreateResource(heap, create_info, debug_name);
+        if (!heap)
+        {
+            Log::Error("RenderContextDX12::CreateBuffer No heap for buffer type {} of {}",
+                       static_cast<u32>(create_info.Type), debug_name);
+            return BufferHandle::eNull;
+        }
+        buffer.ResourceHandle = CreateResource(*heap, create_info, debug_name);
+        if (buffer.ResourceHandle == ResourceHandle::eNull)
+        {
+            return BufferHandle::eNull;
+        }
     }
 
     buffer.BufferType = create_info.Type;
@@ -432,15 +456,26 @@ FS::ShaderHandle FS::RenderBackendDX12::CreateShader(const GraphicsShaderCreateI
     {
         desc.RTVFormats[i] = DX12::GetFormat(create_info.RenderTargetFormats[i]);
     }
-    ID3D12PipelineState* pipelineState;
-    const auto result = m_device->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&pipelineState));
-    DX12::ThrowIfFailed(result, "RenderContextDX12::CreateGraphicsShader Failed to create graphics pipeline");
-    const auto w_debug_name = std::wstring(debug_name.begin(), debug_name.end());
-    const auto nameResult = pipelineState->SetName(w_debug_name.c_str());
-    DX12::ThrowIfFailed(nameResult, "RenderContextDX12::CreateGraphicsShader Failed to name compute pipeline");
-    const auto shaderHandle = static_cast<ShaderHandle>(m_shaders.size());
-    m_shaders.emplace_back(pipelineState);
-    return shaderHandle;
+    ID3D12PipelineState* pipelineState = nullptr;
+    const auto pipeline_name = std::format(L"{:016X}", create_info.PipelineKey);
+    if (create_info.PipelineKey != 0 && m_pipeline_library &&
+        SUCCEEDED(m_pipeline_library->LoadGraphicsPipeline(pipeline_name.c_str(), &desc,
+                                                           IID_PPV_ARGS(&pipelineState))))
+    {
+        ++m_pipeline_library_hits;
+    }
+    else
+    {
+        // Mismatched or broken bytecode of a hot reload fails here, the caller keeps what it has
+        const auto result = m_device->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&pipelineState));
+        if (FAILED(result))
+        {
+            Log::Error("RenderContextDX12::CreateGraphicsShader Failed to create graphics pipeline {}", debug_name);
+            return ShaderHandle::eNull;
+        }
+    }
+    StorePipeline(create_info.PipelineKey, pipeline_name, pipelineState);
+    return AddShader(pipelineState, debug_name);
 }
 
 FS::ShaderHandle FS::RenderBackendDX12::CreateShader(const ComputeShaderCreateInfo& create_info,
@@ -454,15 +489,143 @@ FS::ShaderHandle FS::RenderBackendDX12::CreateShader(const ComputeShaderCreateIn
             create_info.ComputeCode.size(),
         },
     };
-    ID3D12PipelineState* pipelineState;
-    const auto result = m_device->CreateComputePipelineState(&desc, IID_PPV_ARGS(&pipelineState));
-    DX12::ThrowIfFailed(result, "RenderContextDX12::CreateComputeShader Failed to create compute pipeline");
-    const auto wDebugName = std::wstring(debug_name.begin(), debug_name.end());
-    const auto nameResult = pipelineState->SetName(wDebugName.c_str());
-    DX12::ThrowIfFailed(nameResult, "RenderContextDX12::CreateComputeShader Failed to name compute pipeline");
-    const auto shaderHandle = static_cast<ShaderHandle>(m_shaders.size());
-    m_shaders.emplace_back(pipelineState);
-    return shaderHandle;
+    ID3D12PipelineState* pipelineState = nullptr;
+    const auto pipeline_name = std::format(L"{:016X}", create_info.PipelineKey);
+    if (create_info.PipelineKey != 0 && m_pipeline_library &&
+        SUCCEEDED(m_pipeline_library->LoadComputePipeline(pipeline_name.c_str(), &desc,
+                                                          IID_PPV_ARGS(&pipelineState))))
+    {
+        ++m_pipeline_library_hits;
+    }
+    else
+    {
+        const auto result = m_device->CreateComputePipelineState(&desc, IID_PPV_ARGS(&pipelineState));
+        if (FAILED(result))
+        {
+            Log::Error("RenderContextDX12::CreateComputeShader Failed to create compute pipeline {}", debug_name);
+            return ShaderHandle::eNull;
+        }
+    }
+    StorePipeline(create_info.PipelineKey, pipeline_name, pipelineState);
+    return AddShader(pipelineState, debug_name);
+}
+
+void FS::RenderBackendDX12::StorePipeline(const u64 key, const std::wstring& name,
+                                          ID3D12PipelineState* pipeline_state) const
+{
+    if (key != 0 && m_new_pipeline_library)
+    {
+        // Only fails when the pipeline was stored before, by another thread or an earlier reload
+        m_new_pipeline_library->StorePipeline(name.c_str(), pipeline_state);
+    }
+}
+
+FS::ShaderHandle FS::RenderBackendDX12::AddShader(ID3D12PipelineState* pipeline_state,
+                                                  const std::string_view debug_name)
+{
+    const auto w_debug_name = std::wstring(debug_name.begin(), debug_name.end());
+    const auto name_result = pipeline_state->SetName(w_debug_name.c_str());
+    DX12::ThrowIfFailed(name_result, "RenderContextDX12::CreateShader Failed to name pipeline");
+
+    std::lock_guard lock(m_shader_mutex);
+    if (m_free_shaders.empty())
+    {
+        m_shaders.emplace_back(pipeline_state);
+        return static_cast<ShaderHandle>(m_shaders.size() - 1);
+    }
+    const auto handle = m_free_shaders.back();
+    m_free_shaders.pop_back();
+    m_shaders[static_cast<u32>(handle)] = pipeline_state;
+    return handle;
+}
+
+void FS::RenderBackendDX12::DestroyShader(const ShaderHandle shader_handle)
+{
+    std::lock_guard lock(m_shader_mutex);
+    auto& pipeline_state = m_shaders.at(static_cast<u32>(shader_handle));
+    pipeline_state->Release();
+    pipeline_state = nullptr;
+    m_free_shaders.push_back(shader_handle);
+}
+
+void FS::RenderBackendDX12::SwapShader(const ShaderHandle shader_handle, const ShaderHandle replacement_handle)
+{
+    std::lock_guard lock(m_shader_mutex);
+    auto& pipeline_state = m_shaders.at(static_cast<u32>(shader_handle));
+    auto& replacement = m_shaders.at(static_cast<u32>(replacement_handle));
+    // The frame being recorded may have bound it too, so it waits for every frame in flight
+    m_retired_pipelines.push_back({.PipelineState = pipeline_state, .FramesLeft = kFrameCount});
+    pipeline_state = std::exchange(replacement, nullptr);
+    m_free_shaders.push_back(replacement_handle);
+}
+
+void FS::RenderBackendDX12::ReleaseRetiredPipelines(const bool all)
+{
+    std::erase_if(m_retired_pipelines, [all](DX12::RetiredPipeline& retired)
+    {
+        if (!all && --retired.FramesLeft > 0)
+        {
+            return false;
+        }
+        retired.PipelineState->Release();
+        return true;
+    });
+}
+
+bool FS::RenderBackendDX12::LoadPipelineLibrary(const Span<const char> data)
+{
+    ReleasePipelineLibraries();
+    m_pipeline_library_hits = 0;
+    if (FAILED(m_device->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&m_new_pipeline_library))))
+    {
+        Log::Warn("RenderContextDX12::LoadPipelineLibrary Pipeline libraries are not supported");
+        m_new_pipeline_library = nullptr;
+        return data.empty();
+    }
+
+    m_pipeline_library_data.assign(data.begin(), data.end());
+    if (!m_pipeline_library_data.empty() &&
+        FAILED(m_device->CreatePipelineLibrary(m_pipeline_library_data.data(), m_pipeline_library_data.size(),
+                                               IID_PPV_ARGS(&m_pipeline_library))))
+    {
+        // Saved by another driver or for another device, every pipeline is created again
+        m_pipeline_library = nullptr;
+        m_pipeline_library_data.clear();
+        return false;
+    }
+    return true;
+}
+
+FS::Vec<char> FS::RenderBackendDX12::SavePipelineLibrary()
+{
+    if (!m_new_pipeline_library)
+    {
+        return {};
+    }
+    Vec<char> data(m_new_pipeline_library->GetSerializedSize());
+    const auto result = m_new_pipeline_library->Serialize(data.data(), data.size());
+    DX12::ThrowIfFailed(result, "RenderContextDX12::SavePipelineLibrary Failed to serialize the pipeline library");
+    return data;
+}
+
+u32 FS::RenderBackendDX12::GetPipelineLibraryHits() const
+{
+    return m_pipeline_library_hits;
+}
+
+void FS::RenderBackendDX12::ReleasePipelineLibraries()
+{
+    if (m_pipeline_library)
+    {
+        m_pipeline_library->Release();
+        m_pipeline_library = nullptr;
+    }
+    if (m_new_pipeline_library)
+    {
+        m_new_pipeline_library->Release();
+        m_new_pipeline_library = nullptr;
+    }
+    m_pipeline_library_data.clear();
 }
 
 void FS::RenderBackendDX12::DestroyTexture(TextureHandle texture_handle)
@@ -542,6 +705,124 @@ void FS::RenderBackendDX12::UploadToBuffer(BufferHandle buffer_handle,
     BaseResource->Unmap(0, nullptr);
 }
 
+void FS::RenderBackendDX12::UploadToTexture(const ResourceHandle resource_handle, const TextureUploadInfo& info)
+{
+    const auto& [BaseResource, ResourceState] = m_resources.at(static_cast<u32>(resource_handle));
+    const auto resource_desc = BaseResource->GetDesc();
+    const auto subresource_count = static_cast<u32>(info.Subresources.size());
+    Vec<D3D12_PLACED_SUBRESOURCE_FOOTPRINT> footprints(subresource_count);
+    u64 total_size = 0;
+    m_device->GetCopyableFootprints(&resource_desc, 0, subresource_count, 0, footprints.data(), nullptr, nullptr,
+                                    &total_size);
+    auto& upload = AcquireUpload(total_size);
+
+    // The cooked layout already uses the copy alignment, so this is one memcpy per subresource unless
+    // the driver asks for a wider pitch.
+    const auto* source = static_cast<const char*>(info.Data);
+    for (u32 i = 0; i < subresource_count; ++i)
+    {
+        const auto& subresource = info.Subresources[i];
+        const auto& footprint = footprints[i];
+        const u32 row_size = std::min(subresource.RowPitch, footprint.Footprint.RowPitch);
+        if (subresource.RowPitch == footprint.Footprint.RowPitch)
+        {
+            std::memcpy(upload.Mapped + footprint.Offset, source + subresource.Offset,
+                        static_cast<u64>(subresource.RowPitch) * subresource.RowCount);
+            continue;
+        }
+        for (u32 row = 0; row < subresource.RowCount; ++row)
+        {
+            std::memcpy(upload.Mapped + footprint.Offset + static_cast<u64>(row) * footprint.Footprint.RowPitch,
+                        source + subresource.Offset + static_cast<u64>(row) * subresource.RowPitch, row_size);
+        }
+    }
+
+    // Textures start in the common state, which the copy queue promotes to copy dest and decays back
+    // after the copy, so no barriers are needed here.
+    auto result = upload.CommandAllocator->Reset();
+    DX12::ThrowIfFailed(result, "RenderContextDX12::UploadToTexture Failed to reset command allocator");
+    result = upload.CommandList->Reset(upload.CommandAllocator, nullptr);
+    DX12::ThrowIfFailed(result, "RenderContextDX12::UploadToTexture Failed to reset command list");
+    for (u32 i = 0; i < subresource_count; ++i)
+    {
+        const CD3DX12_TEXTURE_COPY_LOCATION destination(BaseResource, i);
+        const CD3DX12_TEXTURE_COPY_LOCATION source_location(upload.Staging, footprints[i]);
+        upload.CommandList->CopyTextureRegion(&destination, 0, 0, 0, &source_location, nullptr);
+    }
+    result = upload.CommandList->Close();
+    DX12::ThrowIfFailed(result, "RenderContextDX12::UploadToTexture Failed to close command list");
+
+    ID3D12CommandList* lists[] = {upload.CommandList};
+    m_transfer_queue->ExecuteCommandLists(1, lists);
+    result = m_transfer_queue->Signal(m_transfer_fence, ++m_transfer_fence_value);
+    DX12::ThrowIfFailed(result, "RenderContextDX12::UploadToTexture Failed to signal transfer queue");
+    upload.FenceValue = m_transfer_fence_value;
+    // The graphics queue waits for the copy on the GPU, the CPU goes on with the next upload
+    result = m_graphics_queue->Wait(m_transfer_fence, m_transfer_fence_value);
+    DX12::ThrowIfFailed(result, "RenderContextDX12::UploadToTexture Failed to order the graphics queue");
+}
+
+FS::DX12::Upload& FS::RenderBackendDX12::AcquireUpload(const u64 size)
+{
+    // Staging buffers start large enough for most textures, so uploads rarely create one
+    constexpr u64 kMinStagingSize = 16ull * 1024 * 1024;
+    const u64 completed = m_transfer_fence->GetCompletedValue();
+    DX12::Upload* free_upload = nullptr;
+    for (auto& upload : m_uploads)
+    {
+        if (upload.FenceValue > completed)
+        {
+            continue;
+        }
+        if (upload.Size >= size)
+        {
+            return upload;
+        }
+        free_upload = &upload;
+    }
+
+    if (!free_upload)
+    {
+        free_upload = &m_uploads.emplace_back();
+        auto result = m_device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY,
+                                                       IID_PPV_ARGS(&free_upload->CommandAllocator));
+        DX12::ThrowIfFailed(result, "RenderContextDX12::AcquireUpload Failed to create command allocator");
+        result = m_device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_COPY, free_upload->CommandAllocator,
+                                             nullptr, IID_PPV_ARGS(&free_upload->CommandList));
+        DX12::ThrowIfFailed(result, "RenderContextDX12::AcquireUpload Failed to create command list");
+        result = free_upload->CommandList->Close();
+        DX12::ThrowIfFailed(result, "RenderContextDX12::AcquireUpload Failed to close command list");
+    }
+    else
+    {
+        // Too small for this texture, grown rather than adding another buffer
+        free_upload->Staging->Release();
+    }
+
+    free_upload->Size = std::max(size, kMinStagingSize);
+    const auto heap_properties = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+    const auto buffer_desc = CD3DX12_RESOURCE_DESC::Buffer(free_upload->Size);
+    auto result = m_device->CreateCommittedResource(&heap_properties, D3D12_HEAP_FLAG_NONE, &buffer_desc,
+                                                    D3D12_RESOURCE_STATE_GENERIC_READ, nullptr,
+                                                    IID_PPV_ARGS(&free_upload->Staging));
+    DX12::ThrowIfFailed(result, "RenderContextDX12::AcquireUpload Failed to create staging buffer");
+    constexpr D3D12_RANGE read_range{0, 0};
+    result = free_upload->Staging->Map(0, &read_range, reinterpret_cast<void**>(&free_upload->Mapped));
+    DX12::ThrowIfFailed(result, "RenderContextDX12::AcquireUpload Failed to map staging buffer");
+    return *free_upload;
+}
+
+void FS::RenderBackendDX12::ReleaseUploads()
+{
+    for (auto& upload : m_uploads)
+    {
+        upload.Staging->Release();
+        upload.CommandList->Release();
+        upload.CommandAllocator->Release();
+    }
+    m_uploads.clear();
+}
+
 void FS::RenderBackendDX12::ChooseGPU()
 {
     u32 flags = 0;
@@ -816,7 +1097,7 @@ void FS::RenderBackendDX12::CheckRebarSupport()
     }
 }
 
-FS::ResourceHandle FS::RenderBackendDX12::CreateResource(const DX12::Heap& heap, const TextureCreateInfo& create_info,
+FS::ResourceHandle FS::RenderBackendDX12::CreateResource(DX12::Heap& heap, const TextureCreateInfo& create_info,
                                                          const std::string_view debug_name)
 {
     D3D12_RESOURCE_FLAGS flags = {};
@@ -849,9 +1130,14 @@ FS::ResourceHandle FS::RenderBackendDX12::CreateResource(const DX12::Heap& heap,
     {
         resource_desc.Format = DXGI_FORMAT_R32_TYPELESS;
     }
+    const auto offset = AllocateFromHeap(heap, resource_desc, debug_name);
+    if (!offset)
+    {
+        return ResourceHandle::eNull;
+    }
     ID3D12Resource2* resource;
     const auto resource_result = m_device->CreatePlacedResource(heap.BaseHeap,
-                                                                heap.Offset,
+                                                                *offset,
                                                                 &resource_desc,
                                                                 D3D12_RESOURCE_STATE_COMMON,
                                                                 &clear_value,
@@ -880,21 +1166,38 @@ FS::ResourceHandle FS::RenderBackendDX12::CreateResource(DX12::Heap& heap, const
         .Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR,
         .Flags = D3D12_RESOURCE_FLAG_NONE,
     };
+    const auto offset = AllocateFromHeap(heap, resource_desc, debug_name);
+    if (!offset)
+    {
+        return ResourceHandle::eNull;
+    }
     ID3D12Resource2* resource;
     const auto resource_result = m_device->CreatePlacedResource(
-        heap.BaseHeap, heap.Offset, &resource_desc, D3D12_RESOURCE_STATE_COMMON, nullptr, IID_PPV_ARGS(&resource));
+        heap.BaseHeap, *offset, &resource_desc, D3D12_RESOURCE_STATE_COMMON, nullptr, IID_PPV_ARGS(&resource));
     const auto w_debug_name = std::wstring(debug_name.begin(), debug_name.end());
     DX12::ThrowIfFailed(resource_result, "RenderContextDX12::CreateResource Failed to create buffer resource");
 
-    const auto [SizeInBytes, Alignment] = m_device->GetResourceAllocationInfo(0, 1, &resource_desc);
-    const u64 aligned_offset = DX12::Align(heap.Offset, Alignment);
-    heap.Offset = aligned_offset + SizeInBytes;
-
     const auto handle = static_cast<ResourceHandle>(m_resources.size());
     m_resources.emplace_back(resource);
     return handle;
 }
 
+FS::Opt<u64> FS::RenderBackendDX12::AllocateFromHeap(DX12::Heap& heap, const D3D12_RESOURCE_DESC& resource_desc,
+                                                     const std::string_view debug_name) const
+{
+    const auto [SizeInBytes, Alignment] = m_device->GetResourceAllocationInfo(0, 1, &resource_desc);
+    const u64 offset = Align(heap.Offset, Alignment);
+    // An invalid desc reports a size of UINT64_MAX
+    if (SizeInBytes > heap.Size || offset > heap.Size - SizeInBytes)
+    {
+        Log::Error("RenderContextDX12::CreateResource Heap exhausted placing {}, {} bytes at offset {} of {}",
+                   debug_name, SizeInBytes, offset, heap.Size);
+        return std::nullopt;
+    }
+    heap.Offset = static_cast<u32>(offset + SizeInBytes);
+    return offset;
+}
+
 FS::DX12::Heap FS::RenderBackendDX12::CreateHeap(const D3D12_HEAP_TYPE type, const u32 size,
                                                  const std::string_view debug_name) const
 {
@@ -1019,7 +1322,7 @@ FS::DX12::Descriptor FS::RenderBackendDX12::CreateShaderResourceView(ResourceHan
                                                                      const TextureCreateInfo& create_info)
 {
     const auto& [BaseResource, ResourceState] = m_resources.at(static_cast<u32>(resource_handle));
-    const D3D12_SHADER_RESOURCE_VIEW_DESC view_desc = {
+    D3D12_SHADER_RESOURCE_VIEW_DESC view_desc = {
         .Format = DX12::GetFormat(create_info.Format),
         .ViewDimension = DX12::GetSRVDimension(create_info.ViewType),
         .Shader4ComponentMapping =
@@ -1031,6 +1334,17 @@ FS::DX12::Descriptor FS::RenderBackendDX12::CreateShaderResourceView(ResourceHan
             .ResourceMinLODClamp = 0,
         }
     };
+    if (create_info.ViewType == ViewType::eTexture2DArray)
+    {
+        view_desc.Texture2DArray = {
+            .MostDetailedMip = 0,
+            .MipLevels = create_info.MipLevels,
+            .FirstArraySlice = 0,
+            .ArraySize = create_info.Depth,
+            .PlaneSlice = 0,
+            .ResourceMinLODClamp = 0,
+        };
+    }
     const auto srv_descriptor = m_cbv_uav_srv_allocator.Allocate();
     m_device->CreateShaderResourceView(BaseResource, &view_desc, srv_descriptor.Cpu);
     return srv_descriptor;
@@ -1061,6 +1375,34 @@ FS::DX12::Descriptor FS::RenderBackendDX12::CreateDepthStencilView(ResourceHandl
     return dsv_descriptor;
 }
 
+void FS::RenderBackendDX12::Barrier(const CommandHandle command_handle, const Span<const ResourceBarrier> barriers)
+{
+    m_barriers.clear();
+    for (const auto& barrier : barriers)
+    {
+        const auto resource_handle = barrier.Texture != TextureHandle::eNull
+                                         ? m_textures.at(static_cast<u32>(barrier.Texture)).ResourceHandle
+                                         : m_buffers.at(static_cast<u32>(barrier.Buffer)).ResourceHandle;
+        // The tracked state is the truth, resources are also transitioned outside of batches
+        auto& [BaseResource, ResourceState] = m_resources.at(static_cast<u32>(resource_handle));
+        const auto new_state = DX12::GetResourceState(barrier.After);
+        if (ResourceState != new_state)
+        {
+            m_barriers.push_back(CD3DX12_RESOURCE_BARRIER::Transition(BaseResource, ResourceState, new_state));
+            ResourceState = new_state;
+        }
+        else if (barrier.Before == barrier.After && barrier.After == FS::ResourceState::eUnorderedAccess)
+        {
+            m_barriers.push_back(CD3DX12_RESOURCE_BARRIER::UAV(BaseResource));
+        }
+    }
+    if (!m_barriers.empty())
+    {
+        m_commands.at(static_cast<u32>(command_handle)).CommandList->ResourceBarrier(m_barriers.size(),
+                                                                                    m_barriers.data());
+    }
+}
+
 void FS::RenderBackendDX12::TransitionResource(CommandHandle command_handle, ResourceHandle resource_handle,
                                                const D3D12_RESOURCE_STATES new_state)
 {
@@ -0,0 +1,62 @@
+#include "Render/MeshletCulling.hpp"
+
+namespace FS
+{
+    Frustum Frustum::FromMatrix(const glm::mat4& view_projection)
+    {
+        // Gribb and Hartmann, the planes are sums of the rows of the matrix
+        const auto row = [&](const i32 index)
+        {
+            return glm::vec4(view_projection[0][index], view_projection[1][index], view_projection[2][index],
+                             view_projection[3][index]);
+        };
+        const glm::vec4 x = row(0);
+        const glm::vec4 y = row(1);
+        const glm::vec4 z = row(2);
+        const glm::vec4 w = row(3);
+
+        Frustum frustum;
+        frustum.Planes = {w + x, w - x, w + y, w - y, z, w - z};
+        for (auto& plane : frustum.Planes)
+        {
+            plane /= glm::length(glm::vec3(plane));
+        }
+        return frustum;
+    }
+
+    bool Frustum::IntersectsSphere(const glm::vec3 center, const f32 radius) const
+    {
+        return std::ranges::all_of(Planes, [&](const glm::vec4& plane)
+        {
+            return glm::dot(glm::vec3(plane), center) + plane.w >= -radius;
+        });
+    }
+
+    bool IsMeshletBackfacing(const MeshletBounds& bounds, const glm::vec3 camera_position)
+    {
+        const glm::vec3 view = bounds.Center - camera_position;
+        return glm::dot(view, bounds.ConeAxis) >= bounds.ConeCutoff * glm::length(view) + bounds.Radius;
+    }
+
+    MeshletCullStatistics CullMeshlets(const Span<const MeshletBounds> bounds, const Frustum& frustum,
+                                       const glm::vec3 camera_position, Vec<u32>* visible)
+    {
+        MeshletCullStatistics statistics{.MeshletCount = static_cast<u32>(bounds.size())};
+        for (u32 i = 0; i < bounds.size(); ++i)
+        {
+            if (!frustum.IntersectsSphere(bounds[i].Center, bounds[i].Radius))
+            {
+                ++statistics.FrustumCulled;
+            }
+            else if (IsMeshletBackfacing(bounds[i], camera_position))
+            {
+                ++statistics.ConeCulled;
+            }
+            else if (visible)
+            {
+                visible->push_back(i);
+            }
+        }
+        return statistics;
+    }
+} // namespace FS
@@ -0,0 +1,242 @@
+#include "Render/PipelineCache.hpp"
+#include "Core/FileIO.hpp"
+#include "Core/FileWriter.hpp"
+#include "Tools/ContentHash.hpp"
+
+namespace
+{
+    // Distinguishes graphics and compute keys of the same bytecode
+    constexpr u64 kGraphicsSeed = 0x47;
+    constexpr u64 kComputeSeed = 0x43;
+
+    void HashBytecode(FS::ContentHasher& hasher, const FS::Span<const char> bytecode)
+    {
+        hasher.Update(static_cast<u64>(bytecode.size()));
+        hasher.Update(bytecode.data(), bytecode.size());
+    }
+}
+
+namespace FS
+{
+    void PipelineCache::Init(IPipelineFactory& factory, const std::string_view path)
+    {
+        m_factory = &factory;
+        m_path = path;
+
+        const auto file = FileIO::Exists(path) ? FileIO::ReadBinaryFile(path) : Vec<char>();
+        const auto* header = reinterpret_cast<const PipelineCacheHeader*>(file.data());
+        const bool valid = file.size() >= sizeof(PipelineCacheHeader) && header->Magic == PipelineCacheHeader::kMagic &&
+                           header->Version == PipelineCacheHeader::kVersion &&
+                           file.size() - sizeof(PipelineCacheHeader) == header->LibrarySize;
+        if (!valid)
+        {
+            if (!file.empty())
+            {
+                Log::Warn("PipelineCache::Init Ignoring the invalid cache {}", path);
+            }
+            m_factory->LoadPipelineLibrary({});
+            return;
+        }
+
+        const Span<const char> library(file.data() + sizeof(PipelineCacheHeader), header->LibrarySize);
+        if (!m_factory->LoadPipelineLibrary(library))
+        {
+            // Another driver or device, every pipeline compiles again
+            Log::Info("PipelineCache::Init The pipeline library of {} is outdated", path);
+        }
+    }
+
+    void PipelineCache::Shutdown()
+    {
+        if (!m_path.empty() && !Save())
+        {
+            Log::Warn("PipelineCache::Shutdown Failed to write {}", m_path);
+        }
+        std::lock_guard lock(m_mutex);
+        for (const auto& [shader, key] : m_shader_keys)
+        {
+            m_factory->DestroyShader(shader);
+        }
+        m_shader_keys.clear();
+        m_entries.clear();
+    }
+
+    ShaderHandle PipelineCache::Acquire(const GraphicsShaderCreateInfo& create_info, const std::string_view debug_name)
+    {
+        return AcquireShader(create_info, debug_name);
+    }
+
+    ShaderHandle PipelineCache::Acquire(const ComputeShaderCreateInfo& create_info, const std::string_view debug_name)
+    {
+        return AcquireShader(create_info, debug_name);
+    }
+
+    void PipelineCache::Release(const ShaderHandle shader)
+    {
+        std::lock_guard lock(m_mutex);
+        const auto key = m_shader_keys.find(shader);
+        if (key == m_shader_keys.end())
+        {
+            Log::Error("PipelineCache::Release Unknown shader {}", static_cast<u32>(shader));
+            return;
+        }
+        const auto entry = m_entries.find(key->second);
+        if (--entry->second.References == 0)
+        {
+            m_factory->DestroyShader(shader);
+            m_entries.erase(entry);
+            m_shader_keys.erase(key);
+        }
+    }
+
+    PipelineReload PipelineCache::PrepareReload(const ShaderHandle shader, const GraphicsShaderCreateInfo& create_info,
+                                                const std::string_view debug_name)
+    {
+        return PrepareShaderReload(shader, create_info, debug_name);
+    }
+
+    PipelineReload PipelineCache::PrepareReload(const ShaderHandle shader, const ComputeShaderCreateInfo& create_info,
+                                                const std::string_view debug_name)
+    {
+        return PrepareShaderReload(shader, create_info, debug_name);
+    }
+
+    void PipelineCache::CommitReload(const PipelineReload& reload)
+    {
+        if (reload.Replacement == ShaderHandle::eNull)
+        {
+            return;
+        }
+        std::lock_guard lock(m_mutex);
+        const auto key = m_shader_keys.find(reload.Shader);
+        if (key == m_shader_keys.end())
+        {
+            Log::Error("PipelineCache::CommitReload Unknown shader {}", static_cast<u32>(reload.Shader));
+            m_factory->DestroyShader(reload.Replacement);
+            return;
+        }
+        m_factory->SwapShader(reload.Shader, reload.Replacement);
+        ++m_stats.Created;
+
+        // When another shader already has the new key this one stays under the old key, requests for either
+        // create info then get an up to date pipeline
+        if (!m_entries.contains(reload.Key))
+        {
+            auto entry = m_entries.extract(key->second);
+            entry.key() = reload.Key;
+            m_entries.insert(std::move(entry));
+            key->second = reload.Key;
+        }
+    }
+
+    void PipelineCache::CancelReload(const PipelineReload& reload)
+    {
+        if (reload.Replacement != ShaderHandle::eNull)
+        {
+            m_factory->DestroyShader(reload.Replacement);
+        }
+    }
+
+    bool PipelineCache::Save() const
+    {
+        // The library only holds the pipelines created this run, live ones included
+        const auto library = m_factory->SavePipelineLibrary();
+        const PipelineCacheHeader header{.LibrarySize = library.size()};
+        FileWriter writer;
+        if (!writer.Open(m_path))
+        {
+            return false;
+        }
+        writer.Write(&header, sizeof(header));
+        writer.Write(library);
+        return writer.Commit();
+    }
+
+    PipelineCacheStats PipelineCache::GetStats() const
+    {
+        std::lock_guard lock(m_mutex);
+        auto stats = m_stats;
+        stats.Persisted = m_factory->GetPipelineLibraryHits();
+        return stats;
+    }
+
+    u64 PipelineCache::GetKey(const GraphicsShaderCreateInfo& create_info)
+    {
+        // Only what shapes the pipeline, formats past NumRenderTargets are ignored like the backend does
+        ContentHasher hasher(kGraphicsSeed);
+        HashBytecode(hasher, create_info.VertexCode);
+        HashBytecode(hasher, create_info.FragmentCode);
+        hasher.Update(create_info.PrimitiveTopology);
+        hasher.Update(create_info.NumRenderTargets);
+        for (u32 i = 0; i < create_info.NumRenderTargets; ++i)
+        {
+            hasher.Update(create_info.RenderTargetFormats[i]);
+        }
+        hasher.Update(create_info.DepthStencilFormat);
+        hasher.Update(create_info.FillMode);
+        hasher.Update(create_info.CullMode);
+        hasher.Update(create_info.FrontFace);
+        return hasher.Finalize();
+    }
+
+    u64 PipelineCache::GetKey(const ComputeShaderCreateInfo& create_info)
+    {
+        ContentHasher hasher(kComputeSeed);
+        HashBytecode(hasher, create_info.ComputeCode);
+        return hasher.Finalize();
+    }
+
+    template <typename CreateInfo>
+    ShaderHandle PipelineCache::AcquireShader(CreateInfo create_info, const std::string_view debug_name)
+    {
+        const u64 key = GetKey(create_info);
+        std::unique_lock lock(m_mutex);
+        auto [it, inserted] = m_entries.try_emplace(key);
+        auto& entry = it->second;
+        ++entry.References;
+        if (!inserted)
+        {
+            ++m_stats.Deduplicated;
+            m_created.wait(lock, [&entry] { return entry.Created; });
+            const auto shader = entry.Shader;
+            if (shader == ShaderHandle::eNull && --entry.References == 0)
+            {
+                m_entries.erase(key);
+            }
+            return shader;
+        }
+
+        // Created outside the lock, other pipelines keep compiling in parallel
+        lock.unlock();
+        create_info.PipelineKey = key;
+        const auto shader = m_factory->CreateShader(create_info, debug_name);
+        lock.lock();
+        entry.Shader = shader;
+        entry.Created = true;
+        m_created.notify_all();
+        if (shader == ShaderHandle::eNull)
+        {
+            // The requests waiting for it fail too, the last one drops the entry so a later request tries again
+            if (--entry.References == 0)
+            {
+                m_entries.erase(key);
+            }
+            return shader;
+        }
+        m_shader_keys.emplace(shader, key);
+        ++m_stats.Created;
+        return shader;
+    }
+
+    template <typename CreateInfo>
+    PipelineReload PipelineCache::PrepareShaderReload(const ShaderHandle shader, CreateInfo create_info,
+                                                      const std::string_view debug_name)
+    {
+        create_info.PipelineKey = GetKey(create_info);
+        return {
+            .Shader = shader,
+            .Replacement = m_factory->CreateShader(create_info, debug_name),
+            .Key = create_info.PipelineKey,
+        };
+    }
+} // namespace FS
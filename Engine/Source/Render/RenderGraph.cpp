@@ -0,0 +1,471 @@
+#include "Render/RenderGraph.hpp"
+
+namespace
+{
+    FS::ResourceState CombineStates(const FS::ResourceState a, const FS::ResourceState b)
+    {
+        return static_cast<FS::ResourceState>(static_cast<u16>(a) | static_cast<u16>(b));
+    }
+}
+
+namespace FS
+{
+    RenderPassBuilder& RenderPassBuilder::Read(const RenderGraphResource resource, const ResourceState state)
+    {
+        m_graph.AddAccess(m_pass, resource, state, false);
+        return *this;
+    }
+
+    RenderPassBuilder& RenderPassBuilder::Write(const RenderGraphResource resource, const ResourceState state)
+    {
+        m_graph.AddAccess(m_pass, resource, state, true);
+        return *this;
+    }
+
+    RenderPassBuilder& RenderPassBuilder::SideEffect()
+    {
+        m_graph.m_passes[m_pass].SideEffect = true;
+        return *this;
+    }
+
+    void RenderGraph::Reset()
+    {
+        m_resources.clear();
+        m_accesses.clear();
+        m_passes.clear();
+        m_order.clear();
+        m_levels.clear();
+        m_barriers.clear();
+        m_final_barrier = 0;
+    }
+
+    void RenderGraph::Shutdown(IRenderBackend& backend)
+    {
+        for (const auto& texture : m_texture_pool)
+        {
+            backend.DestroyTexture(texture.Texture);
+        }
+        for (const auto& buffer : m_buffer_pool)
+        {
+            backend.DestroyBuffer(buffer.Buffer);
+        }
+        m_texture_pool.clear();
+        m_buffer_pool.clear();
+        Reset();
+    }
+
+    RenderGraphResource RenderGraph::ImportTexture(const std::string_view name, const TextureHandle texture,
+                                                   const ResourceState state, const ResourceState final_state)
+    {
+        m_resources.push_back({
+            .Name = name,
+            .Texture = texture,
+            .InitialState = state,
+            .FinalState = final_state,
+            .Imported = true,
+            .IsTexture = true,
+        });
+        return static_cast<RenderGraphResource>(m_resources.size() - 1);
+    }
+
+    RenderGraphResource RenderGraph::ImportBuffer(const std::string_view name, const BufferHandle buffer,
+                                                  const ResourceState state, const ResourceState final_state)
+    {
+        m_resources.push_back({
+            .Name = name,
+            .Buffer = buffer,
+            .InitialState = state,
+            .FinalState = final_state,
+            .Imported = true,
+        });
+        return static_cast<RenderGraphResource>(m_resources.size() - 1);
+    }
+
+    RenderGraphResource RenderGraph::CreateTexture(const std::string_view name, const RenderGraphTextureDesc& desc)
+    {
+        m_resources.push_back({.Name = name, .IsTexture = true, .TextureDesc = desc});
+        return static_cast<RenderGraphResource>(m_resources.size() - 1);
+    }
+
+    RenderGraphResource RenderGraph::CreateBuffer(const std::string_view name, const RenderGraphBufferDesc& desc)
+    {
+        m_resources.push_back({.Name = name, .BufferDesc = desc});
+        return static_cast<RenderGraphResource>(m_resources.size() - 1);
+    }
+
+    RenderPassBuilder RenderGraph::AddPass(const std::string_view name, RenderPassFunction function)
+    {
+        m_passes.push_back({
+            .Name = name,
+            .Function = std::move(function),
+            .FirstAccess = static_cast<u32>(m_accesses.size()),
+        });
+        return RenderPassBuilder(*this, static_cast<u32>(m_passes.size() - 1));
+    }
+
+    void RenderGraph::Compile()
+    {
+        m_tracking.assign(m_resources.size(), {});
+        CullPasses();
+        ScheduleLevels();
+        ComputeBarriers();
+    }
+
+    void RenderGraph::Execute(IRenderBackend& backend, const CommandHandle command)
+    {
+        ++m_frame;
+        AcquireTransients(backend);
+
+        const RenderGraphContext context{.Backend = backend, .Command = command, .Graph = *this};
+        for (const auto& level : m_levels)
+        {
+            RecordBarriers(backend, command,
+                           Span<const RenderGraphBarrier>(m_barriers).subspan(level.FirstBarrier, level.BarrierCount));
+            for (u32 i = level.FirstPass; i < level.FirstPass + level.PassCount; ++i)
+            {
+                if (const auto& pass = m_passes[m_order[i]]; pass.Function)
+                {
+                    pass.Function(context);
+                }
+            }
+        }
+        RecordBarriers(backend, command, GetFinalBarriers());
+
+        // The frames in flight may still use what was acquired up to kFrameCount frames ago
+        std::erase_if(m_texture_pool, [&](const PooledTexture& texture)
+        {
+            const bool stale = texture.LastFrame + kFrameCount < m_frame;
+            if (stale)
+            {
+                backend.DestroyTexture(texture.Texture);
+            }
+            return stale;
+        });
+        std::erase_if(m_buffer_pool, [&](const PooledBuffer& buffer)
+        {
+            const bool stale = buffer.LastFrame + kFrameCount < m_frame;
+            if (stale)
+            {
+                backend.DestroyBuffer(buffer.Buffer);
+            }
+            return stale;
+        });
+    }
+
+    TextureHandle RenderGraph::GetTexture(const RenderGraphResource resource) const
+    {
+        return m_resources[static_cast<u32>(resource)].Texture;
+    }
+
+    BufferHandle RenderGraph::GetBuffer(const RenderGraphResource resource) const
+    {
+        return m_resources[static_cast<u32>(resource)].Buffer;
+    }
+
+    Span<const RenderGraphBarrier> RenderGraph::GetFinalBarriers() const
+    {
+        return Span<const RenderGraphBarrier>(m_barriers).subspan(m_final_barrier);
+    }
+
+    RenderGraphStats RenderGraph::GetStats() const
+    {
+        return {
+            .PassCount = static_cast<u32>(m_passes.size()),
+            .CulledCount = static_cast<u32>(m_passes.size() - m_order.size()),
+            .LevelCount = static_cast<u32>(m_levels.size()),
+            .BarrierCount = static_cast<u32>(m_barriers.size()),
+        };
+    }
+
+    void RenderGraph::AddAccess(const u32 pass, const RenderGraphResource resource, const ResourceState state,
+                                const bool write)
+    {
+        if (pass + 1 != m_passes.size())
+        {
+            Log::Error("RenderGraph::AddAccess Pass {} declared an access after the next pass was added",
+                       m_passes[pass].Name);
+            return;
+        }
+        if (static_cast<u32>(resource) >= m_resources.size())
+        {
+            Log::Error("RenderGraph::AddAccess Pass {} accesses an unknown resource", m_passes[pass].Name);
+            return;
+        }
+        m_accesses.push_back({.Resource = static_cast<u32>(resource), .State = state, .Write = write});
+        ++m_passes[pass].AccessCount;
+    }
+
+    void RenderGraph::CullPasses()
+    {
+        const u32 pass_count = static_cast<u32>(m_passes.size());
+        m_live.assign(pass_count, 0);
+        m_producers.clear();
+        m_producer_offsets.resize(pass_count + 1);
+
+        // Only the writers a pass reads after or writes after keep it alive, a pass writing what an earlier pass
+        // read doesn't need that reader
+        for (u32 pass_index = 0; pass_index < pass_count; ++pass_index)
+        {
+            const auto& pass = m_passes[pass_index];
+            m_producer_offsets[pass_index] = static_cast<u32>(m_producers.size());
+            bool live = pass.SideEffect;
+            for (u32 i = pass.FirstAccess; i < pass.FirstAccess + pass.AccessCount; ++i)
+            {
+                const auto& access = m_accesses[i];
+                const auto& tracking = m_tracking[access.Resource];
+                if (tracking.Written)
+                {
+                    m_producers.push_back(tracking.LastWriter);
+                }
+                live |= access.Write && m_resources[access.Resource].Imported;
+            }
+            for (u32 i = pass.FirstAccess; i < pass.FirstAccess + pass.AccessCount; ++i)
+            {
+                if (const auto& access = m_accesses[i]; access.Write)
+                {
+                    m_tracking[access.Resource].LastWriter = pass_index;
+                    m_tracking[access.Resource].Written = true;
+                }
+            }
+            m_live[pass_index] = live;
+        }
+        m_producer_offsets[pass_count] = static_cast<u32>(m_producers.size());
+
+        // Producers always come earlier, so one backwards sweep reaches everything a live pass needs
+        for (u32 pass_index = pass_count; pass_index-- > 0;)
+        {
+            if (!m_live[pass_index])
+            {
+                continue;
+            }
+            for (u32 i = m_producer_offsets[pass_index]; i < m_producer_offsets[pass_index + 1]; ++i)
+            {
+                m_live[m_producers[i]] = 1;
+            }
+        }
+    }
+
+    void RenderGraph::ScheduleLevels()
+    {
+        const u32 pass_count = static_cast<u32>(m_passes.size());
+        m_pass_levels.assign(pass_count, 0);
+
+        // A pass runs a level after the last writer of what it touches, and a write also waits for the readers
+        // of the previous contents
+        u32 level_count = 0;
+        for (u32 pass_index = 0; pass_index < pass_count; ++pass_index)
+        {
+            if (!m_live[pass_index])
+            {
+                continue;
+            }
+            const auto& pass = m_passes[pass_index];
+            u32 level = 0;
+            for (u32 i = pass.FirstAccess; i < pass.FirstAccess + pass.AccessCount; ++i)
+            {
+                const auto& access = m_accesses[i];
+                const auto& tracking = m_tracking[access.Resource];
+                level = std::max(level, access.Write ? std::max(tracking.WriterLevel, tracking.ReaderLevel)
+                                                     : tracking.WriterLevel);
+            }
+            for (u32 i = pass.FirstAccess; i < pass.FirstAccess + pass.AccessCount; ++i)
+            {
+                const auto& access = m_accesses[i];
+                auto& tracking = m_tracking[access.Resource];
+                if (access.Write)
+                {
+                    tracking.WriterLevel = level + 1;
+                    tracking.ReaderLevel = 0;
+                }
+                else
+                {
+                    tracking.ReaderLevel = std::max(tracking.ReaderLevel, level + 1);
+                }
+            }
+            m_pass_levels[pass_index] = level;
+            level_count = std::max(level_count, level + 1);
+        }
+
+        // Counting sort by level, passes of a level keep the order they were added in
+        m_level_offsets.assign(level_count + 1, 0);
+        for (u32 pass_index = 0; pass_index < pass_count; ++pass_index)
+        {
+            if (m_live[pass_index])
+            {
+                ++m_level_offsets[m_pass_levels[pass_index] + 1];
+            }
+        }
+        m_levels.resize(level_count);
+        for (u32 level = 0; level < level_count; ++level)
+        {
+            m_levels[level] = {.FirstPass = m_level_offsets[level], .PassCount = m_level_offsets[level + 1]};
+            m_level_offsets[level + 1] += m_level_offsets[level];
+        }
+        m_order.resize(m_level_offsets[level_count]);
+        for (u32 pass_index = 0; pass_index < pass_count; ++pass_index)
+        {
+            if (m_live[pass_index])
+            {
+                m_order[m_level_offsets[m_pass_levels[pass_index]]++] = pass_index;
+            }
+        }
+    }
+
+    void RenderGraph::ComputeBarriers()
+    {
+        m_barriers.clear();
+        for (u32 i = 0; i < m_resources.size(); ++i)
+        {
+            auto& tracking = m_tracking[i];
+            tracking.State = m_resources[i].InitialState;
+            tracking.StateKnown = m_resources[i].Imported;
+            tracking.PendingLevel = std::numeric_limits<u32>::max();
+        }
+
+        for (u32 level_index = 0; level_index < m_levels.size(); ++level_index)
+        {
+            auto& level = m_levels[level_index];
+            // Passes of a level only share reads, which merge into one combined read state
+            m_touched.clear();
+            for (u32 order = level.FirstPass; order < level.FirstPass + level.PassCount; ++order)
+            {
+                const auto& pass = m_passes[m_order[order]];
+                for (u32 i = pass.FirstAccess; i < pass.FirstAccess + pass.AccessCount; ++i)
+                {
+                    const auto& access = m_accesses[i];
+                    auto& tracking = m_tracking[access.Resource];
+                    if (tracking.PendingLevel != level_index)
+                    {
+                        tracking.PendingLevel = level_index;
+                        tracking.PendingState = access.State;
+                        tracking.PendingWrite = access.Write;
+                        m_touched.push_back(access.Resource);
+                    }
+                    else if (access.Write)
+                    {
+                        tracking.PendingState = access.State;
+                        tracking.PendingWrite = true;
+                    }
+                    else if (!tracking.PendingWrite)
+                    {
+                        tracking.PendingState = CombineStates(tracking.PendingState, access.State);
+                    }
+                }
+            }
+
+            level.FirstBarrier = static_cast<u32>(m_barriers.size());
+            for (const u32 resource : m_touched)
+            {
+                auto& tracking = m_tracking[resource];
+                const auto handle = static_cast<RenderGraphResource>(resource);
+                if (!tracking.StateKnown || tracking.State != tracking.PendingState)
+                {
+                    m_barriers.push_back({
+                        .Resource = handle,
+                        .Before = tracking.State,
+                        .After = tracking.PendingState,
+                    });
+                }
+                else if (tracking.State == ResourceState::eUnorderedAccess && tracking.WrittenUnordered)
+                {
+                    m_barriers.push_back({.Resource = handle, .Before = tracking.State, .After = tracking.State});
+                }
+                tracking.State = tracking.PendingState;
+                tracking.StateKnown = true;
+                tracking.WrittenUnordered = tracking.PendingWrite && tracking.State == ResourceState::eUnorderedAccess;
+            }
+            level.BarrierCount = static_cast<u32>(m_barriers.size()) - level.FirstBarrier;
+        }
+
+        m_final_barrier = static_cast<u32>(m_barriers.size());
+        for (u32 i = 0; i < m_resources.size(); ++i)
+        {
+            if (const auto& resource = m_resources[i]; resource.Imported && m_tracking[i].State != resource.FinalState)
+            {
+                m_barriers.push_back({
+                    .Resource = static_cast<RenderGraphResource>(i),
+                    .Before = m_tracking[i].State,
+                    .After = resource.FinalState,
+                });
+            }
+        }
+    }
+
+    void RenderGraph::AcquireTransients(IRenderBackend& backend)
+    {
+        for (u32 i = 0; i < m_resources.size(); ++i)
+        {
+            // Transients no live pass touches keep their state unknown and are never created
+            auto& resource = m_resources[i];
+            if (resource.Imported || !m_tracking[i].StateKnown)
+            {
+                continue;
+            }
+            if (resource.IsTexture)
+            {
+                auto it = std::ranges::find_if(m_texture_pool, [&](const PooledTexture& texture)
+                {
+                    return texture.LastFrame != m_frame && texture.Desc == resource.TextureDesc;
+                });
+                if (it == m_texture_pool.end())
+                {
+                    const TextureCreateInfo create_info{
+                        .Dimensions = resource.TextureDesc.Dimensions,
+                        .Format = resource.TextureDesc.Format,
+                        .ViewType = ViewType::eTexture2D,
+                        .TextureFlags = resource.TextureDesc.Flags,
+                    };
+                    m_texture_pool.push_back({
+                        .Desc = resource.TextureDesc,
+                        .Texture = backend.CreateTexture(create_info, resource.Name),
+                    });
+                    it = m_texture_pool.end() - 1;
+                }
+                it->LastFrame = m_frame;
+                resource.Texture = it->Texture;
+            }
+            else
+            {
+                auto it = std::ranges::find_if(m_buffer_pool, [&](const PooledBuffer& buffer)
+                {
+                    return buffer.LastFrame != m_frame && buffer.Desc == resource.BufferDesc;
+                });
+                if (it == m_buffer_pool.end())
+                {
+                    const BufferCreateInfo create_info{
+                        .NumElements = resource.BufferDesc.NumElements,
+                        .Stride = resource.BufferDesc.Stride,
+                    };
+                    m_buffer_pool.push_back({
+                        .Desc = resource.BufferDesc,
+                        .Buffer = backend.CreateBuffer(create_info, resource.Name),
+                    });
+                    it = m_buffer_pool.end() - 1;
+                }
+                it->LastFrame = m_frame;
+                resource.Buffer = it->Buffer;
+            }
+        }
+    }
+
+    void RenderGraph::RecordBarriers(IRenderBackend& backend, const CommandHandle command,
+                                     const Span<const RenderGraphBarrier> barriers)
+    {
+        if (barriers.empty())
+        {
+            return;
+        }
+        m_backend_barriers.clear();
+        for (const auto& [resource, before, after] : barriers)
+        {
+            const auto& graph_resource = m_resources[static_cast<u32>(resource)];
+            m_backend_barriers.push_back({
+                .Texture = graph_resource.Texture,
+                .Buffer = graph_resource.Buffer,
+                .Before = before,
+                .After = after,
+            });
+        }
+        backend.Barrier(command, m_backend_barriers);
+    }
+} // namespace FS
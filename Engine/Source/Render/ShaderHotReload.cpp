@@ -0,0 +1,237 @@
+#include "Render/ShaderHotReload.hpp"
+#include "Asset/ShaderBuilder.hpp"
+#include "Core/FileIO.hpp"
+#include "Tools/ContentHash.hpp"
+
+namespace
+{
+    constexpr std::string_view kLibraryStem = "Shaders";
+    constexpr std::string_view kLibraryExtension = ".fslib";
+
+    // The build writes Shaders.fslib, hot reloads Shaders.<version>.fslib so they never write over each other
+    bool IsLibrary(const std::filesystem::path& path)
+    {
+        const auto stem = path.stem().string();
+        return path.extension().string() == kLibraryExtension &&
+               (stem == kLibraryStem || (stem.starts_with(kLibraryStem) && stem[kLibraryStem.size()] == '.'));
+    }
+
+    bool IsVersionedLibrary(const std::filesystem::path& path)
+    {
+        return IsLibrary(path) && path.stem().string() != kLibraryStem;
+    }
+
+    struct LibraryFile
+    {
+        std::filesystem::path Path;
+        std::filesystem::file_time_type Time;
+    };
+
+    FS::Opt<LibraryFile> FindNewestLibrary(const std::filesystem::path& directory)
+    {
+        FS::Opt<LibraryFile> newest;
+        std::error_code ec;
+        for (std::filesystem::directory_iterator it(directory, ec), end; it != end; it.increment(ec))
+        {
+            if (!it->is_regular_file(ec) || !IsLibrary(it->path()))
+            {
+                continue;
+            }
+            const auto time = it->last_write_time(ec);
+            if (!ec && (!newest || time > newest->Time))
+            {
+                newest = LibraryFile{.Path = it->path(), .Time = time};
+            }
+        }
+        return newest;
+    }
+
+    struct Permutation
+    {
+        FS::Span<const char> Bytecode;
+        u64 Hash = 0;
+    };
+
+    FS::Opt<Permutation> FindPermutation(const FS::ShaderLibraryView& library, const FS::ShaderPermutationRef& ref)
+    {
+        const auto* shader = library.FindShader(ref.Shader);
+        if (!shader)
+        {
+            return std::nullopt;
+        }
+        const Permutation permutation{
+            .Bytecode = library.GetPermutation(*shader, ref.Key),
+            .Hash = library.GetPermutationHash(*shader, ref.Key),
+        };
+        if (permutation.Bytecode.empty())
+        {
+            return std::nullopt;
+        }
+        return permutation;
+    }
+}
+
+namespace FS
+{
+    void ShaderHotReload::Init(AsyncPipelineCompiler& compiler, const ShaderHotReloadSettings& settings)
+    {
+        m_compiler = &compiler;
+        m_settings = settings;
+        const u32 worker_count = settings.WorkerCount != 0
+                                     ? settings.WorkerCount
+                                     : std::max(std::thread::hardware_concurrency() / 2, 1u);
+        m_jobs.Init(worker_count);
+
+        // Versions left by an earlier run are stale, the library loaded at startup is the baseline and only
+        // later writes reload pipelines
+        std::error_code ec;
+        for (std::filesystem::directory_iterator it(settings.OutputDirectory, ec), end; it != end; it.increment(ec))
+        {
+            if (IsVersionedLibrary(it->path()))
+            {
+                std::filesystem::remove(it->path(), ec);
+            }
+        }
+        const auto library = FindNewestLibrary(settings.OutputDirectory);
+        m_library_time = library ? library->Time : std::filesystem::file_time_type();
+        m_last_poll = std::chrono::steady_clock::now();
+        Log::Info("ShaderHotReload Watching {}", settings.SourceDirectory);
+    }
+
+    void ShaderHotReload::Shutdown()
+    {
+        m_jobs.Wait(m_poll);
+        m_jobs.Shutdown();
+        m_loaded.reset();
+        m_pipelines.clear();
+        m_libraries.clear();
+    }
+
+    void ShaderHotReload::Track(const PipelineHandle pipeline, const GraphicsShaderCreateInfo& create_info,
+                                std::string debug_name, ShaderPermutationRef vertex, ShaderPermutationRef fragment)
+    {
+        m_pipelines.push_back({
+            .Pipeline = pipeline,
+            .CreateInfo = create_info,
+            .DebugName = std::move(debug_name),
+            .Vertex = std::move(vertex),
+            .Fragment = std::move(fragment),
+            .VertexHash = HashContent(create_info.VertexCode),
+            .FragmentHash = HashContent(create_info.FragmentCode),
+        });
+    }
+
+    void ShaderHotReload::Update()
+    {
+        if (!m_poll.IsDone())
+        {
+            return;
+        }
+        if (m_loaded)
+        {
+            Apply(m_loaded);
+            m_loaded.reset();
+        }
+        if (m_libraries.size() > 1 && m_compiler->GetPendingCount() == 0)
+        {
+            m_libraries.erase(m_libraries.begin(), m_libraries.end() - 1);
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (std::chrono::duration<f32>(now - m_last_poll).count() < m_settings.PollSeconds)
+        {
+            return;
+        }
+        m_last_poll = now;
+        m_jobs.Submit([this] { Poll(); }, &m_poll);
+    }
+
+    void ShaderHotReload::Poll()
+    {
+        // Any source added, removed or written since the last poll changes the stamp
+        ContentHasher hasher;
+        std::error_code ec;
+        for (std::filesystem::recursive_directory_iterator it(m_settings.SourceDirectory, ec), end; it != end;
+             it.increment(ec))
+        {
+            const auto extension = it->path().extension();
+            if (it->is_regular_file(ec) && (extension == ".hlsl" || extension == ".hlsli"))
+            {
+                hasher.Update(it->path().generic_string());
+                hasher.Update(it->last_write_time(ec).time_since_epoch().count());
+            }
+        }
+        const std::filesystem::path output(m_settings.OutputDirectory);
+        if (const u64 stamp = hasher.Finalize(); stamp != m_source_stamp)
+        {
+            m_source_stamp = stamp;
+            ShaderBuilder builder(m_shader_compiler, m_jobs);
+            const auto shaders =
+                ShaderBuilder::FindShaders(m_settings.SourceDirectory, m_settings.OutputDirectory,
+                                           GetShaderPermutationUsage());
+            const auto library_name = std::format("{}.{}{}", kLibraryStem, ++m_library_version, kLibraryExtension);
+            const ShaderBuildSettings build_settings{
+                .CachePath = (output / "ShaderCache.bin").string(),
+                .LibraryPath = (output / library_name).string(),
+            };
+            const auto report = builder.Cook(shaders, build_settings);
+            if (report.CompiledCount > 0 || report.FailedCount > 0)
+            {
+                Log::Info("ShaderHotReload Compiled {} permutations in {:.1f}ms, {} failed", report.CompiledCount,
+                          report.Milliseconds, report.FailedCount);
+            }
+        }
+
+        // Also catches a library written by a build running next to the engine
+        const auto newest = FindNewestLibrary(output);
+        if (!newest || newest->Time <= m_library_time)
+        {
+            return;
+        }
+        m_library_time = newest->Time;
+        // Read rather than mapped, so the file stays free to be replaced or removed
+        auto library = MakeRef<Library>();
+        library->Data = FileIO::ReadBinaryFile(newest->Path.string());
+        const auto view = ShaderLibraryView::FromMemory(library->Data);
+        if (!view)
+        {
+            return;
+        }
+        library->View = *view;
+        m_loaded = std::move(library);
+
+        // Older versions are no longer needed, the bytecode in use lives in memory
+        if (!m_library_path.empty() && m_library_path != newest->Path && IsVersionedLibrary(m_library_path))
+        {
+            std::filesystem::remove(m_library_path, ec);
+        }
+        m_library_path = newest->Path;
+    }
+
+    void ShaderHotReload::Apply(const Ref<Library>& library)
+    {
+        u32 reloaded = 0;
+        for (auto& pipeline : m_pipelines)
+        {
+            // A shader missing from the library failed to cook, the pipeline keeps what it has
+            const auto vertex = FindPermutation(library->View, pipeline.Vertex);
+            const auto fragment = FindPermutation(library->View, pipeline.Fragment);
+            if (!vertex || !fragment ||
+                (vertex->Hash == pipeline.VertexHash && fragment->Hash == pipeline.FragmentHash))
+            {
+                continue;
+            }
+            pipeline.CreateInfo.VertexCode = vertex->Bytecode;
+            pipeline.CreateInfo.FragmentCode = fragment->Bytecode;
+            pipeline.VertexHash = vertex->Hash;
+            pipeline.FragmentHash = fragment->Hash;
+            m_compiler->Reload(pipeline.Pipeline, pipeline.CreateInfo, pipeline.DebugName);
+            ++reloaded;
+        }
+        if (reloaded > 0)
+        {
+            m_libraries.push_back(library);
+            Log::Info("ShaderHotReload Reloading {} pipelines", reloaded);
+        }
+    }
+} // namespace FS
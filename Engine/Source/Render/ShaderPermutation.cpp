@@ -0,0 +1,24 @@
+#include "Render/ShaderPermutation.hpp"
+
+namespace
+{
+    using GeomKey = FS::PermutationKey<FS::GeomFeature>;
+
+    // Keep in sync with the keys the renderer selects
+    constexpr FS::Array kGeomVSKeys = {
+        GeomKey().Value(),
+        GeomKey{FS::GeomFeature::ePackedVertices}.Value(),
+    };
+
+    constexpr FS::Array kShaderUsage = {
+        FS::ShaderPermutationUsage{.Shader = "GeomVS", .Keys = kGeomVSKeys},
+    };
+}
+
+namespace FS
+{
+    Span<const ShaderPermutationUsage> GetShaderPermutationUsage()
+    {
+        return kShaderUsage;
+    }
+} // namespace FS
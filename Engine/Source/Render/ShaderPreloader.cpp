@@ -0,0 +1,50 @@
+#include "Render/ShaderPreloader.hpp"
+#include "Core/FileIO.hpp"
+#include "Tools/Log.hpp"
+
+namespace FS
+{
+    bool ShaderPreloader::Init(const std::string_view library_path, const bool read_file)
+    {
+        if (read_file)
+        {
+            m_data = FileIO::Exists(library_path) ? FileIO::ReadBinaryFile(library_path) : Vec<char>();
+            if (m_data.empty())
+            {
+                Log::Error("ShaderPreloader::Init Failed to read {}", library_path);
+                return false;
+            }
+        }
+        else if (!m_file.Open(library_path))
+        {
+            Log::Error("ShaderPreloader::Init Failed to map {}", library_path);
+            return false;
+        }
+        const auto library = ShaderLibraryView::FromMemory(read_file ? Span<const char>(m_data) : m_file.GetSpan());
+        if (!library)
+        {
+            m_file.Close();
+            m_data.clear();
+            return false;
+        }
+        m_library = *library;
+        return true;
+    }
+
+    void ShaderPreloader::Shutdown()
+    {
+        m_library = {};
+        m_file.Close();
+        m_data.clear();
+    }
+
+    Span<const char> ShaderPreloader::GetBytecode(const std::string_view shader, const u32 key) const
+    {
+        const auto* library_shader = m_library.Header ? m_library.FindShader(shader) : nullptr;
+        if (!library_shader)
+        {
+            return {};
+        }
+        return m_library.GetPermutation(*library_shader, key);
+    }
+} // namespace FS
@@ -0,0 +1,352 @@
+#include "Render/TextureStreamer.hpp"
+
+namespace FS
+{
+    u16 GetRequiredMip(const glm::uvec2 dimensions, const f32 screen_size, const u16 mip_levels)
+    {
+        const u16 last_mip = mip_levels > 0 ? static_cast<u16>(mip_levels - 1) : 0;
+        if (screen_size <= 0.0f)
+        {
+            return last_mip;
+        }
+        const f32 ratio = static_cast<f32>(std::max(dimensions.x, dimensions.y)) / screen_size;
+        if (ratio <= 1.0f)
+        {
+            return 0;
+        }
+        return static_cast<u16>(std::min<f32>(std::floor(std::log2(ratio)), last_mip));
+    }
+
+    TextureStreamer::TextureStreamer(const TextureStreamerSettings& settings) : m_settings(settings)
+    {
+    }
+
+    StreamingTextureHandle TextureStreamer::Register(const StreamingTextureDesc& desc)
+    {
+        if (desc.MipSizes.empty())
+        {
+            return StreamingTextureHandle::eNull;
+        }
+
+        u32 index;
+        if (!m_free_entries.empty())
+        {
+            index = m_free_entries.back();
+            m_free_entries.pop_back();
+        }
+        else
+        {
+            index = static_cast<u32>(m_entries.size());
+            m_entries.emplace_back();
+        }
+
+        const auto mip_count = static_cast<u16>(desc.MipSizes.size());
+        auto& entry = m_entries[index];
+        entry = {};
+        entry.ChainSizes.resize(mip_count + 1);
+        for (u16 mip = mip_count; mip-- > 0;)
+        {
+            entry.ChainSizes[mip] = entry.ChainSizes[mip + 1] + desc.MipSizes[mip];
+        }
+        const u16 tail_count = std::clamp<u16>(desc.TailMipCount, 1, mip_count);
+        entry.TailMip = static_cast<u16>(mip_count - tail_count);
+        entry.ResidentMip = entry.TailMip;
+        entry.RequestedMip = entry.TailMip;
+        entry.Registered = true;
+        m_tail_size += entry.ChainSizes[entry.TailMip];
+        PushFront(index);
+        return static_cast<StreamingTextureHandle>(index);
+    }
+
+    void TextureStreamer::Unregister(const StreamingTextureHandle texture)
+    {
+        const auto index = static_cast<u32>(texture);
+        auto& entry = m_entries[index];
+        entry.Registered = false;
+        // The slot is reused once the load reports back, so a late CompleteLoad can't hit a new texture
+        if (!entry.Pending)
+        {
+            Release(index);
+        }
+    }
+
+    void TextureStreamer::Request(const StreamingTextureHandle texture, const u16 mip)
+    {
+        const auto index = static_cast<u32>(texture);
+        auto& entry = m_entries[index];
+        const u16 clamped = std::min(mip, entry.TailMip);
+        entry.RequestedMip = entry.LastUsedFrame == m_frame ? std::min(entry.RequestedMip, clamped) : clamped;
+        entry.LastUsedFrame = m_frame;
+        if (m_lru_head != index)
+        {
+            Unlink(index);
+            PushFront(index);
+        }
+    }
+
+    Vec<StreamingRequest> TextureStreamer::Update()
+    {
+        Vec<u32> candidates;
+        for (u32 index = m_lru_head; index != kNone; index = m_entries[index].Next)
+        {
+            const auto& entry = m_entries[index];
+            if (entry.Registered && entry.LastUsedFrame == m_frame && !entry.Pending &&
+                entry.RequestedMip < entry.ResidentMip)
+            {
+                candidates.push_back(index);
+            }
+        }
+
+        // Textures furthest from what they need go first, ties favor the cheaper load
+        std::ranges::sort(candidates, [this](const u32 a, const u32 b)
+        {
+            const auto& entry_a = m_entries[a];
+            const auto& entry_b = m_entries[b];
+            const u16 deficit_a = entry_a.ResidentMip - entry_a.RequestedMip;
+            const u16 deficit_b = entry_b.ResidentMip - entry_b.RequestedMip;
+            if (deficit_a != deficit_b)
+            {
+                return deficit_a > deficit_b;
+            }
+            return GetStreamedSize(entry_a, entry_a.RequestedMip) < GetStreamedSize(entry_b, entry_b.RequestedMip);
+        });
+
+        Vec<StreamingRequest> requests;
+        for (const u32 index : candidates)
+        {
+            if (m_pending_loads >= m_settings.MaxPendingLoads)
+            {
+                break;
+            }
+            auto& entry = m_entries[index];
+            // Settle for a coarser mip than requested when the full one doesn't fit
+            for (u16 mip = entry.RequestedMip; mip < entry.ResidentMip; ++mip)
+            {
+                const u64 size = entry.ChainSizes[mip] - entry.ChainSizes[entry.ResidentMip];
+                // The texture being replaced stays alive until the load completes
+                const u64 replaced_size = GetStreamedSize(entry, entry.ResidentMip);
+                if (MakeRoom(size, replaced_size, index))
+                {
+                    entry.LoadReplacedSize = replaced_size;
+                    m_replaced_size += replaced_size;
+                    entry.Pending = true;
+                    entry.PendingMip = mip;
+                    m_streamed_size += size;
+                    ++m_pending_loads;
+                    requests.push_back({
+                        .Texture = static_cast<StreamingTextureHandle>(index),
+                        .Action = StreamingAction::eLoad,
+                        .Mip = mip,
+                    });
+                    break;
+                }
+            }
+        }
+
+        for (u32 index = 0; index < m_entries.size(); ++index)
+        {
+            auto& entry = m_entries[index];
+            if (entry.Evicted)
+            {
+                entry.Evicted = false;
+                requests.push_back({
+                    .Texture = static_cast<StreamingTextureHandle>(index),
+                    .Action = StreamingAction::eEvict,
+                    .Mip = entry.ResidentMip,
+                });
+            }
+        }
+
+        ++m_frame;
+        return requests;
+    }
+
+    void TextureStreamer::CompleteLoad(const StreamingTextureHandle texture, const bool success)
+    {
+        const auto index = static_cast<u32>(texture);
+        auto& entry = m_entries[index];
+        if (!entry.Pending)
+        {
+            return;
+        }
+        entry.Pending = false;
+        --m_pending_loads;
+        if (success)
+        {
+            entry.ResidentMip = entry.PendingMip;
+        }
+        else
+        {
+            m_streamed_size -= entry.ChainSizes[entry.PendingMip] - entry.ChainSizes[entry.ResidentMip];
+            // Nothing replaces the texture after all
+            m_replaced_size -= entry.LoadReplacedSize;
+            entry.LoadReplacedSize = 0;
+        }
+        if (!entry.Registered)
+        {
+            Release(index);
+        }
+    }
+
+    u64 TextureStreamer::Retire(const StreamingTextureHandle texture, const u16 mip)
+    {
+        auto& entry = m_entries[static_cast<u32>(texture)];
+        const u64 size = GetStreamedSize(entry, std::min(mip, entry.TailMip));
+        // The evicted mips leave with the texture holding them, a texture created while a load is pending is
+        // the one the load replaces
+        m_replaced_size -= entry.ReplacedSize;
+        entry.ReplacedSize = 0;
+        if (!entry.Pending)
+        {
+            m_replaced_size -= entry.LoadReplacedSize;
+            entry.LoadReplacedSize = 0;
+        }
+        m_retired_size += size;
+        return size;
+    }
+
+    void TextureStreamer::FreeRetired(const u64 size)
+    {
+        m_retired_size -= size;
+    }
+
+    u16 TextureStreamer::GetResidentMip(const StreamingTextureHandle texture) const
+    {
+        return m_entries[static_cast<u32>(texture)].ResidentMip;
+    }
+
+    bool TextureStreamer::IsLoadPending(const StreamingTextureHandle texture) const
+    {
+        return m_entries[static_cast<u32>(texture)].Pending;
+    }
+
+    u64 TextureStreamer::GetStreamedSize(const Entry& entry, const u16 mip) const
+    {
+        return entry.ChainSizes[mip] - entry.ChainSizes[entry.TailMip];
+    }
+
+    u16 TextureStreamer::GetEvictionLimit(const Entry& entry) const
+    {
+        if (entry.Pending)
+        {
+            return entry.ResidentMip;
+        }
+        // Textures drawn this frame keep what they asked for, anything finer is fair game
+        return entry.LastUsedFrame == m_frame ? std::max(entry.ResidentMip, entry.RequestedMip) : entry.TailMip;
+    }
+
+    bool TextureStreamer::MakeRoom(const u64 size, const u64 replaced_size, const u32 requester)
+    {
+        // The new texture lives next to the one it replaces for a while, and evicted and replaced textures free
+        // their memory a few frames later, the load waits until they did
+        const auto fits = [this, size, replaced_size]
+        {
+            return m_streamed_size + m_replaced_size + m_retired_size + size + replaced_size <= m_settings.Budget;
+        };
+        if (m_streamed_size + size <= m_settings.Budget)
+        {
+            return fits();
+        }
+        const u64 needed = m_streamed_size + size - m_settings.Budget;
+
+        // Drop the finest mips first so a texture only loses what the load needs
+        const auto eviction_target = [this](const Entry& entry, const u64 still_needed)
+        {
+            const u16 limit = GetEvictionLimit(entry);
+            u16 mip = entry.ResidentMip;
+            while (mip < limit && entry.ChainSizes[entry.ResidentMip] - entry.ChainSizes[mip] < still_needed)
+            {
+                ++mip;
+            }
+            return mip;
+        };
+        // The texture stays alive until the smaller one replacing it is created, so the first eviction adds the
+        // replacement's size on top, an eviction that doesn't fit that is skipped
+        const auto eviction_cost = [this](const Entry& entry, const u16 mip) -> u64
+        {
+            return entry.ReplacedSize == 0 && mip > entry.ResidentMip ? GetStreamedSize(entry, mip) : 0;
+        };
+        const u64 used = m_streamed_size + m_replaced_size + m_retired_size;
+
+        // Check first so a load that can't fit doesn't evict anything
+        u64 available = 0;
+        u64 reserved = 0;
+        for (u32 index = m_lru_tail; index != kNone && available < needed; index = m_entries[index].Prev)
+        {
+            const auto& entry = m_entries[index];
+            if (index == requester)
+            {
+                continue;
+            }
+            const u16 mip = eviction_target(entry, needed - available);
+            const u64 cost = eviction_cost(entry, mip);
+            if (used + reserved + cost <= m_settings.Budget)
+            {
+                reserved += cost;
+                available += entry.ChainSizes[entry.ResidentMip] - entry.ChainSizes[mip];
+            }
+        }
+        if (available < needed)
+        {
+            return false;
+        }
+
+        u64 freed = 0;
+        reserved = 0;
+        for (u32 index = m_lru_tail; index != kNone && freed < needed; index = m_entries[index].Prev)
+        {
+            auto& entry = m_entries[index];
+            if (index == requester)
+            {
+                continue;
+            }
+            const u16 mip = eviction_target(entry, needed - freed);
+            const u64 cost = eviction_cost(entry, mip);
+            if (mip == entry.ResidentMip || used + reserved + cost > m_settings.Budget)
+            {
+                continue;
+            }
+            if (entry.ReplacedSize == 0)
+            {
+                entry.ReplacedSize = GetStreamedSize(entry, entry.ResidentMip);
+                m_replaced_size += entry.ReplacedSize;
+            }
+            const u64 mip_size = entry.ChainSizes[entry.ResidentMip] - entry.ChainSizes[mip];
+            reserved += cost;
+            freed += mip_size;
+            m_streamed_size -= mip_size;
+            entry.ResidentMip = mip;
+            entry.Evicted = true;
+        }
+        return fits();
+    }
+
+    void TextureStreamer::Release(const u32 index)
+    {
+        auto& entry = m_entries[index];
+        m_streamed_size -= GetStreamedSize(entry, entry.ResidentMip);
+        m_replaced_size -= entry.ReplacedSize + entry.LoadReplacedSize;
+        m_tail_size -= entry.ChainSizes[entry.TailMip];
+        Unlink(index);
+        entry = {};
+        m_free_entries.push_back(index);
+    }
+
+    void TextureStreamer::Unlink(const u32 index)
+    {
+        auto& entry = m_entries[index];
+        (entry.Prev != kNone ? m_entries[entry.Prev].Next : m_lru_head) = entry.Next;
+        (entry.Next != kNone ? m_entries[entry.Next].Prev : m_lru_tail) = entry.Prev;
+        entry.Prev = kNone;
+        entry.Next = kNone;
+    }
+
+    void TextureStreamer::PushFront(const u32 index)
+    {
+        auto& entry = m_entries[index];
+        entry.Prev = kNone;
+        entry.Next = m_lru_head;
+        (m_lru_head != kNone ? m_entries[m_lru_head].Prev : m_lru_tail) = index;
+        m_lru_head = index;
+    }
+} // namespace FS
@@ -0,0 +1,210 @@
+#include "Render/TextureStreamingManager.hpp"
+#include "Core/Engine.hpp"
+#include "Core/FileIO.hpp"
+#include "Tools/Log.hpp"
+
+namespace FS
+{
+    void TextureStreamingManager::Init(IRenderBackend& backend, const TextureStreamerSettings& settings)
+    {
+        m_backend = &backend;
+        m_streamer = TextureStreamer(settings);
+    }
+
+    void TextureStreamingManager::Shutdown()
+    {
+        GEngine.Jobs().Wait(m_reads);
+        m_completed.clear();
+        for (const auto& texture : m_textures)
+        {
+            if (texture.Handle != TextureHandle::eNull)
+            {
+                m_backend->DestroyTexture(texture.Handle);
+            }
+        }
+        for (const auto& retired : m_retired)
+        {
+            m_backend->DestroyTexture(retired.Handle);
+        }
+        m_textures.clear();
+        m_retired.clear();
+        m_streamer = TextureStreamer();
+    }
+
+    StreamingTextureHandle TextureStreamingManager::Load(const std::string_view path)
+    {
+        CookedTextureHeader header;
+        if (!FileIO::ReadFileRange(path, 0, Span<char>(reinterpret_cast<char*>(&header), sizeof(header))))
+        {
+            return StreamingTextureHandle::eNull;
+        }
+        if (header.Magic != CookedTextureHeader::kMagic || header.Version != CookedTextureHeader::kVersion ||
+            header.Depth != 1 || header.SubresourceCount == 0 || header.SubresourceCount != header.MipLevels)
+        {
+            Log::Error("TextureStreamingManager::Load {} is not a streamable cooked texture", path);
+            return StreamingTextureHandle::eNull;
+        }
+
+        Vec<TextureSubresource> subresources(header.SubresourceCount);
+        const u64 table_size = subresources.size() * sizeof(TextureSubresource);
+        if (!FileIO::ReadFileRange(path, sizeof(header), Span<char>(reinterpret_cast<char*>(subresources.data()),
+                                                                     table_size)))
+        {
+            return StreamingTextureHandle::eNull;
+        }
+
+        Vec<u64> mip_sizes(header.MipLevels);
+        u16 tail_mip_count = 0;
+        for (u16 mip = 0; mip < header.MipLevels; ++mip)
+        {
+            const u64 next = mip + 1 < header.MipLevels ? GetMipTailSize(subresources, mip + 1) : 0;
+            mip_sizes[mip] = GetMipTailSize(subresources, mip) - next;
+            if (std::max(subresources[mip].Width, subresources[mip].Height) <= kMipTailDimension)
+            {
+                ++tail_mip_count;
+            }
+        }
+
+        const auto handle = m_streamer.Register({.MipSizes = mip_sizes, .TailMipCount = tail_mip_count});
+        const auto index = static_cast<u32>(handle);
+        if (index >= m_textures.size())
+        {
+            m_textures.resize(index + 1);
+        }
+        auto& texture = m_textures[index];
+        texture.Path = path;
+        texture.Header = header;
+        texture.Subresources = std::move(subresources);
+
+        // The tail is read right away, so the texture can be drawn at a low resolution from the first frame
+        const u16 tail_mip = m_streamer.GetResidentMip(handle);
+        Vec<char> data(GetMipTailSize(texture.Subresources, tail_mip));
+        if (!FileIO::ReadFileRange(path, header.DataOffset, data))
+        {
+            Unload(handle);
+            return StreamingTextureHandle::eNull;
+        }
+        Recreate(handle, tail_mip, data);
+        return handle;
+    }
+
+    void TextureStreamingManager::Unload(const StreamingTextureHandle texture)
+    {
+        auto& entry = m_textures[static_cast<u32>(texture)];
+        Retire(texture, entry);
+        entry.Path.clear();
+        entry.Subresources.clear();
+        entry.Handle = TextureHandle::eNull;
+        ++entry.Generation;
+        m_streamer.Unregister(texture);
+    }
+
+    void TextureStreamingManager::Request(const StreamingTextureHandle texture, const f32 screen_size)
+    {
+        const auto& header = m_textures[static_cast<u32>(texture)].Header;
+        m_streamer.Request(texture, GetRequiredMip({header.Width, header.Height}, screen_size, header.MipLevels));
+    }
+
+    void TextureStreamingManager::Update()
+    {
+        ++m_frame;
+
+        Vec<CompletedRead> completed;
+        {
+            std::lock_guard lock(m_completed_mutex);
+            std::swap(completed, m_completed);
+        }
+        for (const auto& read : completed)
+        {
+            const auto& texture = m_textures[static_cast<u32>(read.Texture)];
+            const bool current = read.Generation == texture.Generation;
+            if (read.Action == StreamingAction::eLoad)
+            {
+                m_streamer.CompleteLoad(read.Texture, read.Success && current);
+            }
+            // A read is stale once the resident mips moved on, e.g. an eviction overtaken by a load
+            if (current && read.Success && m_streamer.GetResidentMip(read.Texture) == read.Mip)
+            {
+                Recreate(read.Texture, read.Mip, read.Data);
+            }
+        }
+
+        for (const auto& request : m_streamer.Update())
+        {
+            Read(request.Texture, request.Action, request.Mip);
+        }
+
+        // The frames in flight may still sample replaced textures
+        std::erase_if(m_retired, [this](const RetiredTexture& retired)
+        {
+            if (m_frame - retired.Frame < kFrameCount)
+            {
+                return false;
+            }
+            m_backend->DestroyTexture(retired.Handle);
+            m_streamer.FreeRetired(retired.StreamedSize);
+            return true;
+        });
+    }
+
+    TextureHandle TextureStreamingManager::GetTexture(const StreamingTextureHandle texture) const
+    {
+        return m_textures[static_cast<u32>(texture)].Handle;
+    }
+
+    void TextureStreamingManager::Read(const StreamingTextureHandle texture, const StreamingAction action,
+                                       const u16 mip)
+    {
+        const auto& entry = m_textures[static_cast<u32>(texture)];
+        GEngine.Jobs().Submit([this, texture, action, mip, generation = entry.Generation, path = entry.Path,
+                                  offset = entry.Header.DataOffset, size = GetMipTailSize(entry.Subresources, mip)]
+        {
+            CompletedRead read{
+                .Texture = texture,
+                .Generation = generation,
+                .Action = action,
+                .Mip = mip,
+                .Data = Vec<char>(size),
+            };
+            read.Success = FileIO::ReadFileRange(path, offset, read.Data);
+
+            std::lock_guard lock(m_completed_mutex);
+            m_completed.push_back(std::move(read));
+        }, &m_reads);
+    }
+
+    void TextureStreamingManager::Recreate(const StreamingTextureHandle handle, const u16 mip, const Vec<char>& data)
+    {
+        auto& texture = m_textures[static_cast<u32>(handle)];
+        // Offsets are relative to the start of the data, so a prefix holding mip and everything smaller
+        // uploads as is
+        const Span<const TextureSubresource> subresources = Span<const TextureSubresource>(texture.Subresources)
+            .subspan(mip);
+        const auto& top = subresources.front();
+        const TextureCreateInfo create_info{
+            .Dimensions = {top.Width, top.Height},
+            .MipLevels = static_cast<u16>(texture.Header.MipLevels - mip),
+            .Format = texture.Header.Format,
+            .ViewType = ViewType::eTexture2D,
+            .TextureFlags = TextureFlags::eShaderResource,
+            .UploadInfo = {.Data = data.data(), .Subresources = subresources},
+        };
+        Retire(handle, texture);
+        texture.Handle = m_backend->CreateTexture(create_info, texture.Path);
+        texture.Mip = mip;
+    }
+
+    void TextureStreamingManager::Retire(const StreamingTextureHandle handle, Texture& texture)
+    {
+        if (texture.Handle == TextureHandle::eNull)
+        {
+            return;
+        }
+        m_retired.push_back({
+            .Handle = texture.Handle,
+            .Frame = m_frame,
+            .StreamedSize = m_streamer.Retire(handle, texture.Mip),
+        });
+        texture.Handle = TextureHandle::eNull;
+    }
+} // namespace FS
@@ -0,0 +1,136 @@
+#include "Render/TransientAliasing.hpp"
+#include "Tools/Tools.hpp"
+
+namespace
+{
+    struct MemoryRange
+    {
+        u64 Begin = 0;
+        u64 End = 0;
+    };
+
+    bool LifetimesOverlap(const FS::TransientResourceDesc& a, const FS::TransientResourceDesc& b)
+    {
+        return a.FirstPass <= b.LastPass && b.FirstPass <= a.LastPass;
+    }
+
+    u64 GetAlignment(const FS::TransientResourceDesc& resource)
+    {
+        return std::max<u64>(resource.Alignment, 1);
+    }
+
+    // Sweep over the passes where resources start and stop being used
+    u64 ComputePeakLiveSize(const FS::Span<const FS::TransientResourceDesc> resources)
+    {
+        FS::Vec<std::pair<u64, i64>> events;
+        events.reserve(resources.size() * 2);
+        for (const auto& resource : resources)
+        {
+            events.emplace_back(resource.FirstPass, static_cast<i64>(resource.Size));
+            events.emplace_back(static_cast<u64>(resource.LastPass) + 1, -static_cast<i64>(resource.Size));
+        }
+        // Releases sort before acquires of the same pass
+        std::ranges::sort(events);
+        i64 live = 0;
+        i64 peak = 0;
+        for (const auto& [pass, size] : events)
+        {
+            live += size;
+            peak = std::max(peak, live);
+        }
+        return static_cast<u64>(peak);
+    }
+}
+
+namespace FS
+{
+    TransientAliasingPlan PlanTransientAliasing(const Span<const TransientResourceDesc> resources)
+    {
+        const u32 resource_count = static_cast<u32>(resources.size());
+        TransientAliasingPlan plan;
+        plan.Offsets.resize(resource_count);
+
+        // Large resources placed first leave gaps the smaller ones fill, ties go to the one used first
+        Vec<u32> order(resource_count);
+        std::iota(order.begin(), order.end(), 0u);
+        std::ranges::sort(order, [&](const u32 a, const u32 b)
+        {
+            if (resources[a].Size != resources[b].Size)
+            {
+                return resources[a].Size > resources[b].Size;
+            }
+            if (resources[a].FirstPass != resources[b].FirstPass)
+            {
+                return resources[a].FirstPass < resources[b].FirstPass;
+            }
+            return a < b;
+        });
+
+        Vec<u32> placed;
+        placed.reserve(resource_count);
+        Vec<MemoryRange> occupied;
+        for (const u32 index : order)
+        {
+            const auto& resource = resources[index];
+            const u64 alignment = GetAlignment(resource);
+            plan.Stats.UnaliasedSize = Align(plan.Stats.UnaliasedSize, alignment) + resource.Size;
+
+            occupied.clear();
+            for (const u32 other : placed)
+            {
+                if (LifetimesOverlap(resource, resources[other]))
+                {
+                    occupied.push_back({plan.Offsets[other], plan.Offsets[other] + resources[other].Size});
+                }
+            }
+            std::ranges::sort(occupied, {}, &MemoryRange::Begin);
+
+            // Lowest aligned gap between the ranges in use during the lifetime of the resource
+            u64 offset = 0;
+            for (const auto& [begin, end] : occupied)
+            {
+                if (Align(offset, alignment) + resource.Size <= begin)
+                {
+                    break;
+                }
+                offset = std::max(offset, end);
+            }
+            offset = Align(offset, alignment);
+            plan.Offsets[index] = offset;
+            plan.Stats.HeapSize = std::max(plan.Stats.HeapSize, offset + resource.Size);
+            placed.push_back(index);
+        }
+
+        // Earlier resources sharing memory with a resource are all done before it starts, the one using it
+        // last is named when it is the only one
+        for (u32 after = 0; after < resource_count; ++after)
+        {
+            const auto& resource = resources[after];
+            const MemoryRange range{plan.Offsets[after], plan.Offsets[after] + resource.Size};
+            u32 before = AliasingBarrier::kAnyResource;
+            u32 before_count = 0;
+            for (u32 other = 0; other < resource_count; ++other)
+            {
+                const MemoryRange other_range{plan.Offsets[other], plan.Offsets[other] + resources[other].Size};
+                if (other != after && resources[other].LastPass < resource.FirstPass &&
+                    other_range.Begin < range.End && range.Begin < other_range.End)
+                {
+                    before = other;
+                    ++before_count;
+                }
+            }
+            if (before_count > 0)
+            {
+                plan.Barriers.push_back({
+                    .Pass = resource.FirstPass,
+                    .Before = before_count == 1 ? before : AliasingBarrier::kAnyResource,
+                    .After = after,
+                });
+            }
+        }
+        std::ranges::stable_sort(plan.Barriers, {}, &AliasingBarrier::Pass);
+
+        plan.Stats.PeakLiveSize = ComputePeakLiveSize(resources);
+        return plan;
+    }
+} // namespace FS
@@ -0,0 +1,137 @@
+#include "Tools/ContentHash.hpp"
+
+namespace
+{
+    constexpr u64 kPrime1 = 0x9E3779B185EBCA87;
+    constexpr u64 kPrime2 = 0xC2B2AE3D27D4EB4F;
+    constexpr u64 kPrime3 = 0x165667B19E3779F9;
+    constexpr u64 kPrime4 = 0x85EBCA77C2B2AE63;
+    constexpr u64 kPrime5 = 0x27D4EB2F165667C5;
+    constexpr u64 kStripeSize = 32;
+
+    u64 Read64(const u8* data)
+    {
+        u64 value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    u32 Read32(const u8* data)
+    {
+        u32 value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    u64 Round(u64 accumulator, const u64 input)
+    {
+        accumulator += input * kPrime2;
+        return std::rotl(accumulator, 31) * kPrime1;
+    }
+
+    u64 MergeRound(u64 hash, const u64 accumulator)
+    {
+        hash ^= Round(0, accumulator);
+        return hash * kPrime1 + kPrime4;
+    }
+
+    void ConsumeStripes(FS::Array<u64, 4>& accumulators, const u8* data, const u64 stripe_count)
+    {
+        auto [a, b, c, d] = accumulators;
+        for (u64 i = 0; i < stripe_count; ++i, data += kStripeSize)
+        {
+            a = Round(a, Read64(data));
+            b = Round(b, Read64(data + 8));
+            c = Round(c, Read64(data + 16));
+            d = Round(d, Read64(data + 24));
+        }
+        accumulators = {a, b, c, d};
+    }
+}
+
+namespace FS
+{
+    ContentHasher::ContentHasher(const u64 seed)
+        : m_accumulators{seed + kPrime1 + kPrime2, seed + kPrime2, seed, seed - kPrime1}, m_seed(seed)
+    {
+    }
+
+    void ContentHasher::Update(const void* data, u64 size)
+    {
+        const auto* bytes = static_cast<const u8*>(data);
+        m_total += size;
+        if (m_buffered > 0)
+        {
+            const u64 fill = std::min(size, kStripeSize - m_buffered);
+            std::memcpy(m_buffer.data() + m_buffered, bytes, fill);
+            m_buffered += fill;
+            bytes += fill;
+            size -= fill;
+            if (m_buffered < kStripeSize)
+            {
+                return;
+            }
+            ConsumeStripes(m_accumulators, m_buffer.data(), 1);
+            m_buffered = 0;
+        }
+
+        const u64 stripe_count = size / kStripeSize;
+        ConsumeStripes(m_accumulators, bytes, stripe_count);
+        bytes += stripe_count * kStripeSize;
+        m_buffered = size - stripe_count * kStripeSize;
+        std::memcpy(m_buffer.data(), bytes, m_buffered);
+    }
+
+    u64 ContentHasher::Finalize() const
+    {
+        u64 hash;
+        if (m_total >= kStripeSize)
+        {
+            const auto [a, b, c, d] = m_accumulators;
+            hash = std::rotl(a, 1) + std::rotl(b, 7) + std::rotl(c, 12) + std::rotl(d, 18);
+            for (const u64 accumulator : m_accumulators)
+            {
+                hash = MergeRound(hash, accumulator);
+            }
+        }
+        else
+        {
+            hash = m_seed + kPrime5;
+        }
+        hash += m_total;
+
+        const u8* data = m_buffer.data();
+        u64 remaining = m_buffered;
+        for (; remaining >= 8; remaining -= 8, data += 8)
+        {
+            hash ^= Round(0, Read64(data));
+            hash = std::rotl(hash, 27) * kPrime1 + kPrime4;
+        }
+        if (remaining >= 4)
+        {
+            hash ^= Read32(data) * kPrime1;
+            hash = std::rotl(hash, 23) * kPrime2 + kPrime3;
+            remaining -= 4;
+            data += 4;
+        }
+        for (; remaining > 0; --remaining, ++data)
+        {
+            hash ^= *data * kPrime5;
+            hash = std::rotl(hash, 11) * kPrime1;
+        }
+
+        hash ^= hash >> 33;
+        hash *= kPrime2;
+        hash ^= hash >> 29;
+        hash *= kPrime3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+
+    u64 HashContent(const void* data, const u64 size, const u64 seed)
+    {
+        ContentHasher hasher(seed);
+        hasher.Update(data, size);
+        return hasher.Finalize();
+    }
+} // namespace FS
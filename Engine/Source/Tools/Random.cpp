@@ -0,0 +1,203 @@
+#include "Tools/Random.hpp"
+
+namespace
+{
+    constexpr u64 kVersionMask = 0xFFFF'FFFF'FFFF'0FFF;
+    constexpr u64 kVariantMask = 0x3FFF'FFFF'FFFF'FFFF;
+    constexpr u64 kVariant = 0x8000'0000'0000'0000;
+
+    // Fills with [offset, offset + range), range may be 2^32 for the full 32 bit range
+    void FillUniform(u32* values, const u64 size, const u32 offset, const u64 range);
+
+#ifdef __AVX2__
+    // Four xoshiro256** streams side by side. AVX2 has no 64 bit multiply, but the constant
+    // multiplies in the scrambler are x * 5 and x * 9, which are a shift and an add.
+    struct Xoshiro256x4
+    {
+        __m256i S0;
+        __m256i S1;
+        __m256i S2;
+        __m256i S3;
+
+        explicit Xoshiro256x4(FS::Xoshiro256& seed_engine)
+        {
+            alignas(32) FS::Array<u64, 16> seeds{};
+            for (auto& seed : seeds)
+            {
+                seed = seed_engine();
+            }
+            S0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(seeds.data()));
+            S1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(seeds.data() + 4));
+            S2 = _mm256_load_si256(reinterpret_cast<const __m256i*>(seeds.data() + 8));
+            S3 = _mm256_load_si256(reinterpret_cast<const __m256i*>(seeds.data() + 12));
+        }
+
+        __m256i Next()
+        {
+            const __m256i times5 = _mm256_add_epi64(S1, _mm256_slli_epi64(S1, 2));
+            const __m256i rotated = _mm256_or_si256(_mm256_slli_epi64(times5, 7), _mm256_srli_epi64(times5, 57));
+            const __m256i result = _mm256_add_epi64(rotated, _mm256_slli_epi64(rotated, 3));
+
+            const __m256i t = _mm256_slli_epi64(S1, 17);
+            S2 = _mm256_xor_si256(S2, S0);
+            S3 = _mm256_xor_si256(S3, S1);
+            S1 = _mm256_xor_si256(S1, S2);
+            S0 = _mm256_xor_si256(S0, S3);
+            S2 = _mm256_xor_si256(S2, t);
+            S3 = _mm256_or_si256(_mm256_slli_epi64(S3, 45), _mm256_srli_epi64(S3, 19));
+            return result;
+        }
+    };
+
+    Xoshiro256x4& ThreadRandomX4()
+    {
+        thread_local Xoshiro256x4 engine(FS::ThreadRandom());
+        return engine;
+    }
+
+    // High 32 bits of each 32x32 bit product, so values end up in [0, range)
+    __m256i MultiplyHigh(const __m256i values, const __m256i range)
+    {
+        const __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(values, range), 32);
+        const __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(values, 32), range);
+        return _mm256_blend_epi32(even, odd, 0b10101010);
+    }
+
+    void FillUniform(u32* values, const u64 size, const u32 offset, const u64 range)
+    {
+        auto& engine = ThreadRandomX4();
+        const bool full_range = range > std::numeric_limits<u32>::max();
+        const __m256i range_vector = _mm256_set1_epi32(static_cast<i32>(static_cast<u32>(range)));
+        const __m256i offset_vector = _mm256_set1_epi32(static_cast<i32>(offset));
+        const auto next = [&]
+        {
+            const __m256i bits = engine.Next();
+            const __m256i scaled = full_range ? bits : MultiplyHigh(bits, range_vector);
+            return _mm256_add_epi32(scaled, offset_vector);
+        };
+
+        u64 i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(values + i), next());
+        }
+        if (i < size)
+        {
+            alignas(32) FS::Array<u32, 8> tail{};
+            _mm256_store_si256(reinterpret_cast<__m256i*>(tail.data()), next());
+            std::copy_n(tail.data(), size - i, values + i);
+        }
+    }
+#else
+    void FillUniform(u32* values, const u64 size, const u32 offset, const u64 range)
+    {
+        auto& engine = FS::ThreadRandom();
+        for (u64 i = 0; i < size; ++i)
+        {
+            const u64 bits = engine() >> 32;
+            values[i] = offset + static_cast<u32>((bits * range) >> 32);
+        }
+    }
+#endif
+}
+
+namespace FS
+{
+    u64 CreateThreadSeed()
+    {
+        static std::atomic<u64> thread_counter = 0;
+        std::random_device device;
+        u64 state = (static_cast<u64>(device()) << 32 | device()) ^
+            thread_counter.fetch_add(1, std::memory_order_relaxed) * 0x9e3779b97f4a7c15;
+        return SplitMix64(state);
+    }
+
+    void RandomFill(const Span<f32> values, const f32 min, const f32 max)
+    {
+        // 24 random bits per float so every value is exactly representable before scaling
+        const f32 scale = (max - min) * 0x1p-24f;
+#ifdef __AVX2__
+        auto& engine = ThreadRandomX4();
+        const __m256 scale_vector = _mm256_set1_ps(scale);
+        const __m256 min_vector = _mm256_set1_ps(min);
+        const auto next = [&]
+        {
+            const __m256 unit = _mm256_cvtepi32_ps(_mm256_srli_epi32(engine.Next(), 8));
+            return _mm256_add_ps(_mm256_mul_ps(unit, scale_vector), min_vector);
+        };
+
+        u64 i = 0;
+        for (; i + 8 <= values.size(); i += 8)
+        {
+            _mm256_storeu_ps(values.data() + i, next());
+        }
+        if (i < values.size())
+        {
+            alignas(32) Array<f32, 8> tail{};
+            _mm256_store_ps(tail.data(), next());
+            std::copy_n(tail.data(), values.size() - i, values.data() + i);
+        }
+#else
+        auto& engine = ThreadRandom();
+        for (auto& value : values)
+        {
+            value = static_cast<f32>(engine() >> 40) * scale + min;
+        }
+#endif
+    }
+
+    void RandomFill(const Span<u32> values, const u32 min, const u32 max)
+    {
+        FillUniform(values.data(), values.size(), min, static_cast<u64>(max) - min + 1);
+    }
+
+    void RandomFill(const Span<i32> values, const i32 min, const i32 max)
+    {
+        const u64 range = static_cast<u64>(static_cast<i64>(max) - min + 1);
+        FillUniform(reinterpret_cast<u32*>(values.data()), values.size(), static_cast<u32>(min), range);
+    }
+
+    Guid CreateGuid()
+    {
+        auto& engine = ThreadRandom();
+        return {
+            .High = (engine() & kVersionMask) | 0x4000,
+            .Low = (engine() & kVariantMask) | kVariant,
+        };
+    }
+
+    Guid CreateGuidV7()
+    {
+        thread_local u64 last_time = 0;
+        thread_local u64 counter = 0;
+
+        auto& engine = ThreadRandom();
+        const auto now = std::chrono::system_clock::now().time_since_epoch();
+        const auto time = static_cast<u64>(std::chrono::duration_cast<std::chrono::milliseconds>(now).count());
+        if (time > last_time)
+        {
+            // Start the counter in the lower half so it rarely overflows within a millisecond
+            last_time = time;
+            counter = engine() & 0x7FF;
+        }
+        else if (++counter > 0xFFF)
+        {
+            // Borrow the next millisecond rather than break the ordering
+            ++last_time;
+            counter = 0;
+        }
+
+        return {
+            .High = (last_time & 0xFFFF'FFFF'FFFF) << 16 | 0x7000 | counter,
+            .Low = (engine() & kVariantMask) | kVariant,
+        };
+    }
+
+    void CreateGuids(const Span<Guid> guids)
+    {
+        for (auto& guid : guids)
+        {
+            guid = CreateGuid();
+        }
+    }
+} // namespace FS
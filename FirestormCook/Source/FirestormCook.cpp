@@ -0,0 +1,112 @@
+#include "Asset/AssetCooker.hpp"
+#include "Asset/ShaderBuilder.hpp"
+#include "Core/JobSystem.hpp"
+#include "Core/Serializer.hpp"
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::print("Usage: FirestormCook <project directory, .proj file or shader directory> [options]\n"
+                   "  -o <directory>  Output directory, defaults to Cooked in the project directory\n"
+                   "  -r <file>       JSON build report, defaults to CookReport.json in the output directory\n"
+                   "  -j <count>      Worker threads, defaults to one per hardware thread\n"
+                   "  -f              Cook everything, even assets that are up to date\n"
+                   "  -s              Compile the .hlsl shaders of the directory instead of cooking assets\n");
+    }
+
+    int BuildShaders(const FS::CookSettings& settings, FS::JobSystem& jobs)
+    {
+        FS::DxcShaderCompiler compiler;
+        FS::ShaderBuilder builder(compiler, jobs);
+        const auto shaders = FS::ShaderBuilder::FindShaders(settings.SourceDirectory, settings.OutputDirectory,
+                                                            FS::GetShaderPermutationUsage());
+        const FS::ShaderBuildSettings build_settings{
+            .CachePath = (std::filesystem::path(settings.OutputDirectory) / "ShaderCache.bin").string(),
+            .LibraryPath = (std::filesystem::path(settings.OutputDirectory) / "Shaders.fslib").string(),
+            .Force = settings.Force,
+        };
+        const auto report = builder.Cook(shaders, build_settings);
+        if (!settings.ReportPath.empty() &&
+            !FS::Serializer::Write(report, settings.ReportPath, FS::SerializeFormat::eJson))
+        {
+            FS::Log::Warn("FirestormCook Failed to write the report {}", settings.ReportPath);
+        }
+        return report.FailedCount == 0 ? 0 : 1;
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    FS::CookSettings settings;
+    u32 worker_count = 0;
+    bool shaders = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view argument = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (argument == "-o" && has_value)
+        {
+            settings.OutputDirectory = argv[++i];
+        }
+        else if (argument == "-r" && has_value)
+        {
+            settings.ReportPath = argv[++i];
+        }
+        else if (argument == "-j" && has_value)
+        {
+            const std::string_view value = argv[++i];
+            std::from_chars(value.data(), value.data() + value.size(), worker_count);
+        }
+        else if (argument == "-f")
+        {
+            settings.Force = true;
+        }
+        else if (argument == "-s")
+        {
+            shaders = true;
+        }
+        else if (settings.SourceDirectory.empty() && !argument.starts_with('-'))
+        {
+            settings.SourceDirectory = argument;
+        }
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+    if (settings.SourceDirectory.empty())
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    // A project file cooks the directory it lives in
+    if (std::filesystem::path source(settings.SourceDirectory); !shaders && source.extension() == ".proj")
+    {
+        settings.SourceDirectory = source.parent_path().string();
+    }
+    if (settings.OutputDirectory.empty())
+    {
+        settings.OutputDirectory = (std::filesystem::path(settings.SourceDirectory) / "Cooked").string();
+    }
+    if (settings.ReportPath.empty() && !shaders)
+    {
+        settings.ReportPath = (std::filesystem::path(settings.OutputDirectory) / "CookReport.json").string();
+    }
+
+    FS::JobSystem jobs;
+    jobs.Init(worker_count);
+    if (shaders)
+    {
+        const int result = BuildShaders(settings, jobs);
+        jobs.Shutdown();
+        return result;
+    }
+    FS::AssetCooker cooker(jobs);
+    cooker.AddDefaultRules();
+    const auto report = cooker.Cook(settings);
+    jobs.Shutdown();
+    return report.FailedCount == 0 ? 0 : 1;
+}